@@ -0,0 +1 @@
+#include "../../src/Core/source/ObjectPropertyStore_p.h"
@@ -72,12 +72,17 @@ HEADERS += source/QtilitiesCore_global.h \
     source/ITask.h \
     source/Task.h \
     source/TaskManager.h \
+    source/TaskExecutor.h \
     source/ITaskContainer.h \
     source/FileUtils.h \
     source/QtilitiesProcess.h \
+    source/ProcessBufferSplitter.h \
+    source/QtilitiesProcessPool.h \
     source/FileSetInfo.h \
     source/FileLocker.h \
-    source/IAvailablePropertyProvider.h
+    source/IAvailablePropertyProvider.h \
+    source/ObjectPropertyStore_p.h \
+    source/QtilitiesPropertyAtoms.h
 
 SOURCES += source/QtilitiesCoreApplication.cpp \
     source/QtilitiesCoreApplication_p.cpp \
@@ -100,9 +105,14 @@ SOURCES += source/QtilitiesCoreApplication.cpp \
     source/QtilitiesProperty.cpp \
     source/IExportable.cpp \
     source/TaskManager.cpp \
+    source/TaskExecutor.cpp \
     source/ITaskContainer.cpp \
     source/Task.cpp \
     source/FileUtils.cpp \
     source/QtilitiesProcess.cpp \
+    source/ProcessBufferSplitter.cpp \
+    source/QtilitiesProcessPool.cpp \
     source/FileSetInfo.cpp \
-    source/FileLocker.cpp
+    source/FileLocker.cpp \
+    source/ObjectPropertyStore_p.cpp \
+    source/QtilitiesPropertyAtoms.cpp
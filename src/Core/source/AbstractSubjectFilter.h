@@ -14,6 +14,8 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QList>
+#include <QStringList>
 
 #include "QtilitiesCore_global.h"
 #include "IExportable.h"
@@ -97,6 +99,31 @@ namespace Qtilities {
                 Q_UNUSED(silent)
                 return AbstractSubjectFilter::Allowed;
             }
+            //! Evaluates the attachment of a batch of new subjects to the filter's observer context.
+            /*!
+                Observer::attachSubjects() evaluates a complete batch of objects with a single call to this function on each installed subject
+                filter. Filters which can evaluate many objects at once cheaper than one at a time should reimplement this function.
+
+                \param objects The objects to be evaluated.
+                \param rejectMsgs When valid, a reject message is appended for every object which was rejected.
+                \param silent See evaluateAttachment().
+                \returns One evaluation result for every object in \p objects, in the same order.
+
+                \note By default evaluateAttachment() is called for every object.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual QList<AbstractSubjectFilter::EvaluationResult> evaluateAttachments(const QList<QObject*>& objects, QStringList* rejectMsgs = 0, bool silent = false) const {
+                QList<AbstractSubjectFilter::EvaluationResult> results;
+                for (int i = 0; i < objects.count(); ++i) {
+                    QString reject_msg;
+                    AbstractSubjectFilter::EvaluationResult result = evaluateAttachment(objects.at(i),&reject_msg,silent);
+                    if (result == AbstractSubjectFilter::Rejected && rejectMsgs)
+                        rejectMsgs->append(reject_msg);
+                    results << result;
+                }
+                return results;
+            }
             //! Initialize the attachment of a new subject to the filter's observer context.
             /*!
                 \note The object is not yet attached to the observer context when this function is called.
@@ -144,6 +171,30 @@ namespace Qtilities {
                 Q_UNUSED(rejectMsg)
                 return AbstractSubjectFilter::Allowed;
             }
+            //! Evaluates the detachment of a batch of subjects from the filter's observer context.
+            /*!
+                Observer::detachSubjects() evaluates a complete batch of objects with a single call to this function on each installed subject
+                filter. Filters which can evaluate many objects at once cheaper than one at a time should reimplement this function.
+
+                \param objects The objects to be evaluated.
+                \param rejectMsgs When valid, a reject message is appended for every object which was rejected.
+                \returns One evaluation result for every object in \p objects, in the same order.
+
+                \note By default evaluateDetachment() is called for every object.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual QList<AbstractSubjectFilter::EvaluationResult> evaluateDetachments(const QList<QObject*>& objects, QStringList* rejectMsgs = 0) const {
+                QList<AbstractSubjectFilter::EvaluationResult> results;
+                for (int i = 0; i < objects.count(); ++i) {
+                    QString reject_msg;
+                    AbstractSubjectFilter::EvaluationResult result = evaluateDetachment(objects.at(i),&reject_msg);
+                    if (result == AbstractSubjectFilter::Rejected && rejectMsgs)
+                        rejectMsgs->append(reject_msg);
+                    results << result;
+                }
+                return results;
+            }
 
             //! Initialize the detachment of a subject from the filter's observer context.
             /*!
@@ -211,6 +262,7 @@ namespace Qtilities {
                 change is completed.
 
                 \note By default an empty QStringList() is returned by the base class.
+                \note The observer context queries this list once when the filter is installed.
 
                 \sa handleMonitoredPropertyChange(), monitoredPropertyChanged()
               */
@@ -224,6 +276,7 @@ namespace Qtilities {
                 All %Qtilities properties are defined in the Qtilities::Core::Properties namespace.
 
                 \note By default an empty QStringList() is returned by the base class.
+                \note The observer context queries this list once when the filter is installed.
               */
             virtual QStringList reservedProperties() const {
                 return QStringList();
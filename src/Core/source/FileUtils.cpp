@@ -22,6 +22,11 @@
 #include <QHash>
 #include <QtDebug>
 #include <QCoreApplication>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 using namespace Qtilities::Core::Interfaces;
 
@@ -205,6 +210,225 @@ QFileInfoList Qtilities::Core::FileUtils::findFilesUnderDir(const QString &dirNa
     return d->find_files_under_dir_list;
 }
 
+// --------------------------------
+// Parallel findFilesUnderDir() implementation
+// --------------------------------
+
+struct FileUtilsWalkState {
+    FileUtilsWalkState() : outstanding(0),
+        want_files(false),
+        want_dirs(false),
+        sort(QDir::NoSort),
+        include_case(Qt::CaseSensitive) {}
+    ~FileUtilsWalkState() {
+        delete [] outstanding;
+    }
+
+    QThreadPool         pool;
+    //! The number of directories still to be scanned for each directory directly under the root directory.
+    QAtomicInt*         outstanding;
+    //! The number of directories directly under the root directory of which the complete hierarchy was scanned.
+    QAtomicInt          completed_subtrees;
+
+    QStringList         ignore_patterns;
+    QStringList         include_patterns;
+    QDir::Filters       list_filters;
+    bool                want_files;
+    bool                want_dirs;
+    QDir::SortFlags     sort;
+    Qt::CaseSensitivity include_case;
+
+    QMutex              found_mutex;
+    QFileInfoList       found;
+};
+
+//! Pattern lists are compiled once per directory task since QRegExp instances can't be shared between threads.
+static QList<QRegExp> compileFileUtilsPatterns(const QStringList& patterns, Qt::CaseSensitivity cs) {
+    QList<QRegExp> regexps;
+    foreach (const QString& pattern, patterns)
+        regexps << QRegExp(pattern,cs,QRegExp::Wildcard);
+    return regexps;
+}
+
+static bool matchesFileUtilsPattern(QList<QRegExp>& regexps, const QString& value) {
+    for (int i = 0; i < regexps.count(); ++i) {
+        if (regexps[i].exactMatch(value))
+            return true;
+    }
+    return false;
+}
+
+//! Lists a single directory, adds matching entries to found and returns the sub directories which must be scanned.
+static QStringList scanFileUtilsDirectory(FileUtilsWalkState* state, const QString& path, QList<QRegExp>& ignore_regexps, QList<QRegExp>& include_regexps, QFileInfoList& found) {
+    QStringList sub_dirs;
+    QDir dir(path);
+    foreach (const QFileInfo& info, dir.entryInfoList(state->list_filters,state->sort)) {
+        if (!ignore_regexps.isEmpty()) {
+            // IMPORTANT: For paths, \\ separators does not do the trick. We need to use /
+            #ifdef Q_OS_WIN
+            QString path_to_match = QDir::fromNativeSeparators(info.filePath());
+            #else
+            QString path_to_match = QDir::toNativeSeparators(info.filePath());
+            #endif
+            if (matchesFileUtilsPattern(ignore_regexps,path_to_match))
+                continue;
+        }
+
+        if (info.isDir()) {
+            sub_dirs << info.absoluteFilePath();
+            if (state->want_dirs)
+                found << info;
+        } else if (state->want_files) {
+            if (include_regexps.isEmpty() || matchesFileUtilsPattern(include_regexps,info.fileName()))
+                found << info;
+        }
+    }
+    return sub_dirs;
+}
+
+//! Scans a single directory for FileUtils::findFilesUnderDirParallel() and queues its sub directories as new tasks.
+class FileUtilsDirectoryTask : public QRunnable {
+public:
+    FileUtilsDirectoryTask(FileUtilsWalkState* state, const QString& path, int subtree) : d_state(state),
+        d_path(path),
+        d_subtree(subtree) {}
+
+    void run() {
+        QList<QRegExp> ignore_regexps = compileFileUtilsPatterns(d_state->ignore_patterns,Qt::CaseSensitive);
+        QList<QRegExp> include_regexps = compileFileUtilsPatterns(d_state->include_patterns,d_state->include_case);
+
+        QFileInfoList found;
+        QStringList sub_dirs = scanFileUtilsDirectory(d_state,d_path,ignore_regexps,include_regexps,found);
+
+        // Sub directories are queued before this task finishes, thus the pool is never idle while work remains:
+        foreach (const QString& sub_dir, sub_dirs) {
+            d_state->outstanding[d_subtree].ref();
+            d_state->pool.start(new FileUtilsDirectoryTask(d_state,sub_dir,d_subtree));
+        }
+
+        if (!found.isEmpty()) {
+            QMutexLocker locker(&d_state->found_mutex);
+            d_state->found.append(found);
+        }
+
+        if (!d_state->outstanding[d_subtree].deref())
+            d_state->completed_subtrees.ref();
+    }
+
+private:
+    FileUtilsWalkState* d_state;
+    QString             d_path;
+    int                 d_subtree;
+};
+
+QFileInfoList Qtilities::Core::FileUtils::findFilesUnderDirParallel(const QString &dirName,
+                                                                    const QString& file_filters,
+                                                                    const QString& ignore_list,
+                                                                    QDir::Filters filters,
+                                                                    QDir::SortFlags sort,
+                                                                    int thread_count,
+                                                                    bool collect_results) {
+    d->find_files_under_dir_list.clear();
+
+    QDir dir(dirName);
+    if (!dir.exists(dirName))
+        return d->find_files_under_dir_list;
+
+    int task_id = findTaskID(taskNameToString(TaskFindFilesUnderDir));
+    Task* task_ref = 0;
+    if (isTaskActive(task_id))
+        task_ref = findTask(taskNameToString(TaskFindFilesUnderDir));
+
+    FileUtilsWalkState state;
+    state.ignore_patterns = ignore_list.split(" ",QString::SkipEmptyParts);
+    state.ignore_patterns.removeDuplicates();
+    for (int i = 0; i < state.ignore_patterns.count(); ++i) {
+        #ifdef Q_OS_WIN
+        state.ignore_patterns[i] = QDir::fromNativeSeparators(state.ignore_patterns.at(i));
+        #else
+        state.ignore_patterns[i] = QDir::toNativeSeparators(state.ignore_patterns.at(i));
+        #endif
+    }
+    state.include_patterns = file_filters.split(" ",QString::SkipEmptyParts);
+    state.include_case = (filters & QDir::CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    // Always add QDir::NoDotAndDotDot otherwise we can go into an endless loop here.
+    state.list_filters = filters | QDir::AllDirs | QDir::NoDotAndDotDot;
+    state.want_files = filters & QDir::Files;
+    state.want_dirs = filters & QDir::AllDirs;
+    state.sort = sort;
+    if (thread_count < 1)
+        thread_count = QThread::idealThreadCount();
+    state.pool.setMaxThreadCount(qMax(1,thread_count));
+
+    // The root directory is scanned here, each directory under it becomes a subtree which is scanned in parallel:
+    QList<QRegExp> ignore_regexps = compileFileUtilsPatterns(state.ignore_patterns,Qt::CaseSensitive);
+    QList<QRegExp> include_regexps = compileFileUtilsPatterns(state.include_patterns,state.include_case);
+    QFileInfoList root_found;
+    QStringList sub_dirs = scanFileUtilsDirectory(&state,dir.absolutePath(),ignore_regexps,include_regexps,root_found);
+    int root_file_count = 0;
+    foreach (const QFileInfo& info, root_found) {
+        if (!info.isDir())
+            ++root_file_count;
+    }
+
+    if (task_ref) {
+        task_ref->setDisplayName(tr("Finding Files: ") + dir.dirName());
+        task_ref->startTask(sub_dirs.count()*10 + root_file_count);
+        task_ref->logMessage(tr("Searching for files in directory: ") + dirName);
+        if (root_file_count > 0)
+            task_ref->addCompletedSubTasks(root_file_count);
+    }
+
+    int found_count = root_found.count();
+    if (collect_results)
+        d->find_files_under_dir_list.append(root_found);
+    if (!root_found.isEmpty())
+        emit filesFound(root_found);
+
+    state.outstanding = new QAtomicInt[qMax(1,sub_dirs.count())];
+    for (int i = 0; i < sub_dirs.count(); ++i) {
+        state.outstanding[i].ref();
+        state.pool.start(new FileUtilsDirectoryTask(&state,sub_dirs.at(i),i));
+    }
+
+    // Deliver found entries and progress while the pool is busy:
+    int reported_subtrees = 0;
+    bool done = sub_dirs.isEmpty();
+    forever {
+        if (!done)
+            done = state.pool.waitForDone(50);
+
+        QFileInfoList found;
+        state.found_mutex.lock();
+        found.swap(state.found);
+        state.found_mutex.unlock();
+
+        if (!found.isEmpty()) {
+            found_count += found.count();
+            if (collect_results)
+                d->find_files_under_dir_list.append(found);
+            emit filesFound(found);
+        }
+
+        int completed_subtrees = state.completed_subtrees.fetchAndAddOrdered(0);
+        if (task_ref && completed_subtrees > reported_subtrees)
+            task_ref->addCompletedSubTasks((completed_subtrees - reported_subtrees)*10);
+        reported_subtrees = completed_subtrees;
+
+        if (done)
+            break;
+        QCoreApplication::processEvents();
+    }
+
+    if (task_ref) {
+        task_ref->setDisplayName(tr("Found Files In: ") + dir.dirName());
+        task_ref->logMessage(tr("Successfully searched for and found ") + QString::number(found_count) + tr(" files under directory: ") + dirName);
+        task_ref->completeTask(ITask::TaskSuccessful);
+    }
+
+    return d->find_files_under_dir_list;
+}
+
 QFileInfoList Qtilities::Core::FileUtils::lastFilesUnderDir() {
     return d->find_files_under_dir_list;
 }
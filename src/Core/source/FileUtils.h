@@ -88,6 +88,8 @@ QFileInfoList files = fu.findFilesUnderDir("c:/my_path");
                \param sort The QDir::SortFlags to apply when searching for files and folders.
                \param first_run Ignore this parameter, used in recursive operations.
                \return A list of QFileInfos containing the information about found files.
+
+               \sa findFilesUnderDirParallel()
               */
             QFileInfoList findFilesUnderDir(const QString &dirName,
                                             const QString& file_filters = QString(),
@@ -95,6 +97,47 @@ QFileInfoList files = fu.findFilesUnderDir("c:/my_path");
                                             QDir::Filters filters = QDir::Files | QDir::NoDotAndDotDot,
                                             QDir::SortFlags sort = QDir::NoSort,
                                             bool first_run = true);
+            //! Finds all files in the directory hierarchy under a directory using multiple threads.
+            /*!
+               This function finds files in the same way as findFilesUnderDir(), but scans directories in parallel on a thread pool. Each directory
+               is listed only once, the ignore and file filter patterns are compiled once per directory instead of once per entry, and found entries are streamed
+               through filesFound() in batches while the scan is busy. The calling thread keeps processing events while waiting for the scan to finish.
+
+               Progress is reported through the TaskFindFilesUnderDir task: every file directly under \p dirName counts as 1 sub task and every
+               directory directly under \p dirName counts as 10 sub tasks, which complete when the complete hierarchy under that directory was scanned.
+               Unlike findFilesUnderDir(), individual files and directories are not logged to the task in order to keep the scan bounded by I/O.
+
+               Directories are only returned when \p filters contains QDir::AllDirs, in which case all directories in the hierarchy are returned.
+               This differs from findFilesUnderDir(), which also returns the directories below the first level of the hierarchy when \p filters only
+               contains QDir::Files. Apart from that, both functions return the same entries, although not in the same order.
+
+\code
+FileUtils fu;
+connect(&fu,SIGNAL(filesFound(QFileInfoList)),SLOT(handleFilesFound(QFileInfoList)));
+
+// All non-system and non-hidden files, streamed to handleFilesFound() without collecting them:
+fu.findFilesUnderDirParallel("c:/my_path",QString(),"*.svn *.bak",QDir::Files | QDir::NoDotAndDotDot,QDir::NoSort,-1,false);
+\endcode
+
+               \param dirName Path of directory to search under.
+               \param file_filters The list of files which must be returned, when empty all files are returned. For example: *.bit *.log *.ngc
+               \param ignore_list Files and directories which should be ignored. Must be in the format: *.svn *.bak *.tmp
+               \param filters The QDir::Filters to apply when searching for files and folders.
+               \param sort The QDir::SortFlags to apply when listing each directory. The order of entries from different directories is not defined.
+               \param thread_count The number of threads to use, when -1 QThread::idealThreadCount() is used.
+               \param collect_results When true the found entries are returned and available through lastFilesUnderDir(). When false they are only
+               streamed through filesFound() and an empty list is returned.
+               \return A list of QFileInfos containing the information about found files when \p collect_results is true.
+
+               <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QFileInfoList findFilesUnderDirParallel(const QString &dirName,
+                                                    const QString& file_filters = QString(),
+                                                    const QString& ignore_list = QString(),
+                                                    QDir::Filters filters = QDir::Files | QDir::NoDotAndDotDot,
+                                                    QDir::SortFlags sort = QDir::NoSort,
+                                                    int thread_count = -1,
+                                                    bool collect_results = true);
             //! Returns the last QFileInfoList produced by fileFilesUnderDir().
             QFileInfoList lastFilesUnderDir();
             //! Sets up the paramaters for future findFilesUnderDir() runs.
@@ -111,6 +154,13 @@ QFileInfoList files = fu.findFilesUnderDir("c:/my_path");
                                             const QString& ignore_list = QString(),
                                             QDir::Filters filters = QDir::Files | QDir::NoDotAndDotDot,
                                             QDir::SortFlags sort = QDir::NoSort);
+        signals:
+            //! Emitted with batches of found entries while findFilesUnderDirParallel() is busy.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void filesFound(const QFileInfoList& files);
+
         private slots:
             //! Finds all files in the directory hierarhcy under a directory.
             /*!
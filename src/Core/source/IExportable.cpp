@@ -13,6 +13,8 @@
 #include "QtilitiesCoreApplication.h"
 
 #include <QDomElement>
+#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
 
 Qtilities::Core::Interfaces::IExportable::IExportable() {
     d_export_version = Qtilities::Qtilities_Latest;
@@ -80,6 +82,90 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Int
     return IExportable::Complete;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Interfaces::IExportable::exportXmlStream(QXmlStreamWriter* writer) const {
+    // Only this object is built in memory, thus the temporary document stays small:
+    QDomDocument doc("tmp");
+    QDomElement object_node = doc.createElement("tmp");
+    doc.appendChild(object_node);
+
+    ExportResultFlags result = exportXml(&doc,&object_node);
+    if (result & IExportable::FailedResult)
+        return result;
+
+    writeXmlElementContents(writer,object_node);
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Interfaces::IExportable::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    QDomDocument doc("tmp");
+    QDomElement object_node = doc.createElement(reader->qualifiedName().toString());
+    doc.appendChild(object_node);
+
+    if (!readXmlElementContents(reader,&doc,&object_node)) {
+        LOG_TASK_ERROR(QString(QObject::tr("Failed to read XML stream on line %1: %2")).arg(reader->lineNumber()).arg(reader->errorString()),exportTask());
+        return IExportable::Failed;
+    }
+
+    return importXml(&doc,&object_node,import_list);
+}
+
+void Qtilities::Core::Interfaces::IExportable::writeXmlElementContents(QXmlStreamWriter* writer, const QDomElement& element) {
+    // Attributes must be written before any child nodes:
+    QDomNamedNodeMap attributes = element.attributes();
+    for (int i = 0; i < attributes.count(); ++i) {
+        QDomAttr attribute = attributes.item(i).toAttr();
+        writer->writeAttribute(attribute.name(),attribute.value());
+    }
+
+    QDomNode child = element.firstChild();
+    while (!child.isNull()) {
+        if (child.isElement()) {
+            QDomElement child_element = child.toElement();
+            writer->writeStartElement(child_element.tagName());
+            writeXmlElementContents(writer,child_element);
+            writer->writeEndElement();
+        } else if (child.isCDATASection()) {
+            // Check CDATA before text, QDomCDATASection is also a QDomText:
+            writer->writeCDATA(child.toCDATASection().data());
+        } else if (child.isText()) {
+            writer->writeCharacters(child.toText().data());
+        } else if (child.isComment()) {
+            writer->writeComment(child.toComment().data());
+        }
+        child = child.nextSibling();
+    }
+}
+
+bool Qtilities::Core::Interfaces::IExportable::readXmlElementContents(QXmlStreamReader* reader, QDomDocument* doc, QDomElement* element) {
+    readXmlElementAttributes(reader,element);
+
+    while (!reader->atEnd()) {
+        reader->readNext();
+        if (reader->isEndElement())
+            break;
+
+        if (reader->isStartElement()) {
+            QDomElement child = doc->createElement(reader->qualifiedName().toString());
+            element->appendChild(child);
+            if (!readXmlElementContents(reader,doc,&child))
+                return false;
+        } else if (reader->isCDATA()) {
+            element->appendChild(doc->createCDATASection(reader->text().toString()));
+        } else if (reader->isCharacters() && !reader->isWhitespace()) {
+            // Whitespace only text is dropped, the same as QDomDocument::setContent() does:
+            element->appendChild(doc->createTextNode(reader->text().toString()));
+        }
+    }
+
+    return !reader->hasError();
+}
+
+void Qtilities::Core::Interfaces::IExportable::readXmlElementAttributes(QXmlStreamReader* reader, QDomElement* element) {
+    QXmlStreamAttributes attributes = reader->attributes();
+    for (int i = 0; i < attributes.count(); ++i)
+        element->setAttribute(attributes.at(i).qualifiedName().toString(),attributes.at(i).value().toString());
+}
+
 void Qtilities::Core::Interfaces::IExportable::setApplicationExportVersion(quint32 version) {
     d_application_export_version_set = true;
     d_export_application_version = version;
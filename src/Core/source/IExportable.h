@@ -26,6 +26,8 @@
 
 class QDomDocument;
 class QDomElement;
+class QXmlStreamWriter;
+class QXmlStreamReader;
 
 namespace Qtilities {
     namespace Core {
@@ -57,6 +59,8 @@ namespace Qtilities {
 
             XML exports allow you to build up an XML QDomDocument with information about a set of objects and is performed through the exportXml() and importXml() functions. These both provides you with a reference to the QDomDocument which allows you to create a new QDomElements. A QDomElement which represents your object is also provided. This allows you to easily construct new QDomElements and attach them to your objects node.
 
+            For large exports, for example complete projects, the exportXmlStream() and importXmlStream() functions write the same XML directly to a QXmlStreamWriter and read it back element by element from a QXmlStreamReader. This avoids building the complete document in memory. By default these functions use exportXml() and importXml() on a small temporary document, thus you only need to reimplement them when your object's own export is large.
+
             See the \ref iexportable_comparison section of this page for a comparison between Binary and XML exports.
 
             \section iexportable_comparison Binary vs. XML Exports
@@ -275,7 +279,7 @@ int main(int argc, char *argv[])
                 enum ExportMode {
                     None = 0,      /*!< Does not support any export modes. */
                     Binary = 1,    /*!< Binary exporting using QDataStream. \sa exportBinary(), importBinary() */
-                    XML = 2        /*!< XML exporting using QDomDocument. \sa exportXml(), importXml() */
+                    XML = 2        /*!< XML exporting using QDomDocument, or QXmlStreamWriter and QXmlStreamReader. \sa exportXml(), importXml(), exportXmlStream(), importXmlStream() */
                 };
                 Q_DECLARE_FLAGS(ExportModeFlags, ExportMode)
                 Q_FLAGS(ExportModeFlags)
@@ -495,6 +499,57 @@ TreeNode* duplicated_node = IExportable::duplicateInstance<TreeNode>(&node);
                   */
                 virtual ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
 
+                //----------------------------
+                // XML Stream Exporting
+                //----------------------------
+                //! Allows exporting directly to a QXmlStreamWriter, without building a QDomDocument first.
+                /*!
+                    The stream variant produces exactly the same XML as exportXml(), thus files written by it can be read using importXml() and vice versa.
+
+                    When this function is called the start element of the object node was already written to \p writer, thus the implementation can
+                    still add attributes to it. The implementation must not close the object node, the caller is responsible for that.
+
+                    The default implementation builds the object node in a small temporary QDomDocument using exportXml() and writes it to \p writer using
+                    writeXmlElementContents(). Classes with large exports, like Qtilities::Core::Observer, reimplement this function in order to write their
+                    contents to \p writer as they go.
+
+                    <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+                //! Allows importing and reconstruction of data from a QXmlStreamReader, without building a QDomDocument of the complete input first.
+                /*!
+                    When this function is called \p reader is positioned on the start element of the object node. When the function returns \p reader must be
+                    positioned on the matching end element.
+
+                    The default implementation reads the object node into a small temporary QDomDocument using readXmlElementContents() and passes it to importXml().
+
+                    <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
+                //! Writes the attributes and child nodes of \p element to \p writer.
+                /*!
+                    The start element representing \p element must already be written to \p writer, only its contents are written.
+
+                    <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                static void writeXmlElementContents(QXmlStreamWriter* writer, const QDomElement& element);
+                //! Reads the current element of \p reader into \p element.
+                /*!
+                    \p reader must be positioned on a start element. Its attributes and child nodes are added to \p element and when the function returns
+                    \p reader is positioned on the matching end element. Attributes already present on \p element are kept, thus it is possible to
+                    read the attributes of an element first and the rest of it later.
+
+                    \returns True when successful, false if \p reader reported an error.
+
+                    <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                static bool readXmlElementContents(QXmlStreamReader* reader, QDomDocument* doc, QDomElement* element);
+                //! Adds the attributes of the current element of \p reader to \p element.
+                /*!
+                    <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                static void readXmlElementAttributes(QXmlStreamReader* reader, QDomElement* element);
+
                 //----------------------------
                 // Enum <-> String Functions
                 //----------------------------
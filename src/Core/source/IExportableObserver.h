@@ -18,6 +18,7 @@
 
 class QDomDocument;
 class QDomElement;
+class QXmlStreamWriter;
 
 namespace Qtilities {
     namespace Core {
@@ -43,6 +44,18 @@ namespace Qtilities {
                     Q_UNUSED(object_node)
                     Q_UNUSED(export_flags)
 
+                    return IExportable::Complete;
+                }
+                //! Stream variant of exportXmlExt() which writes directly to a QXmlStreamWriter.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+
+                  \sa IExportable::exportXmlStream()
+                  */
+                virtual IExportable::ExportResultFlags exportXmlStreamExt(QXmlStreamWriter* writer, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData) const {
+                    Q_UNUSED(writer)
+                    Q_UNUSED(export_flags)
+
                     return IExportable::Complete;
                 }
             };
@@ -21,6 +21,8 @@
 #include "SubjectTypeFilter.h"
 #include "ObserverRelationalTable.h"
 #include "FileSetInfo.h"
+#include "ObjectPropertyStore_p.h"
+#include "QtilitiesPropertyAtoms.h"
 
 #include <Logger>
 
@@ -185,75 +187,118 @@ bool Qtilities::Core::ObjectManager::moveSubjects(QList<QObject*> objects, int s
 
     bool none_failed = true;
 
-    // For now we discard objects that cause problems during attachment and detachment
+    // Evaluate the complete batch once in both observers:
+    QStringList attach_reject_msgs;
+    QList<Observer::EvaluationResult> attach_results = destination_observer->canAttach(objects,Observer::ManualOwnership,&attach_reject_msgs,silent);
+    QList<Observer::EvaluationResult> detach_results = source_observer->canDetach(objects);
+    if (error_msg && !attach_reject_msgs.isEmpty())
+        *error_msg = attach_reject_msgs.last();
+
+    // For now we discard objects that cause problems during attachment and detachment, thus we move all objects up to the first problem:
+    QList<QObject*> scoped_objects;
+    QList<QObject*> other_objects;
     for (int i = 0; i < objects.count(); ++i) {
         // Check if the destination observer will accept it
-        Observer::EvaluationResult result = destination_observer->canAttach(objects.at(i),Observer::ManualOwnership,error_msg,silent);
-        if (result == Observer::Rejected) {           
+        if (attach_results.at(i) == Observer::Rejected)
             break;
-        } else {
-            // Detach from source
-            result = source_observer->canDetach(objects.at(i));
-            if (result == Observer::Rejected) {
-                QString error_msg_int = QString(QObject::tr("The move operation could not be completed. Detachment of the object(s) you are trying to move was rejected by the destination observer. Check the session log for more details."));
-                LOG_ERROR(error_msg_int);
-                if (error_msg)
-                    *error_msg = error_msg_int;
-                none_failed = false;
-                break;
-            } else if (result == Observer::IsParentObserver) {              
-                QString error_msg_int =QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer which is defined to be their owner.\n\nTry to share with (copy to) the destination observer instead."));
-                LOG_ERROR(error_msg_int);
-                if (error_msg)
-                    *error_msg = error_msg_int;
-                none_failed = false;
-                break;
-            } else if (result == Observer::LastScopedObserver) {
-                destination_observer->setMultiContextPropertyValue(objects.at(i),qti_prop_OWNERSHIP,QVariant(Observer::ManualOwnership));
-                if (!source_observer->detachSubject(objects.at(i))) {
-                    QString error_msg_int =QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer where LastScopedObserver was detected. Check the session log for more details."));
-                    LOG_ERROR(error_msg_int);
-                    if (error_msg)
-                        *error_msg = error_msg_int;
-                    destination_observer->setMultiContextPropertyValue(objects.at(i),qti_prop_OWNERSHIP,QVariant(Observer::ObserverScopeOwnership));
-                    none_failed = false;
-                    break;
-                } else {
-                    if (!destination_observer->attachSubject(objects.at(i),Observer::ObserverScopeOwnership)) {
-                        source_observer->attachSubject(objects.at(i),Observer::ObserverScopeOwnership,error_msg);
-                        QString error_msg_int;
-                        if (error_msg)
-                            error_msg_int = QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Error message: " ) + *error_msg);
-                        else
-                            error_msg_int = QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Calling ObjectManager::moveSubjects() with a valid error message argument will add an error message to this message."));
-                        LOG_ERROR(error_msg_int);
-                        if (error_msg)
-                            *error_msg = error_msg_int;
-                    }
-                }
-            } else {
-                if (!source_observer->detachSubject(objects.at(i))) {
-                    QString error_msg_int =QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer. Check the session log for more details."));
-                    LOG_ERROR(error_msg_int);
-                    if (error_msg)
-                        *error_msg = error_msg_int;
-                    none_failed = false;
-                    break;
-                } else {
-                    if (!destination_observer->attachSubject(objects.at(i))) {
-                        source_observer->attachSubject(objects.at(i));
-                        QString error_msg_int;
-                        if (error_msg)
-                            error_msg_int = QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Error message: " ) + *error_msg);
-                        else
-                            error_msg_int = QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Calling ObjectManager::moveSubjects() with a valid error message argument will add an error message to this message."));
-                        LOG_ERROR(error_msg_int);
-                    }
-                }
-            }
+
+        Observer::EvaluationResult result = detach_results.at(i);
+        if (result == Observer::Rejected) {
+            QString error_msg_int = QString(QObject::tr("The move operation could not be completed. Detachment of the object(s) you are trying to move was rejected by the destination observer. Check the session log for more details."));
+            LOG_ERROR(error_msg_int);
+            if (error_msg)
+                *error_msg = error_msg_int;
+            none_failed = false;
+            break;
+        } else if (result == Observer::IsParentObserver) {
+            QString error_msg_int =QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer which is defined to be their owner.\n\nTry to share with (copy to) the destination observer instead."));
+            LOG_ERROR(error_msg_int);
+            if (error_msg)
+                *error_msg = error_msg_int;
+            none_failed = false;
+            break;
+        } else if (result == Observer::LastScopedObserver) {
+            // Make sure the object is not deleted when it is detached from the source observer:
+            destination_observer->setMultiContextPropertyValue(objects.at(i),qti_prop_OWNERSHIP,QVariant(Observer::ManualOwnership));
+            scoped_objects << objects.at(i);
+        } else
+            other_objects << objects.at(i);
+    }
+
+    if (scoped_objects.isEmpty() && other_objects.isEmpty())
+        return none_failed;
+
+    source_observer->startProcessingCycle();
+    destination_observer->startProcessingCycle();
+
+    // Detach from source:
+    QList<QPointer<QObject> > detached_list = source_observer->detachSubjects(scoped_objects + other_objects);
+    QSet<QObject*> detached_set;
+    for (int i = 0; i < detached_list.count(); ++i)
+        detached_set.insert(detached_list.at(i));
+    if (detached_list.count() != scoped_objects.count() + other_objects.count()) {
+        QString error_msg_int =QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer. Check the session log for more details."));
+        LOG_ERROR(error_msg_int);
+        if (error_msg)
+            *error_msg = error_msg_int;
+        none_failed = false;
+
+        // Restore the ownership of scoped objects which are still attached to the source observer:
+        for (int i = 0; i < scoped_objects.count(); ++i) {
+            if (!detached_set.contains(scoped_objects.at(i)))
+                destination_observer->setMultiContextPropertyValue(scoped_objects.at(i),qti_prop_OWNERSHIP,QVariant(Observer::ObserverScopeOwnership));
         }
     }
 
+    QList<QObject*> detached_scoped_objects;
+    for (int i = 0; i < scoped_objects.count(); ++i) {
+        if (detached_set.contains(scoped_objects.at(i)))
+            detached_scoped_objects << scoped_objects.at(i);
+    }
+    QList<QObject*> detached_other_objects;
+    for (int i = 0; i < other_objects.count(); ++i) {
+        if (detached_set.contains(other_objects.at(i)))
+            detached_other_objects << other_objects.at(i);
+    }
+
+    // Attach to destination, objects which could not be attached are attached to the source again:
+    QString attach_error_msg;
+    QList<QPointer<QObject> > attached_scoped = destination_observer->attachSubjects(detached_scoped_objects,Observer::ObserverScopeOwnership,&attach_error_msg);
+    QList<QPointer<QObject> > attached_other = destination_observer->attachSubjects(detached_other_objects,Observer::ManualOwnership,&attach_error_msg);
+
+    QSet<QObject*> attached_set;
+    for (int i = 0; i < attached_scoped.count(); ++i)
+        attached_set.insert(attached_scoped.at(i));
+    for (int i = 0; i < attached_other.count(); ++i)
+        attached_set.insert(attached_other.at(i));
+
+    QList<QObject*> failed_scoped_objects;
+    for (int i = 0; i < detached_scoped_objects.count(); ++i) {
+        if (!attached_set.contains(detached_scoped_objects.at(i)))
+            failed_scoped_objects << detached_scoped_objects.at(i);
+    }
+    QList<QObject*> failed_other_objects;
+    for (int i = 0; i < detached_other_objects.count(); ++i) {
+        if (!attached_set.contains(detached_other_objects.at(i)))
+            failed_other_objects << detached_other_objects.at(i);
+    }
+
+    if (!failed_scoped_objects.isEmpty() || !failed_other_objects.isEmpty()) {
+        source_observer->attachSubjects(failed_scoped_objects,Observer::ObserverScopeOwnership);
+        source_observer->attachSubjects(failed_other_objects,Observer::ManualOwnership);
+        QString error_msg_int;
+        if (error_msg)
+            error_msg_int = QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Error message: " ) + attach_error_msg);
+        else
+            error_msg_int = QString(QObject::tr("The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Calling ObjectManager::moveSubjects() with a valid error message argument will add an error message to this message."));
+        LOG_ERROR(error_msg_int);
+        if (error_msg)
+            *error_msg = error_msg_int;
+    }
+
+    destination_observer->endProcessingCycle();
+    source_observer->endProcessingCycle();
+
     return none_failed;
 }
 
@@ -413,13 +458,14 @@ IExportable::ExportResultFlags Qtilities::Core::ObjectManager::exportObjectPrope
     QList<SharedProperty> properties_shared;
     QList<MultiContextProperty> properties_multi_context;
     QMap<QString,QVariant> properties_normal;
-    for (int i = 0; i < obj->dynamicPropertyNames().count(); ++i) {
-        QString property_name = QString(obj->dynamicPropertyNames().at(i).constData());
-        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
+    const QList<QByteArray> dynamic_property_names = obj->dynamicPropertyNames();
+    for (int i = 0; i < dynamic_property_names.count(); ++i) {
+        const QByteArray& property_name = dynamic_property_names.at(i);
+        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && QtilitiesPropertyAtoms::isInternalPropertyName(property_name))
             continue;
 
         // Now check the property types:
-        QVariant prop = obj->property(obj->dynamicPropertyNames().at(i).constData());
+        QVariant prop = obj->property(property_name.constData());
         if (prop.isValid() && prop.canConvert<SharedProperty>() && (property_types & ObjectManager::SharedProperties)) {
             SharedProperty shared_prop = prop.value<SharedProperty>();
             shared_prop.setExportVersion(version);
@@ -429,7 +475,7 @@ IExportable::ExportResultFlags Qtilities::Core::ObjectManager::exportObjectPrope
             multi_context_prop.setExportVersion(version);
             properties_multi_context << multi_context_prop;
         } else if (prop.isValid() && !prop.canConvert<SharedProperty>() && !prop.canConvert<MultiContextProperty>() && property_types & ObjectManager::NonQtilitiesProperties) {
-            properties_normal[QString(obj->dynamicPropertyNames().at(i).constData())] = prop;
+            properties_normal[QString(property_name.constData())] = prop;
         }
     }
 
@@ -537,13 +583,14 @@ IExportable::ExportResultFlags Qtilities::Core::ObjectManager::exportObjectPrope
     QList<SharedProperty> properties_shared;
     QList<MultiContextProperty> properties_multi_context;
     QMap<QString,QVariant> properties_normal;
-    for (int i = 0; i < obj->dynamicPropertyNames().count(); ++i) {
-        QString property_name = QString(obj->dynamicPropertyNames().at(i).constData());
-        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
+    const QList<QByteArray> dynamic_property_names = obj->dynamicPropertyNames();
+    for (int i = 0; i < dynamic_property_names.count(); ++i) {
+        const QByteArray& property_name = dynamic_property_names.at(i);
+        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && QtilitiesPropertyAtoms::isInternalPropertyName(property_name))
             continue;
 
         // Now check the property types:
-        QVariant prop = obj->property(obj->dynamicPropertyNames().at(i).constData());
+        QVariant prop = obj->property(property_name.constData());
         if (prop.isValid() && prop.canConvert<SharedProperty>() && (property_types & ObjectManager::SharedProperties)) {
             SharedProperty shared_prop = prop.value<SharedProperty>();
             if (shared_prop.isExportable()) {
@@ -557,7 +604,7 @@ IExportable::ExportResultFlags Qtilities::Core::ObjectManager::exportObjectPrope
                 properties_multi_context << multi_context_prop;
             }
         } else if (prop.isValid() && !prop.canConvert<SharedProperty>() && !prop.canConvert<MultiContextProperty>() && property_types & ObjectManager::NonQtilitiesProperties) {
-            properties_normal[QString(obj->dynamicPropertyNames().at(i).constData())] = prop;
+            properties_normal[QString(property_name.constData())] = prop;
         }
     }
 
@@ -736,19 +783,20 @@ bool Qtilities::Core::ObjectManager::cloneObjectProperties(const QObject* source
     QList<MultiContextProperty> multi_context_properties;
     QMap<QString,QVariant> non_qtilities_properties;
 
-    for (int i = 0; i < source_obj->dynamicPropertyNames().count(); ++i) {
-        QString property_name = QString(source_obj->dynamicPropertyNames().at(i).constData());
-        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
+    const QList<QByteArray> dynamic_property_names = source_obj->dynamicPropertyNames();
+    for (int i = 0; i < dynamic_property_names.count(); ++i) {
+        const QByteArray& property_name = dynamic_property_names.at(i);
+        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && QtilitiesPropertyAtoms::isInternalPropertyName(property_name))
             continue;
 
         // Now check the property types:
-        QVariant prop = source_obj->property(source_obj->dynamicPropertyNames().at(i).constData());
+        QVariant prop = source_obj->property(property_name.constData());
         if (prop.isValid() && prop.canConvert<SharedProperty>() && (property_types & ObjectManager::SharedProperties))
             shared_properties << prop.value<SharedProperty>();
         else if (prop.isValid() && prop.canConvert<MultiContextProperty>() && (property_types & ObjectManager::MultiContextProperties))
             multi_context_properties << prop.value<MultiContextProperty>();
         else if (prop.isValid() && !prop.canConvert<SharedProperty>() && !prop.canConvert<MultiContextProperty>() && property_types & ObjectManager::NonQtilitiesProperties) {
-            non_qtilities_properties[property_name] = prop;
+            non_qtilities_properties[QString(property_name.constData())] = prop;
         }
     }
 
@@ -870,33 +918,103 @@ bool Qtilities::Core::ObjectManager::propertyExists(const QObject* obj, const ch
     return prop.isValid();
 }
 
+void Qtilities::Core::ObjectManager::setPropertyStoreEnabled(bool enabled) {
+    ObjectPropertyStore::instance()->setEnabled(enabled);
+}
+
+bool Qtilities::Core::ObjectManager::propertyStoreEnabled() {
+    return ObjectPropertyStore::instance()->isEnabled();
+}
+
+QVariant Qtilities::Core::ObjectManager::getPropertyContextValue(const QObject* obj, const char* property_name, int context_id, bool* ok) {
+    if (ok)
+        *ok = false;
+    if (!obj)
+        return QVariant();
+
+    ObjectPropertyStore* store = ObjectPropertyStore::instance();
+    if (store->isEnabled()) {
+        bool handled;
+        QVariant value = store->value(obj,property_name,context_id,&handled);
+        if (handled) {
+            if (ok)
+                *ok = value.isValid() || obj->property(property_name).isValid();
+            return value;
+        }
+    }
+
+    QVariant prop = obj->property(property_name);
+    if (prop.isValid() && prop.canConvert<SharedProperty>()) {
+        if (ok)
+            *ok = true;
+        return (prop.value<SharedProperty>()).value();
+    } else if (prop.isValid() && prop.canConvert<MultiContextProperty>()) {
+        if (ok)
+            *ok = true;
+        return (prop.value<MultiContextProperty>()).value(context_id);
+    }
+
+    return QVariant();
+}
+
+bool Qtilities::Core::ObjectManager::setPropertyContextValue(QObject* obj, const char* property_name, const QVariant& new_value, int context_id) {
+    if (!obj)
+        return false;
+
+    ObjectPropertyStore* store = ObjectPropertyStore::instance();
+    if (store->isEnabled()) {
+        bool handled;
+        bool result = store->setValue(obj,property_name,new_value,context_id,&handled);
+        if (handled)
+            return result;
+    }
+
+    // Important, we do not just use the setValue() functions on the properties, we call
+    // obj->setProperty to make sure the QDynamicPropertyChangeEvent event is triggered.
+    QVariant prop = obj->property(property_name);
+    if (prop.isValid() && prop.canConvert<SharedProperty>()) {
+        SharedProperty shared_property = prop.value<SharedProperty>();
+        shared_property.setValue(new_value);
+        ObjectManager::setSharedProperty(obj,shared_property);
+        return true;
+    } else if (prop.isValid() && prop.canConvert<MultiContextProperty>()) {
+        MultiContextProperty multi_context_property = prop.value<MultiContextProperty>();
+        multi_context_property.setValue(new_value,context_id);
+        ObjectManager::setMultiContextProperty(obj,multi_context_property);
+        return true;
+    }
+
+    return false;
+}
+
 bool Qtilities::Core::ObjectManager::removeDynamicProperties(QObject* obj, PropertyTypeFlags property_types) {
     if (!obj)
         return false;
 
     // Get all properties from obj:
-    QList<QString> to_be_removed;
+    QList<QByteArray> to_be_removed;
 
-    for (int i = 0; i < obj->dynamicPropertyNames().count(); ++i) {
-        QString property_name = QString(obj->dynamicPropertyNames().at(i).constData());
-        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
+    const QList<QByteArray> dynamic_property_names = obj->dynamicPropertyNames();
+    for (int i = 0; i < dynamic_property_names.count(); ++i) {
+        const QByteArray& property_name = dynamic_property_names.at(i);
+        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && QtilitiesPropertyAtoms::isInternalPropertyName(property_name))
             continue;
 
         // Now check the property types:
-        QVariant prop = obj->property(obj->dynamicPropertyNames().at(i).constData());
+        QVariant prop = obj->property(property_name.constData());
         if (prop.isValid() && prop.canConvert<SharedProperty>() && (property_types & ObjectManager::SharedProperties))
-            to_be_removed << QString(obj->dynamicPropertyNames().at(i).constData());
+            to_be_removed << property_name;
         else if (prop.isValid() && prop.canConvert<MultiContextProperty>() && (property_types & ObjectManager::MultiContextProperties))
-            to_be_removed << QString(obj->dynamicPropertyNames().at(i).constData());
+            to_be_removed << property_name;
         else if (prop.isValid() && !prop.canConvert<SharedProperty>() && !prop.canConvert<MultiContextProperty>() && property_types & ObjectManager::NonQtilitiesProperties) {
-            to_be_removed << QString(obj->dynamicPropertyNames().at(i).constData());
+            to_be_removed << property_name;
         }
     }
 
     LOG_TRACE(QString("Removing %1 dynamic properties from object %2.").arg(to_be_removed.count()).arg(obj->objectName()));
 
-    foreach (const QString& prop_name, to_be_removed)
-        obj->setProperty(prop_name.toUtf8().constData(),QVariant());
+    foreach (const QByteArray& prop_name, to_be_removed)
+        obj->setProperty(prop_name.constData(),QVariant());
 
     return true;
 }
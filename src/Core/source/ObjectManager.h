@@ -276,6 +276,51 @@ if (ObjectManager::propertyExists(iface->objectBase(),qti_prop_CATEGORY_MAP)) {
             static bool setSharedProperty(QObject* obj, PropertySpecification property_specification);
             //! Convenience function to check if a dynamic property exists on a object.
             static bool propertyExists(const QObject* obj, const char* property_name);
+
+            // --------------------------------
+            // Property Store Functions
+            // --------------------------------
+            //! Enables or disables the typed property side-table used to access %Qtilities property values.
+            /*!
+              When enabled, getPropertyContextValue() and setPropertyContextValue() (and therefore Observer::getMultiContextPropertyValue()
+              and Observer::setMultiContextPropertyValue()) keep a compact copy of each %Qtilities property they access, keyed on the object
+              and an interned property id. This avoids copying the complete context map of a MultiContextProperty every time the value of a single
+              context is needed. The dynamic property on the object stays the master copy, thus QObject::property() works as before.
+
+              The store only serves objects living in the thread from which it was enabled. Disabled by default.
+
+              \sa propertyStoreEnabled()
+
+              This function was added in %Qtilities v1.5.
+              */
+            static void setPropertyStoreEnabled(bool enabled);
+            //! Indicates if the typed property side-table is enabled.
+            /*!
+              \sa setPropertyStoreEnabled()
+
+              This function was added in %Qtilities v1.5.
+              */
+            static bool propertyStoreEnabled();
+            //! Gets the value of a SharedProperty or MultiContextProperty for a specific context.
+            /*!
+              For shared properties the \p context_id is ignored. When the property store is enabled the value is served from the store, otherwise
+              the property is read using QObject::property().
+
+              \param ok When a valid pointer is passed, it is set to true when the property exists and is a %Qtilities property, false otherwise.
+
+              This function was added in %Qtilities v1.5.
+              */
+            static QVariant getPropertyContextValue(const QObject* obj, const char* property_name, int context_id, bool* ok = 0);
+            //! Sets the value of an existing SharedProperty or MultiContextProperty for a specific context.
+            /*!
+              For shared properties the \p context_id is ignored. The dynamic property on the object is always updated, thus
+              a QDynamicPropertyChangeEvent is delivered to the object.
+
+              \returns True when the value was set, false when the property does not exist or is not a %Qtilities property.
+
+              This function was added in %Qtilities v1.5.
+              */
+            static bool setPropertyContextValue(QObject* obj, const char* property_name, const QVariant& new_value, int context_id);
             //! Convenience function to remove all properties that match the PropertyTypeFlags from an object.
             static bool removeDynamicProperties(QObject* obj, PropertyTypeFlags property_types = AllPropertyTypes);
             //! Convenience function to compare all properties that match the PropertyTypeFlags on two objects.
@@ -0,0 +1,300 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ObjectPropertyStore_p.h"
+
+#include <Logger>
+
+#include <QMutex>
+#include <QThread>
+#include <QDynamicPropertyChangeEvent>
+
+#include <algorithm>
+
+using namespace Qtilities::Core;
+
+Qtilities::Core::ObjectPropertyStore* Qtilities::Core::ObjectPropertyStore::m_Instance = 0;
+
+Qtilities::Core::ObjectPropertyStore* Qtilities::Core::ObjectPropertyStore::instance() {
+    static QMutex mutex;
+    if (!m_Instance)
+    {
+        mutex.lock();
+
+        if (!m_Instance)
+            m_Instance = new ObjectPropertyStore;
+
+        mutex.unlock();
+    }
+
+    return m_Instance;
+}
+
+Qtilities::Core::ObjectPropertyStore::ObjectPropertyStore() : QObject() {
+    is_enabled = false;
+    setObjectName("Object Property Store");
+}
+
+Qtilities::Core::ObjectPropertyStore::~ObjectPropertyStore() {
+    setEnabled(false);
+}
+
+void Qtilities::Core::ObjectPropertyStore::setEnabled(bool enabled) {
+    if (is_enabled == enabled)
+        return;
+
+    if (enabled) {
+        // The store is used from the thread in which it was enabled:
+        if (thread() != QThread::currentThread())
+            moveToThread(QThread::currentThread());
+    } else {
+        QList<const QObject*> objects = object_entries.keys();
+        foreach (const QObject* obj, objects)
+            invalidate(obj);
+    }
+
+    is_enabled = enabled;
+    LOG_DEBUG(QString("Object property store %1.").arg(enabled ? "enabled" : "disabled"));
+}
+
+int Qtilities::Core::ObjectPropertyStore::internPropertyName(const char* property_name) {
+    const QByteArray name = QByteArray::fromRawData(property_name,qstrlen(property_name));
+    QHash<QByteArray,int>::const_iterator itr = property_ids.constFind(name);
+    if (itr != property_ids.constEnd())
+        return itr.value();
+
+    // Take a deep copy of the name, the raw data above is not owned by us:
+    const QByteArray owned_name(property_name);
+    const int property_id = property_names.count();
+    property_names << owned_name;
+    property_ids[owned_name] = property_id;
+    return property_id;
+}
+
+QByteArray Qtilities::Core::ObjectPropertyStore::propertyName(int property_id) const {
+    if (property_id < 0 || property_id >= property_names.count())
+        return QByteArray();
+    return property_names.at(property_id);
+}
+
+QVariant Qtilities::Core::ObjectPropertyStore::value(const QObject* obj, const char* property_name, int context_id, bool* handled) {
+    *handled = false;
+    if (!canHandle(obj))
+        return QVariant();
+
+    const int property_id = internPropertyName(property_name);
+    PropertyEntry* entry = findEntry(obj,property_id);
+    if (!entry) {
+        entry = populateEntry(obj,property_id,property_name);
+        if (!entry) {
+            // Either the property does not exist, or it is not a Qtilities property. Let the caller decide
+            // in the second case, an invalid variant is the final answer in the first case.
+            if (!obj->property(property_name).isValid()) {
+                *handled = true;
+            }
+            return QVariant();
+        }
+    }
+
+    *handled = true;
+    if (entry->is_shared)
+        return entry->values.isEmpty() ? QVariant() : entry->values.at(0);
+
+    QVector<quint32>::const_iterator itr = std::lower_bound(entry->contexts.constBegin(),entry->contexts.constEnd(),(quint32) context_id);
+    if (itr == entry->contexts.constEnd() || *itr != (quint32) context_id)
+        return QVariant();
+    return entry->values.at(itr - entry->contexts.constBegin());
+}
+
+bool Qtilities::Core::ObjectPropertyStore::setValue(QObject* obj, const char* property_name, const QVariant& new_value, int context_id, bool* handled) {
+    *handled = false;
+    if (!canHandle(obj))
+        return false;
+
+    const int property_id = internPropertyName(property_name);
+    PropertyEntry* entry = findEntry(obj,property_id);
+    if (!entry)
+        entry = populateEntry(obj,property_id,property_name);
+    if (!entry)
+        return false;
+
+    *handled = true;
+    // SharedProperty::setValue() and MultiContextProperty::setValue() ignore invalid values, in which
+    // case the property stays unchanged:
+    if (!new_value.isValid())
+        return true;
+
+    QVariant property_variant;
+    if (entry->is_shared) {
+        if (entry->values.isEmpty())
+            entry->values.append(new_value);
+        else
+            entry->values[0] = new_value;
+
+        SharedProperty shared_property(entry->attributes);
+        shared_property.setValue(new_value);
+        property_variant = qVariantFromValue(shared_property);
+    } else {
+        if (context_id == -1)
+            return true;
+
+        QVector<quint32>::iterator itr = std::lower_bound(entry->contexts.begin(),entry->contexts.end(),(quint32) context_id);
+        const int index = itr - entry->contexts.begin();
+        if (itr != entry->contexts.end() && *itr == (quint32) context_id) {
+            entry->values[index] = new_value;
+        } else {
+            entry->contexts.insert(index,(quint32) context_id);
+            entry->values.insert(index,new_value);
+        }
+
+        // The dynamic property must stay the master copy, thus we rebuild it from the flat arrays. Since the contexts
+        // are sorted, the map is constructed in order.
+        MultiContextProperty multi_context_property(entry->attributes);
+        for (int i = 0; i < entry->contexts.count(); ++i)
+            multi_context_property.addContext(entry->values.at(i),entry->contexts.at(i));
+        multi_context_property.setValue(new_value,context_id);
+        property_variant = qVariantFromValue(multi_context_property);
+    }
+
+    // Setting the property triggers our own event filter, make sure the entry we just updated is not dropped.
+    // Other event filters (for example observers) might change the property again during the event, in which
+    // case our filter sees more than one change and the entry is dropped afterwards. The entry is looked up again
+    // since the entries of the object might have been reallocated during the event.
+    entry->is_writing = true;
+    entry->write_events = 0;
+    obj->setProperty(property_name,property_variant);
+    entry = findEntry(obj,property_id);
+    if (entry) {
+        entry->is_writing = false;
+        if (entry->write_events > 1)
+            removeEntry(obj,property_id);
+    }
+    return true;
+}
+
+void Qtilities::Core::ObjectPropertyStore::invalidate(const QObject* obj) {
+    if (!obj)
+        return;
+
+    if (object_entries.remove(obj) > 0) {
+        QObject* non_const_obj = const_cast<QObject*> (obj);
+        non_const_obj->removeEventFilter(this);
+        disconnect(non_const_obj,SIGNAL(destroyed(QObject*)),this,SLOT(handleObjectDestroyed(QObject*)));
+    }
+}
+
+int Qtilities::Core::ObjectPropertyStore::cachedObjectCount() const {
+    return object_entries.count();
+}
+
+bool Qtilities::Core::ObjectPropertyStore::eventFilter(QObject *object, QEvent *event) {
+    if (event->type() == QEvent::DynamicPropertyChange) {
+        QDynamicPropertyChangeEvent* propertyChangeEvent = static_cast<QDynamicPropertyChangeEvent *>(event);
+        QHash<QByteArray,int>::const_iterator itr = property_ids.constFind(propertyChangeEvent->propertyName());
+        if (itr != property_ids.constEnd()) {
+            PropertyEntry* entry = findEntry(object,itr.value());
+            if (entry) {
+                if (entry->is_writing)
+                    ++entry->write_events;
+                else
+                    removeEntry(object,itr.value());
+            }
+        }
+    }
+
+    return false;
+}
+
+void Qtilities::Core::ObjectPropertyStore::handleObjectDestroyed(QObject* obj) {
+    // Only the QObject part of obj is still valid here, which is all we need since we only use it as a key.
+    object_entries.remove(obj);
+}
+
+bool Qtilities::Core::ObjectPropertyStore::canHandle(const QObject* obj) const {
+    if (!is_enabled || !obj)
+        return false;
+
+    QThread* store_thread = thread();
+    return (QThread::currentThread() == store_thread && obj->thread() == store_thread);
+}
+
+Qtilities::Core::ObjectPropertyStore::PropertyEntry* Qtilities::Core::ObjectPropertyStore::findEntry(const QObject* obj, int property_id) {
+    QHash<const QObject*,ObjectEntries>::iterator itr = object_entries.find(obj);
+    if (itr == object_entries.end())
+        return 0;
+
+    ObjectEntries& entries = itr.value();
+    for (int i = 0; i < entries.count(); ++i) {
+        if (entries.at(i).property_id == property_id)
+            return &entries[i];
+    }
+    return 0;
+}
+
+Qtilities::Core::ObjectPropertyStore::PropertyEntry* Qtilities::Core::ObjectPropertyStore::populateEntry(const QObject* obj, int property_id, const char* property_name) {
+    QVariant prop = obj->property(property_name);
+    if (!prop.isValid())
+        return 0;
+
+    PropertyEntry entry;
+    entry.property_id = property_id;
+    if (prop.canConvert<SharedProperty>()) {
+        SharedProperty shared_property = prop.value<SharedProperty>();
+        entry.is_shared = true;
+        entry.attributes = shared_property;
+        entry.values.append(shared_property.value());
+    } else if (prop.canConvert<MultiContextProperty>()) {
+        MultiContextProperty multi_context_property = prop.value<MultiContextProperty>();
+        entry.is_shared = false;
+        entry.attributes = multi_context_property;
+        // QMap iterates in key order, thus the arrays are sorted:
+        const QMap<quint32,QVariant> context_map = multi_context_property.contextMap();
+        entry.contexts.reserve(context_map.count());
+        entry.values.reserve(context_map.count());
+        QMap<quint32,QVariant>::const_iterator itr = context_map.constBegin();
+        while (itr != context_map.constEnd()) {
+            entry.contexts.append(itr.key());
+            entry.values.append(itr.value());
+            ++itr;
+        }
+    } else {
+        return 0;
+    }
+
+    QHash<const QObject*,ObjectEntries>::iterator itr = object_entries.find(obj);
+    if (itr == object_entries.end()) {
+        QObject* non_const_obj = const_cast<QObject*> (obj);
+        non_const_obj->installEventFilter(this);
+        connect(non_const_obj,SIGNAL(destroyed(QObject*)),SLOT(handleObjectDestroyed(QObject*)),Qt::DirectConnection);
+        itr = object_entries.insert(obj,ObjectEntries());
+    }
+
+    itr.value().append(entry);
+    return &itr.value().last();
+}
+
+void Qtilities::Core::ObjectPropertyStore::removeEntry(const QObject* obj, int property_id) {
+    QHash<const QObject*,ObjectEntries>::iterator itr = object_entries.find(obj);
+    if (itr == object_entries.end())
+        return;
+
+    ObjectEntries& entries = itr.value();
+    for (int i = 0; i < entries.count(); ++i) {
+        if (entries.at(i).property_id == property_id) {
+            entries.remove(i);
+            break;
+        }
+    }
+
+    // Keep the event filter installed while the object has entries, otherwise release it:
+    if (entries.isEmpty())
+        invalidate(obj);
+}
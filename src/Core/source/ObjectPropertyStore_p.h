@@ -0,0 +1,128 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef OBJECT_PROPERTY_STORE_P_H
+#define OBJECT_PROPERTY_STORE_P_H
+
+#include "QtilitiesCore_global.h"
+#include "QtilitiesProperty.h"
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QVariant>
+#include <QByteArray>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+          \class ObjectPropertyStore
+          \brief The ObjectPropertyStore class is a typed side-table which caches the values of %Qtilities properties on objects.
+
+          Reading a value from a MultiContextProperty through QObject::property() copies the complete context map of the property
+          twice (once into the QVariant and once out of it) just to look up the value of a single context. On large observer trees this
+          dominates the cost of functions like Observer::getMultiContextPropertyValue().
+
+          The store keeps an entry for every (object, interned property id) pair it has seen, where the values of the different contexts
+          are kept in two flat sorted arrays. Values are looked up with a binary search on the context array and no maps are copied.
+
+          The dynamic property on the object stays the master copy of the property, thus QObject::property() keeps working as before.
+          When a value is set through the store, the dynamic property is updated as well so that the QDynamicPropertyChangeEvent is still
+          delivered. The store installs itself as an event filter on objects it caches and drops an entry whenever its dynamic property
+          is changed through any other path, for example ObjectManager::setMultiContextProperty() or QObject::setProperty(). Entries for an
+          object are removed when the object is destroyed.
+
+          The store only caches objects which live in the thread in which the store was enabled and it is only used from that thread. In all
+          other cases it reports that it could not handle the request and callers fall back to QObject::property().
+
+          The store is disabled by default and is enabled through ObjectManager::setPropertyStoreEnabled().
+
+          This class was added in %Qtilities v1.5.
+         */
+        class QTILIITES_CORE_SHARED_EXPORT ObjectPropertyStore : public QObject {
+            Q_OBJECT
+
+        public:
+            static ObjectPropertyStore* instance();
+            ~ObjectPropertyStore();
+
+            //! Enables or disables the store. Disabling the store clears all cached entries.
+            void setEnabled(bool enabled);
+            //! Indicates if the store is enabled.
+            inline bool isEnabled() const { return is_enabled; }
+
+            //! Returns the interned id of the given property name, registering it if needed.
+            int internPropertyName(const char* property_name);
+            //! Returns the property name for an interned property id, or an empty byte array if the id is unknown.
+            QByteArray propertyName(int property_id) const;
+
+            //! Gets the value of the property for the given context.
+            /*!
+              \param obj The object on which the property lives.
+              \param property_name The name of the property.
+              \param context_id The context for which the value must be returned. Ignored for shared properties.
+              \param handled Set to true when the store handled the request. When false, the caller must fall back to QObject::property().
+              \returns The value of the property in the given context, or an invalid QVariant when the property or context does not exist.
+              */
+            QVariant value(const QObject* obj, const char* property_name, int context_id, bool* handled);
+            //! Sets the value of the property for the given context and updates the dynamic property on the object.
+            /*!
+              \param obj The object on which the property lives.
+              \param property_name The name of the property.
+              \param new_value The new value.
+              \param context_id The context for which the value must be set. Ignored for shared properties.
+              \param handled Set to true when the store handled the request. When false, the caller must fall back to QObject::property().
+              \returns True when the value was set, false when the property does not exist on the object.
+              */
+            bool setValue(QObject* obj, const char* property_name, const QVariant& new_value, int context_id, bool* handled);
+            //! Drops all cached entries for the given object.
+            void invalidate(const QObject* obj);
+            //! Returns the number of objects which currently have cached entries.
+            int cachedObjectCount() const;
+
+        protected:
+            bool eventFilter(QObject *object, QEvent *event);
+
+        private slots:
+            void handleObjectDestroyed(QObject* obj);
+
+        private:
+            ObjectPropertyStore();
+
+            //! A cached property on an object, contexts and values are kept sorted on the context id.
+            struct PropertyEntry {
+                PropertyEntry() : property_id(-1), is_shared(false), is_writing(false), write_events(0) {}
+                int                 property_id;
+                bool                is_shared;
+                bool                is_writing;
+                int                 write_events;
+                QtilitiesProperty   attributes;
+                QVector<quint32>    contexts;
+                QVector<QVariant>   values;
+            };
+            //! All cached properties for a single object. Objects carry only a handful of properties, thus a flat vector is used.
+            typedef QVector<PropertyEntry> ObjectEntries;
+
+            bool canHandle(const QObject* obj) const;
+            PropertyEntry* findEntry(const QObject* obj, int property_id);
+            PropertyEntry* populateEntry(const QObject* obj, int property_id, const char* property_name);
+            void removeEntry(const QObject* obj, int property_id);
+
+            static ObjectPropertyStore*         m_Instance;
+            bool                                is_enabled;
+            QHash<QByteArray,int>               property_ids;
+            QList<QByteArray>                   property_names;
+            QHash<const QObject*,ObjectEntries> object_entries;
+        };
+    }
+}
+
+#endif // OBJECT_PROPERTY_STORE_P_H
@@ -13,6 +13,7 @@
 #include "TreeIterator.h"
 #include "QtilitiesCoreConstants.h"
 #include "QtilitiesProperty.h"
+#include "QtilitiesPropertyAtoms.h"
 #include "ActivityPolicyFilter.h"
 #include "QtilitiesPropertyChangeEvent.h"
 #include "ObserverMimeData.h"
@@ -205,6 +206,12 @@ bool Qtilities::Core::Observer::subjectEventFilteringEnabled() const {
     return observerData->filter_subject_events_enabled;
 }
 
+int Qtilities::Core::Observer::unfilteredSubjectChangeRevision() const {
+    if (!observerData->allSubjectsMonitored())
+        return -1;
+    return observerData->unfiltered_change_revision;
+}
+
 void Qtilities::Core::Observer::toggleQtilitiesPropertyChangeEvents(bool toggle) {
     observerData->deliver_qtilities_property_changed_events = toggle;
 }
@@ -270,6 +277,14 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     return observerData->importXml(doc,object_node,import_list);
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::exportXmlStream(QXmlStreamWriter* writer) const {
+    return observerData->exportXmlStreamExt(writer,ObserverData::ExportData);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    return observerData->importXmlStream(reader,import_list);
+}
+
 Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::exportBinaryExt(QDataStream& stream, ObserverData::ExportItemFlags export_flags) const {
     return observerData->exportBinaryExt(stream,export_flags);
 }
@@ -278,6 +293,10 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     return observerData->exportXmlExt(doc,object_node,export_flags);
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::exportXmlStreamExt(QXmlStreamWriter* writer, ObserverData::ExportItemFlags export_flags) const {
+    return observerData->exportXmlStreamExt(writer,export_flags);
+}
+
 bool Observer::setMonitorSubjectModificationState(QObject *obj, bool monitor) {
     if (!contains(obj))
         return false;
@@ -524,8 +543,6 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
     }
     #endif
 
-    QPointer<QObject> safe_obj = obj;
-
     // If objectName() is empty, set the object name using the objects meta type info:
     if (obj->objectName().isEmpty())
         obj->setObjectName(obj->metaObject()->className());
@@ -534,6 +551,12 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
     if (canAttach(obj,object_ownership,rejectMsg) == Rejected)
         return false;
 
+    return attachEvaluatedSubject(obj,object_ownership,rejectMsg,import_cycle);
+}
+
+bool Qtilities::Core::Observer::attachEvaluatedSubject(QObject* obj, Observer::ObjectOwnership object_ownership, QString* rejectMsg, bool import_cycle) {
+    QPointer<QObject> safe_obj = obj;
+
     // Pass new object through all installed subject filters:
     bool passed_filters = true;
     for (int i = 0; i < observerData->subject_filters.count(); ++i) {
@@ -563,21 +586,24 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
     if (objectName() != QString(qti_def_GLOBAL_OBJECT_POOL)) {
         // Now, add observer details to needed properties
         // Add observer details to property: qti_prop_OBSERVER_MAP
+        int subject_id = observerData->subject_id_counter;
         MultiContextProperty subject_id_property = ObjectManager::getMultiContextProperty(obj,qti_prop_OBSERVER_MAP);
         if (subject_id_property.isValid()) {
             // Thus, the property already exists
-            subject_id_property.addContext(QVariant(observerData->subject_id_counter),observerData->observer_id);
+            subject_id_property.addContext(QVariant(subject_id),observerData->observer_id);
             ObjectManager::setMultiContextProperty(obj,subject_id_property);
         } else {
             // We need to create the property and add it to the object
             MultiContextProperty new_subject_id_property(qti_prop_OBSERVER_MAP);
-            new_subject_id_property.addContext(QVariant(observerData->subject_id_counter),observerData->observer_id);
+            new_subject_id_property.addContext(QVariant(subject_id),observerData->observer_id);
             ObjectManager::setMultiContextProperty(obj,new_subject_id_property);
         }
         observerData->subject_id_counter += 1;
 
         // Now that the object has the properties needed, we add it:
         observerData->subject_list.append(obj);
+        observerData->addSubjectToIndex(obj,subject_id,subjectIndexName(obj));
+        invalidateTreeCaches();
 
         // Handle object ownership
         #ifndef QT_NO_DEBUG
@@ -719,6 +745,13 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
         // We do this last, otherwise all dynamic property changes will go through this event filter.
         if (obj->thread() == thread() && observerData->filter_subject_events_enabled)
             obj->installEventFilter(this);
+        else
+            observerData->setSubjectMonitored(obj,false);
+
+        // Subjects without a qti_prop_NAME property are indexed using their objectName(), thus we need to know when it changes:
+        #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+        connect(obj,SIGNAL(objectNameChanged(QString)),SLOT(handle_subjectObjectNameChanged()));
+        #endif
 
         // Check if this is an observer:
         bool has_mod_iface = false;
@@ -756,6 +789,8 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
     } else {
         // If it is the global object manager it will get here.
         observerData->subject_list.append(obj);
+        observerData->addSubjectToIndex(obj,-1,subjectIndexName(obj));
+        invalidateTreeCaches();
 
         Observer* obs = qobject_cast<Observer*> (obj);
         if (obs)
@@ -765,6 +800,8 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
         // We do this last, otherwise all dynamic property changes will go through this event filter.
         if (obj->thread() == thread() && observerData->filter_subject_events_enabled)
             obj->installEventFilter(this);
+        else
+            observerData->setSubjectMonitored(obj,false);
 
         // Emit neccesarry signals
         QList<QPointer<QObject> > objects;
@@ -801,28 +838,137 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
 
 QList<QPointer<QObject> > Qtilities::Core::Observer::attachSubjects(QList<QObject*> objects, Observer::ObjectOwnership ownership, QString* rejectMsg, bool import_cycle) {
     QList<QPointer<QObject> > success_list;
+    if (objects.isEmpty())
+        return success_list;
+
     startProcessingCycle();
+
+    // Set names before the evaluation since subject filters might depend on them:
     for (int i = 0; i < objects.count(); ++i) {
-        if (attachSubject(objects.at(i), ownership, rejectMsg, import_cycle))
+        QObject* obj = objects.at(i);
+        if (obj && obj->objectName().isEmpty())
+            obj->setObjectName(obj->metaObject()->className());
+    }
+
+    // Evaluate the complete batch once, in this observer and in all installed subject filters:
+    QStringList reject_msgs;
+    QList<Observer::EvaluationResult> results = canAttach(objects,ownership,&reject_msgs);
+    if (rejectMsg && !reject_msgs.isEmpty())
+        *rejectMsg = reject_msgs.last();
+
+    int accepted_count = results.count() - results.count(Observer::Rejected);
+    observerData->subject_list.reserve(observerData->subject_list.count() + accepted_count);
+
+    for (int i = 0; i < objects.count(); ++i) {
+        if (results.at(i) == Observer::Rejected)
+            continue;
+        if (attachEvaluatedSubject(objects.at(i), ownership, rejectMsg, import_cycle))
             success_list << objects.at(i);
     }
+
     endProcessingCycle(true);
     return success_list;
 }
 
 QList<QPointer<QObject> > Qtilities::Core::Observer::attachSubjects(ObserverMimeData* mime_data_object, Observer::ObjectOwnership ownership, QString* rejectMsg, bool import_cycle) {
-    QList<QPointer<QObject> > success_list;
-    startProcessingCycle();
-    for (int i = 0; i < mime_data_object->subjectList().count(); ++i) {
-        if (attachSubject(mime_data_object->subjectList().at(i), ownership, rejectMsg, import_cycle)) {
-            success_list << mime_data_object->subjectList().at(i);
-        }
+    if (!mime_data_object)
+        return QList<QPointer<QObject> >();
+
+    QList<QObject*> objects;
+    QList<QPointer<QObject> > subject_list = mime_data_object->subjectList();
+    for (int i = 0; i < subject_list.count(); ++i) {
+        if (subject_list.at(i))
+            objects << subject_list.at(i);
     }
-    endProcessingCycle(true);
-    return success_list;
+
+    return attachSubjects(objects,ownership,rejectMsg,import_cycle);
 }
 
 Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach(QObject* obj, Observer::ObjectOwnership, QString* rejectMsg, bool silent) const {
+    if (evaluateAttachmentInObserver(obj,observerData->subject_list.count(),rejectMsg) == Observer::Rejected)
+        return Observer::Rejected;
+
+    // Evaluate attachment in all installed subject filters
+    bool was_rejected = false;
+    bool was_conditional = false;
+    AbstractSubjectFilter::EvaluationResult current_filter_evaluation;
+    for (int i = 0; i < observerData->subject_filters.count(); ++i) {
+        current_filter_evaluation = observerData->subject_filters.at(i)->evaluateAttachment(obj,rejectMsg,silent);
+        if (current_filter_evaluation == AbstractSubjectFilter::Rejected) {
+            was_rejected = true;
+            break;
+        }
+        if (current_filter_evaluation == AbstractSubjectFilter::Conditional)
+            was_conditional = true;
+    }
+
+    if (was_rejected)
+        return Observer::Rejected;
+
+    if (was_conditional)
+        return Observer::Conditional;
+
+    return Observer::Allowed;
+}
+
+QList<Qtilities::Core::Observer::EvaluationResult> Qtilities::Core::Observer::canAttach(const QList<QObject*>& objects, Observer::ObjectOwnership, QStringList* rejectMsgs, bool silent) const {
+    QList<Observer::EvaluationResult> results;
+    QList<QObject*> candidates;
+    QList<int> candidate_rows;
+    QSet<QObject*> accepted_objects;
+    int subject_count = observerData->subject_list.count();
+
+    // First evaluate the objects from the observer side. Objects accepted earlier in the batch count towards the subject limit:
+    for (int i = 0; i < objects.count(); ++i) {
+        QObject* obj = objects.at(i);
+        QString reject_msg;
+        Observer::EvaluationResult result;
+        if (obj && accepted_objects.contains(obj)) {
+            reject_msg = QString(tr("Observer (%1): Object (%2) attachment failed, object is already observed by this observer.")).arg(objectName()).arg(obj->objectName());
+            result = Observer::Rejected;
+        } else
+            result = evaluateAttachmentInObserver(obj,subject_count,&reject_msg);
+
+        if (result == Observer::Rejected) {
+            if (rejectMsgs)
+                rejectMsgs->append(reject_msg);
+        } else {
+            accepted_objects.insert(obj);
+            candidates << obj;
+            candidate_rows << i;
+            ++subject_count;
+        }
+        results << result;
+    }
+
+    // Evaluate the remaining objects in all installed subject filters, one call per filter:
+    for (int f = 0; f < observerData->subject_filters.count() && !candidates.isEmpty(); ++f) {
+        QList<AbstractSubjectFilter::EvaluationResult> filter_results = observerData->subject_filters.at(f)->evaluateAttachments(candidates,rejectMsgs,silent);
+        QList<QObject*> remaining_candidates;
+        QList<int> remaining_rows;
+        for (int c = 0; c < candidates.count(); ++c) {
+            AbstractSubjectFilter::EvaluationResult filter_result = AbstractSubjectFilter::Allowed;
+            if (c < filter_results.count())
+                filter_result = filter_results.at(c);
+
+            int row = candidate_rows.at(c);
+            if (filter_result == AbstractSubjectFilter::Rejected) {
+                results[row] = Observer::Rejected;
+                continue;
+            }
+            if (filter_result == AbstractSubjectFilter::Conditional)
+                results[row] = Observer::Conditional;
+            remaining_candidates << candidates.at(c);
+            remaining_rows << row;
+        }
+        candidates = remaining_candidates;
+        candidate_rows = remaining_rows;
+    }
+
+    return results;
+}
+
+Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::evaluateAttachmentInObserver(QObject* obj, int subject_count, QString* rejectMsg) const {
     if (!obj) {
         if (rejectMsg)
             *rejectMsg = tr("Invalid object reference received. Attachment cannot be done.");
@@ -852,7 +998,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
     }
 
     // First evaluate new subject from Observer side:
-    if (observerData->subject_limit == observerData->subject_list.count()) {
+    if (observerData->subject_limit == subject_count) {
         QString reject_string = QString(tr("Observer (%1): Object (%2) attachment failed, subject limit reached.")).arg(objectName()).arg(obj->objectName());
         LOG_WARNING(reject_string);
         if (rejectMsg)
@@ -907,26 +1053,6 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
         }
     }
 
-    // Evaluate attachment in all installed subject filters
-    bool was_rejected = false;
-    bool was_conditional = false;
-    AbstractSubjectFilter::EvaluationResult current_filter_evaluation;
-    for (int i = 0; i < observerData->subject_filters.count(); ++i) {
-        current_filter_evaluation = observerData->subject_filters.at(i)->evaluateAttachment(obj,rejectMsg,silent);
-        if (current_filter_evaluation == AbstractSubjectFilter::Rejected) {
-            was_rejected = true;
-            break;
-        }
-        if (current_filter_evaluation == AbstractSubjectFilter::Conditional)
-            was_conditional = true;
-    }
-
-    if (was_rejected)
-        return Observer::Rejected;
-
-    if (was_conditional)
-        return Observer::Conditional;
-
     return Observer::Allowed;
 }
 
@@ -964,6 +1090,10 @@ void Qtilities::Core::Observer::handle_deletedSubject(QObject* obj) {
             return;
     #endif
 
+    // The object is removed from subject_list by the time we get here, thus we must always update the index:
+    observerData->removeSubjectFromIndex(obj);
+    invalidateTreeCaches();
+
     if (!observerData->observer_mutex.tryLock())
         return;
 
@@ -1012,6 +1142,10 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
     if (canDetach(obj,rejectMsg) == Rejected)
         return false;
 
+    return detachEvaluatedSubject(obj,rejectMsg,0);
+}
+
+bool Qtilities::Core::Observer::detachEvaluatedSubject(QObject* obj, QString* rejectMsg, QList<QObject*>* deferred_removals) {
     bool currrent_filter_subject_events_enabled = observerData->filter_subject_events_enabled;
     observerData->filter_subject_events_enabled = false;
 
@@ -1053,29 +1187,30 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
                 LOG_DEBUG(QString("Object (%1) went out of scope, it will be deleted.").arg(obj->objectName()));
                 deleteObject(obj);
                 obj = 0;
-                QCoreApplication::processEvents();
+                // Batches process events once after all subjects were detached:
+                if (!deferred_removals)
+                    QCoreApplication::processEvents();
                 lost_scope = true;
             } else {
                 removeQtilitiesProperties(obj);
-                observerData->subject_list.removeOne(obj);
-                observerData->subject_observer_list.removeOne(obj);
+                removeSubjectFromLists(obj,deferred_removals);
             }
         } else if (ownership_variant.isValid() && ((ObjectOwnership) ownership_variant.toInt() == SpecificObserverOwnership)) {
             QVariant observer_parent = getMultiContextPropertyValue(obj,qti_prop_PARENT_ID);
             if (observer_parent.isValid() && (observer_parent.toInt() == observerID()) && obj) {
                 deleteObject(obj);
                 obj = 0;
-                QCoreApplication::processEvents();
+                // Batches process events once after all subjects were detached:
+                if (!deferred_removals)
+                    QCoreApplication::processEvents();
                 lost_scope = true;
             } else {
                 removeQtilitiesProperties(obj);
-                observerData->subject_list.removeOne(obj);
-                observerData->subject_observer_list.removeOne(obj);
+                removeSubjectFromLists(obj,deferred_removals);
             }
         } else {
             removeQtilitiesProperties(obj);
-            observerData->subject_list.removeOne(obj);
-            observerData->subject_observer_list.removeOne(obj);
+            removeSubjectFromLists(obj,deferred_removals);
         }
 
         #ifndef QT_NO_DEBUG
@@ -1107,22 +1242,54 @@ QList<QPointer<QObject> > Qtilities::Core::Observer::detachSubjects(QList<QObjec
     QList<QPointer<QObject> > success_list;
     startProcessingCycle();
 
-    QList<QPointer<QObject> > safe_list;
+    QList<QObject*> valid_objects;
     for (int i = 0; i < objects.count(); ++i) {
-        if (objects.at(i)) {
-            safe_list << objects.at(i);
-            QString tmp_rejectMsg;
-            if (detachSubject(safe_list.at(i),&tmp_rejectMsg)) {
-                // The object could have been deleted in detach subject, thus we must use some
-                // safe QPointers here:
-                if (safe_list.at(i))
-                    success_list << safe_list.at(i);
-            } else {
-                if (rejectMsg) {
-                    rejectMsg->append(tmp_rejectMsg);
-                    rejectMsg->append("\n");
-                }
-            }
+        if (objects.at(i))
+            valid_objects << objects.at(i);
+    }
+
+    // Evaluate the complete batch once, in this observer and in all installed subject filters:
+    QStringList reject_msgs;
+    QList<Observer::EvaluationResult> results = canDetach(valid_objects,&reject_msgs);
+
+    // The objects could be deleted during detachment, thus we must use some safe QPointers here:
+    QList<QPointer<QObject> > safe_list;
+    for (int i = 0; i < valid_objects.count(); ++i)
+        safe_list << valid_objects.at(i);
+
+    QList<QObject*> deferred_removals;
+    QList<int> detached_rows;
+    bool deleted_objects = false;
+    for (int i = 0; i < safe_list.count(); ++i) {
+        if (results.at(i) == Observer::Rejected || !safe_list.at(i))
+            continue;
+
+        QString tmp_rejectMsg;
+        if (detachEvaluatedSubject(safe_list.at(i),&tmp_rejectMsg,&deferred_removals)) {
+            detached_rows << i;
+            if (results.at(i) == Observer::LastScopedObserver || results.at(i) == Observer::IsParentObserver)
+                deleted_objects = true;
+        } else
+            reject_msgs << tmp_rejectMsg;
+    }
+
+    // Remove all detached subjects with a single pass over the subject lists:
+    observerData->subject_list.removeObjects(deferred_removals);
+    observerData->subject_observer_list.removeObjects(deferred_removals);
+    if (!deferred_removals.isEmpty())
+        invalidateTreeCaches();
+    if (deleted_objects)
+        QCoreApplication::processEvents();
+
+    for (int i = 0; i < detached_rows.count(); ++i) {
+        if (safe_list.at(detached_rows.at(i)))
+            success_list << safe_list.at(detached_rows.at(i));
+    }
+
+    if (rejectMsg) {
+        for (int i = 0; i < reject_msgs.count(); ++i) {
+            rejectMsg->append(reject_msgs.at(i));
+            rejectMsg->append("\n");
         }
     }
 
@@ -1131,6 +1298,79 @@ QList<QPointer<QObject> > Qtilities::Core::Observer::detachSubjects(QList<QObjec
 }
 
 Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canDetach(QObject* obj, QString* rejectMsg) const {
+    Observer::EvaluationResult observer_evaluation = evaluateDetachmentInObserver(obj,rejectMsg);
+    if (observer_evaluation != Observer::Allowed)
+        return observer_evaluation;
+
+    // Evaluate detachment in all installed subject filters
+    bool was_rejected = false;
+    bool was_conditional = false;
+    AbstractSubjectFilter::EvaluationResult current_filter_evaluation;
+    for (int i = 0; i < observerData->subject_filters.count(); ++i) {
+        current_filter_evaluation = observerData->subject_filters.at(i)->evaluateDetachment(obj);
+        if (current_filter_evaluation == AbstractSubjectFilter::Rejected)
+            was_rejected = true;
+        if (current_filter_evaluation == AbstractSubjectFilter::Conditional)
+            was_conditional = true;
+    }
+
+    if (was_rejected)
+        return Observer::Rejected;
+
+    if (was_conditional)
+        return Observer::Conditional;
+
+    return Observer::Allowed;
+}
+
+QList<Qtilities::Core::Observer::EvaluationResult> Qtilities::Core::Observer::canDetach(const QList<QObject*>& objects, QStringList* rejectMsgs) const {
+    QList<Observer::EvaluationResult> results;
+    QList<QObject*> candidates;
+    QList<int> candidate_rows;
+    QSet<QObject*> evaluated_objects;
+
+    // First evaluate the objects from the observer side:
+    for (int i = 0; i < objects.count(); ++i) {
+        QObject* obj = objects.at(i);
+        QString reject_msg;
+        Observer::EvaluationResult result;
+        if (!obj || evaluated_objects.contains(obj)) {
+            // Objects can only be detached once:
+            result = Observer::Rejected;
+        } else {
+            evaluated_objects.insert(obj);
+            result = evaluateDetachmentInObserver(obj,&reject_msg);
+        }
+
+        if (result == Observer::Rejected) {
+            if (rejectMsgs && !reject_msg.isEmpty())
+                rejectMsgs->append(reject_msg);
+        } else if (result == Observer::Allowed) {
+            // Subject filters are only consulted when the observer does not handle the ownership of the object:
+            candidates << obj;
+            candidate_rows << i;
+        }
+        results << result;
+    }
+
+    // Evaluate the remaining objects in all installed subject filters, one call per filter:
+    for (int f = 0; f < observerData->subject_filters.count() && !candidates.isEmpty(); ++f) {
+        QList<AbstractSubjectFilter::EvaluationResult> filter_results = observerData->subject_filters.at(f)->evaluateDetachments(candidates);
+        for (int c = 0; c < candidates.count(); ++c) {
+            if (c >= filter_results.count())
+                break;
+            int row = candidate_rows.at(c);
+            if (filter_results.at(c) == AbstractSubjectFilter::Rejected)
+                results[row] = Observer::Rejected;
+            else if (filter_results.at(c) == AbstractSubjectFilter::Conditional && results.at(row) != Observer::Rejected)
+                results[row] = Observer::Conditional;
+        }
+    }
+
+    return results;
+}
+
+Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::evaluateDetachmentInObserver(QObject* obj, QString* rejectMsg) const {
     if (objectName() != QString(qti_def_GLOBAL_OBJECT_POOL)) {
         // Check if this subject is observed by this observer. If its not observed by this observer, we can't detach it.
         MultiContextProperty observer_list_variant = ObjectManager::getMultiContextProperty(obj,qti_prop_OBSERVER_MAP);
@@ -1177,24 +1417,6 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canDetach
         }
     }
 
-    // Evaluate detachment in all installed subject filters
-    bool was_rejected = false;
-    bool was_conditional = false;
-    AbstractSubjectFilter::EvaluationResult current_filter_evaluation;
-    for (int i = 0; i < observerData->subject_filters.count(); ++i) {
-        current_filter_evaluation = observerData->subject_filters.at(i)->evaluateDetachment(obj);
-        if (current_filter_evaluation == AbstractSubjectFilter::Rejected)
-            was_rejected = true;
-        if (current_filter_evaluation == AbstractSubjectFilter::Conditional)
-            was_conditional = true;
-    }
-
-    if (was_rejected)
-        return Observer::Rejected;
-
-    if (was_conditional)
-        return Observer::Conditional;
-
     return Observer::Allowed;
 }
 
@@ -1260,6 +1482,10 @@ QVariant Qtilities::Core::Observer::getMultiContextPropertyValue(const QObject*
             return QVariant();
     #endif
 
+    // When the property store is enabled, avoid copying the complete property to get the value for our context:
+    if (ObjectManager::propertyStoreEnabled())
+        return ObjectManager::getPropertyContextValue(obj,property_name,observerData->observer_id);
+
     QVariant prop;
     prop = obj->property(property_name);
 
@@ -1288,6 +1514,13 @@ bool Qtilities::Core::Observer::setMultiContextPropertyValue(QObject* obj, const
             return false;
     #endif
 
+    // The property store updates the dynamic property on the object as well, thus the QDynamicPropertyChangeEvent is still triggered.
+    // When it fails the property does not exist, which is reported below.
+    if (ObjectManager::propertyStoreEnabled()) {
+        if (ObjectManager::setPropertyContextValue(obj,property_name,new_value,observerData->observer_id))
+            return true;
+    }
+
     QVariant prop;
     prop = obj->property(property_name);
 
@@ -1599,12 +1832,17 @@ int Qtilities::Core::Observer::treeCount(const QString& base_class_name) {
     time.start();
     #endif
 
+    QHash<QString,int>::const_iterator cached = observerData->tree_count_cache.constFind(base_class_name);
+    if (cached != observerData->tree_count_cache.constEnd())
+        return cached.value();
+
     int count = subjectCount(base_class_name);
     QList<QPointer<Observer> > observers = subjectObserverReferences();
     for (int i = 0; i < observers.count(); ++i) {
         if (observers.at(i))
             count += observers.at(i)->treeCount(base_class_name);
     }
+    observerData->tree_count_cache.insert(base_class_name,count);
 
     #ifdef QTILITIES_BENCHMARKING
     QTime ref_time(0,0);
@@ -1623,43 +1861,38 @@ int Qtilities::Core::Observer::subjectCount(const QString& base_class_name) cons
 }
 
 QObject* Qtilities::Core::Observer::treeAt(int i) const {
-    if (i < 0)
-        return 0;
-
-    QList<QObject*> list = treeChildren(QString(),i);
-    if (i >= list.count())
-        return 0;
-
-    return list.at(i);
+    return observerData->treeSnapshotAt(i);
 }
 
 bool Qtilities::Core::Observer::treeContains(QObject* tree_item) const {
-     return treeChildren().contains(tree_item);
+    return observerData->treeSnapshotContains(tree_item);
+}
+
+Qtilities::Core::ObserverTreeSnapshot Qtilities::Core::Observer::treeSnapshot() const {
+    return observerData->treeSnapshot();
 }
 
 QList<QObject*> Qtilities::Core::Observer::treeChildren(const QString& iface, int limit, int iterator_id) const {
+    Q_UNUSED(iterator_id)
+
+    const QVector<QObject*> snapshot = observerData->treeSnapshot().objects;
+    bool all_objects = (iface.isEmpty() || iface == QLatin1String("QObject"));
+    if (all_objects && limit == -1)
+        return snapshot.toList();
+
     QList<QObject*> children;
+    QByteArray iface_name = iface.toUtf8();
     int count = 0;
-
-    TreeIterator itr(this,iterator_id);
-    while (itr.hasNext()) {
-        QObject* obj = itr.next();
-        if (iface.isEmpty()) {
+    int snapshot_count = snapshot.count();
+    for (int i = 0; i < snapshot_count; ++i) {
+        QObject* obj = snapshot.at(i);
+        if (all_objects || obj->inherits(iface_name.constData())) {
             children << obj;
             if (limit != -1) {
                 ++count;
                 if (count > limit)
                     break;
             }
-        } else {
-            if (obj->inherits(iface.toUtf8().data())) {
-                children << obj;
-                if (limit != -1) {
-                    ++count;
-                    if (count > limit)
-                        break;
-                }
-            }
         }
     }
 
@@ -1707,102 +1940,83 @@ QStringList Qtilities::Core::Observer::subjectDisplayedNames(const QString& ifac
 QStringList Qtilities::Core::Observer::subjectNamesByCategory(const QtilitiesCategory& category) const {
     QStringList subject_names;
 
-    int count = observerData->subject_list.count();
+    QList<QObject*> subjects = observerData->indexedSubjectsByCategory(category);
+    int count = subjects.count();
     for (int i = 0; i < count; ++i) {
-        QObject* obj = observerData->subject_list.at(i);
-        QVariant category_variant = getMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP);
-        // Handles cases where category is valid, thus it contains levels.
-        if (category_variant.isValid()) {
-            QtilitiesCategory current_category = category_variant.value<QtilitiesCategory>();
-            if (current_category == category) {
-                // We need to check if a subject has an instance name in this context. If so, we use the instance name, not the objectName().
-                QVariant instance_name = getMultiContextPropertyValue(obj,qti_prop_ALIAS_MAP);
-                if (instance_name.isValid())
-                    subject_names << instance_name.toString();
-                else
-                    subject_names << obj->objectName();
-            }
-        } else {
-            // Handle cases where the category is not valid on a subject.
-            // Thus subjects without a category specified for them.
-            if (!category.isValid()) {
-                // We need to check if a subject has an instance name in this context. If so, we use the instance name, not the objectName().
-                QVariant instance_name = getMultiContextPropertyValue(obj,qti_prop_ALIAS_MAP);
-                if (instance_name.isValid())
-                    subject_names << instance_name.toString();
-                else
-                    subject_names << obj->objectName();
-            }
-        }
+        QObject* obj = subjects.at(i);
+        // We need to check if a subject has an instance name in this context. If so, we use the instance name, not the objectName().
+        QVariant instance_name = getMultiContextPropertyValue(obj,qti_prop_ALIAS_MAP);
+        if (instance_name.isValid())
+            subject_names << instance_name.toString();
+        else
+            subject_names << obj->objectName();
     }
 
     return subject_names;
 }
 
 bool Qtilities::Core::Observer::hasCategory(const QtilitiesCategory& category) const {
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QVariant category_variant = getMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP);
-        // Check if a category property exists:
-        if (category_variant.isValid()) {
-            QtilitiesCategory current_category = category_variant.value<QtilitiesCategory>();
-            if (current_category == category)
-                return true;
-        }
-    }
-
-    return false;
+    // Subjects without a category property are indexed under an empty category, but they do not have that category:
+    int subject_count = observerData->indexedSubjectsByCategory(category).count();
+    if (category.isEmpty())
+        subject_count -= observerData->uncategorizedSubjectCount();
+    return subject_count > 0;
 }
 
 QList<QPointer<QObject> > Qtilities::Core::Observer::renameCategory(const QtilitiesCategory& old_category,const QtilitiesCategory& new_category, bool match_exactly) {
     QList<QPointer<QObject> > renamed_list;
 
+    // Work on a copy of the category index since updating the category properties below invalidates the index:
+    QSet<const QObject*> uncategorized_subjects;
+    const QMap<QtilitiesCategory,QList<QObject*> > category_index = observerData->categoryIndex(&uncategorized_subjects);
+
     startProcessingCycle();
-    // Check the category on all subjects:
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QVariant category_variant = getMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP);
-        // Check if a category property exists:
-        if (category_variant.isValid()) {
-            QtilitiesCategory current_category = category_variant.value<QtilitiesCategory>();
-            // Skip if current category is same as new category:
-            if (current_category == new_category)
+    // Check all categories in this context:
+    QMap<QtilitiesCategory,QList<QObject*> >::const_iterator itr;
+    for (itr = category_index.constBegin(); itr != category_index.constEnd(); ++itr) {
+        const QtilitiesCategory& current_category = itr.key();
+        // Skip if current category is same as new category:
+        if (current_category == new_category)
+            continue;
+
+        // Check if we match exactly. In that case, the depths must match:
+        if (match_exactly) {
+            if (current_category.categoryDepth() != old_category.categoryDepth())
                 continue;
+        }
 
-            // Check if we match exactly. In that case, the depths must match:
-            if (match_exactly) {
-                if (current_category.categoryDepth() != old_category.categoryDepth())
-                    continue;
-            }
-
-            QStringList subject_cat_list = current_category.toStringList(old_category.categoryDepth());
+        QStringList subject_cat_list = current_category.toStringList(old_category.categoryDepth());
 
-            // Check if we must update it:
-            if (subject_cat_list == old_category.toStringList()) {
-                // Construct the renamed category:
-                QString new_cat_string = current_category.toString();
-                new_cat_string.replace(old_category.toString(),new_category.toString());
-                QtilitiesCategory renamed_category(new_cat_string,QString("::"));
+        // Check if we must update it:
+        if (subject_cat_list == old_category.toStringList()) {
+            // Construct the renamed category:
+            QString new_cat_string = current_category.toString();
+            new_cat_string.replace(old_category.toString(),new_category.toString());
+            QtilitiesCategory renamed_category(new_cat_string,QString("::"));
 
-                // Skip if renamed category is same as current category:
-                if (renamed_category == current_category)
-                    continue;
+            // Skip if renamed category is same as current category:
+            if (renamed_category == current_category)
+                continue;
 
-                // We need to update the access mode settings:
-                bool took_cat = false;
-                for (int c = 0; c < observerData->categories.count(); c++) {
-                    if (observerData->categories.at(c) == current_category) {
-                        observerData->categories.takeAt(c);
-                        took_cat = true;
-                        break;
-                    }
+            // We need to update the access mode settings:
+            bool took_cat = false;
+            for (int c = 0; c < observerData->categories.count(); c++) {
+                if (observerData->categories.at(c) == current_category) {
+                    observerData->categories.takeAt(c);
+                    took_cat = true;
+                    break;
                 }
-                if (took_cat)
-                    observerData->categories << renamed_category;
+            }
+            if (took_cat)
+                observerData->categories << renamed_category;
 
-                // Update the property on the current subject:
-                setMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP,qVariantFromValue(renamed_category));
-                renamed_list << subjectAt(i);
+            // Update the property on all subjects in the category which has a category property:
+            const QList<QObject*>& subjects = itr.value();
+            for (int i = 0; i < subjects.count(); ++i) {
+                if (uncategorized_subjects.contains(subjects.at(i)))
+                    continue;
+                setMultiContextPropertyValue(subjects.at(i),qti_prop_CATEGORY_MAP,qVariantFromValue(renamed_category));
+                renamed_list << subjects.at(i);
             }
         }
     }
@@ -1833,24 +2047,8 @@ Qtilities::Core::Observer::AccessMode Qtilities::Core::Observer::categoryAccessM
 }
 
 QList<Qtilities::Core::QtilitiesCategory> Qtilities::Core::Observer::subjectCategories() const {
-    QList<QtilitiesCategory> subject_categories;
-
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QVariant category_variant = getMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP);
-        // Check if a category property exists:
-        if (category_variant.isValid()) {
-            QtilitiesCategory current_category = category_variant.value<QtilitiesCategory>();
-            if (!subject_categories.contains(current_category))
-                subject_categories << current_category;
-        } else {
-            if (!subject_categories.contains(QtilitiesCategory()))
-                subject_categories << QtilitiesCategory();
-        }
-    }
-
-    qSort(subject_categories);
-    return subject_categories;
+    // The keys of the category index are already sorted:
+    return observerData->indexedCategories();
 }
 
 QObject* Qtilities::Core::Observer::subjectAt(int i) const {
@@ -1866,8 +2064,9 @@ int Qtilities::Core::Observer::subjectID(int i) const {
 }
 
 int Qtilities::Core::Observer::subjectID(const QString& subject_name, Qt::CaseSensitivity cs) const {
-    if (containsSubjectWithName(subject_name,cs)) {
-        QVariant prop = getMultiContextPropertyValue(subjectReference(subject_name,cs),qti_prop_OBSERVER_MAP);
+    QObject* obj = subjectReference(subject_name,cs);
+    if (obj) {
+        QVariant prop = getMultiContextPropertyValue(obj,qti_prop_OBSERVER_MAP);
         return prop.toInt();
     } else
         return -1;
@@ -1896,36 +2095,18 @@ QList<QObject*> Qtilities::Core::Observer::subjectReferences(const QString& ifac
 
 QList<QObject*> Qtilities::Core::Observer::subjectReferencesByCategory(const QtilitiesCategory& category) const {
     // Get all subjects which has the qti_prop_CATEGORY_MAP property set to category.
-    QList<QObject*> list;
-
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QObject* obj = subjectAt(i);
-        QVariant category_variant = getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
-        if (category_variant.isValid()) {
-            QtilitiesCategory current_category = category_variant.value<QtilitiesCategory>();
-            if (current_category == category)
-                list << obj;
-        } else {
-            if (category.isEmpty())
-                list << obj;
-        }
-    }
-
-    return list;
+    return observerData->indexedSubjectsByCategory(category);
 }
 
 QMap<QPointer<QObject>, QString> Observer::subjectReferenceCategoryMap() const {
     QMap<QPointer<QObject>, QString> map;
 
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QPointer<QObject> obj = subjectAt(i);
-        QVariant category_variant = getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
-        if (category_variant.isValid())
-            map[obj] = (category_variant.value<QtilitiesCategory>()).toString("::");
-        else
-            map[obj] = "";
+    // Subjects without a category are indexed under an empty category:
+    const QMap<QtilitiesCategory,QList<QObject*> > category_index = observerData->categoryIndex();
+    QMap<QtilitiesCategory,QList<QObject*> >::const_iterator itr;
+    for (itr = category_index.constBegin(); itr != category_index.constEnd(); ++itr) {
+        for (int i = 0; i < itr.value().count(); ++i)
+            map[QPointer<QObject>(itr.value().at(i))] = itr.key().toString("::");
     }
 
     return map;
@@ -1949,44 +2130,36 @@ QList<QPointer<Observer> > Observer::subjectObserverReferences() const {
 }
 
 QObject* Qtilities::Core::Observer::subjectReference(int ID) const {
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QObject* obj = observerData->subject_list.at(i);
-        QVariant prop = getMultiContextPropertyValue(obj,qti_prop_OBSERVER_MAP);
-        if (!prop.isValid()) {
-            LOG_TRACE(QString("Observer (%1): Looking for subject ID (%2) failed, property 'Subject ID' contains invalid variant for this context.").arg(objectName()).arg(ID));
-            return 0;
-        }
-        if (prop.toInt() == ID)
-            return obj;
-    }
-    return 0;
+    return observerData->indexedSubject(ID);
 }
 
 QObject* Qtilities::Core::Observer::subjectReference(const QString& subject_name, Qt::CaseSensitivity cs) const {
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QObject* obj = observerData->subject_list.at(i);
-        QVariant prop = getMultiContextPropertyValue(obj,qti_prop_NAME);
-        if (!prop.isValid()) {
-            if (obj->objectName().compare(subject_name,cs) == 0)
-                return obj;
-        } else {
-            if (prop.toString().compare(subject_name,cs) == 0)
-                return obj;
-        }
+    QObject* obj = observerData->indexedSubject(subject_name,cs);
+    while (obj) {
+        // Names can change without this observer being notified, for example on subjects living in a different
+        // thread (the event filter is not installed on them). Thus we validate the match and refresh stale entries:
+        QString current_name = subjectIndexName(obj);
+        if (current_name.compare(subject_name,cs) == 0)
+            return obj;
+
+        observerData->updateSubjectNameInIndex(obj,current_name);
+        obj = observerData->indexedSubject(subject_name,cs);
     }
-    return 0;
-}
 
-bool Qtilities::Core::Observer::contains(const QObject* object) const {
+    // For the same reason a miss can be stale, in which case we refresh the names of all subjects:
+    if (observerData->subjectNamesMonitored())
+        return 0;
+
     int count = observerData->subject_list.count();
     for (int i = 0; i < count; ++i) {
-        if (observerData->subject_list.at(i) == object)
-            return true;
+        QObject* subject = observerData->subject_list.at(i);
+        observerData->updateSubjectNameInIndex(subject,subjectIndexName(subject));
     }
+    return observerData->indexedSubject(subject_name,cs);
+}
 
-    return false;
+bool Qtilities::Core::Observer::contains(const QObject* object) const {
+    return observerData->subject_index.contains(object);
 }
 
 bool Qtilities::Core::Observer::containsSubjectWithName(const QString& subject_name, Qt::CaseSensitivity cs) const {
@@ -2013,8 +2186,10 @@ bool Qtilities::Core::Observer::installSubjectFilter(AbstractSubjectFilter* subj
     // Set the observer context of the filter
     if (!subject_filter->setObserverContext(this)) {
         LOG_ERROR(QString(tr("Observer (%1): Subject filter installation failed. Setting the observer context on the subject filter failed.")).arg(objectName()));
+        observerData->refreshSubjectFilterProperties();
         return false;
     }
+    observerData->refreshSubjectFilterProperties();
 
     subject_filter->setParent(this);
 
@@ -2042,6 +2217,7 @@ bool Qtilities::Core::Observer::uninstallSubjectFilter(AbstractSubjectFilter* su
     }
 
     observerData->subject_filters.removeOne(subject_filter);
+    observerData->refreshSubjectFilterProperties();
     subject_filter->disconnect(this);
     delete subject_filter;
     subject_filter = 0;
@@ -2090,15 +2266,46 @@ Qtilities::Core::ObserverHints* Qtilities::Core::Observer::useDisplayHints() {
     return 0;
 }
 
+QString Qtilities::Core::Observer::subjectIndexName(const QObject* obj) const {
+    QVariant prop = getMultiContextPropertyValue(obj,qti_prop_NAME);
+    if (prop.isValid())
+        return prop.toString();
+    else
+        return obj->objectName();
+}
+
+void Qtilities::Core::Observer::handle_subjectObjectNameChanged() {
+    QObject* obj = sender();
+    if (obj)
+        observerData->updateSubjectNameInIndex(obj,subjectIndexName(obj));
+}
+
 bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
 //    if (observerName() != "qti.def.ObjectPool")
 //        qDebug() << "Observer::eventFilter(): " << observerName() << ", filter subject events enabled: " << observerData->filter_subject_events_enabled;
-    if ((event->type() == QEvent::DynamicPropertyChange) && observerData->filter_subject_events_enabled) {
-        // Get the event in the correct format
-        QDynamicPropertyChangeEvent* propertyChangeEvent = static_cast<QDynamicPropertyChangeEvent *>(event);
+    if (event->type() != QEvent::DynamicPropertyChange)
+        return false;
+
+    // Get the event in the correct format
+    QDynamicPropertyChangeEvent* propertyChangeEvent = static_cast<QDynamicPropertyChangeEvent *>(event);
+    const QByteArray property_name = propertyChangeEvent->propertyName();
+    const QtilitiesPropertyAtoms::Atom property_atom = QtilitiesPropertyAtoms::atom(property_name);
+
+    // The subject lookup index must follow all name changes, also the ones that are filtered or rolled back below:
+    if (property_atom == QtilitiesPropertyAtoms::NameAtom && observerData->subject_index.contains(object))
+        observerData->updateSubjectNameInIndex(object,subjectIndexName(object));
+    // The same applies to the category index:
+    if (property_atom == QtilitiesPropertyAtoms::CategoryMapAtom)
+        observerData->updateSubjectCategoryInIndex(object);
+    // Subject filters are not notified of the change below, see unfilteredSubjectChangeRevision():
+    if (!observerData->filter_subject_events_enabled)
+        ++observerData->unfiltered_change_revision;
+
+    if (observerData->filter_subject_events_enabled) {
+        const QtilitiesPropertyAtoms::Capabilities property_capabilities = QtilitiesPropertyAtoms::capabilities(property_atom);
 
         // First check is to see if it is a reserved property. In that case we filter it directly.
-        if (reservedProperties().contains(QString(propertyChangeEvent->propertyName().data()))) {
+        if ((property_capabilities & QtilitiesPropertyAtoms::ObserverReserved) || observerData->subject_filter_reserved_properties.contains(property_name)) {
             QList<QObject*> filtered_list;
             filtered_list << object;
             emit propertyChangeFiltered(propertyChangeEvent->propertyName().data(),filtered_list);
@@ -2106,7 +2313,7 @@ bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
         }
 
         // Next check if it is a monitored property.
-        if (monitoredProperties().contains(QString(propertyChangeEvent->propertyName().data()))) {
+        if ((property_capabilities & QtilitiesPropertyAtoms::ObserverMonitored) || observerData->subject_filter_monitored_properties.contains(property_name)) {
             // Handle changes from different threads:
             if (!observerData->filter_subject_events_enabled) {
                 QList<QObject*> filtered_list;
@@ -2163,18 +2370,12 @@ bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
                 emit monitoredPropertyChanged(propertyChangeEvent->propertyName(),changed_objects);
 
                 // 3. For specific role properties, we need to notify views that the data changed:
-                if ((!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_DECORATION)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_FOREGROUND)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_BACKGROUND)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_TEXT_ALIGNMENT)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_FONT)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_SIZE_HINT))) {
-
+                if (property_capabilities & QtilitiesPropertyAtoms::ViewDataRole) {
                     refreshViewsData();
                 }
 
                 // 4. For specific role properties, we need to notify views that layout changed:
-                if (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_CATEGORY_MAP)) {
+                if (property_atom == QtilitiesPropertyAtoms::CategoryMapAtom) {
                     // Get the property and check its last changed context:
                     MultiContextProperty prop = ObjectManager::getMultiContextProperty(object,qti_prop_CATEGORY_MAP);
                     if (prop.isValid()) {
@@ -2319,6 +2520,30 @@ int Qtilities::Core::Observer::parentCount(const QObject* obj) {
     return 0;
 }
 
+void Qtilities::Core::Observer::removeSubjectFromLists(QObject* obj, QList<QObject*>* deferred_removals) {
+    observerData->removeSubjectFromIndex(obj);
+    invalidateTreeCaches();
+    if (deferred_removals) {
+        deferred_removals->append(obj);
+    } else {
+        observerData->subject_list.removeOne(obj);
+        observerData->subject_observer_list.removeOne(obj);
+    }
+}
+
+void Qtilities::Core::Observer::invalidateTreeCaches() {
+    // A cached count or snapshot on an observer implies cached counts and snapshots on all observers underneath it,
+    // thus when nothing is cached here nothing is cached in the observers above us either:
+    bool had_snapshot = observerData->invalidateTreeSnapshot();
+    if (observerData->tree_count_cache.isEmpty() && !had_snapshot)
+        return;
+
+    observerData->tree_count_cache.clear();
+    QList<Observer*> parents = parentReferences(this);
+    for (int i = 0; i < parents.count(); ++i)
+        parents.at(i)->invalidateTreeCaches();
+}
+
 QList<Qtilities::Core::Observer*> Qtilities::Core::Observer::parentReferences(const QObject* obj) {
     QList<Observer*> parents;
     if (!obj)
@@ -2364,6 +2589,8 @@ void Qtilities::Core::Observer::deleteObject(QObject* object) {
     object->removeEventFilter(this);
 
     if ((ObjectDeletionPolicy) observerData->object_deletion_policy == DeleteLater) {
+        observerData->removeSubjectFromIndex(object);
+        invalidateTreeCaches();
         observerData->subject_list.removeOne(object);
         observerData->subject_observer_list.removeOne(object);
         object->deleteLater();
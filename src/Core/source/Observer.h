@@ -447,6 +447,18 @@ In this example \p observerA will be deleted as soon as \p object1 is deleted.
               \sa toggleSubjectEventFiltering(), qtilitiesPropertyChangeEventsEnabled()
               */
             bool subjectEventFilteringEnabled() const;
+            //! Returns a revision which changes whenever subject filters might have missed a change to a property of a subject.
+            /*!
+              Subject filters which cache information about subjects, for example the names of subjects in NamingPolicyFilter, must
+              rebuild their caches when the revision changes. The revision changes when a property of a subject changes while subject
+              event filtering is disabled.
+
+              Changes to subjects which are not monitored by the event filter of the observer, for example subjects living in other threads
+              and subjects attached while subject event filtering was disabled, are never seen. While such subjects are attached -1 is returned.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int unfilteredSubjectChangeRevision() const;
             //! This function enables/disables delivery of QtilitiesPropertyChangeEvents on objects when property changes occurs.
             /*!
               \param toggle When true, change events are delivered. When false they are not delivered.
@@ -520,12 +532,26 @@ In this example \p observerA will be deleted as soon as \p object1 is deleted.
               \note This function does not call detachAll() before doing the import.
               */
             virtual IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            /*!
+              Writes the same XML as exportXml() while the tree is visited. See ObserverData::exportXmlStreamExt() for more details.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            /*!
+              Reads XML written by exportXml() or exportXmlStream(). Subjects are reconstructed in the same sequence as importXml() does, except that
+              observers are attached and their data is imported before their own subjects are read.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
             // --------------------------------
             // IExportableObserver Implementation
             // --------------------------------
             virtual IExportable::ExportResultFlags exportBinaryExt(QDataStream& stream, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData) const;
             virtual IExportable::ExportResultFlags exportXmlExt(QDomDocument* doc, QDomElement* object_node, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData) const;
+            virtual IExportable::ExportResultFlags exportXmlStreamExt(QXmlStreamWriter* writer, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData) const;
 
             // --------------------------------
             // IModificationNotifier Implementation
@@ -697,7 +723,9 @@ obs.endProcessingCycle(); // Internal count = 0;
             virtual bool attachSubject(QObject* obj, Observer::ObjectOwnership ownership = Observer::ManualOwnership, QString* rejectMsg = 0, bool import_cycle = false);
             //! Will attempt to attach the specified objects to the observer.
             /*!
-              This function will call startProcessingCycle() when it starts and endProcessingCycle() when it is done.
+              This function will call startProcessingCycle() when it starts and endProcessingCycle() when it is done, thus views are notified
+              once for the complete batch. The batch is evaluated once using canAttach(const QList<QObject*>&,Observer::ObjectOwnership,QStringList*,bool)
+              after which the accepted objects are attached without evaluating them again.
 
               \param objects A list of objects which must be attached.
               \param ownership The ownership that the observer should use to manage the object. The default is Observer::ManualOwnership.
@@ -736,12 +764,39 @@ obs.endProcessingCycle(); // Internal count = 0;
               \param silent When true the function checks if the attachment can be done without using any dialog boxes. This is useful when you need to attach subjects in an event filter where showing a dialog is a problem. An example of this is drag/drop operations in ObserverWidgets.
               */
             Observer::EvaluationResult canAttach(ObserverMimeData* mime_data_object, QString* rejectMsg = 0, bool silent = false) const;
+            //! A function which checks if a batch of objects can be attached to the observer. This function also validates the attachment operation inside all installed subject filters. Note that this function does not attach them.
+            /*!
+              The observer evaluates every object once and calls AbstractSubjectFilter::evaluateAttachments() once on each installed subject filter
+              for the objects which it accepted. Objects accepted earlier in the batch count towards the subjectLimit() and objects which appear more
+              than once in the batch are only accepted once.
+
+              \param objects The objects to test attachment of.
+              \param ownership This parameter allows you to specify the ownership to use during attachment. By default Observer::ManualOwnership.
+              \param rejectMsgs When valid, a rejection message is appended for every rejected object.
+              \param silent See canAttach(QObject*,Observer::ObjectOwnership,QString*,bool).
+              \returns One evaluation result for every object in \p objects, in the same order.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<Observer::EvaluationResult> canAttach(const QList<QObject*>& objects, Observer::ObjectOwnership ownership = Observer::ManualOwnership, QStringList* rejectMsgs = 0, bool silent = false) const;
             //! A function which checks if the object can be detached from the observer. This function also validates the detachment operation inside all installed subject filters. Note that this function does not detach it.
             /*!
              * \param obj The object to test detachment of.
              * \param rejectMsg Rejection message. If the attachment cannot be done, thus it returns Observer::Rejected, you can get the reason through this error message.
              */
             Observer::EvaluationResult canDetach(QObject* obj, QString* rejectMsg = 0) const;
+            //! A function which checks if a batch of objects can be detached from the observer. This function also validates the detachment operation inside all installed subject filters. Note that this function does not detach them.
+            /*!
+              The observer evaluates every object once and calls AbstractSubjectFilter::evaluateDetachments() once on each installed subject filter
+              for the objects which it accepted.
+
+              \param objects The objects to test detachment of.
+              \param rejectMsgs When valid, a rejection message is appended for rejected objects.
+              \returns One evaluation result for every object in \p objects, in the same order.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<Observer::EvaluationResult> canDetach(const QList<QObject*>& objects, QStringList* rejectMsgs = 0) const;
 
         public slots:
             //! Will attempt to detach the specified object from the observer.
@@ -762,6 +817,9 @@ obs.endProcessingCycle(); // Internal count = 0;
              * it has SpecificObserverOwnership set to this Observer, or when it has ObserverScopeOwnership and this
              * is the last observer that it is attached to. Note that the deletion method used depends on the
              * objectDeletionPolicy() of this observer.
+             *
+             * The batch is evaluated once using canDetach(const QList<QObject*>&,QStringList*) and the detached objects are removed from the
+             * observer with a single pass over its subjects, thus views are notified once for the complete batch.
              *
               \param objects A list of objects which must be detached.
               \param rejectMsg When this function fails and rejectMsg will be populated with an rejection message when valid.
@@ -786,6 +844,8 @@ obs.endProcessingCycle(); // Internal count = 0;
         private slots:
             //! Will handle an object which has been deleted somewhere else in the application.
             void handle_deletedSubject(QObject* obj);
+            //! Updates the subject lookup index when the objectName() of a subject changes.
+            void handle_subjectObjectNameChanged();
         signals:
             //! Will be emitted when a subject is deleted.
             void subjectDeleted(QObject* obj);
@@ -833,6 +893,20 @@ obs.endProcessingCycle(); // Internal count = 0;
         private:
             //! This function will remove all the properties which this observer might have added to an obj.
             void removeQtilitiesProperties(QObject* obj);
+            //! Returns the name under which \p obj is found by subjectReference(const QString&,Qt::CaseSensitivity), thus its qti_prop_NAME property if it exists, otherwise its objectName().
+            QString subjectIndexName(const QObject* obj) const;
+            //! Drops the cached tree counts and tree snapshots of this observer and of all observers above it in the tree.
+            void invalidateTreeCaches();
+            //! Evaluates the attachment of \p obj on the observer side, thus without consulting subject filters. \p subject_count is used for the subject limit check.
+            Observer::EvaluationResult evaluateAttachmentInObserver(QObject* obj, int subject_count, QString* rejectMsg) const;
+            //! Evaluates the detachment of \p obj on the observer side, thus without consulting subject filters.
+            Observer::EvaluationResult evaluateDetachmentInObserver(QObject* obj, QString* rejectMsg) const;
+            //! Attaches an object which was already evaluated using canAttach().
+            bool attachEvaluatedSubject(QObject* obj, Observer::ObjectOwnership object_ownership, QString* rejectMsg, bool import_cycle);
+            //! Detaches an object which was already evaluated using canDetach(). When \p deferred_removals is valid, the object is appended to it instead of being removed from the subject lists.
+            bool detachEvaluatedSubject(QObject* obj, QString* rejectMsg, QList<QObject*>* deferred_removals);
+            //! Removes \p obj from the subject index and from the subject lists, or appends it to \p deferred_removals when valid.
+            void removeSubjectFromLists(QObject* obj, QList<QObject*>* deferred_removals);
 
         public:
             // --------------------------------
@@ -920,22 +994,49 @@ obs.endProcessingCycle(); // Internal count = 0;
             /*!
                 This count includes the children of children as well. To get the number of subjects only in this context use subjectCount().
                 \note This observer itself is not counted.
+
+                The count is cached per \p base_class_name and the cache is dropped for this observer and all observers above it in the tree
+                whenever a subject is attached to, detached from or deleted in any of them. Thus calling this function repeatedly on an unchanged
+                tree does not walk the tree again.
                 */
             int treeCount(const QString& base_class_name = QString());
             //! Function to get a QObject reference at a specific location in the tree underneath this observer.
             /*!
               If \p i is < 0 or bigger than or equal to the number of items retuned by allChildren() this function returns 0.
+
+              \sa treeSnapshot()
               */
             QObject* treeAt(int i) const;
             //! Function to check if a specific AbstractTreeItem is contained in the tree underneath this node.
+            /*!
+              \sa treeSnapshot()
+              */
             bool treeContains(QObject* tree_item) const;
+            //! Returns the flattened tree underneath this observer.
+            /*!
+              The snapshot contains all objects in the tree underneath this observer in the order in which Qtilities::Core::TreeIterator iterates
+              through the tree. Objects attached to more than one observer in the tree appear once for every parent. This observer itself is not
+              part of the snapshot.
+
+              The snapshot is built the first time it is needed and is then kept until a subject is attached to or detached from this observer
+              or any observer underneath it, thus repeated calls to treeAt(), treeContains() and treeChildren() on an unchanged tree do not walk
+              the tree again. Changes to unrelated observers, for example the global object pool, do not affect it. The returned snapshot is
+              implicitly shared, thus it is cheap to keep and it does not change when the tree changes afterwards.
+
+              It is safe to call this function, treeAt() and treeContains() from different threads at the same time, but only while no subjects
+              are attached to or detached from observers in the tree. The subject lists are read without locking, thus changes to the tree must
+              be made from one thread while no other thread uses the tree.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverTreeSnapshot treeSnapshot() const;
             //! Function to get the QObject references of all items in the tree underneath this observer.
             /*!
               Returns a list of QObjects* in tree underneath this observer where the list is populated in the same order in which Qtilities::Core::TreeIterator iterates through the tree.
 
               \param base_class_name The name of the base class of children you are looking for. By default, all children underneath this observer is returned.
               \param limit When defined, the tree children will be search up until the limit count is reached. This allows you to stop when a tree gets too big. By default all children are returned.
-              *\param iterator_id Internal iterator ID. You should never use this directly.
+              *\param iterator_id Not used anymore since the tree is iterated using treeSnapshot(). Kept for source compatibility.
 
               For example:
 
@@ -974,8 +1075,8 @@ QVERIFY(items_verify.count() == 5);
             /*!
               \note Only depend on this function (where you specify the object using the object's name) when you are sure that
               objects have unique names. This can be achieved by installing a NamingPolicyFilter in your observer. If names
-              are not unique, the first match of the given subject_name will be used. If you don't care about unique subject names,
-              rather use subjectReference(int ID) to get subject references.
+              are not unique, the same subject as returned by subjectReference(const QString&, Qt::CaseSensitivity) will be used. If you
+              don't care about unique subject names, rather use subjectReference(int ID) to get subject references.
               */
             int subjectID(const QString& subject_name, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
             //! Returns the IDs for all the attached subjects.
@@ -996,8 +1097,11 @@ QVERIFY(items_verify.count() == 5);
             /*!
               \note Only depend on this function (where you specify the object using the object's name) when you are sure that
               objects have unique names. This can be achieved by installing a NamingPolicyFilter in your observer. If names
-              are not unique, the first match of the given subject_name will be used. If you don't care about unique subject names,
+              are not unique, the subject which got the given subject_name first will be used. This is the first match in the order
+              of the subjects, unless subjects were renamed after they were attached. If you don't care about unique subject names,
               rather use subjectReference(int ID) to get subject references.
+
+              <i>Before %Qtilities v1.5 the first match in the order of the subjects was always used.</i>
               */
             QObject* subjectReference(const QString& subject_name, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
             //! Returns true if a given subject is currently observed by the observer.
@@ -15,15 +15,65 @@
 #include "ActivityPolicyFilter.h"
 #include "ObserverRelationalTable.h"
 #include "ITask.h"
+#include "Task.h"
 
 #include <stdio.h>
 #include <time.h>
 
 #include <QDomElement>
+#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QBuffer>
 
 using namespace Qtilities::Core::Interfaces;
 
 quint32 MARKER_OBS_DATA_SECTION = 0xDEADBEEF;
+// Starts streamed binary exports. Importers from before streamed exports were added refuse anything but MARKER_OBS_DATA_SECTION at the
+// start of an observer, thus they reject streamed exports instead of misreading them:
+quint32 MARKER_OBS_STREAMED_SECTION = 0xDEADC0DE;
+// The number of subjects after which streamed binary exports and imports report progress:
+const int STREAMED_PROGRESS_INTERVAL = 1000;
+
+/*!
+  \class Qtilities::Core::ObserverDataExportTask
+  \brief Exports the subtree of a single observer to a buffer during ExportParallel binary exports of ObserverData.
+
+  The buffer uses the version, byte order and floating point precision of the stream to which the export is written, thus
+  it can be written to that stream as raw data afterwards.
+  */
+class Qtilities::Core::ObserverDataExportTask : public QRunnable {
+public:
+    ObserverDataExportTask(IExportableObserver* export_iface_obs, ObserverData::ExportItemFlags export_flags, const QDataStream& target_stream) :
+        export_iface_obs(export_iface_obs),
+        export_flags(export_flags),
+        stream_version(target_stream.version()),
+        byte_order(target_stream.byteOrder()),
+        precision(target_stream.floatingPointPrecision()),
+        result(IExportable::Failed) {
+        setAutoDelete(false);
+    }
+
+    void run() {
+        QBuffer buffer(&export_data);
+        buffer.open(QIODevice::WriteOnly);
+        QDataStream stream(&buffer);
+        stream.setVersion(stream_version);
+        stream.setByteOrder(byte_order);
+        stream.setFloatingPointPrecision(precision);
+        result = export_iface_obs->exportBinaryExt(stream,export_flags);
+        buffer.close();
+    }
+
+    IExportableObserver*                    export_iface_obs;
+    ObserverData::ExportItemFlags           export_flags;
+    int                                     stream_version;
+    QDataStream::ByteOrder                  byte_order;
+    QDataStream::FloatingPointPrecision     precision;
+    QByteArray                              export_data;
+    IExportable::ExportResultFlags          result;
+};
 
 void Qtilities::Core::ObserverData::setExportVersion(Qtilities::ExportVersion version) {
     IExportable::setExportVersion(version);
@@ -187,8 +237,11 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt(QD
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2)
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2) {
+        if ((export_flags & ExportStreamed) || (export_flags & ExportObserverDataOnly))
+            return exportBinaryStreamed(stream,export_flags);
         return exportBinaryExt_1_0(stream,export_flags);
+    }
 
     return IExportable::Incomplete;
 }
@@ -204,7 +257,45 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlExt(QDomD
     return IExportable::Incomplete;
 }
 
+IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlStreamExt(QXmlStreamWriter* writer, ExportItemFlags export_flags) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2) {
+        if ((export_flags & ExportRelationalData) || (export_flags & ExportVisitorIDs)) {
+            // The subjects which are exported depend on the complete tree, thus it is built first:
+            QDomDocument doc("tmp");
+            QDomElement object_node = doc.createElement("tmp");
+            doc.appendChild(object_node);
+            IExportable::ExportResultFlags result = exportXmlExt_1_0(&doc,&object_node,export_flags);
+            if (!(result & IExportable::FailedResult))
+                writeXmlElementContents(writer,object_node);
+            return result;
+        }
+        return exportXmlStream_1_0(writer,export_flags);
+    }
+
+    return IExportable::Incomplete;
+}
+
+IExportable::ExportResultFlags Qtilities::Core::ObserverData::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2)
+        return importXmlStream_1_0(reader,import_list);
+
+    reader->skipCurrentElement();
+    return IExportable::Incomplete;
+}
+
 IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_0(QDataStream& stream, ExportItemFlags export_flags) const {
+    // The parallel flag only changes how the export is done, it is not part of the export:
+    bool parallel_export = (export_flags & ExportParallel);
+    export_flags &= ~ExportParallel;
+
     stream << MARKER_OBS_DATA_SECTION;
     // Export the flags used:
     stream << (quint32) export_flags;
@@ -228,91 +319,11 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_
     }
 
     if (export_flags & ExportData) {
-        // -----------------------------------
-        // Observer Data
-        // -----------------------------------
-        stream << MARKER_OBS_DATA_SECTION;
-        stream << (quint32) subject_limit;
-        stream << observer_description;
-        stream << (quint32) access_mode;
-        stream << (quint32) access_mode_scope;
-        stream << (quint32) object_deletion_policy;
-
-        // Visitor ID (only when needed)
-        if (export_flags & ExportVisitorIDs) {
-            int visitor_id = -1;
-            if (ObjectManager::propertyExists(observer,qti_prop_VISITOR_ID)) {
-                QVariant prop_variant = observer->property(qti_prop_VISITOR_ID);
-                if (prop_variant.isValid() && prop_variant.canConvert<SharedProperty>()) {
-                    SharedProperty prop = prop_variant.value<SharedProperty>();
-                    if (prop.isValid()) {
-                         visitor_id = prop.value().toInt();
-                    }
-                }
-            }
-            stream << (qint32) visitor_id;
-        }
-
-        // Stream categories
-        stream << (quint32) categories.count();
-        for (int i = 0; i < categories.count(); ++i) {
-            categories.at(i).exportBinary(stream);
-        }
-
-        stream << deliver_qtilities_property_changed_events;
-
-        if (display_hints) {
-            // Indicates that this observer has hints.
-            if (display_hints->isExportable()) {
-                stream << (bool) true;
-                display_hints->setExportTask(exportTask());
-                if (display_hints->exportBinary(stream) != IExportable::Complete) {
-                    if (relational_table)
-                        delete relational_table;
-                    display_hints->clearExportTask();
-                    return IExportable::Failed;
-                }
-                display_hints->clearExportTask();
-            } else {
-                stream << (bool) false;
-            }
-        } else {
-            stream << (bool) false;
-        }
-        stream << MARKER_OBS_DATA_SECTION;
-
-        // -----------------------------------
-        // Subject Filters
-        // -----------------------------------
-        int exportable_filters_count = 0;
-        for (int i = 0; i < subject_filters.count(); ++i) {
-            if (subject_filters.at(i)->isExportable())
-                ++exportable_filters_count;
-        }
-
-        stream << (quint32) exportable_filters_count;
-        // Stream all subject filters:
-        for (int i = 0; i < subject_filters.count(); ++i) {
-            if (subject_filters.at(i)->isExportable()) {
-                subject_filters.at(i)->setExportVersion(exportVersion());
-                subject_filters.at(i)->setExportTask(exportTask());
-                if (!subject_filters.at(i)->instanceFactoryInfo().exportBinary(stream,exportVersion())) {
-                    if (relational_table)
-                        delete relational_table;
-                    subject_filters.at(i)->clearExportTask();
-                    return IExportable::Failed;
-                }
-                if (subject_filters.at(i)->exportBinary(stream) != IExportable::Complete) {
-                    if (relational_table)
-                        delete relational_table;
-                    subject_filters.at(i)->clearExportTask();
-                    return IExportable::Failed;
-                }
-                subject_filters.at(i)->clearExportTask();
-                LOG_TASK_TRACE(QString("%1/%2: Exporting subject filter \"%3\"...").arg(i+1).arg(subject_filters.count()).arg(subject_filters.at(i)->filterName()),exportTask());
-            }
+        if (exportObserverSectionBinary(stream,export_flags) == IExportable::Failed) {
+            if (relational_table)
+                delete relational_table;
+            return IExportable::Failed;
         }
-        stream << MARKER_OBS_DATA_SECTION;
 
         // -----------------------------------
         // Make List Of Exportable Subjects
@@ -345,6 +356,32 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_
         qint32 iface_count = exportable_list.count();
         stream << iface_count;
 
+        // -----------------------------------
+        // Export Independent Subtrees Concurrently
+        // -----------------------------------
+        // Visitor IDs and relational tables depend on the order in which the complete tree is visited, thus they are always exported serially.
+        QVector<ObserverDataExportTask*> export_tasks(exportable_list.count(),0);
+        if (parallel_export && !(export_flags & ExportVisitorIDs) && !(export_flags & ExportRelationalData) && parallelExportSupported(exportable_list)) {
+            ExportItemFlags child_obs_flags = export_flags;
+            child_obs_flags &= ~ExportRelationalData;
+
+            QThreadPool export_pool;
+            for (int i = 0; i < exportable_list.count(); ++i) {
+                IExportable* iface = exportable_list.at(i);
+                Observer* obs = qobject_cast<Observer*> (iface->objectBase());
+                if (!obs)
+                    continue;
+
+                iface->setExportVersion(exportVersion());
+                iface->setApplicationExportVersion(applicationExportVersion());
+                IExportableObserver* export_iface_obs = qobject_cast<IExportableObserver*> (obs->objectBase());
+                Q_ASSERT(export_iface_obs);
+                export_tasks[i] = new ObserverDataExportTask(export_iface_obs,child_obs_flags,stream);
+                export_pool.start(export_tasks[i]);
+            }
+            export_pool.waitForDone();
+            LOG_TASK_TRACE(QString(QObject::tr("Subtrees of observer %1 were exported concurrently using %2 thread(s).")).arg(observer->observerName()).arg(export_pool.maxThreadCount()),exportTask());
+        }
 
         // Now check all subjects for the IExportable interface.
         for (int i = 0; i < exportable_list.count(); ++i) {
@@ -355,6 +392,7 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_
             if (!iface->instanceFactoryInfo().exportBinary(stream,exportVersion())) {
                 if (relational_table)
                     delete relational_table;
+                qDeleteAll(export_tasks);
                 return IExportable::Failed;
             }
 
@@ -379,7 +417,12 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_
             // Check if it is an observer:
             IExportable::ExportResultFlags result;
             Observer* obs = qobject_cast<Observer*> (iface->objectBase());
-            if (obs) {
+            if (export_tasks.at(i)) {
+                // The subtree was exported concurrently above:
+                const QByteArray& export_data = export_tasks.at(i)->export_data;
+                stream.writeRawData(export_data.constData(),export_data.size());
+                result = export_tasks.at(i)->result;
+            } else if (obs) {
                 ExportItemFlags child_obs_flags = export_flags;
                 child_obs_flags &= ~ExportRelationalData;
 
@@ -399,6 +442,7 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_
                 complete = false;
         }
 
+        qDeleteAll(export_tasks);
         stream << MARKER_OBS_DATA_SECTION;
     }
 
@@ -424,7 +468,8 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
 
     quint32 ui32;
     stream >> ui32;
-    if (ui32 != MARKER_OBS_DATA_SECTION) {
+    bool streamed = (ui32 == MARKER_OBS_STREAMED_SECTION);
+    if (ui32 != MARKER_OBS_DATA_SECTION && !streamed) {
         LOG_TASK_ERROR(QObject::tr("Observer binary import failed to detect marker at start of import. Import will fail at ") + Q_FUNC_INFO,exportTask());
         observer->endProcessingCycle();
         return IExportable::Failed;
@@ -432,6 +477,21 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
 
     stream >> ui32;
     ExportModeFlags export_flags = (ExportModeFlags) ui32;
+    ExportItemFlags item_flags = (ExportItemFlags) ui32;
+
+    // The layout is determined by the marker, the streamed flags are only valid after the streamed marker:
+    if (streamed != ((item_flags & ExportStreamed) || (item_flags & ExportObserverDataOnly))) {
+        LOG_TASK_ERROR(QObject::tr("Observer binary import found export flags which do not match the marker at the start of the import. Import will fail at ") + Q_FUNC_INFO,exportTask());
+        observer->endProcessingCycle();
+        return IExportable::Failed;
+    }
+
+    // Streamed exports use their own layout after the export flags:
+    if (streamed) {
+        IExportable::ExportResultFlags result = importBinaryStreamed(stream,item_flags,import_list);
+        observer->endProcessingCycle();
+        return result;
+    }
 
     // We define a succesfull operation as an import which is able to import all subjects.
     bool success = true;
@@ -453,96 +513,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     }
 
     if (export_flags & ExportData) {
-        stream >> ui32;
-        if (ui32 != MARKER_OBS_DATA_SECTION) {
-            LOG_TASK_ERROR(QObject::tr("Observer binary import failed to detect marker located after factory data. Import will fail at ") + Q_FUNC_INFO,exportTask());
-            observer->endProcessingCycle();
-            return IExportable::Failed;
-        }
-
-        // -----------------------------------
-        // Observer Data
-        // -----------------------------------
-        stream >> ui32;
-        subject_limit = ui32;
-        stream >> observer_description;
-        stream >> ui32;
-        access_mode = ui32;
-        stream >> ui32;
-        access_mode_scope = ui32;
-        stream >> ui32;
-        object_deletion_policy = ui32;
-
-        if (export_flags & ExportVisitorIDs) {
-            qint32 visitor_id;
-            stream >> visitor_id;
-            SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,visitor_id);
-            ObjectManager::setSharedProperty(observer,visitor_id_prop);
-        }
-
-        // Stream categories
-        stream >> ui32;
-        int category_count = ui32;
-        for (int i = 0; i < category_count; ++i) {
-            QtilitiesCategory category(stream,exportVersion());
-            categories.push_back(category);
-        }
-
-        stream >> deliver_qtilities_property_changed_events;
-
-        bool has_hints;
-        stream >> has_hints;
-        if (has_hints) {
-            if (!display_hints)
-                display_hints = new ObserverHints();
-            display_hints->setExportVersion(exportVersion());
-            display_hints->setExportTask(exportTask());
-            if (display_hints->importBinary(stream,import_list) == IExportable::Failed) {
-                display_hints->clearExportTask();
-                return IExportable::Failed;
-            }
-            display_hints->clearExportTask();
-        }
-
-        stream >> ui32;
-        if (ui32 != MARKER_OBS_DATA_SECTION) {
-            LOG_TASK_ERROR(QObject::tr("Observer binary import failed to detect marker located after ObserverData. Import will fail at ") + Q_FUNC_INFO,exportTask());
-            observer->endProcessingCycle();
-            return IExportable::Failed;
-        }
-
-        // -----------------------------------
-        // Subject Filters
-        // -----------------------------------
-        stream >> ui32;
-        int subject_filter_count = ui32;
-        for (int i = 0; i < subject_filter_count; ++i) {
-            // Get the factory data of the subject filter:
-            InstanceFactoryInfo instanceFactoryInfo;
-            if (!instanceFactoryInfo.importBinary(stream,exportVersion())) {
-                observer->endProcessingCycle();
-                return IExportable::Failed;
-            } else {
-                AbstractSubjectFilter* new_filter = qobject_cast<AbstractSubjectFilter*> (OBJECT_MANAGER->createInstance(instanceFactoryInfo));
-                if (new_filter) {
-                    new_filter->setExportVersion(exportVersion());
-                    new_filter->setObjectName(instanceFactoryInfo.d_instance_name);
-                    LOG_TASK_TRACE(QString("%1/%2: Importing subject filter \"%3\"...").arg(i+1).arg(subject_filter_count).arg(instanceFactoryInfo.d_instance_name),exportTask());
-                    new_filter->setExportTask(exportTask());
-                    new_filter->importBinary(stream,import_list);
-                    new_filter->clearExportTask();
-                    observer->installSubjectFilter(new_filter);
-                } else {
-                    LOG_TASK_ERROR(QString(QObject::tr("%1/%2: Importing subject filter \"%3\" failed. Import cannot continue at %4")).arg(i+1).arg(subject_filter_count).arg(instanceFactoryInfo.d_instance_name).arg(Q_FUNC_INFO),exportTask());
-                    observer->endProcessingCycle();
-                    return IExportable::Failed;
-                }
-            }
-        }
-
-        stream >> ui32;
-        if (ui32 != MARKER_OBS_DATA_SECTION) {
-            LOG_TASK_ERROR(QObject::tr("Observer binary import failed to detect marker located after subject filters. Import will fail at ") + Q_FUNC_INFO,exportTask());
+        if (importObserverSectionBinary(stream,item_flags,import_list) == IExportable::Failed) {
             observer->endProcessingCycle();
             return IExportable::Failed;
         }
@@ -647,28 +618,545 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
             LOG_TASK_INFO(QString(QObject::tr("Relational verification successful on observer: %1")).arg(observer->observerName()),exportTask());
         }
 
-        // Remove all relational properties used.
-        ObserverRelationalTable::removeRelationalProperties(observer);
+        // Remove all relational properties used.
+        ObserverRelationalTable::removeRelationalProperties(observer);
+    }
+
+    observer->endProcessingCycle();
+
+    if (success) {
+        if (complete) {
+            LOG_TASK_DEBUG(QObject::tr("Binary import of observer ") + observer->observerName() + QObject::tr(" section was Successful (complete)."),exportTask());
+            return IExportable::Complete;
+        } else {
+            LOG_TASK_DEBUG(QObject::tr("Binary import of observer ") + observer->observerName() + QObject::tr(" section was Successful (incomplete."),exportTask());
+            return IExportable::Incomplete;
+        }
+    } else {
+        LOG_TASK_WARNING(QObject::tr("Binary import of observer ") + observer->observerName() + QObject::tr(" section failed."),exportTask());
+        return IExportable::Failed;
+    }
+}
+
+IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportObserverSectionBinary(QDataStream& stream, ExportItemFlags export_flags) const {
+    // -----------------------------------
+    // Observer Data
+    // -----------------------------------
+    stream << MARKER_OBS_DATA_SECTION;
+    stream << (quint32) subject_limit;
+    stream << observer_description;
+    stream << (quint32) access_mode;
+    stream << (quint32) access_mode_scope;
+    stream << (quint32) object_deletion_policy;
+
+    // Visitor ID (only when needed)
+    if (export_flags & ExportVisitorIDs) {
+        int visitor_id = -1;
+        if (ObjectManager::propertyExists(observer,qti_prop_VISITOR_ID)) {
+            QVariant prop_variant = observer->property(qti_prop_VISITOR_ID);
+            if (prop_variant.isValid() && prop_variant.canConvert<SharedProperty>()) {
+                SharedProperty prop = prop_variant.value<SharedProperty>();
+                if (prop.isValid()) {
+                     visitor_id = prop.value().toInt();
+                }
+            }
+        }
+        stream << (qint32) visitor_id;
+    }
+
+    // Stream categories
+    stream << (quint32) categories.count();
+    for (int i = 0; i < categories.count(); ++i) {
+        categories.at(i).exportBinary(stream);
+    }
+
+    stream << deliver_qtilities_property_changed_events;
+
+    if (display_hints) {
+        // Indicates that this observer has hints.
+        if (display_hints->isExportable()) {
+            stream << (bool) true;
+            display_hints->setExportTask(exportTask());
+            if (display_hints->exportBinary(stream) != IExportable::Complete) {
+                display_hints->clearExportTask();
+                return IExportable::Failed;
+            }
+            display_hints->clearExportTask();
+        } else {
+            stream << (bool) false;
+        }
+    } else {
+        stream << (bool) false;
+    }
+    stream << MARKER_OBS_DATA_SECTION;
+
+    // -----------------------------------
+    // Subject Filters
+    // -----------------------------------
+    int exportable_filters_count = 0;
+    for (int i = 0; i < subject_filters.count(); ++i) {
+        if (subject_filters.at(i)->isExportable())
+            ++exportable_filters_count;
+    }
+
+    stream << (quint32) exportable_filters_count;
+    // Stream all subject filters:
+    for (int i = 0; i < subject_filters.count(); ++i) {
+        if (subject_filters.at(i)->isExportable()) {
+            subject_filters.at(i)->setExportVersion(exportVersion());
+            subject_filters.at(i)->setExportTask(exportTask());
+            if (!subject_filters.at(i)->instanceFactoryInfo().exportBinary(stream,exportVersion())) {
+                subject_filters.at(i)->clearExportTask();
+                return IExportable::Failed;
+            }
+            if (subject_filters.at(i)->exportBinary(stream) != IExportable::Complete) {
+                subject_filters.at(i)->clearExportTask();
+                return IExportable::Failed;
+            }
+            subject_filters.at(i)->clearExportTask();
+            LOG_TASK_TRACE(QString("%1/%2: Exporting subject filter \"%3\"...").arg(i+1).arg(subject_filters.count()).arg(subject_filters.at(i)->filterName()),exportTask());
+        }
+    }
+    stream << MARKER_OBS_DATA_SECTION;
+
+    return IExportable::Complete;
+}
+
+IExportable::ExportResultFlags Qtilities::Core::ObserverData::importObserverSectionBinary(QDataStream& stream, ExportItemFlags export_flags, QList<QPointer<QObject> >& import_list) {
+    quint32 ui32;
+    stream >> ui32;
+    if (ui32 != MARKER_OBS_DATA_SECTION) {
+        LOG_TASK_ERROR(QObject::tr("Observer binary import failed to detect marker located after factory data. Import will fail at ") + Q_FUNC_INFO,exportTask());
+        return IExportable::Failed;
+    }
+
+    // -----------------------------------
+    // Observer Data
+    // -----------------------------------
+    stream >> ui32;
+    subject_limit = ui32;
+    stream >> observer_description;
+    stream >> ui32;
+    access_mode = ui32;
+    stream >> ui32;
+    access_mode_scope = ui32;
+    stream >> ui32;
+    object_deletion_policy = ui32;
+
+    if (export_flags & ExportVisitorIDs) {
+        qint32 visitor_id;
+        stream >> visitor_id;
+        SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,visitor_id);
+        ObjectManager::setSharedProperty(observer,visitor_id_prop);
+    }
+
+    // Stream categories
+    stream >> ui32;
+    int category_count = ui32;
+    for (int i = 0; i < category_count; ++i) {
+        QtilitiesCategory category(stream,exportVersion());
+        categories.push_back(category);
+    }
+
+    stream >> deliver_qtilities_property_changed_events;
+
+    bool has_hints;
+    stream >> has_hints;
+    if (has_hints) {
+        if (!display_hints)
+            display_hints = new ObserverHints();
+        display_hints->setExportVersion(exportVersion());
+        display_hints->setExportTask(exportTask());
+        if (display_hints->importBinary(stream,import_list) == IExportable::Failed) {
+            display_hints->clearExportTask();
+            return IExportable::Failed;
+        }
+        display_hints->clearExportTask();
+    }
+
+    stream >> ui32;
+    if (ui32 != MARKER_OBS_DATA_SECTION) {
+        LOG_TASK_ERROR(QObject::tr("Observer binary import failed to detect marker located after ObserverData. Import will fail at ") + Q_FUNC_INFO,exportTask());
+        return IExportable::Failed;
+    }
+
+    // -----------------------------------
+    // Subject Filters
+    // -----------------------------------
+    stream >> ui32;
+    int subject_filter_count = ui32;
+    for (int i = 0; i < subject_filter_count; ++i) {
+        // Get the factory data of the subject filter:
+        InstanceFactoryInfo instanceFactoryInfo;
+        if (!instanceFactoryInfo.importBinary(stream,exportVersion())) {
+            return IExportable::Failed;
+        } else {
+            AbstractSubjectFilter* new_filter = qobject_cast<AbstractSubjectFilter*> (OBJECT_MANAGER->createInstance(instanceFactoryInfo));
+            if (new_filter) {
+                new_filter->setExportVersion(exportVersion());
+                new_filter->setObjectName(instanceFactoryInfo.d_instance_name);
+                LOG_TASK_TRACE(QString("%1/%2: Importing subject filter \"%3\"...").arg(i+1).arg(subject_filter_count).arg(instanceFactoryInfo.d_instance_name),exportTask());
+                new_filter->setExportTask(exportTask());
+                new_filter->importBinary(stream,import_list);
+                new_filter->clearExportTask();
+                observer->installSubjectFilter(new_filter);
+            } else {
+                LOG_TASK_ERROR(QString(QObject::tr("%1/%2: Importing subject filter \"%3\" failed. Import cannot continue at %4")).arg(i+1).arg(subject_filter_count).arg(instanceFactoryInfo.d_instance_name).arg(Q_FUNC_INFO),exportTask());
+                return IExportable::Failed;
+            }
+        }
+    }
+
+    stream >> ui32;
+    if (ui32 != MARKER_OBS_DATA_SECTION) {
+        LOG_TASK_ERROR(QObject::tr("Observer binary import failed to detect marker located after subject filters. Import will fail at ") + Q_FUNC_INFO,exportTask());
+        return IExportable::Failed;
+    }
+
+    return IExportable::Complete;
+}
+
+bool Qtilities::Core::ObserverData::parallelExportSupported(const QList<IExportable*>& exportable_list) const {
+    QList<const Observer*> observers;
+    for (int i = 0; i < exportable_list.count(); ++i) {
+        const Observer* obs = qobject_cast<const Observer*> (exportable_list.at(i)->objectBase());
+        if (obs)
+            observers << obs;
+    }
+    if (observers.count() < 2)
+        return false;
+
+    return !subjectsShared(observers);
+}
+
+bool Qtilities::Core::ObserverData::subjectsShared(QList<const Observer*> observers) {
+    // Subjects which are attached to more than one observer can be reached from more than one subtree, thus they
+    // would be exported from more than one thread:
+    while (!observers.isEmpty()) {
+        const Observer* obs = observers.takeLast();
+        if (Observer::parentCount(obs) > 1)
+            return true;
+        for (int i = 0; i < obs->subjectCount(); ++i) {
+            const QObject* subject = obs->subjectAt(i);
+            const Observer* child_obs = qobject_cast<const Observer*> (subject);
+            if (child_obs)
+                observers << child_obs;
+            else if (Observer::parentCount(subject) > 1)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryStreamed(QDataStream& stream, ExportItemFlags export_flags) const {
+    // The streamed layout keeps the relationships in the tree itself, thus visitor IDs and relational tables are not used:
+    export_flags &= ~ExportVisitorIDs;
+    export_flags &= ~ExportRelationalData;
+    export_flags &= ~ExportParallel;
+
+    stream << MARKER_OBS_STREAMED_SECTION;
+    stream << (quint32) export_flags;
+
+    if (exportObserverSectionBinary(stream,export_flags) == IExportable::Failed)
+        return IExportable::Failed;
+    if (export_flags & ExportObserverDataOnly)
+        return IExportable::Complete;
+
+    bool complete = true;
+    int exported_count = 0;
+    // Only subjects with more than one parent can appear again later in the tree, thus only they are remembered:
+    QHash<const QObject*,qint32> shared_ids;
+
+    // The observers on the current path through the tree, each with the index of its next subject to export:
+    QVector<QPair<const Observer*,int> > path;
+    path.append(qMakePair((const Observer*) observer,0));
+    while (!path.isEmpty()) {
+        const Observer* parent = path.last().first;
+        int subject_index = path.last().second;
+        if (subject_index >= parent->subjectCount()) {
+            stream << (quint8) StreamedEndRecord;
+            path.pop_back();
+            continue;
+        }
+        ++path.last().second;
+
+        QObject* obj = parent->subjectAt(subject_index);
+        quint32 ownership = parent->getMultiContextPropertyValue(obj,qti_prop_OWNERSHIP).toInt();
+        bool is_owner = (parent->getMultiContextPropertyValue(obj,qti_prop_PARENT_ID).toInt() == parent->observerID());
+
+        QHash<const QObject*,qint32>::const_iterator shared_itr = shared_ids.constFind(obj);
+        if (shared_itr != shared_ids.constEnd()) {
+            stream << (quint8) StreamedReferenceRecord;
+            stream << shared_itr.value();
+            stream << ownership;
+            stream << is_owner;
+            continue;
+        }
+
+        IExportable* iface = qobject_cast<IExportable*> (obj);
+        if (!iface || !(iface->supportedFormats() & IExportable::Binary) || !iface->instanceFactoryInfo().isValid()) {
+            LOG_TASK_WARNING(QObject::tr("Streamed binary export found an object (") + parent->subjectNameInContext(obj) + QObject::tr(" in context ") + parent->observerName() + QObject::tr(") which cannot be exported. Export will be incomplete."),exportTask());
+            complete = false;
+            continue;
+        }
+
+        qint32 shared_id = -1;
+        if (Observer::parentCount(obj) > 1) {
+            shared_id = shared_ids.count();
+            shared_ids[obj] = shared_id;
+        }
+
+        stream << (quint8) StreamedSubjectRecord;
+        stream << shared_id;
+        stream << ownership;
+        stream << is_owner;
+        if (!iface->instanceFactoryInfo().exportBinary(stream,exportVersion()))
+            return IExportable::Failed;
+
+        iface->setExportVersion(exportVersion());
+        iface->setApplicationExportVersion(applicationExportVersion());
+        iface->setExportTask(exportTask());
+
+        IExportable::ExportResultFlags result;
+        Observer* obs = qobject_cast<Observer*> (iface->objectBase());
+        if (obs) {
+            // Only the data of the observer is exported here, its subjects follow as records of their own:
+            IExportableObserver* export_iface_obs = qobject_cast<IExportableObserver*> (obs->objectBase());
+            Q_ASSERT(export_iface_obs);
+            result = export_iface_obs->exportBinaryExt(stream,export_flags | ExportObserverDataOnly);
+            path.append(qMakePair((const Observer*) obs,0));
+        } else {
+            result = iface->exportBinary(stream);
+        }
+
+        iface->clearExportTask();
+
+        // A failed subject leaves the stream in an unknown state, thus the rest of the stream cannot be read back:
+        if (result == IExportable::Failed)
+            return IExportable::Failed;
+        if (result == IExportable::Incomplete)
+            complete = false;
+
+        if (++exported_count % STREAMED_PROGRESS_INTERVAL == 0)
+            reportStreamedProgress(STREAMED_PROGRESS_INTERVAL,exported_count);
+    }
+
+    stream << MARKER_OBS_DATA_SECTION;
+    reportStreamedProgress(exported_count % STREAMED_PROGRESS_INTERVAL,exported_count);
+
+    if (complete) {
+        LOG_TASK_DEBUG(QObject::tr("Streamed binary export of observer ") + observer->observerName() + QString(QObject::tr(" was successful (complete).")),exportTask());
+        return IExportable::Complete;
+    } else {
+        LOG_TASK_DEBUG(QObject::tr("Streamed binary export of observer ") + observer->observerName() + QString(QObject::tr(" was successful (incomplete).")),exportTask());
+        return IExportable::Incomplete;
+    }
+}
+
+IExportable::ExportResultFlags Qtilities::Core::ObserverData::importBinaryStreamed(QDataStream& stream, ExportItemFlags export_flags, QList<QPointer<QObject> >& import_list) {
+    if (importObserverSectionBinary(stream,export_flags,import_list) == IExportable::Failed)
+        return IExportable::Failed;
+    if (export_flags & ExportObserverDataOnly)
+        return IExportable::Complete;
+
+    bool failed = false;
+    bool complete = true;
+    int imported_count = 0;
+    // Subjects which can be referenced again later in the stream, indexed on the ID under which they were exported:
+    QHash<qint32,QPointer<QObject> > shared_objects;
+
+    // The observers on the current path through the tree. The processing cycle of this observer is managed by the caller,
+    // processing cycles of the rest are managed here:
+    QVector<Observer*> path;
+    path.append(observer);
+    while (!path.isEmpty()) {
+        quint8 record;
+        stream >> record;
+        if (stream.status() != QDataStream::Ok) {
+            LOG_TASK_ERROR(QObject::tr("Streamed binary import of observer ") + observer->observerName() + QObject::tr(" reached the end of the stream before all subjects were read."),exportTask());
+            failed = true;
+            break;
+        }
+
+        if (record == StreamedEndRecord) {
+            if (path.count() > 1) {
+                Observer* obs = path.last();
+                obs->endProcessingCycle();
+                // Observers which could not be attached are only kept until their subjects were read:
+                if (Observer::parentCount(obs) == 0)
+                    delete obs;
+            }
+            path.pop_back();
+            continue;
+        }
+
+        Observer* parent = path.last();
+        qint32 shared_id;
+        quint32 ownership;
+        bool is_owner;
+        stream >> shared_id;
+        stream >> ownership;
+        stream >> is_owner;
+        Observer::ObjectOwnership attach_ownership = (Observer::ObjectOwnership) ownership;
+        if (attach_ownership == Observer::SpecificObserverOwnership && !is_owner)
+            attach_ownership = Observer::ManualOwnership;
+
+        if (record == StreamedReferenceRecord) {
+            QObject* obj = shared_objects.value(shared_id);
+            if (!obj || !parent->attachSubject(obj,attach_ownership,0,true)) {
+                LOG_TASK_WARNING(QString(QObject::tr("Streamed binary import failed to attach shared subject %1 to observer %2. The import will be incomplete.")).arg(shared_id).arg(parent->observerName()),exportTask());
+                complete = false;
+            }
+            continue;
+        } else if (record != StreamedSubjectRecord) {
+            LOG_TASK_ERROR(QString(QObject::tr("Streamed binary import found an unknown record type (%1). Import will fail at ")).arg(record) + Q_FUNC_INFO,exportTask());
+            failed = true;
+            break;
+        }
+
+        InstanceFactoryInfo instanceFactoryInfo;
+        if (!instanceFactoryInfo.importBinary(stream,exportVersion())) {
+            failed = true;
+            break;
+        }
+
+        // The data of a subject cannot be skipped without knowing its type, thus subjects which cannot be constructed fail the import:
+        QObject* new_instance = 0;
+        IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
+        if (ifactory)
+            new_instance = ifactory->createInstance(instanceFactoryInfo);
+        IExportable* export_iface = qobject_cast<IExportable*> (new_instance);
+        if (!export_iface) {
+            LOG_TASK_ERROR(QString(QObject::tr("Streamed binary import failed to construct subject type \"%1\" in factory \"%2\". Import will fail at ")).arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag) + Q_FUNC_INFO,exportTask());
+            if (new_instance)
+                delete new_instance;
+            failed = true;
+            break;
+        }
+
+        new_instance->setObjectName(instanceFactoryInfo.d_instance_name);
+        if (path.count() == 1)
+            import_list.append(new_instance);
+        export_iface->setExportVersion(exportVersion());
+        export_iface->setApplicationExportVersion(applicationExportVersion());
+        export_iface->setExportTask(exportTask());
+
+        IExportable::ExportResultFlags result;
+        Observer* obs = qobject_cast<Observer*> (export_iface->objectBase());
+        if (obs) {
+            QList<QPointer<QObject> > internal_import_list;
+            result = obs->importBinary(stream,internal_import_list);
+        } else {
+            result = export_iface->importBinary(stream,import_list);
+        }
+
+        export_iface->clearExportTask();
+
+        if (result == IExportable::Failed) {
+            delete new_instance;
+            failed = true;
+            break;
+        } else if (result == IExportable::Incomplete) {
+            complete = false;
+        }
+
+        if (!parent->attachSubject(new_instance,attach_ownership,0,true)) {
+            LOG_TASK_WARNING(QString(QObject::tr("Streamed binary import failed to attach subject \"%1\" to observer %2. The import will be incomplete.")).arg(instanceFactoryInfo.d_instance_name).arg(parent->observerName()),exportTask());
+            complete = false;
+            if (!obs) {
+                delete new_instance;
+                continue;
+            }
+        }
+
+        if (shared_id != -1)
+            shared_objects[shared_id] = new_instance;
+        if (obs) {
+            obs->startProcessingCycle();
+            path.append(obs);
+        }
+
+        if (++imported_count % STREAMED_PROGRESS_INTERVAL == 0)
+            reportStreamedProgress(STREAMED_PROGRESS_INTERVAL,imported_count);
     }
 
-    observer->endProcessingCycle();
+    // End the processing cycles of observers which are still on the path when the import failed:
+    for (int i = 1; i < path.count(); ++i)
+        path.at(i)->endProcessingCycle();
 
-    if (success) {
-        if (complete) {
-            LOG_TASK_DEBUG(QObject::tr("Binary import of observer ") + observer->observerName() + QObject::tr(" section was Successful (complete)."),exportTask());
-            return IExportable::Complete;
-        } else {
-            LOG_TASK_DEBUG(QObject::tr("Binary import of observer ") + observer->observerName() + QObject::tr(" section was Successful (incomplete."),exportTask());
-            return IExportable::Incomplete;
+    if (!failed) {
+        quint32 ui32;
+        stream >> ui32;
+        if (ui32 != MARKER_OBS_DATA_SECTION) {
+            LOG_TASK_ERROR(QObject::tr("Observer binary import failed to detect end marker. Import will fail at ") + Q_FUNC_INFO,exportTask());
+            failed = true;
         }
-    } else {
-        LOG_TASK_WARNING(QObject::tr("Binary import of observer ") + observer->observerName() + QObject::tr(" section failed."),exportTask());
+    }
+
+    if (failed) {
+        LOG_TASK_WARNING(QObject::tr("Streamed binary import of observer ") + observer->observerName() + QObject::tr(" section failed."),exportTask());
         return IExportable::Failed;
     }
+
+    reportStreamedProgress(imported_count % STREAMED_PROGRESS_INTERVAL,imported_count);
+    if (complete) {
+        LOG_TASK_DEBUG(QObject::tr("Streamed binary import of observer ") + observer->observerName() + QObject::tr(" section was Successful (complete)."),exportTask());
+        return IExportable::Complete;
+    } else {
+        LOG_TASK_DEBUG(QObject::tr("Streamed binary import of observer ") + observer->observerName() + QObject::tr(" section was Successful (incomplete)."),exportTask());
+        return IExportable::Incomplete;
+    }
+}
+
+void Qtilities::Core::ObserverData::reportStreamedProgress(int completed_count, int processed_count) const {
+    QCoreApplication::processEvents();
+    LOG_TASK_TRACE(QString(QObject::tr("%1 subject(s) processed in streamed export or import of observer %2...")).arg(processed_count).arg(observer->observerName()),exportTask());
+
+    if (!exportTask() || completed_count == 0)
+        return;
+    Task* task = qobject_cast<Task*> (exportTask()->objectBase());
+    if (task && task->state() == ITask::TaskBusy)
+        task->addCompletedSubTasks(completed_count);
+}
+
+bool Qtilities::Core::ObserverData::exportSubjectItemXml(const Observer* context, IExportable* export_iface, QDomDocument* doc, QDomElement* subject_item) const {
+    // 1. Category:
+    if (ObjectManager::propertyExists(export_iface->objectBase(),qti_prop_CATEGORY_MAP)) {
+        QVariant category_variant = context->getMultiContextPropertyValue(export_iface->objectBase(),qti_prop_CATEGORY_MAP);
+        if (category_variant.isValid()) {
+            QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
+            QDomElement category_item = doc->createElement("Category");
+            subject_item->appendChild(category_item);
+            category.setExportVersion(exportVersion());
+            category.setExportTask(exportTask());
+            category.exportXml(doc,&category_item);
+            category.clearExportTask();
+        }
+    }
+    // 2. Is Active:
+    if (ObjectManager::propertyExists(export_iface->objectBase(),qti_prop_ACTIVITY_MAP)) {
+        bool activity = context->getMultiContextPropertyValue(export_iface->objectBase(),qti_prop_ACTIVITY_MAP).toBool();
+        if (activity)
+            subject_item->setAttribute("Activity","Active");
+        else
+            subject_item->setAttribute("Activity","Inactive");
+    }
+    // 3. Ownership:
+    Observer::ObjectOwnership ownership = context->subjectOwnershipInContext(export_iface->objectBase());
+    if (ownership != Observer::ObserverScopeOwnership)
+        subject_item->setAttribute("Ownership",Observer::objectOwnershipToString(ownership));
+
+    // 4. Factory Data:
+    return export_iface->instanceFactoryInfo().exportXml(doc,subject_item,exportVersion());
 }
 
 Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlExt_1_0(QDomDocument* doc, QDomElement* object_node, ExportItemFlags export_flags) const {
-    object_node->setAttribute("ExportFlags",QString::number(export_flags));
+    // ExportObserverDataOnly only controls what is written here, it is not part of the format:
+    ExportItemFlags written_flags = export_flags;
+    written_flags &= ~ExportObserverDataOnly;
+    written_flags &= ~ExportParallel;
+    object_node->setAttribute("ExportFlags",QString::number(written_flags));
 
     IExportable::ExportResultFlags result = IExportable::Complete;
     bool complete = true;
@@ -790,6 +1278,13 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
         if (subject_data.attributes().count() > 0 || subject_data.childNodes().count() > 0)
             object_node->appendChild(subject_data);
 
+        // Streamed exports write the subjects themselves:
+        if (export_flags & ExportObserverDataOnly) {
+            if (relational_table)
+                delete relational_table;
+            return IExportable::Complete;
+        }
+
         // Make List Of Exportable Subjects
         QList<IExportable*> exportable_list;
         if (export_flags & ExportVisitorIDs)
@@ -822,35 +1317,8 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
                     // The item and its factory data:
                     QDomElement subject_item = doc->createElement("TreeItem");
                     subject_children.appendChild(subject_item);
-                    // We also append the following information:
-                    // 1. Category:
-                    if (ObjectManager::propertyExists(export_iface->objectBase(),qti_prop_CATEGORY_MAP)) {
-                        QVariant category_variant = observer->getMultiContextPropertyValue(export_iface->objectBase(),qti_prop_CATEGORY_MAP);
-                        if (category_variant.isValid()) {
-                            QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
-                            QDomElement category_item = doc->createElement("Category");
-                            subject_item.appendChild(category_item);
-                            category.setExportVersion(exportVersion());
-                            category.setExportTask(exportTask());
-                            category.exportXml(doc,&category_item);
-                            category.clearExportTask();
-                        }
-                    }
-                    // 2. Is Active:
-                    if (ObjectManager::propertyExists(export_iface->objectBase(),qti_prop_ACTIVITY_MAP)) {
-                        bool activity = observer->getMultiContextPropertyValue(export_iface->objectBase(),qti_prop_ACTIVITY_MAP).toBool();
-                        if (activity)
-                            subject_item.setAttribute("Activity","Active");
-                        else
-                            subject_item.setAttribute("Activity","Inactive");
-                    }
-                    // 3. Ownership:
-                    Observer::ObjectOwnership ownership = observer->subjectOwnershipInContext(export_iface->objectBase());
-                    if (ownership != Observer::ObserverScopeOwnership)
-                        subject_item.setAttribute("Ownership",Observer::objectOwnershipToString(ownership));
-
-                    // 4. Factory Data:
-                    if (!export_iface->instanceFactoryInfo().exportXml(doc,&subject_item,exportVersion())) {
+                    // 1-4. Category, activity, ownership and factory data:
+                    if (!exportSubjectItemXml(observer,export_iface,doc,&subject_item)) {
                         if (relational_table)
                             delete relational_table;
                         return IExportable::Failed;
@@ -1130,77 +1598,11 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
                                             continue;
                                         }
 
-                                        QDomNodeList subjectChildNodes = childrenChild.childNodes();
-                                        for(int i = 0; i < subjectChildNodes.count(); ++i)
-                                        {
-                                            QDomNode subjectChildNode = subjectChildNodes.item(i);
-                                            QDomElement subjectChild = subjectChildNode.toElement();
-
-                                            if (subjectChild.isNull())
-                                                continue;
-
-                                            if (subjectChild.tagName() == QLatin1String("Category")) {
-                                                // We just created this object, it will not have a category property yet so no need to check if it needs one:
-                                                QtilitiesCategory category;
-                                                category.setExportVersion(exportVersion());
-                                                category.setExportTask(exportTask());
-                                                IExportable::ExportResultFlags category_result = category.importXml(doc,&subjectChild,import_list);
-                                                category.clearExportTask();
-
-                                                if (category_result == IExportable::Incomplete) {
-                                                    LOG_TASK_WARNING(QString(QObject::tr("Failed to import category completely for object in tree node: %1. Item \"%2\" will not have its category set.")).arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                                    result = IExportable::Incomplete;
-                                                } else if (category_result & IExportable::FailedResult) {
-                                                    LOG_TASK_ERROR(QString(QObject::tr("Failed to import category for object in tree node: %1. Item \"%2\" will not have its category set.")).arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                                    result = category_result;
-                                                }
-
-                                                MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
-                                                category_property.setValue(qVariantFromValue(category),observer->observerID());
-                                                if (!ObjectManager::setMultiContextProperty(iface->objectBase(),category_property)) {
-                                                    LOG_TASK_WARNING(QString(QObject::tr("Failed to set category on object \"%1\" to tree node: %2. Import will be incomplete.")).arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                                    result = IExportable::Incomplete;
-                                                }
-                                            }
-                                        }
-
-                                        // Now that we created the item, init its data and children:
-                                        iface->setExportVersion(exportVersion());
-                                        iface->setApplicationExportVersion(applicationExportVersion());
-                                        iface->setExportTask(exportTask());
-
-                                        // Check if it is an observer: if so we must use internal_import_list, not import_list:
+                                        // Set its category, then init its data and children. If it is an observer we must use internal_import_list, not import_list:
                                         Observer* obs = qobject_cast<Observer*> (iface->objectBase());
-                                        IExportable::ExportResultFlags intermediate_result;
-
-                                        if (obs)
-                                            intermediate_result = iface->importXml(doc,&childrenChild,internal_import_list);
-                                        else
-                                            intermediate_result = iface->importXml(doc,&childrenChild,import_list);
-
-                                        if (intermediate_result == IExportable::Incomplete) {
-                                            LOG_TASK_WARNING(QString(QObject::tr("Failed to reconstruct object completely in tree node: %1. Item \"%2\" will be incomplete.")).arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                            result = IExportable::Incomplete;
-                                        } else if (intermediate_result & IExportable::FailedResult) {
-                                            LOG_TASK_ERROR(QString(QObject::tr("Failed to import object in tree node: %1. Item \"%2\" will not be imported.")).arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                            result = intermediate_result;
-                                        }
-
-                                        // Check if it is active:
-                                        if (childrenChild.hasAttribute("Activity")) {
-                                            if (childrenChild.attribute("Activity") == QString("Active"))
-                                                active_subjects << iface->objectBase();
-                                        }
-
-                                        // Get VisitorID if needed:
-                                        if (export_flags & ExportVisitorIDs) {
-                                            if (childrenChild.hasAttribute("VisitorID")) {
-                                                SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,childrenChild.attribute("VisitorID").toInt());
-                                                ObjectManager::setSharedProperty(iface->objectBase(),visitor_id_prop);
-                                            }
-                                        }
-
-                                        iface->clearExportTask();
+                                        IExportable::ExportResultFlags item_result = importSubjectItemXml(observer,iface,doc,&childrenChild,export_flags,obs ? internal_import_list : import_list,active_subjects);
+                                        if (item_result != IExportable::Complete)
+                                            result = item_result;
                                     } else {
                                         LOG_TASK_ERROR(QString(QObject::tr("Found invalid exportable interface on reconstructed object in tree node: %1")).arg(observer->observerName()),exportTask());
                                         observer->endProcessingCycle();
@@ -1253,19 +1655,368 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     observer->endProcessingCycle();
 
     // If active_subjects has items in it we must set them active:
-    if (active_subjects.count() > 0) {
-        for (int i = 0; i < subject_filters.count(); ++i) {
-            ActivityPolicyFilter* activity_filter = qobject_cast<ActivityPolicyFilter*> (subject_filters.at(i));
-            if (activity_filter) {
-                activity_filter->setActiveSubjects(active_subjects,true);
+    restoreActiveSubjects(observer,active_subjects);
+
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importSubjectItemXml(Observer* context, IExportable* iface, QDomDocument* doc, QDomElement* subject_item, ExportItemFlags export_flags, QList<QPointer<QObject> >& import_list, QList<QPointer<QObject> >& active_subjects) const {
+    IExportable::ExportResultFlags result = IExportable::Complete;
+
+    QDomNodeList subjectChildNodes = subject_item->childNodes();
+    for(int i = 0; i < subjectChildNodes.count(); ++i)
+    {
+        QDomNode subjectChildNode = subjectChildNodes.item(i);
+        QDomElement subjectChild = subjectChildNode.toElement();
+
+        if (subjectChild.isNull())
+            continue;
+
+        if (subjectChild.tagName() == QLatin1String("Category")) {
+            // We just created this object, it will not have a category property yet so no need to check if it needs one:
+            QtilitiesCategory category;
+            category.setExportVersion(exportVersion());
+            category.setExportTask(exportTask());
+            IExportable::ExportResultFlags category_result = category.importXml(doc,&subjectChild,import_list);
+            category.clearExportTask();
+
+            if (category_result == IExportable::Incomplete) {
+                LOG_TASK_WARNING(QString(QObject::tr("Failed to import category completely for object in tree node: %1. Item \"%2\" will not have its category set.")).arg(context->observerName()).arg(iface->objectBase()->objectName()),exportTask());
+                result = IExportable::Incomplete;
+            } else if (category_result & IExportable::FailedResult) {
+                LOG_TASK_ERROR(QString(QObject::tr("Failed to import category for object in tree node: %1. Item \"%2\" will not have its category set.")).arg(context->observerName()).arg(iface->objectBase()->objectName()),exportTask());
+                result = category_result;
+            }
+
+            MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+            category_property.setValue(qVariantFromValue(category),context->observerID());
+            if (!ObjectManager::setMultiContextProperty(iface->objectBase(),category_property)) {
+                LOG_TASK_WARNING(QString(QObject::tr("Failed to set category on object \"%1\" to tree node: %2. Import will be incomplete.")).arg(context->observerName()).arg(iface->objectBase()->objectName()),exportTask());
+                result = IExportable::Incomplete;
+            }
+        }
+    }
+
+    // Now that we created the item, init its data and children:
+    iface->setExportVersion(exportVersion());
+    iface->setApplicationExportVersion(applicationExportVersion());
+    iface->setExportTask(exportTask());
+
+    IExportable::ExportResultFlags intermediate_result = iface->importXml(doc,subject_item,import_list);
+    if (intermediate_result == IExportable::Incomplete) {
+        LOG_TASK_WARNING(QString(QObject::tr("Failed to reconstruct object completely in tree node: %1. Item \"%2\" will be incomplete.")).arg(context->observerName()).arg(iface->objectBase()->objectName()),exportTask());
+        result = IExportable::Incomplete;
+    } else if (intermediate_result & IExportable::FailedResult) {
+        LOG_TASK_ERROR(QString(QObject::tr("Failed to import object in tree node: %1. Item \"%2\" will not be imported.")).arg(context->observerName()).arg(iface->objectBase()->objectName()),exportTask());
+        result = intermediate_result;
+    }
+
+    // Check if it is active:
+    if (subject_item->hasAttribute("Activity")) {
+        if (subject_item->attribute("Activity") == QString("Active"))
+            active_subjects << iface->objectBase();
+    }
+
+    // Get VisitorID if needed:
+    if (export_flags & ExportVisitorIDs) {
+        if (subject_item->hasAttribute("VisitorID")) {
+            SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,subject_item->attribute("VisitorID").toInt());
+            ObjectManager::setSharedProperty(iface->objectBase(),visitor_id_prop);
+        }
+    }
+
+    iface->clearExportTask();
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlStream_1_0(QXmlStreamWriter* writer, ExportItemFlags export_flags) const {
+    // The data of this observer, without its subjects:
+    QDomDocument observer_doc("tmp");
+    QDomElement object_node = observer_doc.createElement("tmp");
+    observer_doc.appendChild(object_node);
+    if (exportXmlExt_1_0(&observer_doc,&object_node,export_flags | ExportObserverDataOnly) & IExportable::FailedResult)
+        return IExportable::Failed;
+    writeXmlElementContents(writer,object_node);
+    if (!(export_flags & ExportData))
+        return IExportable::Complete;
+
+    bool complete = true;
+    int exported_count = 0;
+
+    // The observers on the current path through the tree, each with the index of its next subject to export. The Children element
+    // of an observer is only written once it has an exportable subject, the same as exportXmlExt_1_0() does:
+    QVector<QPair<const Observer*,int> > path;
+    QVector<bool> children_written;
+    path.append(qMakePair((const Observer*) observer,0));
+    children_written.append(false);
+    while (!path.isEmpty()) {
+        const Observer* parent = path.last().first;
+        int subject_index = path.last().second;
+        if (subject_index >= parent->subjectCount()) {
+            if (children_written.last())
+                writer->writeEndElement();
+            // Close the TreeItem element of the observer:
+            if (path.count() > 1)
+                writer->writeEndElement();
+            path.pop_back();
+            children_written.pop_back();
+            continue;
+        }
+        ++path.last().second;
+
+        IExportable* export_iface = qobject_cast<IExportable*> (parent->subjectAt(subject_index));
+        if (!export_iface) {
+            complete = false;
+            continue;
+        }
+        if (!children_written.last()) {
+            writer->writeStartElement("Children");
+            children_written.last() = true;
+        }
+        if (!(export_iface->supportedFormats() & IExportable::XML)) {
+            LOG_TASK_WARNING(QObject::tr("XML export found an interface (") + parent->subjectNameInContext(export_iface->objectBase()) + QObject::tr(" in context ") + parent->observerName() + QObject::tr(") which does not support XML exporting. XML export will be incomplete."),exportTask());
+            complete = false;
+            continue;
+        }
+
+        // Only the element of the current subject is built in memory:
+        QDomDocument doc("tmp");
+        QDomElement subject_item = doc.createElement("TreeItem");
+        doc.appendChild(subject_item);
+        if (!exportSubjectItemXml(parent,export_iface,&doc,&subject_item))
+            return IExportable::Failed;
+
+        export_iface->setExportVersion(exportVersion());
+        export_iface->setApplicationExportVersion(applicationExportVersion());
+        export_iface->setExportTask(exportTask());
+
+        IExportable::ExportResultFlags intermediate_result;
+        Observer* obs = qobject_cast<Observer*> (export_iface->objectBase());
+        if (obs) {
+            // Only the data of the observer is added here, its subjects are written once it is on the path:
+            IExportableObserver* export_iface_obs = qobject_cast<IExportableObserver*> (obs->objectBase());
+            Q_ASSERT(export_iface_obs);
+            intermediate_result = export_iface_obs->exportXmlExt(&doc,&subject_item,export_flags | ExportObserverDataOnly);
+        } else {
+            intermediate_result = export_iface->exportXml(&doc,&subject_item);
+        }
+
+        export_iface->clearExportTask();
+
+        if (intermediate_result & IExportable::FailedResult) {
+            LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") failed.",exportTask());
+            return intermediate_result;
+        } else if (intermediate_result == IExportable::Incomplete) {
+            complete = false;
+            LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") is incomplete.",exportTask());
+        }
+
+        writer->writeStartElement("TreeItem");
+        writeXmlElementContents(writer,subject_item);
+        if (obs) {
+            // The TreeItem element of the observer is closed when all its subjects were written:
+            path.append(qMakePair((const Observer*) obs,0));
+            children_written.append(false);
+        } else {
+            writer->writeEndElement();
+        }
+
+        if (++exported_count % STREAMED_PROGRESS_INTERVAL == 0)
+            reportStreamedProgress(STREAMED_PROGRESS_INTERVAL,exported_count);
+    }
+
+    reportStreamedProgress(exported_count % STREAMED_PROGRESS_INTERVAL,exported_count);
+
+    if (writer->hasError()) {
+        LOG_TASK_ERROR(QObject::tr("Xml stream export of observer ") + observer->observerName() + QObject::tr(" failed to write to its device."),exportTask());
+        return IExportable::Failed;
+    }
+
+    if (complete) {
+        LOG_TASK_DEBUG(QObject::tr("Xml stream export of observer ") + observer->observerName() + QString(QObject::tr(" was successful (complete).")),exportTask());
+        return IExportable::Complete;
+    } else {
+        LOG_TASK_DEBUG(QObject::tr("Xml stream export of observer ") + observer->observerName() + QString(QObject::tr(" was successful (incomplete).")),exportTask());
+        return IExportable::Incomplete;
+    }
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importXmlStream_1_0(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    QDomDocument doc("tmp");
+    QDomElement object_node = doc.createElement(reader->qualifiedName().toString());
+    doc.appendChild(object_node);
+    readXmlElementAttributes(reader,&object_node);
+
+    ExportItemFlags export_flags = ExportData;
+    if (object_node.hasAttribute("ExportFlags"))
+        export_flags = (ExportItemFlags) object_node.attribute("ExportFlags").toInt();
+
+    if ((export_flags & ExportRelationalData) || (export_flags & ExportVisitorIDs)) {
+        // Relationships can only be constructed once all subjects were read:
+        if (!readXmlElementContents(reader,&doc,&object_node)) {
+            LOG_TASK_ERROR(QString(QObject::tr("Failed to read XML stream of observer %1 on line %2: %3")).arg(observer->observerName()).arg(reader->lineNumber()).arg(reader->errorString()),exportTask());
+            return IExportable::Failed;
+        }
+        return importXmlExt_1_0(&doc,&object_node,import_list);
+    }
+
+    // Everything except the subjects is read into object_node and imported as soon as the Children element is reached:
+    bool found_children = false;
+    while (reader->readNextStartElement()) {
+        if (reader->name() == QLatin1String("Children")) {
+            found_children = true;
+            break;
+        }
+        QDomElement child = doc.createElement(reader->qualifiedName().toString());
+        object_node.appendChild(child);
+        if (!readXmlElementContents(reader,&doc,&child))
+            break;
+    }
+    if (reader->hasError()) {
+        LOG_TASK_ERROR(QString(QObject::tr("Failed to read XML stream of observer %1 on line %2: %3")).arg(observer->observerName()).arg(reader->lineNumber()).arg(reader->errorString()),exportTask());
+        return IExportable::Failed;
+    }
+
+    IExportable::ExportResultFlags result = importXmlExt_1_0(&doc,&object_node,import_list);
+    if (!found_children || (result & IExportable::FailedResult))
+        return result;
+
+    bool failed = false;
+    int imported_count = 0;
+
+    // The observers on the current path through the tree, each with the subjects which must be set active once all its subjects were read:
+    QVector<QPair<Observer*,QList<QPointer<QObject> > > > path;
+    observer->startProcessingCycle();
+    path.append(qMakePair(observer,QList<QPointer<QObject> >()));
+    while (!path.isEmpty()) {
+        if (!reader->readNextStartElement()) {
+            if (reader->hasError()) {
+                failed = true;
                 break;
             }
+
+            // The end of the Children element of the last observer on the path was reached:
+            Observer* obs = path.last().first;
+            obs->endProcessingCycle();
+            restoreActiveSubjects(obs,path.last().second);
+            path.pop_back();
+
+            // Skip to the end of the element which contained the Children element:
+            while (reader->readNextStartElement())
+                reader->skipCurrentElement();
+            continue;
+        }
+
+        Observer* parent = path.last().first;
+        if (reader->name() != QLatin1String("TreeItem")) {
+            reader->skipCurrentElement();
+            continue;
+        }
+
+        // Only the element of the current subject is built in memory:
+        QDomDocument item_doc("tmp");
+        QDomElement subject_item = item_doc.createElement("TreeItem");
+        item_doc.appendChild(subject_item);
+        readXmlElementAttributes(reader,&subject_item);
+
+        // Construct and init the child:
+        InstanceFactoryInfo instanceFactoryInfo(&item_doc,&subject_item,exportVersion());
+        QObject* obj = 0;
+        if (instanceFactoryInfo.isValid()) {
+            LOG_TASK_TRACE(QString(QObject::tr("Importing subject type \"%1\" in factory \"%2\"...")).arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+            IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
+            if (ifactory)
+                obj = ifactory->createInstance(instanceFactoryInfo);
+        }
+        IExportable* iface = qobject_cast<IExportable*> (obj);
+        if (!iface) {
+            LOG_TASK_WARNING(QString(QObject::tr("Failed to construct subject type \"%1\" in factory \"%2\" for tree node: %3. This item will be skipped and the import will be incomplete.")).arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag).arg(parent->observerName()),exportTask());
+            if (obj)
+                delete obj;
+            result = IExportable::Incomplete;
+            reader->skipCurrentElement();
+            continue;
+        }
+        obj->setObjectName(instanceFactoryInfo.d_instance_name);
+
+        // Attach first before doing import on object:
+        Observer::ObjectOwnership ownership = Observer::ObserverScopeOwnership;
+        if (subject_item.hasAttribute("Ownership"))
+            ownership = Observer::stringToObjectOwnership(subject_item.attribute("Ownership"));
+        QString error_msg;
+        if (!parent->attachSubject(obj,ownership,&error_msg)) {
+            LOG_TASK_WARNING(QString(QObject::tr("Failed to attach reconstructed object \"%1\" to tree node: %2. Import will be incomplete.")).arg(parent->observerName()).arg(error_msg),exportTask());
+            delete obj;
+            result = IExportable::Incomplete;
+            reader->skipCurrentElement();
+            continue;
+        }
+        if (path.count() == 1)
+            import_list << obj;
+
+        Observer* obs = qobject_cast<Observer*> (obj);
+        bool obs_has_children = false;
+        if (obs) {
+            // Everything except the subjects of the observer is read into subject_item, its subjects are read once it is on the path:
+            while (reader->readNextStartElement()) {
+                if (reader->name() == QLatin1String("Children")) {
+                    obs_has_children = true;
+                    break;
+                }
+                QDomElement child = item_doc.createElement(reader->qualifiedName().toString());
+                subject_item.appendChild(child);
+                if (!readXmlElementContents(reader,&item_doc,&child))
+                    break;
+            }
+        } else {
+            readXmlElementContents(reader,&item_doc,&subject_item);
+        }
+        if (reader->hasError()) {
+            failed = true;
+            break;
         }
+
+        QList<QPointer<QObject> > internal_import_list;
+        IExportable::ExportResultFlags item_result = importSubjectItemXml(parent,iface,&item_doc,&subject_item,export_flags,obs ? internal_import_list : import_list,path.last().second);
+        if (item_result != IExportable::Complete)
+            result = item_result;
+
+        if (obs_has_children) {
+            obs->startProcessingCycle();
+            path.append(qMakePair(obs,QList<QPointer<QObject> >()));
+        }
+
+        if (++imported_count % STREAMED_PROGRESS_INTERVAL == 0)
+            reportStreamedProgress(STREAMED_PROGRESS_INTERVAL,imported_count);
+    }
+
+    // End the processing cycles of observers which are still on the path when the import failed:
+    for (int i = 0; i < path.count(); ++i)
+        path.at(i).first->endProcessingCycle();
+
+    if (failed || reader->hasError()) {
+        LOG_TASK_ERROR(QString(QObject::tr("Failed to read XML stream of observer %1 on line %2: %3")).arg(observer->observerName()).arg(reader->lineNumber()).arg(reader->errorString()),exportTask());
+        return IExportable::Failed;
     }
 
+    reportStreamedProgress(imported_count % STREAMED_PROGRESS_INTERVAL,imported_count);
     return result;
 }
 
+void Qtilities::Core::ObserverData::restoreActiveSubjects(Observer* context, const QList<QPointer<QObject> >& active_subjects) {
+    if (active_subjects.isEmpty())
+        return;
+
+    QList<AbstractSubjectFilter*> filters = context->subjectFilters();
+    for (int i = 0; i < filters.count(); ++i) {
+        ActivityPolicyFilter* activity_filter = qobject_cast<ActivityPolicyFilter*> (filters.at(i));
+        if (activity_filter) {
+            activity_filter->setActiveSubjects(active_subjects,true);
+            break;
+        }
+    }
+}
+
 bool Qtilities::Core::ObserverData::constructRelationships(QList<QPointer<QObject> >& objects, ObserverRelationalTable* table) const {
     if (!table)
         return false;
@@ -1532,3 +2283,316 @@ QList<IExportable*> Qtilities::Core::ObserverData::getLimitedExportsList(QList<Q
     //qDebug() << "getLimitedExportsList() on " + observer->observerName() + ": input list count = " + QString::number(objects.count()) + ", exportable list count = " + QString::number(exportable_list.count());
     return exportable_list;
 }
+
+Qtilities::Core::ObserverTreeSnapshot Qtilities::Core::ObserverData::treeSnapshot() {
+    QMutexLocker locker(&tree_snapshot_mutex);
+    if (!tree_snapshot_valid)
+        buildTreeSnapshot();
+    return tree_snapshot;
+}
+
+QObject* Qtilities::Core::ObserverData::treeSnapshotAt(int i) {
+    QMutexLocker locker(&tree_snapshot_mutex);
+    if (!tree_snapshot_valid)
+        buildTreeSnapshot();
+    if (i < 0 || i >= tree_snapshot.objects.count())
+        return 0;
+    return tree_snapshot.objects.at(i);
+}
+
+bool Qtilities::Core::ObserverData::treeSnapshotContains(const QObject* obj) {
+    QMutexLocker locker(&tree_snapshot_mutex);
+    if (!tree_snapshot_valid)
+        buildTreeSnapshot();
+    return tree_snapshot.first_positions.contains(obj);
+}
+
+bool Qtilities::Core::ObserverData::invalidateTreeSnapshot() {
+    QMutexLocker locker(&tree_snapshot_mutex);
+    if (!tree_snapshot_valid)
+        return false;
+
+    tree_snapshot = ObserverTreeSnapshot();
+    tree_snapshot_valid = false;
+    return true;
+}
+
+void Qtilities::Core::ObserverData::buildTreeSnapshot() {
+    // The snapshots of attached observers are reused, thus they are valid whenever this snapshot is valid. Their mutexes
+    // are always locked after the mutexes of the observers above them, thus concurrent builds can't deadlock:
+    ObserverTreeSnapshot snapshot;
+    int count = subject_list.count();
+    for (int i = 0; i < count; ++i) {
+        QObject* obj = subject_list.at(i);
+        int position = snapshot.objects.count();
+        snapshot.objects.append(obj);
+        snapshot.parent_positions.append(-1);
+        snapshot.subtree_ends.append(position + 1);
+
+        Observer* child_obs = qobject_cast<Observer*> (obj);
+        if (!child_obs)
+            continue;
+
+        ObserverTreeSnapshot child_snapshot = child_obs->treeSnapshot();
+        int child_count = child_snapshot.objects.count();
+        int offset = position + 1;
+        for (int c = 0; c < child_count; ++c) {
+            snapshot.objects.append(child_snapshot.objects.at(c));
+            int parent_position = child_snapshot.parent_positions.at(c);
+            snapshot.parent_positions.append(parent_position == -1 ? position : parent_position + offset);
+            snapshot.subtree_ends.append(child_snapshot.subtree_ends.at(c) + offset);
+        }
+        snapshot.subtree_ends[position] = offset + child_count;
+    }
+
+    // Link the occurrences of objects which are reached through more than one parent:
+    int snapshot_count = snapshot.objects.count();
+    snapshot.next_occurrences.fill(-1,snapshot_count);
+    snapshot.first_positions.reserve(snapshot_count);
+    QHash<const QObject*,int> last_positions;
+    for (int i = 0; i < snapshot_count; ++i) {
+        const QObject* obj = snapshot.objects.at(i);
+        QHash<const QObject*,int>::iterator last = last_positions.find(obj);
+        if (last == last_positions.end()) {
+            snapshot.first_positions.insert(obj,i);
+            last_positions.insert(obj,i);
+        } else {
+            snapshot.next_occurrences[last.value()] = i;
+            last.value() = i;
+        }
+    }
+
+    tree_snapshot = snapshot;
+    tree_snapshot_valid = true;
+}
+
+void Qtilities::Core::ObserverData::addSubjectToIndex(QObject* obj, int subject_id, const QString& subject_name) {
+    if (!obj)
+        return;
+
+    SubjectIndexEntry entry;
+    entry.subject_id = subject_id;
+    entry.subject_name = subject_name;
+    subject_index[obj] = entry;
+
+    if (subject_id != -1) {
+        QMutexLocker id_locker(&subject_id_index_mutex);
+        if (subject_id_index_valid)
+            subject_id_index[subject_id] = obj;
+    }
+    subject_name_index.insert(subject_name,obj);
+    subject_name_index_ci.insert(subject_name.toCaseFolded(),obj);
+
+    // Subjects are appended to subject_list, thus appending them to their category keeps the category index in subject order:
+    QMutexLocker category_locker(&category_index_mutex);
+    if (category_index_valid)
+        addSubjectToCategoryIndex(obj);
+}
+
+void Qtilities::Core::ObserverData::removeSubjectFromIndex(const QObject* obj) {
+    if (!subject_index.contains(obj))
+        return;
+
+    SubjectIndexEntry entry = subject_index.take(obj);
+    QObject* non_const_obj = const_cast<QObject*> (obj);
+    if (entry.subject_id != -1) {
+        QMutexLocker id_locker(&subject_id_index_mutex);
+        if (subject_id_index_valid && subject_id_index.value(entry.subject_id) == non_const_obj)
+            subject_id_index.remove(entry.subject_id);
+    }
+    subject_name_index.remove(entry.subject_name,non_const_obj);
+    subject_name_index_ci.remove(entry.subject_name.toCaseFolded(),non_const_obj);
+
+    QMutexLocker category_locker(&category_index_mutex);
+    unmonitored_subjects_mutex.lock();
+    unmonitored_subjects.remove(obj);
+    unmonitored_subjects_mutex.unlock();
+    if (category_index_valid)
+        removeSubjectFromCategoryIndex(obj);
+}
+
+void Qtilities::Core::ObserverData::updateSubjectNameInIndex(QObject* obj, const QString& subject_name) {
+    QHash<const QObject*,SubjectIndexEntry>::iterator itr = subject_index.find(obj);
+    if (itr == subject_index.end())
+        return;
+
+    if (itr.value().subject_name == subject_name)
+        return;
+
+    subject_name_index.remove(itr.value().subject_name,obj);
+    subject_name_index_ci.remove(itr.value().subject_name.toCaseFolded(),obj);
+    itr.value().subject_name = subject_name;
+    subject_name_index.insert(subject_name,obj);
+    subject_name_index_ci.insert(subject_name.toCaseFolded(),obj);
+}
+
+bool Qtilities::Core::ObserverData::subjectNamesMonitored() {
+    #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+    return allSubjectsMonitored();
+    #else
+    return false;
+    #endif
+}
+
+bool Qtilities::Core::ObserverData::allSubjectsMonitored() {
+    QMutexLocker unmonitored_locker(&unmonitored_subjects_mutex);
+    return unmonitored_subjects.isEmpty();
+}
+
+QObject* Qtilities::Core::ObserverData::indexedSubject(int subject_id) {
+    QMutexLocker id_locker(&subject_id_index_mutex);
+    if (!subject_id_index_valid) {
+        subject_id_index.clear();
+        QHash<const QObject*,SubjectIndexEntry>::const_iterator itr;
+        for (itr = subject_index.constBegin(); itr != subject_index.constEnd(); ++itr) {
+            if (itr.value().subject_id != -1)
+                subject_id_index[itr.value().subject_id] = const_cast<QObject*> (itr.key());
+        }
+        subject_id_index_valid = true;
+    }
+    return subject_id_index.value(subject_id,0);
+}
+
+QObject* Qtilities::Core::ObserverData::indexedSubject(const QString& subject_name, Qt::CaseSensitivity cs) const {
+    const QMultiHash<QString,QObject*>& name_index = (cs == Qt::CaseSensitive) ? subject_name_index : subject_name_index_ci;
+    const QString key = (cs == Qt::CaseSensitive) ? subject_name : subject_name.toCaseFolded();
+
+    // Values sharing a key are adjacent in a QMultiHash, ordered from the most recently to the least recently inserted:
+    QMultiHash<QString,QObject*>::const_iterator itr = name_index.constFind(key);
+    if (itr == name_index.constEnd())
+        return 0;
+
+    QObject* match = itr.value();
+    while (++itr != name_index.constEnd() && itr.key() == key)
+        match = itr.value();
+    return match;
+}
+
+void Qtilities::Core::ObserverData::setSubjectMonitored(const QObject* obj, bool monitored) {
+    QMutexLocker category_locker(&category_index_mutex);
+    QMutexLocker unmonitored_locker(&unmonitored_subjects_mutex);
+    if (monitored) {
+        unmonitored_subjects.remove(obj);
+    } else {
+        unmonitored_subjects.insert(obj);
+        category_index_valid = false;
+    }
+}
+
+void Qtilities::Core::ObserverData::ensureCategoryIndex() {
+    if (category_index_valid)
+        return;
+
+    // Build the index in locals first so that it is never published half built:
+    QMap<QtilitiesCategory,QList<QObject*> > new_category_index;
+    QHash<const QObject*,QtilitiesCategory> new_subject_category_index;
+    QSet<const QObject*> new_uncategorized_subjects;
+    int count = subject_list.count();
+    for (int i = 0; i < count; ++i) {
+        QObject* obj = subject_list.at(i);
+        QVariant category_variant = observer->getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
+        QtilitiesCategory category;
+        if (category_variant.isValid())
+            category = category_variant.value<QtilitiesCategory>();
+        else
+            new_uncategorized_subjects.insert(obj);
+        new_category_index[category].append(obj);
+        new_subject_category_index[obj] = category;
+    }
+
+    category_index = new_category_index;
+    subject_category_index = new_subject_category_index;
+    uncategorized_subjects = new_uncategorized_subjects;
+    // Changes to the categories of unmonitored subjects are not seen, thus the index can only be kept when all subjects are monitored:
+    category_index_valid = allSubjectsMonitored();
+}
+
+void Qtilities::Core::ObserverData::updateSubjectCategoryInIndex(QObject* obj) {
+    QMutexLocker category_locker(&category_index_mutex);
+    if (!category_index_valid)
+        return;
+
+    QHash<const QObject*,QtilitiesCategory>::const_iterator itr = subject_category_index.constFind(obj);
+    if (itr == subject_category_index.constEnd())
+        return;
+
+    QVariant category_variant = observer->getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
+    if (category_variant.isValid() != !uncategorized_subjects.contains(obj)) {
+        category_index_valid = false;
+        return;
+    }
+    if (category_variant.isValid() && category_variant.value<QtilitiesCategory>() != itr.value())
+        category_index_valid = false;
+}
+
+QList<QObject*> Qtilities::Core::ObserverData::indexedSubjectsByCategory(const QtilitiesCategory& category) {
+    QMutexLocker category_locker(&category_index_mutex);
+    ensureCategoryIndex();
+    return category_index.value(category);
+}
+
+QList<Qtilities::Core::QtilitiesCategory> Qtilities::Core::ObserverData::indexedCategories() {
+    QMutexLocker category_locker(&category_index_mutex);
+    ensureCategoryIndex();
+    return category_index.keys();
+}
+
+Qtilities::Core::QtilitiesCategory Qtilities::Core::ObserverData::indexedSubjectCategory(const QObject* obj) {
+    QMutexLocker category_locker(&category_index_mutex);
+    ensureCategoryIndex();
+    return subject_category_index.value(obj);
+}
+
+int Qtilities::Core::ObserverData::uncategorizedSubjectCount() {
+    QMutexLocker category_locker(&category_index_mutex);
+    ensureCategoryIndex();
+    return uncategorized_subjects.count();
+}
+
+QMap<Qtilities::Core::QtilitiesCategory,QList<QObject*> > Qtilities::Core::ObserverData::categoryIndex(QSet<const QObject*>* uncategorized) {
+    QMutexLocker category_locker(&category_index_mutex);
+    ensureCategoryIndex();
+    if (uncategorized)
+        *uncategorized = uncategorized_subjects;
+    return category_index;
+}
+
+void Qtilities::Core::ObserverData::addSubjectToCategoryIndex(QObject* obj) {
+    QVariant category_variant = observer->getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
+    QtilitiesCategory category;
+    if (category_variant.isValid())
+        category = category_variant.value<QtilitiesCategory>();
+    else
+        uncategorized_subjects.insert(obj);
+
+    category_index[category].append(obj);
+    subject_category_index[obj] = category;
+}
+
+void Qtilities::Core::ObserverData::removeSubjectFromCategoryIndex(const QObject* obj) {
+    QHash<const QObject*,QtilitiesCategory>::iterator itr = subject_category_index.find(obj);
+    if (itr == subject_category_index.end())
+        return;
+
+    QMap<QtilitiesCategory,QList<QObject*> >::iterator cat_itr = category_index.find(itr.value());
+    if (cat_itr != category_index.end()) {
+        cat_itr.value().removeOne(const_cast<QObject*> (obj));
+        if (cat_itr.value().isEmpty())
+            category_index.erase(cat_itr);
+    }
+    uncategorized_subjects.remove(obj);
+    subject_category_index.erase(itr);
+}
+
+void Qtilities::Core::ObserverData::refreshSubjectFilterProperties() {
+    subject_filter_reserved_properties.clear();
+    subject_filter_monitored_properties.clear();
+    for (int i = 0; i < subject_filters.count(); ++i) {
+        if (!subject_filters.at(i))
+            continue;
+        foreach (const QString& property_name, subject_filters.at(i)->reservedProperties())
+            subject_filter_reserved_properties << property_name.toUtf8();
+        foreach (const QString& property_name, subject_filters.at(i)->monitoredProperties())
+            subject_filter_monitored_properties << property_name.toUtf8();
+    }
+}
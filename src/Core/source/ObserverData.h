@@ -24,14 +24,40 @@
 #include <QObject>
 #include <QMutex>
 #include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QByteArray>
+#include <QVector>
 
 namespace Qtilities {
     namespace Core {
         class ObserverHints;
         class ObserverRelationalTable;
+        class ObserverDataExportTask;
         using namespace Qtilities::Core::Interfaces;
         using namespace Qtilities::Core::Constants;
 
+        /*!
+          \struct ObserverTreeSnapshot
+          \brief The ObserverTreeSnapshot struct holds the flattened tree underneath an observer.
+
+          All containers are implicitly shared, thus snapshots are cheap to copy. See Observer::treeSnapshot().
+
+          <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct ObserverTreeSnapshot {
+            //! The objects in the tree, in the order in which TreeIterator iterates through the tree.
+            QVector<QObject*>           objects;
+            //! The position of the parent through which each object is reached, -1 when it is the observer of the snapshot itself.
+            QVector<int>                parent_positions;
+            //! The position following the tree underneath each object, thus the position of the next object which is not a child of it.
+            QVector<int>                subtree_ends;
+            //! The position at which each object appears again, -1 when it is the last occurrence of the object.
+            QVector<int>                next_occurrences;
+            //! The position at which each object appears first.
+            QHash<const QObject*,int>   first_positions;
+        };
+
         /*!
           \class ObserverData
           \brief The ObserverData class contains data which is shared by different references of the same observer.
@@ -51,12 +77,16 @@ namespace Qtilities {
                 ExportData                  = 1, /*!< Exports all observer data, subjects and their children. */
                 ExportVisitorIDs            = 2, /*!< XML Only: Indicates that VisitorIDs must be added to subject nodes. This is needed when ExportRelationalData is used, and therefore it is automatically enabled in that case.  */
                 ExportRelationalData        = 4, /*!< Indicates that an ObserverRelationalTable must be constructed for the observer and it must be exported with the observer data. During extended imports the relational structure of the tree under your observer will be reconstructed. */
+                ExportStreamed              = 8, /*!< Binary Only: Indicates that subjects must be written depth first while the tree is visited, instead of building an ObserverRelationalTable and gathering all exportable subjects first. Subjects which appear more than once in the tree are written once and referenced afterwards, thus the relational structure of the tree is kept without ExportVisitorIDs and ExportRelationalData, which are ignored when this flag is used. During imports subjects are constructed and attached while they are read. See exportBinaryExt() for more details. <i>This flag was added in %Qtilities v1.5.</i> */
+                ExportObserverDataOnly      = 16, /*!< Used internally by ExportStreamed binary exports and by exportXmlStreamExt() to export the data and subject filters of an observer without its subjects. <i>This flag was added in %Qtilities v1.5.</i> */
+                ExportParallel              = 32, /*!< Binary Only: Indicates that the subtrees of the observers attached to the observer may be exported concurrently. The flag is not written to the export and the output is identical to an export without it. It is ignored when used together with ExportStreamed, ExportVisitorIDs or ExportRelationalData. See exportBinaryExt() for more details. <i>This flag was added in %Qtilities v1.5.</i> */
                 ExportAllItems             = ExportData | ExportVisitorIDs | ExportRelationalData
             };
             Q_DECLARE_FLAGS(ExportItemFlags, ExportItem)
             Q_FLAGS(ExportItemFlags)
 
-            ObserverData(Observer* obs, const QString& observer_name) : subject_limit(-1),
+            ObserverData(Observer* obs, const QString& observer_name) : subject_id_index_valid(true),
+                subject_limit(-1),
                 subject_id_counter(0),
                 filter_subject_events_lock(true),
                 filter_subject_events_enabled(false),
@@ -71,13 +101,22 @@ namespace Qtilities {
                 object_deletion_policy(0),
                 number_of_subjects_start_of_proc_cycle(0),
                 broadcast_modification_state_changes(true),
-                modification_state_start_of_proc_cycle(false)
+                modification_state_start_of_proc_cycle(false),
+                tree_snapshot_valid(false),
+                category_index_valid(false),
+                unfiltered_change_revision(0)
             {
                 subject_list.setObjectName(observer_name);
             }
 
             ObserverData(const ObserverData &other) : subject_list(other.subject_list),
+                subject_index(other.subject_index),
+                subject_id_index_valid(false),
+                subject_name_index(other.subject_name_index),
+                subject_name_index_ci(other.subject_name_index_ci),
                 subject_filters(other.subject_filters),
+                subject_filter_reserved_properties(other.subject_filter_reserved_properties),
+                subject_filter_monitored_properties(other.subject_filter_monitored_properties),
                 subject_limit(other.subject_limit),
                 subject_id_counter(0),
                 filter_subject_events_lock(true),
@@ -95,7 +134,11 @@ namespace Qtilities {
                 object_deletion_policy(other.object_deletion_policy),
                 number_of_subjects_start_of_proc_cycle(0),
                 broadcast_modification_state_changes(true),
-                modification_state_start_of_proc_cycle(false) {}
+                modification_state_start_of_proc_cycle(false),
+                tree_snapshot_valid(false),
+                category_index_valid(false),
+                unmonitored_subjects(other.unmonitored_subjects),
+                unfiltered_change_revision(0) {}
 
             // --------------------------------
             // IObjectBase Implementation
@@ -125,9 +168,50 @@ namespace Qtilities {
             // Extended Access Call Functions From Observer
             // --------------------------------
             //! Extended binary export function.
+            /*!
+              When \p export_flags contains ExportStreamed, the tree underneath the observer is exported in a single depth first pass. Peak memory
+              is bounded by the depth of the tree and the number of subjects which have more than one parent, thus large trees can be exported
+              without building an ObserverRelationalTable first. When an export task was set using setExportTask() and it is busy, progress is
+              reported on the task as subjects are processed, on both exports and imports.
+
+              Streamed exports are read back using the normal importBinary() function. They start with a different marker than other binary exports,
+              thus importers from %Qtilities versions before streamed exports were added reject them instead of misreading them.
+
+              When \p export_flags contains ExportParallel, the subtrees of the observers attached to this observer are exported concurrently
+              on a thread pool into separate buffers which are written to \p stream in the order of the subjects, thus the export is identical
+              to a serial export. Subtrees are only exported concurrently when no subject underneath them is attached to more than one observer,
+              otherwise the export falls back to a serial export. No export task is set on the subtrees which are exported concurrently, progress
+              is reported on the export task of this observer as each subtree is written.
+              */
             IExportable::ExportResultFlags exportBinaryExt(QDataStream& stream, ExportItemFlags export_flags) const;
             //! Extended XML export function.
             IExportable::ExportResultFlags exportXmlExt(QDomDocument* doc, QDomElement* object_node, ExportItemFlags export_flags) const;
+            //! Extended XML stream export function.
+            /*!
+              Writes the same XML as exportXmlExt() directly to \p writer. The tree underneath the observer is written in a single depth first pass,
+              only the data of the observer which is being written is built in memory at any time. When \p export_flags contains ExportRelationalData
+              or ExportVisitorIDs the subjects to export depend on the complete tree, thus the observer is built using exportXmlExt() and then written
+              to \p writer.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            IExportable::ExportResultFlags exportXmlStreamExt(QXmlStreamWriter* writer, ExportItemFlags export_flags) const;
+            //! XML stream import function.
+            /*!
+              Reads XML written by exportXmlExt() or exportXmlStreamExt() from \p reader. Subjects are constructed and attached while their elements
+              are read, thus the complete document is never built in memory. When the input contains relational data the observer's element is read
+              into a QDomDocument and imported using importXml().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
+            //! Checks if any of \p observers or any subject underneath them is attached to more than one observer.
+            /*!
+              Subtrees which do not share subjects can be exported on separate threads, see ExportParallel.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static bool subjectsShared(QList<const Observer*> observers);
 
             // --------------------------------
             // Export Implementations For Different Qtilities Versions
@@ -140,12 +224,137 @@ namespace Qtilities {
 
             //! Construct relationships between a list of objects with the relational data being passed to the function as a RelationalObserverTable.
             bool constructRelationships(QList<QPointer<QObject> >& objects, ObserverRelationalTable* table) const;
+            //! Exports the observer data and subject filter sections of the binary export.
+            IExportable::ExportResultFlags exportObserverSectionBinary(QDataStream& stream, ExportItemFlags export_flags) const;
+            //! Imports the sections exported by exportObserverSectionBinary().
+            IExportable::ExportResultFlags importObserverSectionBinary(QDataStream& stream, ExportItemFlags export_flags, QList<QPointer<QObject> >& import_list);
+            //! The record types used in streamed binary exports.
+            enum StreamedRecord {
+                StreamedSubjectRecord       = 0, /*!< A subject which is exported for the first time. */
+                StreamedReferenceRecord     = 1, /*!< A reference to a subject which was exported earlier in the stream. */
+                StreamedEndRecord           = 2  /*!< Marks the end of the subjects of an observer. */
+            };
+            //! Checks if the observers in \p exportable_list can be exported concurrently when ExportParallel is part of the export flags.
+            /*!
+              Returns true when \p exportable_list contains more than one observer and no subject underneath these observers is attached to more than one observer.
+              */
+            bool parallelExportSupported(const QList<IExportable*>& exportable_list) const;
+            //! Binary export used when ExportStreamed or ExportObserverDataOnly is part of the export flags.
+            IExportable::ExportResultFlags exportBinaryStreamed(QDataStream& stream, ExportItemFlags export_flags) const;
+            //! Imports binary exports created by exportBinaryStreamed().
+            IExportable::ExportResultFlags importBinaryStreamed(QDataStream& stream, ExportItemFlags export_flags, QList<QPointer<QObject> >& import_list);
+            //! Reports \p completed_count more processed subjects on the export task during streamed exports and imports.
+            void reportStreamedProgress(int completed_count, int processed_count) const;
+            //! Adds the category, activity, ownership and factory data of \p export_iface in \p context to \p subject_item.
+            bool exportSubjectItemXml(const Observer* context, IExportable* export_iface, QDomDocument* doc, QDomElement* subject_item) const;
+            //! Imports \p subject_item into \p iface after it was attached to \p context.
+            /*!
+              Sets the category of the subject in \p context, calls importXml() on \p iface and adds the subject to \p active_subjects when it is active.
+              */
+            IExportable::ExportResultFlags importSubjectItemXml(Observer* context, IExportable* iface, QDomDocument* doc, QDomElement* subject_item, ExportItemFlags export_flags, QList<QPointer<QObject> >& import_list, QList<QPointer<QObject> >& active_subjects) const;
+            //! Sets \p active_subjects active in \p context when it has an activity policy filter installed.
+            static void restoreActiveSubjects(Observer* context, const QList<QPointer<QObject> >& active_subjects);
+            //! XML stream export used when neither ExportRelationalData nor ExportVisitorIDs is part of the export flags.
+            IExportable::ExportResultFlags exportXmlStream_1_0(QXmlStreamWriter* writer, ExportItemFlags export_flags) const;
+            //! Imports XML written by exportXmlStream_1_0() and exportXmlExt_1_0() without relational data.
+            IExportable::ExportResultFlags importXmlStream_1_0(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
             //! Creates a list of exportable subjects for cases where ExportRelationalData is enabled.
             /*!
               In this case, we need to make sure objects appearing multiple times in the tree is not exported more than once. This is done using qti_prop_LIMITED_EXPORTS.
               */
             QList<IExportable*> getLimitedExportsList(QList<QObject* > objects, IExportable::ExportMode export_mode, bool * complete = 0) const;
 
+            // --------------------------------
+            // Subject Lookup Index
+            // --------------------------------
+        public:
+            //! Adds a subject to the lookup index used by Observer::subjectReference() and Observer::contains().
+            /*!
+              \param obj The subject which was attached.
+              \param subject_id The ID of the subject in this observer context, thus its qti_prop_OBSERVER_MAP value. Pass -1 when the subject does not have an ID in this context.
+              \param subject_name The name under which the subject must be found.
+              */
+            void addSubjectToIndex(QObject* obj, int subject_id, const QString& subject_name);
+            //! Removes a subject from the lookup index.
+            /*!
+              The object is never dereferenced, thus it is safe to call this function on subjects that are being destroyed.
+              */
+            void removeSubjectFromIndex(const QObject* obj);
+            //! Updates the name under which an indexed subject is found.
+            void updateSubjectNameInIndex(QObject* obj, const QString& subject_name);
+            //! Indicates if the observer is notified of all name changes of its subjects, in which case the names in the lookup index are never stale.
+            /*!
+              This is only the case when all subjects are monitored, see setSubjectMonitored(). On Qt 4, changes to the objectName() of subjects
+              are never notified.
+              */
+            bool subjectNamesMonitored();
+            //! Indicates if the event filter of the observer is installed on all subjects, see setSubjectMonitored().
+            bool allSubjectsMonitored();
+            //! Returns the subject indexed under \p subject_name, or 0 when no subject is indexed under that name.
+            /*!
+              When more than one subject is indexed under the same name, the subject which was indexed under that name first is returned.
+              This is the first of these subjects in subject_list, unless subjects were renamed after they were attached: a renamed subject is
+              indexed under its new name when the rename is seen, thus it is returned after subjects which already had that name.
+              */
+            QObject* indexedSubject(const QString& subject_name, Qt::CaseSensitivity cs) const;
+            //! Returns the subject with ID \p subject_id in this observer context, or 0 when no subject has that ID.
+            /*!
+              Rebuilds subject_id_index from subject_index first when it is not valid.
+              */
+            QObject* indexedSubject(int subject_id);
+            //! Rebuilds subject_filter_reserved_properties and subject_filter_monitored_properties from the installed subject filters.
+            void refreshSubjectFilterProperties();
+
+            // --------------------------------
+            // Subject Category Index
+            // --------------------------------
+        public:
+            //! Indicates if the event filter of the observer is installed on \p obj, and therefore sees changes to its category.
+            /*!
+              The category index is only kept while all subjects are monitored. Subjects living in another thread, and subjects attached
+              while subject event filtering was disabled, are not monitored. While such subjects are attached the index is built again every
+              time it is used.
+              */
+            void setSubjectMonitored(const QObject* obj, bool monitored);
+            //! Updates the category of an indexed subject after its qti_prop_CATEGORY_MAP property changed.
+            /*!
+              Nothing happens when the category of the subject in this observer context did not change, thus changes to the property in
+              other observer contexts are cheap. When it did change the index is marked as invalid in order to keep subjects in the order in
+              which they appear in subject_list.
+              */
+            void updateSubjectCategoryInIndex(QObject* obj);
+            //! Returns the subjects indexed under \p category, in the order in which they appear in subject_list.
+            /*!
+              Subjects which do not have the qti_prop_CATEGORY_MAP property in this context are indexed under an empty category.
+              */
+            QList<QObject*> indexedSubjectsByCategory(const QtilitiesCategory& category);
+            //! Returns the categories in the category index, sorted.
+            QList<QtilitiesCategory> indexedCategories();
+            //! Returns the category under which \p obj is indexed, an empty category when it is not categorized.
+            QtilitiesCategory indexedSubjectCategory(const QObject* obj);
+            //! Returns the number of subjects which do not have the qti_prop_CATEGORY_MAP property in this context.
+            int uncategorizedSubjectCount();
+            //! Returns a copy of the category index, and optionally the subjects without a category in \p uncategorized.
+            QMap<QtilitiesCategory,QList<QObject*> > categoryIndex(QSet<const QObject*>* uncategorized = 0);
+
+            // --------------------------------
+            // Tree Snapshot
+            // --------------------------------
+        public:
+            //! Returns the tree snapshot of the observer, building it first when it is not valid.
+            ObserverTreeSnapshot treeSnapshot();
+            //! Returns the object at position \p i in the tree snapshot of the observer, 0 if \p i is out of range.
+            QObject* treeSnapshotAt(int i);
+            //! Returns true if \p obj is part of the tree snapshot of the observer.
+            bool treeSnapshotContains(const QObject* obj);
+            //! Drops the tree snapshot of the observer.
+            /*!
+              Called by the observer on itself and on all observers above it whenever a subject is attached or detached.
+
+              \return True if a valid snapshot was dropped.
+              */
+            bool invalidateTreeSnapshot();
+
             // --------------------------------
             // All Data Stored For An Observer
             // --------------------------------
@@ -156,7 +365,31 @@ namespace Qtilities {
               Used to optimize performance.
               */
             PointerList                         subject_observer_list;
+            //! Index entry stored for every subject in subject_index.
+            /*!
+              The entry keeps the key values under which the subject was indexed, which allows removal from the index without accessing the subject itself.
+              */
+            struct SubjectIndexEntry {
+                int     subject_id;
+                QString subject_name;
+            };
+            //! Lookup index of all subjects in subject_list. Used as the pointer set behind Observer::contains().
+            QHash<const QObject*,SubjectIndexEntry> subject_index;
+            //! Maps subject IDs in this context to subjects. Use indexedSubject(int) to access it, it is rebuilt from subject_index when it is not valid.
+            QHash<int,QObject*>                 subject_id_index;
+            //! Indicates if subject_id_index is valid. Copies of ObserverData do not copy subject_id_index, they rebuild it the first time it is used.
+            bool                                subject_id_index_valid;
+            //! Protects subject_id_index, which is rebuilt lazily by const functions on Observer.
+            QMutex                              subject_id_index_mutex;
+            //! Maps subject names to subjects, used for case sensitive name lookups.
+            QMultiHash<QString,QObject*>        subject_name_index;
+            //! Maps case folded subject names to subjects, used for case insensitive name lookups.
+            QMultiHash<QString,QObject*>        subject_name_index_ci;
             QList<AbstractSubjectFilter*>       subject_filters;
+            //! The reserved properties of all installed subject filters. Updated when filters are installed or uninstalled.
+            QSet<QByteArray>                    subject_filter_reserved_properties;
+            //! The monitored properties of all installed subject filters. Updated when filters are installed or uninstalled.
+            QSet<QByteArray>                    subject_filter_monitored_properties;
             int                                 subject_limit;
             int                                 subject_id_counter;
             int                                 observer_id;
@@ -188,6 +421,50 @@ namespace Qtilities {
             bool                                broadcast_modification_state_changes;
             //! Used during processing cycles to store the modification state of the observer when a processing cycle is started. When different when the processing cycle is stopped, only then will it emit that the modification state changed.
             bool                                modification_state_start_of_proc_cycle;
+            //! The flattened tree underneath the observer, see Observer::treeSnapshot().
+            ObserverTreeSnapshot                tree_snapshot;
+            //! Indicates if tree_snapshot is valid. A valid snapshot implies valid snapshots on all observers underneath the observer.
+            bool                                tree_snapshot_valid;
+            //! Protects the tree snapshot, which is built lazily by const functions on Observer which can be called from worker threads. It does not protect subject_list, see buildTreeSnapshot().
+            QMutex                              tree_snapshot_mutex;
+            //! Cached tree counts of the observer, keyed on the base class name passed to Observer::treeCount().
+            QHash<QString,int>                  tree_count_cache;
+            //! Maps categories to the subjects in that category. Subjects without a category are indexed under an empty category.
+            QMap<QtilitiesCategory,QList<QObject*> > category_index;
+            //! The category under which each subject is indexed in category_index.
+            QHash<const QObject*,QtilitiesCategory> subject_category_index;
+            //! The subjects in category_index which do not have the qti_prop_CATEGORY_MAP property in this context.
+            QSet<const QObject*>                uncategorized_subjects;
+            //! Indicates if category_index, subject_category_index and uncategorized_subjects are valid.
+            bool                                category_index_valid;
+            //! The subjects on which the event filter of the observer is not installed, see setSubjectMonitored().
+            QSet<const QObject*>                unmonitored_subjects;
+            //! Protects unmonitored_subjects. When both are needed, category_index_mutex is locked first.
+            QMutex                              unmonitored_subjects_mutex;
+            //! Protects the category index, which is built lazily by const functions on Observer which can be called from worker threads.
+            QMutex                              category_index_mutex;
+            //! Incremented when a property of a subject changes while subject event filtering is disabled, see Observer::unfilteredSubjectChangeRevision().
+            int                                 unfiltered_change_revision;
+
+        private:
+            //! Builds the category index from the qti_prop_CATEGORY_MAP properties of all subjects when it is not valid. Must be called with category_index_mutex locked.
+            /*!
+              The index is built in local containers which replace the current index once they are complete. The index is marked as valid
+              only when all subjects are monitored, from then on it is kept up to date by addSubjectToIndex(), removeSubjectFromIndex() and
+              updateSubjectCategoryInIndex().
+              */
+            void ensureCategoryIndex();
+            //! Adds a subject to the category index using its current qti_prop_CATEGORY_MAP property.
+            void addSubjectToCategoryIndex(QObject* obj);
+            //! Removes a subject from the category index without accessing the subject itself.
+            void removeSubjectFromCategoryIndex(const QObject* obj);
+            //! Builds tree_snapshot from the subjects of the observer and the snapshots of the observers attached to it. Must be called with tree_snapshot_mutex locked.
+            /*!
+              subject_list is read without locking observer_mutex: the list is changed outside of observer_mutex and the observer emits signals
+              while holding it, thus locking it here would deadlock when a view builds the snapshot in response. Concurrent builds are therefore
+              only safe while the tree is not changed, as documented on Observer::treeSnapshot().
+              */
+            void buildTreeSnapshot();
         };
 
         Q_DECLARE_OPERATORS_FOR_FLAGS(ObserverData::ExportItemFlags)
@@ -11,6 +11,8 @@
 
 #include "PointerList.h"
 
+#include <QSet>
+
 Qtilities::Core::PointerList::PointerList(bool cleanup_when_done, QObject *parent) : PointerListDeleter() {
     Q_UNUSED(parent)
 
@@ -54,6 +56,29 @@ void Qtilities::Core::PointerList::removeOne(QObject* obj) {
     list.removeOne(obj);
 }
 
+void Qtilities::Core::PointerList::removeObjects(const QList<QObject*>& objects) {
+    if (objects.isEmpty())
+        return;
+
+    QSet<QObject*> remove_set;
+    for (int i = 0; i < objects.count(); ++i) {
+        QObject::disconnect(objects.at(i), SIGNAL(destroyed(QObject *)), this, SLOT(removeSender()));
+        remove_set.insert(objects.at(i));
+    }
+
+    QList<QObject*> remaining;
+    remaining.reserve(list.count());
+    for (int i = 0; i < list.count(); ++i) {
+        if (!remove_set.contains(list.at(i)))
+            remaining.append(list.at(i));
+    }
+    list = remaining;
+}
+
+void Qtilities::Core::PointerList::reserve(int size) {
+    list.reserve(size);
+}
+
 void Qtilities::Core::PointerList::addThisObject(QObject * obj) {
     QObject::connect(obj, SIGNAL(destroyed(QObject *)), this, SLOT(removeSender()));
 }
@@ -97,6 +97,16 @@ test_list: Delete object test2 during destruction of test_list. Deleting it will
             void deleteAll();
             int count() const;
             void removeOne(QObject* obj);
+            //! Removes all the given objects from the list with a single pass over the list.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeObjects(const QList<QObject*>& objects);
+            //! Reserves space for \p size objects in the list.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void reserve(int size);
             QObject* at(int i) const;
             QMutableListIterator<QObject*> iterator();
             QList<QObject*> toQList() const;
@@ -0,0 +1,205 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ProcessBufferSplitter.h"
+
+#include <QVector>
+
+#include <string.h>
+
+struct Qtilities::Core::ProcessBufferSplitterPrivateData {
+    ProcessBufferSplitterPrivateData() : message_start(0),
+        scan_position(0) {
+        for (int i = 0; i < 256; ++i)
+            first_byte_index[i] = -1;
+    }
+
+    //! The delimiters, sorted by first byte and then from longest to shortest.
+    QList<QByteArray>   delimiters;
+    QList<bool>         keep_delimiter;
+    //! The index of the first delimiter in delimiters starting with a byte, -1 if no delimiter starts with the byte.
+    int                 first_byte_index[256];
+
+    QByteArray          buffer;
+    //! The start of the incomplete message in buffer.
+    int                 message_start;
+    //! The position in buffer from where the next scan starts.
+    int                 scan_position;
+    QVector<int>        message_starts;
+    QVector<int>        message_lengths;
+};
+
+Qtilities::Core::ProcessBufferSplitter::ProcessBufferSplitter() {
+    d = new ProcessBufferSplitterPrivateData;
+    addSeparator("\n");
+}
+
+Qtilities::Core::ProcessBufferSplitter::~ProcessBufferSplitter() {
+    delete d;
+}
+
+void Qtilities::Core::ProcessBufferSplitter::clearDelimiters() {
+    d->delimiters.clear();
+    d->keep_delimiter.clear();
+    for (int i = 0; i < 256; ++i)
+        d->first_byte_index[i] = -1;
+}
+
+void Qtilities::Core::ProcessBufferSplitter::addSeparator(const QByteArray& separator) {
+    addDelimiter(separator,false);
+}
+
+void Qtilities::Core::ProcessBufferSplitter::addMessageStart(const QByteArray& message_start) {
+    addDelimiter(message_start,true);
+}
+
+void Qtilities::Core::ProcessBufferSplitter::setLineBreakStrings(const QStringList& line_break_strings) {
+    clearDelimiters();
+    addSeparator("\n");
+    foreach (const QString& line_break_string, line_break_strings)
+        addMessageStart(line_break_string.toUtf8());
+}
+
+void Qtilities::Core::ProcessBufferSplitter::addDelimiter(const QByteArray& delimiter, bool keep_in_message) {
+    if (delimiter.isEmpty() || d->delimiters.contains(delimiter))
+        return;
+
+    // Keep delimiters with the same first byte together, longest first, so that scan() only has to look at one run:
+    int insert_at = 0;
+    while (insert_at < d->delimiters.count()) {
+        const QByteArray& current = d->delimiters.at(insert_at);
+        if ((uchar) current.at(0) == (uchar) delimiter.at(0) && current.size() < delimiter.size())
+            break;
+        if ((uchar) current.at(0) > (uchar) delimiter.at(0))
+            break;
+        ++insert_at;
+    }
+    d->delimiters.insert(insert_at,delimiter);
+    d->keep_delimiter.insert(insert_at,keep_in_message);
+
+    for (int i = 0; i < 256; ++i)
+        d->first_byte_index[i] = -1;
+    for (int i = d->delimiters.count() - 1; i >= 0; --i)
+        d->first_byte_index[(uchar) d->delimiters.at(i).at(0)] = i;
+}
+
+void Qtilities::Core::ProcessBufferSplitter::append(const QByteArray& data) {
+    append(data.constData(),data.size());
+}
+
+void Qtilities::Core::ProcessBufferSplitter::append(const char* data, int length) {
+    if (length <= 0)
+        return;
+
+    d->buffer.append(data,length);
+    scan();
+}
+
+void Qtilities::Core::ProcessBufferSplitter::scan() {
+    const char* data = d->buffer.constData();
+    const int size = d->buffer.size();
+    int position = d->scan_position;
+
+    while (position < size) {
+        int delimiter_index = d->first_byte_index[(uchar) data[position]];
+        if (delimiter_index == -1) {
+            ++position;
+            continue;
+        }
+
+        // Check all delimiters starting with this byte, longest first:
+        const uchar first_byte = (uchar) data[position];
+        bool matched = false;
+        while (delimiter_index < d->delimiters.count() && (uchar) d->delimiters.at(delimiter_index).at(0) == first_byte) {
+            const QByteArray& delimiter = d->delimiters.at(delimiter_index);
+            const int available = size - position;
+            if (available < delimiter.size()) {
+                // The delimiter might be completed by the next chunk, thus we wait for more data before deciding:
+                if (memcmp(data + position,delimiter.constData(),available) == 0) {
+                    d->scan_position = position;
+                    return;
+                }
+            } else if (memcmp(data + position,delimiter.constData(),delimiter.size()) == 0) {
+                addMessage(d->message_start,position);
+                d->message_start = d->keep_delimiter.at(delimiter_index) ? position : position + delimiter.size();
+                position += delimiter.size();
+                matched = true;
+                break;
+            }
+            ++delimiter_index;
+        }
+
+        if (!matched)
+            ++position;
+    }
+
+    d->scan_position = position;
+}
+
+void Qtilities::Core::ProcessBufferSplitter::addMessage(int start, int end) {
+    d->message_starts.append(start);
+    d->message_lengths.append(end - start);
+}
+
+void Qtilities::Core::ProcessBufferSplitter::flush() {
+    if (d->message_start >= d->buffer.size())
+        return;
+
+    addMessage(d->message_start,d->buffer.size());
+    d->message_start = d->buffer.size();
+    d->scan_position = d->buffer.size();
+}
+
+int Qtilities::Core::ProcessBufferSplitter::messageCount() const {
+    return d->message_starts.count();
+}
+
+const char* Qtilities::Core::ProcessBufferSplitter::messageData(int index) const {
+    if (index < 0 || index >= d->message_starts.count())
+        return 0;
+    return d->buffer.constData() + d->message_starts.at(index);
+}
+
+int Qtilities::Core::ProcessBufferSplitter::messageLength(int index) const {
+    if (index < 0 || index >= d->message_lengths.count())
+        return 0;
+    return d->message_lengths.at(index);
+}
+
+QString Qtilities::Core::ProcessBufferSplitter::message(int index) const {
+    if (index < 0 || index >= d->message_starts.count())
+        return QString();
+    return QString::fromUtf8(d->buffer.constData() + d->message_starts.at(index),d->message_lengths.at(index));
+}
+
+void Qtilities::Core::ProcessBufferSplitter::clearMessages() {
+    d->message_starts.clear();
+    d->message_lengths.clear();
+
+    // Only the incomplete message is moved to the front of the buffer, thus the cost depends on its size only:
+    if (d->message_start > 0) {
+        d->buffer.remove(0,d->message_start);
+        d->scan_position -= d->message_start;
+        d->message_start = 0;
+    }
+}
+
+QByteArray Qtilities::Core::ProcessBufferSplitter::remainder() const {
+    return d->buffer.mid(d->message_start);
+}
+
+void Qtilities::Core::ProcessBufferSplitter::reset() {
+    d->buffer.clear();
+    d->message_start = 0;
+    d->scan_position = 0;
+    d->message_starts.clear();
+    d->message_lengths.clear();
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef PROCESS_BUFFER_SPLITTER_H
+#define PROCESS_BUFFER_SPLITTER_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \struct ProcessBufferSplitterPrivateData
+        \brief Structure used by ProcessBufferSplitter to store private data.
+          */
+        struct ProcessBufferSplitterPrivateData;
+
+        /*!
+        \class ProcessBufferSplitter
+        \brief The ProcessBufferSplitter class splits a stream of raw process output into individual messages.
+
+        Data is passed to the splitter in chunks as it becomes available using append(). Every byte is scanned only once:
+        all delimiters are matched in a single pass using a lookup table on the first byte of the delimiters, and scanning
+        resumes where the previous append() stopped. Delimiters which are split across two chunks are handled correctly.
+
+        The complete messages found are exposed as views into the internal buffer through messageData() and messageLength(),
+        thus no copies are made until a message is converted to a QString using message(). Once the messages have been
+        handled, clearMessages() removes them from the buffer, leaving only the incomplete message at the end of the stream.
+
+        Two kinds of delimiters are supported:
+        - Separators, for example the new line character, which are not part of any message.
+        - Message starts, for example "ERROR:", which start a new message and which are kept at the start of that message.
+
+        When a position in the stream matches multiple delimiters, the longest delimiter is used.
+
+\code
+ProcessBufferSplitter splitter;
+splitter.append(process->readAllStandardOutput());
+for (int i = 0; i < splitter.messageCount(); ++i)
+    handleMessage(splitter.message(i));
+splitter.clearMessages();
+\endcode
+
+        This class is used by QtilitiesProcess to split process buffers, see \ref qtilities_process_buffering.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT ProcessBufferSplitter
+        {
+        public:
+            //! Constructs a splitter which splits messages on the new line character.
+            ProcessBufferSplitter();
+            ~ProcessBufferSplitter();
+
+            //! Removes all delimiters. Must not be called while the splitter holds complete messages.
+            void clearDelimiters();
+            //! Adds a delimiter which separates messages and which is not part of any message.
+            void addSeparator(const QByteArray& separator);
+            //! Adds a delimiter which starts a new message and which is kept at the start of that message.
+            void addMessageStart(const QByteArray& message_start);
+            //! Convenience function which sets up the delimiters used by QtilitiesProcess.
+            /*!
+              The new line character is used as separator and each string in \p line_break_strings is used as a message start.
+              */
+            void setLineBreakStrings(const QStringList& line_break_strings);
+
+            //! Appends new data to the stream and finds all messages completed by it.
+            void append(const QByteArray& data);
+            //! Appends new data to the stream and finds all messages completed by it.
+            void append(const char* data, int length);
+            //! Marks the incomplete message at the end of the stream as complete. Use this when the stream ends.
+            /*!
+              Nothing is done when the incomplete message is empty.
+              */
+            void flush();
+
+            //! Returns the number of complete messages found since the last call to clearMessages().
+            int messageCount() const;
+            //! Returns a pointer to the data of the complete message at \p index. The data is not null terminated.
+            /*!
+              The pointer is valid until the next call to append(), flush() or clearMessages().
+              */
+            const char* messageData(int index) const;
+            //! Returns the length of the complete message at \p index in bytes.
+            int messageLength(int index) const;
+            //! Returns the complete message at \p index converted from UTF-8.
+            QString message(int index) const;
+
+            //! Removes all complete messages from the buffer.
+            void clearMessages();
+            //! Returns the data of the incomplete message at the end of the stream.
+            QByteArray remainder() const;
+            //! Clears all messages and the buffer. The delimiters are not changed.
+            void reset();
+
+        private:
+            Q_DISABLE_COPY(ProcessBufferSplitter)
+
+            void addDelimiter(const QByteArray& delimiter, bool keep_in_message);
+            void scan();
+            void addMessage(int start, int end);
+
+            ProcessBufferSplitterPrivateData* d;
+        };
+    }
+}
+
+#endif // PROCESS_BUFFER_SPLITTER_H
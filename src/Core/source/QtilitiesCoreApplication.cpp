@@ -48,6 +48,10 @@ Qtilities::Core::Interfaces::TaskManager* Qtilities::Core::QtilitiesCoreApplicat
     return QtilitiesCoreApplicationPrivate::instance()->taskManager();
 }
 
+Qtilities::Core::TaskExecutor* Qtilities::Core::QtilitiesCoreApplication::taskExecutor() {
+    return QtilitiesCoreApplicationPrivate::instance()->taskExecutor();
+}
+
 QString Qtilities::Core::QtilitiesCoreApplication::qtilitiesVersionString() {
     return QtilitiesCoreApplicationPrivate::instance()->qtilitiesVersionString();
 }
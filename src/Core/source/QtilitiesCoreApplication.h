@@ -17,6 +17,7 @@
 #include "ContextManager.h"
 #include "VersionInformation.h"
 #include "TaskManager.h"
+#include "TaskExecutor.h"
 
 #include <Logger>
 
@@ -71,6 +72,13 @@ namespace Qtilities {
               This function is thread-safe.
               */
             static TaskManager* taskManager();
+            //! Returns a reference to the application wide task executor.
+            /*!
+              This function is thread-safe.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static TaskExecutor* taskExecutor();
 
             //! Returns a reference to the QtilitiesCoreApplication instance.
             /*!
@@ -197,5 +205,6 @@ QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::
 #define OBJECT_MANAGER ((Qtilities::Core::QtilitiesCoreApplication *) QCoreApplication::instance())->objectManager()
 #define CONTEXT_MANAGER ((Qtilities::Core::QtilitiesCoreApplication *) QCoreApplication::instance())->contextManager()
 #define TASK_MANAGER ((Qtilities::Core::QtilitiesCoreApplication *) QCoreApplication::instance())->taskManager()
+#define TASK_EXECUTOR ((Qtilities::Core::QtilitiesCoreApplication *) QCoreApplication::instance())->taskExecutor()
 
 #endif // QTILITIES_CORE_H
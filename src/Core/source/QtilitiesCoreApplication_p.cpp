@@ -56,6 +56,9 @@ Qtilities::Core::QtilitiesCoreApplicationPrivate::QtilitiesCoreApplicationPrivat
     QObject::connect(d_objectManager,SIGNAL(newObjectAdded(QObject*)),d_taskManager,SLOT(addTask(QObject*)));
     QObject::connect(d_objectManager,SIGNAL(objectRemoved(QObject*)),d_taskManager,SLOT(removeTask(QObject*)));
 
+    // Task Executor
+    d_taskExecutor = new TaskExecutor;
+
     // Register QList<QPointer<QObject> > in Meta Object System.
     qRegisterMetaType<QList<QPointer<QObject> > >("QList<QPointer<QObject> >");
 
@@ -90,6 +93,10 @@ Qtilities::Core::Interfaces::TaskManager* Qtilities::Core::QtilitiesCoreApplicat
     return d_taskManager;
 }
 
+Qtilities::Core::TaskExecutor* Qtilities::Core::QtilitiesCoreApplicationPrivate::taskExecutor() const {
+    return d_taskExecutor;
+}
+
 QString Qtilities::Core::QtilitiesCoreApplicationPrivate::qtilitiesVersionString() const {
     QString version_string;
     if (qti_def_VERSION_BETA != 0)
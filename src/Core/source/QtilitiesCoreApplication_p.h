@@ -16,6 +16,7 @@
 #include "ObjectManager.h"
 #include "ContextManager.h"
 #include "TaskManager.h"
+#include "TaskExecutor.h"
 #include "VersionInformation.h"
 
 #include <QObject>
@@ -41,6 +42,8 @@ namespace Qtilities {
             Qtilities::Core::Interfaces::IContextManager* contextManager() const;
             //! Function to access task manager pointer.
             Qtilities::Core::TaskManager* taskManager() const;          
+            //! Function to access task executor pointer.
+            Qtilities::Core::TaskExecutor* taskExecutor() const;
             //! Returns the version string of %Qtilities as a QString.
             /*!
               \return The version of %Qtilities, for example: 0.1 Beta 1. Note that the v is not part of the returned string.
@@ -116,6 +119,7 @@ QString("%1%2").arg(QCoreApplication::applicationDirPath()).arg(Qtilities::Loggi
             ContextManager*     d_contextManager;
             IContextManager*    d_contextManagerIFace;
             TaskManager*        d_taskManager;
+            TaskExecutor*       d_taskExecutor;
             QString             d_application_session_path;
             VersionNumber       d_version_number;
             quint32             d_application_export_version;
@@ -10,10 +10,12 @@
 ****************************************************************************/
 
 #include "QtilitiesProcess.h"
+#include "ProcessBufferSplitter.h"
 
 #include <QCoreApplication>
 #include <FileUtils>
 #include <QRegExp>
+#include <QMutexLocker>
 
 #include <Logger>
 
@@ -23,8 +25,8 @@ struct Qtilities::Core::QtilitiesProcessPrivateData {
     QtilitiesProcessPrivateData() : process(0) { }
 
     QProcess* process;
-    QString buffer_std_out;
-    QString buffer_std_error;
+    ProcessBufferSplitter buffer_std_out;
+    ProcessBufferSplitter buffer_std_error;
     QStringList line_break_strings;
     QString default_qprocess_error_string;
     QList<ProcessBufferMessageTypeHint> buffer_message_type_hints;
@@ -68,7 +70,12 @@ QProcess* Qtilities::Core::QtilitiesProcess::process() {
 }
 
 void Qtilities::Core::QtilitiesProcess::setLineBreakStrings(const QStringList &line_break_strings) {
+    QMutexLocker locker_std_out(&d->buffer_mutex_std_out);
+    QMutexLocker locker_std_err(&d->buffer_mutex_std_err);
+
     d->line_break_strings = line_break_strings;
+    d->buffer_std_out.setLineBreakStrings(line_break_strings);
+    d->buffer_std_error.setLineBreakStrings(line_break_strings);
 }
 
 QStringList Qtilities::Core::QtilitiesProcess::lineBreakStrings() {
@@ -116,6 +123,10 @@ bool Qtilities::Core::QtilitiesProcess::startProcess(const QString& program,
     logMessage("");
     d->process->start(native_program, arguments, mode);
 
+    // Failures to start are reported through procStateChanged(), which completes the task:
+    if (wait_for_started_msecs == 0)
+        return true;
+
     if (!d->process->waitForStarted(wait_for_started_msecs)) {
         logMessage("Failed to start " + native_program + ". Make sure the executable is visible in your system's paths.", Logger::Error);
         if (state() == ITask::TaskBusy)
@@ -205,103 +216,39 @@ void Qtilities::Core::QtilitiesProcess::procStateChanged(QProcess::ProcessState
 }
 
 void Qtilities::Core::QtilitiesProcess::logProgressOutput() {
-    QString new_output = d->process->readAllStandardOutput();
+    QByteArray new_output = d->process->readAllStandardOutput();
     if (new_output.isEmpty())
         return;
 
-    d->buffer_mutex_std_out.lock();
+    QMutexLocker locker(&d->buffer_mutex_std_out);
 
     //qDebug() << Q_FUNC_INFO << new_output;
-    emit newStandardOutputMessage(new_output);
-    d->buffer_std_out.append(new_output);
+    if (receivers(SIGNAL(newStandardOutputMessage(QString))) > 0)
+        emit newStandardOutputMessage(QString::fromUtf8(new_output.constData(),new_output.size()));
 
-    if (d->buffer_std_out.isEmpty()) {
-        d->buffer_mutex_std_out.unlock();
-        return;
-    }
-
-    QStringList split_list;
-    if (d->line_break_strings.isEmpty()) {
-        // We search for \n and split messages up:
-        split_list = d->buffer_std_out.split("\n");
-        while (split_list.count() > 1) {
-            processSingleBufferMessage(split_list.front().simplified());
-            split_list.pop_front();
-        }
-    } else {
-        // We loop through the string and replace all known break strings with &{_BREAKSTRING and then split
-        // it using &{_:
-        d->line_break_strings.append("\n");
-        foreach (const QString& break_string, d->line_break_strings)
-            d->buffer_std_out.replace(break_string,"&{_" + break_string);
-
-        split_list = d->buffer_std_out.split("&{_");
-        while (split_list.count() > 1) {
-            QString msg = split_list.front().simplified();
-            if (msg.startsWith("&{_"))
-                msg = msg.remove(0,3);
-
-            processSingleBufferMessage(msg);
-            split_list.pop_front();
-        }
-    }
-
-    if (split_list.isEmpty())
-        d->buffer_std_out.clear();
-    else
-        d->buffer_std_out = split_list.front();
-
-    d->buffer_mutex_std_out.unlock();
+    d->buffer_std_out.append(new_output);
+    processBufferMessages(d->buffer_std_out);
 }
 
 void Qtilities::Core::QtilitiesProcess::logProgressError() {   
-    QString new_output = d->process->readAllStandardError();
+    QByteArray new_output = d->process->readAllStandardError();
     if (new_output.isEmpty())
         return;
 
-    d->buffer_mutex_std_err.lock();
+    QMutexLocker locker(&d->buffer_mutex_std_err);
 
     //qDebug() << Q_FUNC_INFO << new_output;
-    emit newStandardErrorMessage(new_output);
-    d->buffer_std_error.append(new_output);
+    if (receivers(SIGNAL(newStandardErrorMessage(QString))) > 0)
+        emit newStandardErrorMessage(QString::fromUtf8(new_output.constData(),new_output.size()));
 
-    if (d->buffer_std_error.isEmpty()) {
-        d->buffer_mutex_std_err.unlock();
-        return;
-    }
-
-    QStringList split_list;
-    if (d->line_break_strings.isEmpty()) {
-        // We search for \n and split messages up:
-        split_list = d->buffer_std_error.split("\n");
-        while (split_list.count() > 1) {
-            processSingleBufferMessage(split_list.front().simplified());
-            split_list.pop_front();
-        }
-    } else { 
-        // We loop through the string and replace all known break strings with &{_BREAKSTRING and then split
-        // it using &{_:
-        d->line_break_strings.append("\n");
-        foreach (const QString& break_string, d->line_break_strings)
-            d->buffer_std_error.replace(break_string,"&{_" + break_string);
-
-        split_list = d->buffer_std_error.split("&{_");
-        while (split_list.count() > 1) {
-            QString msg = split_list.front().simplified();
-            if (msg.startsWith("&{_"))
-                msg = msg.remove(0,3);
-
-            processSingleBufferMessage(msg);
-            split_list.pop_front();
-        }
-    }
-
-    if (split_list.isEmpty())
-        d->buffer_std_error.clear();
-    else
-        d->buffer_std_error = split_list.front();
+    d->buffer_std_error.append(new_output);
+    processBufferMessages(d->buffer_std_error);
+}
 
-    d->buffer_mutex_std_err.unlock();
+void Qtilities::Core::QtilitiesProcess::processBufferMessages(ProcessBufferSplitter& splitter) {
+    for (int i = 0; i < splitter.messageCount(); ++i)
+        processSingleBufferMessage(splitter.message(i).simplified());
+    splitter.clearMessages();
 }
 
 void Qtilities::Core::QtilitiesProcess::processSingleBufferMessage(const QString &buffer_message) {
@@ -337,10 +284,17 @@ void Qtilities::Core::QtilitiesProcess::processSingleBufferMessage(const QString
 
 void Qtilities::Core::QtilitiesProcess::completeTaskExt() {
     // We need to make sure the process buffer is clean:
-    d->buffer_std_out.append("\n");
     logProgressOutput();
-    d->buffer_std_error.append("\n");
+    d->buffer_mutex_std_out.lock();
+    d->buffer_std_out.flush();
+    processBufferMessages(d->buffer_std_out);
+    d->buffer_mutex_std_out.unlock();
+
     logProgressError();
+    d->buffer_mutex_std_err.lock();
+    d->buffer_std_error.flush();
+    processBufferMessages(d->buffer_std_error);
+    d->buffer_mutex_std_err.unlock();
 
     // Now we can complete the task.
     completeTask();
@@ -78,6 +78,7 @@ namespace Qtilities {
         \brief Structure used by QtilitiesProcess to store private data.
           */
         struct QtilitiesProcessPrivateData;
+        class ProcessBufferSplitter;
 
         /*!
         \class QtilitiesProcess
@@ -114,7 +115,7 @@ namespace Qtilities {
         proper logging of process messages in more complicated situations.
 
         During default buffer processing, the process buffer is split into individual messages using a search for the
-        new line character ("\n"). The text in the QStringList resulting from the split is then handled as individual messages.
+        new line character ("\n"). Each resulting line is then handled as an individual message.
         By default these individual messages are logged as normal info messages. However, using setProcessBufferMessageTypeHint() it
         is possible to classify these individual messages as different types of messages. For example, if the backend process
         starts error messages with "ERROR:", it is possible to add a process buffer message type hint using
@@ -141,6 +142,9 @@ my_process.addProcessBufferMessageTypeHint(message_hint_error);
         must start with a known string, warnings with another known string and errors with another known string. These known
         strings can be set as the line break strings on the QtilitiesProcess and all text between these known strings will be logged
         as individual messages.
+
+        The process buffers are split using a ProcessBufferSplitter, which scans the raw process output once as it arrives. The cost
+        of processing therefore only depends on the amount of output, also for processes producing very large amounts of output.
           */
         class QTILIITES_CORE_SHARED_EXPORT QtilitiesProcess : public Task
         {
@@ -166,7 +170,9 @@ my_process.addProcessBufferMessageTypeHint(message_hint_error);
               \param arguments The arguments to send to the QProcess.
               \param mode The OpenMode of the QProcess.
               \param wait_for_started_msecs The wait for started time in milli seconds to be passed to the waitForStarted() call on the QProcess().
-              \returns True when the task was started successfully (thus waitForStarted() returned true), false otherwise.
+              When 0, the function does not wait for the process to start. A process which fails to start then completes its task
+              once control returns to the event loop (<i>added in %Qtilities v1.5</i>).
+              \returns True when the task was started successfully (thus waitForStarted() returned true), false otherwise. Always true when \p wait_for_started_msecs is 0.
               */
             virtual bool startProcess(const QString& program,
                                       const QStringList& arguments,
@@ -258,6 +264,8 @@ my_process.addProcessBufferMessageTypeHint(message_hint_error);
             void newStandardErrorMessage(const QString& message);
 
         private:
+            //! Processes all complete messages found by \p splitter and removes them from it.
+            void processBufferMessages(ProcessBufferSplitter& splitter);
             //! Process buffer work function.
             void processSingleBufferMessage(const QString& buffer_message);
             //! Internal function used to complete the task. Thus function will also process any remaining messages in the process buffer.
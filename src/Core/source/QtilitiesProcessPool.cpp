@@ -0,0 +1,271 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "QtilitiesProcessPool.h"
+#include "QtilitiesProcess.h"
+
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QQueue>
+#include <QThread>
+#include <QTimer>
+
+struct QtilitiesProcessPoolEntry {
+    QtilitiesProcessPoolEntry() : process(0),
+        result(ITask::TaskNoResult),
+        finished(false) {}
+
+    QString                             program;
+    QStringList                         arguments;
+    QString                             working_directory;
+    QString                             task_name;
+    Qtilities::Core::QtilitiesProcess*  process;
+    ITask::TaskResult                   result;
+    bool                                finished;
+};
+
+struct Qtilities::Core::QtilitiesProcessPoolPrivateData {
+    QtilitiesProcessPoolPrivateData() : max_concurrent_processes(QThread::idealThreadCount()),
+        running_count(0),
+        finished_count(0),
+        launching(false),
+        stop_requested(false) {}
+
+    QList<QtilitiesProcessPoolEntry>    entries;
+    QQueue<int>                         queue;
+    int                                 max_concurrent_processes;
+    int                                 running_count;
+    int                                 finished_count;
+    //! Used to avoid recursive launches when a process completes while it is being started.
+    bool                                launching;
+    bool                                stop_requested;
+    //! Kills the processes which did not terminate in time after stopProcesses().
+    QTimer                              kill_timer;
+};
+
+Qtilities::Core::QtilitiesProcessPool::QtilitiesProcessPool(const QString& task_name, bool enable_logging, QObject* parent) : Task(task_name,enable_logging,parent) {
+    d = new QtilitiesProcessPoolPrivateData;
+    if (d->max_concurrent_processes < 1)
+        d->max_concurrent_processes = 1;
+
+    d->kill_timer.setSingleShot(true);
+    d->kill_timer.setInterval(3000);
+    connect(&d->kill_timer,SIGNAL(timeout()),SLOT(killRemainingProcesses()));
+
+    connect(this,SIGNAL(stopTaskRequest()),SLOT(stopProcesses()));
+    setCanStop(true);
+}
+
+Qtilities::Core::QtilitiesProcessPool::~QtilitiesProcessPool() {
+    // The processes are children of the pool, we only have to make sure they stop logging to it:
+    for (int i = 0; i < d->entries.count(); ++i) {
+        if (d->entries.at(i).process) {
+            d->entries.at(i).process->disconnect(this);
+            d->entries.at(i).process->removeParentTask();
+        }
+    }
+    delete d;
+}
+
+void Qtilities::Core::QtilitiesProcessPool::setMaxConcurrentProcesses(int max_concurrent_processes) {
+    if (max_concurrent_processes < 1)
+        max_concurrent_processes = 1;
+    d->max_concurrent_processes = max_concurrent_processes;
+
+    if (state() == ITask::TaskBusy)
+        launchQueuedProcesses();
+}
+
+int Qtilities::Core::QtilitiesProcessPool::maxConcurrentProcesses() const {
+    return d->max_concurrent_processes;
+}
+
+int Qtilities::Core::QtilitiesProcessPool::addProcess(const QString& program, const QStringList& arguments, const QString& working_directory, const QString& task_name) {
+    QtilitiesProcessPoolEntry entry;
+    entry.program = program;
+    entry.arguments = arguments;
+    entry.working_directory = working_directory;
+    if (task_name.isEmpty())
+        entry.task_name = QFileInfo(program).fileName();
+    else
+        entry.task_name = task_name;
+
+    d->entries << entry;
+    int index = d->entries.count() - 1;
+    d->queue.enqueue(index);
+
+    if (state() == ITask::TaskBusy && !d->stop_requested) {
+        addExpectedSubTasks(1);
+        launchQueuedProcesses();
+    }
+    return index;
+}
+
+int Qtilities::Core::QtilitiesProcessPool::processCount() const {
+    return d->entries.count();
+}
+
+Qtilities::Core::QtilitiesProcess* Qtilities::Core::QtilitiesProcessPool::process(int index) const {
+    if (index < 0 || index >= d->entries.count())
+        return 0;
+    return d->entries.at(index).process;
+}
+
+Qtilities::Core::Interfaces::ITask::TaskResult Qtilities::Core::QtilitiesProcessPool::processResult(int index) const {
+    if (index < 0 || index >= d->entries.count())
+        return ITask::TaskNoResult;
+    return d->entries.at(index).result;
+}
+
+bool Qtilities::Core::QtilitiesProcessPool::clearProcesses() {
+    if (state() == ITask::TaskBusy || state() == ITask::TaskPaused)
+        return false;
+
+    for (int i = 0; i < d->entries.count(); ++i)
+        delete d->entries.at(i).process;
+    d->entries.clear();
+    d->queue.clear();
+    d->finished_count = 0;
+    return true;
+}
+
+int Qtilities::Core::QtilitiesProcessPool::queuedProcessCount() const {
+    return d->queue.count();
+}
+
+int Qtilities::Core::QtilitiesProcessPool::runningProcessCount() const {
+    return d->running_count;
+}
+
+int Qtilities::Core::QtilitiesProcessPool::finishedProcessCount() const {
+    return d->finished_count;
+}
+
+bool Qtilities::Core::QtilitiesProcessPool::startProcesses() {
+    if (state() == ITask::TaskBusy || state() == ITask::TaskPaused)
+        return false;
+
+    d->stop_requested = false;
+    startTask(d->queue.count(),QString(tr("Running %1 process(es), at most %2 at a time.")).arg(d->queue.count()).arg(d->max_concurrent_processes));
+    launchQueuedProcesses();
+    return true;
+}
+
+bool Qtilities::Core::QtilitiesProcessPool::waitForFinished(int msecs) {
+    if (state() != ITask::TaskBusy)
+        return true;
+
+    QEventLoop loop;
+    connect(this,SIGNAL(allProcessesFinished()),&loop,SLOT(quit()));
+    if (msecs >= 0)
+        QTimer::singleShot(msecs,&loop,SLOT(quit()));
+    loop.exec();
+
+    return state() != ITask::TaskBusy;
+}
+
+void Qtilities::Core::QtilitiesProcessPool::stopProcesses() {
+    if (state() != ITask::TaskBusy || d->stop_requested)
+        return;
+
+    d->stop_requested = true;
+    if (!d->queue.isEmpty())
+        logWarning(QString(tr("Stopping pool, %1 queued process(es) will not be started.")).arg(d->queue.count()));
+    d->queue.clear();
+
+    // QtilitiesProcess::stopProcess() waits for each process in turn, thus we terminate all processes and let them report back:
+    for (int i = 0; i < d->entries.count(); ++i) {
+        QtilitiesProcess* process = d->entries.at(i).process;
+        if (process && !d->entries.at(i).finished)
+            process->process()->terminate();
+    }
+
+    if (d->running_count > 0)
+        d->kill_timer.start();
+    checkCompletion();
+}
+
+void Qtilities::Core::QtilitiesProcessPool::killRemainingProcesses() {
+    for (int i = 0; i < d->entries.count(); ++i) {
+        QtilitiesProcess* process = d->entries.at(i).process;
+        if (process && !d->entries.at(i).finished)
+            process->process()->kill();
+    }
+}
+
+void Qtilities::Core::QtilitiesProcessPool::handleProcessCompleted(ITask::TaskResult result) {
+    QtilitiesProcess* process = qobject_cast<QtilitiesProcess*> (sender());
+    if (!process)
+        return;
+
+    int index = -1;
+    for (int i = 0; i < d->entries.count(); ++i) {
+        if (d->entries.at(i).process == process) {
+            index = i;
+            break;
+        }
+    }
+    if (index == -1 || d->entries.at(index).finished)
+        return;
+
+    d->entries[index].finished = true;
+    d->entries[index].result = result;
+    --d->running_count;
+    ++d->finished_count;
+
+    if (result == ITask::TaskFailed)
+        addCompletedSubTasks(1,QString(tr("Process \"%1\" failed.")).arg(process->taskName()),Logger::Error);
+    else
+        addCompletedSubTasks(1,QString(tr("Process \"%1\" completed.")).arg(process->taskName()));
+    emit processFinished(index,result);
+
+    launchQueuedProcesses();
+}
+
+void Qtilities::Core::QtilitiesProcessPool::launchQueuedProcesses() {
+    if (d->launching)
+        return;
+
+    d->launching = true;
+    while (!d->stop_requested && d->running_count < d->max_concurrent_processes && !d->queue.isEmpty()) {
+        int index = d->queue.dequeue();
+        QtilitiesProcessPoolEntry& entry = d->entries[index];
+
+        QtilitiesProcess* process = new QtilitiesProcess(entry.task_name,loggingEnabled(),true,this);
+        process->setParentTask(this);
+        if (!entry.working_directory.isEmpty())
+            process->process()->setWorkingDirectory(entry.working_directory);
+        entry.process = process;
+        connect(process,SIGNAL(taskCompleted(ITask::TaskResult,QString,Logger::MessageType)),SLOT(handleProcessCompleted(ITask::TaskResult)));
+
+        ++d->running_count;
+        emit processAboutToStart(index,process);
+        // We do not wait for processes to start, processes which fail to start complete later through handleProcessCompleted():
+        process->startProcess(entry.program,entry.arguments,QProcess::ReadWrite,0);
+    }
+    d->launching = false;
+
+    checkCompletion();
+}
+
+void Qtilities::Core::QtilitiesProcessPool::checkCompletion() {
+    if (state() != ITask::TaskBusy || d->running_count > 0 || d->launching)
+        return;
+    if (!d->queue.isEmpty() && !d->stop_requested)
+        return;
+
+    d->kill_timer.stop();
+    if (d->stop_requested)
+        stopTask();
+    else
+        completeTask();
+    emit allProcessesFinished();
+}
@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef QTILITIES_PROCESS_POOL_H
+#define QTILITIES_PROCESS_POOL_H
+
+#include "QtilitiesCore_global.h"
+#include "Task.h"
+
+#include <QObject>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace Core {
+        class QtilitiesProcess;
+
+        /*!
+        \struct QtilitiesProcessPoolPrivateData
+        \brief Structure used by QtilitiesProcessPool to store private data.
+          */
+        struct QtilitiesProcessPoolPrivateData;
+
+        /*!
+        \class QtilitiesProcessPool
+        \brief The QtilitiesProcessPool class runs a queue of external processes concurrently, each as its own QtilitiesProcess.
+
+        Processes are queued using addProcess() and launched by startProcesses(). At most maxConcurrentProcesses() processes run
+        at the same time, the rest wait in the queue and are started as running processes finish.
+
+        The pool is itself a task which represents the complete batch. Each process runs as a separate QtilitiesProcess which logs
+        its output to its own task log, and which uses the pool as its parent task (see Task::setParentTask()). All messages logged by the
+        processes are therefore also available in the log of the pool, and the pool's progress advances by one sub task for every finished
+        process. Processes are started without waiting for them, processes which fail to start are reported as failed processes. Stopping the pool task stops all running processes and clears the queue.
+
+\code
+QtilitiesProcessPool pool("Converting Files");
+pool.setMaxConcurrentProcesses(QThread::idealThreadCount());
+foreach (const QString& file, files)
+    pool.addProcess("converter",QStringList() << file);
+OBJECT_MANAGER->registerObject(&pool);
+pool.startProcesses();
+\endcode
+
+        Use processAboutToStart() to customize a process, for example using QtilitiesProcess::addProcessBufferMessageTypeHint(), before it is started.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT QtilitiesProcessPool : public Task
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Core::Interfaces::ITask)
+
+        public:
+            //! Constructs a new QtilitiesProcessPool instance.
+            /*!
+             * \param task_name The name of the task representing the pool.
+             * \param enable_logging Indicates if the pool and the processes it runs must log their messages.
+             * \param parent The parent of this pool.
+             */
+            QtilitiesProcessPool(const QString& task_name, bool enable_logging = true, QObject* parent = 0);
+            virtual ~QtilitiesProcessPool();
+
+            //! Sets the maximum number of processes which run at the same time.
+            /*!
+              By default QThread::idealThreadCount().
+              */
+            void setMaxConcurrentProcesses(int max_concurrent_processes);
+            //! Gets the maximum number of processes which run at the same time.
+            int maxConcurrentProcesses() const;
+
+            //! Adds a process to the queue of the pool.
+            /*!
+              Processes can be added while the pool is busy, in which case they are started as soon as possible and the number of sub tasks
+              of the pool task is increased accordingly.
+
+              \param program The program to start.
+              \param arguments The arguments to pass to the program.
+              \param working_directory The working directory of the process. When empty, the working directory of the application is used.
+              \param task_name The name of the task representing the process. When empty, the file name of the program is used.
+              \return The index of the process in the pool.
+              */
+            int addProcess(const QString& program,
+                           const QStringList& arguments = QStringList(),
+                           const QString& working_directory = QString(),
+                           const QString& task_name = QString());
+            //! Returns the number of processes added to the pool.
+            int processCount() const;
+            //! Returns the process at \p index, or 0 if the process was not started yet.
+            /*!
+              The processes are owned by the pool and remain available after they finished until clearProcesses() is called.
+              */
+            QtilitiesProcess* process(int index) const;
+            //! Returns the result of the process at \p index, ITask::TaskNoResult if it did not finish yet.
+            ITask::TaskResult processResult(int index) const;
+            //! Removes all processes from the pool. Only possible when the pool is not busy.
+            /*!
+              \return True if the processes were removed, false otherwise.
+              */
+            bool clearProcesses();
+
+            //! Returns the number of processes waiting in the queue.
+            int queuedProcessCount() const;
+            //! Returns the number of processes which are running.
+            int runningProcessCount() const;
+            //! Returns the number of processes which finished.
+            int finishedProcessCount() const;
+
+            //! Starts the task of the pool and launches the queued processes.
+            /*!
+              \return True if the pool was started, false if it is already busy.
+              */
+            bool startProcesses();
+            //! Waits until all processes finished while processing events.
+            /*!
+              \param msecs The maximum time to wait, -1 waits forever.
+              \return True if the pool is not busy anymore, false if the timeout expired.
+              */
+            bool waitForFinished(int msecs = -1);
+
+        public slots:
+            //! Stops all running processes and removes all processes from the queue.
+            /*!
+              This function does not block: all running processes are asked to terminate at once and processes which are still running
+              after 3 seconds are killed. The pool task is stopped and allProcessesFinished() is emitted once all processes finished.
+              */
+            void stopProcesses();
+
+        signals:
+            //! Emitted just before the process at \p index is started, allowing it to be customized.
+            void processAboutToStart(int index, QtilitiesProcess* process);
+            //! Emitted when the process at \p index finished.
+            void processFinished(int index, ITask::TaskResult result);
+            //! Emitted when all processes in the pool finished.
+            void allProcessesFinished();
+
+        private slots:
+            void handleProcessCompleted(ITask::TaskResult result);
+            void killRemainingProcesses();
+
+        private:
+            void launchQueuedProcesses();
+            void checkCompletion();
+
+            QtilitiesProcessPoolPrivateData* d;
+        };
+    }
+}
+
+#endif // QTILITIES_PROCESS_POOL_H
@@ -11,6 +11,7 @@
 
 #include "QtilitiesProperty.h"
 #include "QtilitiesCoreConstants.h"
+#include "QtilitiesPropertyAtoms.h"
 #include "ObjectManager.h"
 #include "Observer.h"
 
@@ -30,9 +31,10 @@ Qtilities::Core::QtilitiesProperty::QtilitiesProperty(const QString& property_na
     else
         name = property_name;
 
-    is_reserved = QtilitiesProperty::propertyIsReserved(property_name.toUtf8().data());
-    supports_change_notifications = QtilitiesProperty::propertySupportsChangeNotifications(property_name.toUtf8().data());
-    is_removable = QtilitiesProperty::propertyIsRemovable(property_name.toUtf8().data());
+    QtilitiesPropertyAtoms::Capabilities capabilities = QtilitiesPropertyAtoms::capabilities(name.toUtf8().constData());
+    is_reserved = capabilities & QtilitiesPropertyAtoms::Reserved;
+    supports_change_notifications = capabilities & QtilitiesPropertyAtoms::ChangeNotifications;
+    is_removable = capabilities & QtilitiesPropertyAtoms::Removable;
     read_only = false;
 }
 
@@ -42,9 +44,10 @@ Qtilities::Core::QtilitiesProperty::QtilitiesProperty(const char* property_name)
     else
         name = QString("");
 
-    is_reserved = QtilitiesProperty::propertyIsReserved(property_name);
-    supports_change_notifications = QtilitiesProperty::propertySupportsChangeNotifications(property_name);
-    is_removable = QtilitiesProperty::propertyIsRemovable(property_name);
+    QtilitiesPropertyAtoms::Capabilities capabilities = QtilitiesPropertyAtoms::capabilities(property_name);
+    is_reserved = capabilities & QtilitiesPropertyAtoms::Reserved;
+    supports_change_notifications = capabilities & QtilitiesPropertyAtoms::ChangeNotifications;
+    is_removable = capabilities & QtilitiesPropertyAtoms::Removable;
     read_only = false;
 }
 
@@ -93,127 +96,19 @@ bool Qtilities::Core::QtilitiesProperty::isValid() {
 }
 
 bool Qtilities::Core::QtilitiesProperty::propertyIsExportable(const char* property_name) {
-    if (!qstrcmp(property_name,qti_prop_ALIAS_MAP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_ACCESS_MODE))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_ACTIVITY_MAP))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_CATEGORY_MAP))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_LIMITED_EXPORTS))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_NAME))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_NAME_MANAGER_ID))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_OWNERSHIP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_OBSERVER_LIMIT))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_PARENT_ID))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_OBSERVER_MAP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_VISITOR_ID))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_DISPLAYED_ALIAS_MAP))
-        return false;
-
-    return true;
+    return QtilitiesPropertyAtoms::capabilities(property_name) & QtilitiesPropertyAtoms::Exportable;
 }
 
 bool Qtilities::Core::QtilitiesProperty::propertyIsReserved(const char* property_name) {
-    if (!qstrcmp(property_name,qti_prop_ALIAS_MAP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_ACCESS_MODE))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_ACTIVITY_MAP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_CATEGORY_MAP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_LIMITED_EXPORTS))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_NAME))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_NAME_MANAGER_ID))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_OWNERSHIP))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_OBSERVER_LIMIT))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_PARENT_ID))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_OBSERVER_MAP))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_VISITOR_ID))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_DISPLAYED_ALIAS_MAP))
-        return false;
-
-    return false;
+    return QtilitiesPropertyAtoms::capabilities(property_name) & QtilitiesPropertyAtoms::Reserved;
 }
 
 bool Qtilities::Core::QtilitiesProperty::propertyIsRemovable(const char* property_name) {
-    if (!qstrcmp(property_name,qti_prop_ALIAS_MAP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_ACCESS_MODE))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_ACTIVITY_MAP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_CATEGORY_MAP))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_LIMITED_EXPORTS))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_NAME))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_NAME_MANAGER_ID))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_OWNERSHIP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_OBSERVER_LIMIT))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_PARENT_ID))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_OBSERVER_MAP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_VISITOR_ID))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_DISPLAYED_ALIAS_MAP))
-        return true;
-
-    return true;
+    return QtilitiesPropertyAtoms::capabilities(property_name) & QtilitiesPropertyAtoms::Removable;
 }
 
 bool Qtilities::Core::QtilitiesProperty::propertySupportsChangeNotifications(const char* property_name) {
-    if (!qstrcmp(property_name,qti_prop_ALIAS_MAP))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_ACCESS_MODE))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_ACTIVITY_MAP))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_CATEGORY_MAP))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_LIMITED_EXPORTS))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_NAME))
-        return true;
-    if (!qstrcmp(property_name,qti_prop_NAME_MANAGER_ID))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_OWNERSHIP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_OBSERVER_LIMIT))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_PARENT_ID))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_OBSERVER_MAP))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_VISITOR_ID))
-        return false;
-    if (!qstrcmp(property_name,qti_prop_DISPLAYED_ALIAS_MAP))
-        return false;
-
-    return false;
+    return QtilitiesPropertyAtoms::capabilities(property_name) & QtilitiesPropertyAtoms::ChangeNotifications;
 }
 
 quint32 MARKER_OBSERVER_PROPERTY = 0xBABEFACE;
@@ -404,7 +299,7 @@ Qtilities::Core::MultiContextProperty::MultiContextProperty(const MultiContextPr
 }
 
 Qtilities::Core::MultiContextProperty::MultiContextProperty(const QtilitiesProperty& qtilities_property) : QtilitiesProperty(qtilities_property){
-
+    last_change_context = -1;
 }
 
 MultiContextProperty& Qtilities::Core::MultiContextProperty::operator=(const MultiContextProperty& other) {
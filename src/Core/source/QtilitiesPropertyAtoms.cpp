@@ -0,0 +1,129 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "QtilitiesPropertyAtoms.h"
+#include "QtilitiesCoreConstants.h"
+
+#include <string.h>
+
+using namespace Qtilities::Core::Properties;
+
+namespace {
+    struct AtomTableEntry {
+        const char*                                     name;
+        int                                             length;
+        Qtilities::Core::QtilitiesPropertyAtoms::Atom   atom;
+    };
+
+    // All property names start with "qti.", thus we first split on the length of the name and only compare
+    // names of equal length. The table must be sorted on the length, the lengths are verified in the tests.
+    const AtomTableEntry atom_table[] = {
+        { qti_prop_FONT,                                13, Qtilities::Core::QtilitiesPropertyAtoms::FontAtom },
+        { qti_prop_NAME,                                16, Qtilities::Core::QtilitiesPropertyAtoms::NameAtom },
+        { qti_prop_TOOLTIP,                             16, Qtilities::Core::QtilitiesPropertyAtoms::TooltipAtom },
+        { qti_prop_PARENT_ID,                           17, Qtilities::Core::QtilitiesPropertyAtoms::ParentIdAtom },
+        { qti_prop_SIZE_HINT,                           17, Qtilities::Core::QtilitiesPropertyAtoms::SizeHintAtom },
+        { qti_prop_OWNERSHIP,                           18, Qtilities::Core::QtilitiesPropertyAtoms::OwnershipAtom },
+        { qti_prop_VISITOR_ID,                          18, Qtilities::Core::QtilitiesPropertyAtoms::VisitorIdAtom },
+        { qti_prop_STATUSTIP,                           18, Qtilities::Core::QtilitiesPropertyAtoms::StatusTipAtom },
+        { qti_prop_WHATS_THIS,                          18, Qtilities::Core::QtilitiesPropertyAtoms::WhatsThisAtom },
+        { qti_prop_ACCESS_MODE,                         19, Qtilities::Core::QtilitiesPropertyAtoms::AccessModeAtom },
+        { qti_prop_LIMITED_EXPORTS,                     19, Qtilities::Core::QtilitiesPropertyAtoms::LimitedExportsAtom },
+        { qti_prop_BACKGROUND,                          19, Qtilities::Core::QtilitiesPropertyAtoms::BackgroundAtom },
+        { qti_prop_DECORATION,                          19, Qtilities::Core::QtilitiesPropertyAtoms::DecorationAtom },
+        { qti_prop_FOREGROUND,                          19, Qtilities::Core::QtilitiesPropertyAtoms::ForegroundAtom },
+        { qti_prop_CATEGORY_MAP,                        20, Qtilities::Core::QtilitiesPropertyAtoms::CategoryMapAtom },
+        { qti_prop_OBSERVER_MAP,                        20, Qtilities::Core::QtilitiesPropertyAtoms::ObserverMapAtom },
+        { qti_prop_ALIAS_MAP,                           20, Qtilities::Core::QtilitiesPropertyAtoms::AliasMapAtom },
+        { qti_prop_OBSERVER_LIMIT,                      22, Qtilities::Core::QtilitiesPropertyAtoms::ObserverLimitAtom },
+        { qti_prop_TEXT_ALIGNMENT,                      22, Qtilities::Core::QtilitiesPropertyAtoms::TextAlignmentAtom },
+        { qti_prop_ACTIVITY_MAP,                        23, Qtilities::Core::QtilitiesPropertyAtoms::ActivityMapAtom },
+        { qti_prop_NAME_MANAGER_ID,                     25, Qtilities::Core::QtilitiesPropertyAtoms::NameManagerIdAtom },
+        { qti_prop_DISPLAYED_ALIAS_MAP,                 29, Qtilities::Core::QtilitiesPropertyAtoms::DisplayedAliasMapAtom },
+        { qti_prop_TREE_ITERATOR_SOURCE_OBS,            30, Qtilities::Core::QtilitiesPropertyAtoms::TreeIteratorSourceObsAtom },
+        { qti_prop_SUBJECT_IGNORE_MODIFICATION_STATE,   32, Qtilities::Core::QtilitiesPropertyAtoms::IgnoreModificationStateAtom }
+    };
+    const int atom_table_count = sizeof(atom_table) / sizeof(atom_table[0]);
+    const int atom_max_length = 32;
+
+    // Capabilities indexed on the atom. The first four bits reflect the documented permissions of each property.
+    const int atom_capabilities[Qtilities::Core::QtilitiesPropertyAtoms::AtomCount] = {
+        /* NoAtom */                        Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable,
+        /* ObserverMapAtom */               Qtilities::Core::QtilitiesPropertyAtoms::Reserved | Qtilities::Core::QtilitiesPropertyAtoms::ObserverReserved,
+        /* OwnershipAtom */                 Qtilities::Core::QtilitiesPropertyAtoms::Reserved | Qtilities::Core::QtilitiesPropertyAtoms::ObserverReserved,
+        /* ParentIdAtom */                  Qtilities::Core::QtilitiesPropertyAtoms::Reserved | Qtilities::Core::QtilitiesPropertyAtoms::ObserverReserved,
+        /* ObserverLimitAtom */             Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable,
+        /* VisitorIdAtom */                 Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Reserved | Qtilities::Core::QtilitiesPropertyAtoms::ObserverReserved,
+        /* TreeIteratorSourceObsAtom */     Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable,
+        /* LimitedExportsAtom */            Qtilities::Core::QtilitiesPropertyAtoms::Reserved | Qtilities::Core::QtilitiesPropertyAtoms::ObserverReserved,
+        /* AccessModeAtom */                Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ChangeNotifications | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored,
+        /* CategoryMapAtom */               Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ChangeNotifications | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored,
+        /* IgnoreModificationStateAtom */   Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable,
+        /* NameAtom */                      Qtilities::Core::QtilitiesPropertyAtoms::ChangeNotifications,
+        /* DisplayedAliasMapAtom */         Qtilities::Core::QtilitiesPropertyAtoms::Removable,
+        /* NameManagerIdAtom */             Qtilities::Core::QtilitiesPropertyAtoms::Reserved,
+        /* AliasMapAtom */                  Qtilities::Core::QtilitiesPropertyAtoms::ChangeNotifications,
+        /* ActivityMapAtom */               Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::ChangeNotifications,
+        /* TooltipAtom */                   Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored,
+        /* DecorationAtom */                Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored | Qtilities::Core::QtilitiesPropertyAtoms::ViewDataRole,
+        /* WhatsThisAtom */                 Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored,
+        /* StatusTipAtom */                 Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored,
+        /* SizeHintAtom */                  Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored | Qtilities::Core::QtilitiesPropertyAtoms::ViewDataRole,
+        /* FontAtom */                      Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored | Qtilities::Core::QtilitiesPropertyAtoms::ViewDataRole,
+        /* TextAlignmentAtom */             Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored | Qtilities::Core::QtilitiesPropertyAtoms::ViewDataRole,
+        /* BackgroundAtom */                Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored | Qtilities::Core::QtilitiesPropertyAtoms::ViewDataRole,
+        /* ForegroundAtom */                Qtilities::Core::QtilitiesPropertyAtoms::Exportable | Qtilities::Core::QtilitiesPropertyAtoms::Removable | Qtilities::Core::QtilitiesPropertyAtoms::ObserverMonitored | Qtilities::Core::QtilitiesPropertyAtoms::ViewDataRole
+    };
+}
+
+Qtilities::Core::QtilitiesPropertyAtoms::Atom Qtilities::Core::QtilitiesPropertyAtoms::atom(const char* property_name) {
+    if (!property_name)
+        return NoAtom;
+    return lookup(property_name,qstrlen(property_name));
+}
+
+Qtilities::Core::QtilitiesPropertyAtoms::Atom Qtilities::Core::QtilitiesPropertyAtoms::atom(const QByteArray& property_name) {
+    return lookup(property_name.constData(),property_name.size());
+}
+
+Qtilities::Core::QtilitiesPropertyAtoms::Capabilities Qtilities::Core::QtilitiesPropertyAtoms::capabilities(Atom atom) {
+    if (atom < NoAtom || atom >= AtomCount)
+        atom = NoAtom;
+    return Capabilities(atom_capabilities[atom]);
+}
+
+const char* Qtilities::Core::QtilitiesPropertyAtoms::name(Atom atom) {
+    for (int i = 0; i < atom_table_count; ++i) {
+        if (atom_table[i].atom == atom)
+            return atom_table[i].name;
+    }
+    return 0;
+}
+
+Qtilities::Core::QtilitiesPropertyAtoms::Atom Qtilities::Core::QtilitiesPropertyAtoms::lookup(const char* property_name, int length) {
+    // Quick rejection of everything outside of the qti. namespace, which is the common case for user properties:
+    if (length < atom_table[0].length || length > atom_max_length)
+        return NoAtom;
+    if (property_name[0] != 'q' || property_name[1] != 't' || property_name[2] != 'i' || property_name[3] != '.')
+        return NoAtom;
+
+    for (int i = 0; i < atom_table_count; ++i) {
+        if (atom_table[i].length < length)
+            continue;
+        if (atom_table[i].length > length)
+            break;
+        // All names share the "qti." prefix which we already checked:
+        if (!memcmp(atom_table[i].name + 4,property_name + 4,length - 4))
+            return atom_table[i].atom;
+    }
+
+    return NoAtom;
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef QTILITIES_PROPERTY_ATOMS_H
+#define QTILITIES_PROPERTY_ATOMS_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QByteArray>
+#include <QFlags>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+          \class QtilitiesPropertyAtoms
+          \brief The QtilitiesPropertyAtoms class provides a compile-time table of all the %Qtilities property names defined in Qtilities::Core::Properties.
+
+          Each property name maps to an atom together with a set of capability bits describing the property. Classifying a property
+          name is done with a single lookup in the table instead of comparing the name against every %Qtilities property, which makes
+          it cheap enough to do on every QDynamicPropertyChangeEvent:
+
+\code
+QtilitiesPropertyAtoms::Atom atom = QtilitiesPropertyAtoms::atom(propertyChangeEvent->propertyName());
+if (QtilitiesPropertyAtoms::capabilities(atom) & QtilitiesPropertyAtoms::ObserverReserved) {
+    // The property is reserved by all observers.
+}
+\endcode
+
+          Names which are not %Qtilities properties map to NoAtom, for which capabilities() returns the defaults used for
+          non-%Qtilities properties (exportable and removable).
+
+          The table lives in a single translation unit and contains only string literals and integers, thus it is initialized at compile
+          time and is safe to use from any thread.
+
+          This class was added in %Qtilities v1.5.
+         */
+        class QTILIITES_CORE_SHARED_EXPORT QtilitiesPropertyAtoms
+        {
+        public:
+            //! The atoms of all %Qtilities properties.
+            enum Atom {
+                NoAtom = 0,                     /*!< Not a %Qtilities property. */
+                ObserverMapAtom,                /*!< Qtilities::Core::Properties::qti_prop_OBSERVER_MAP */
+                OwnershipAtom,                  /*!< Qtilities::Core::Properties::qti_prop_OWNERSHIP */
+                ParentIdAtom,                   /*!< Qtilities::Core::Properties::qti_prop_PARENT_ID */
+                ObserverLimitAtom,              /*!< Qtilities::Core::Properties::qti_prop_OBSERVER_LIMIT */
+                VisitorIdAtom,                  /*!< Qtilities::Core::Properties::qti_prop_VISITOR_ID */
+                TreeIteratorSourceObsAtom,      /*!< Qtilities::Core::Properties::qti_prop_TREE_ITERATOR_SOURCE_OBS */
+                LimitedExportsAtom,             /*!< Qtilities::Core::Properties::qti_prop_LIMITED_EXPORTS */
+                AccessModeAtom,                 /*!< Qtilities::Core::Properties::qti_prop_ACCESS_MODE */
+                CategoryMapAtom,                /*!< Qtilities::Core::Properties::qti_prop_CATEGORY_MAP */
+                IgnoreModificationStateAtom,    /*!< Qtilities::Core::Properties::qti_prop_SUBJECT_IGNORE_MODIFICATION_STATE */
+                NameAtom,                       /*!< Qtilities::Core::Properties::qti_prop_NAME */
+                DisplayedAliasMapAtom,          /*!< Qtilities::Core::Properties::qti_prop_DISPLAYED_ALIAS_MAP */
+                NameManagerIdAtom,              /*!< Qtilities::Core::Properties::qti_prop_NAME_MANAGER_ID */
+                AliasMapAtom,                   /*!< Qtilities::Core::Properties::qti_prop_ALIAS_MAP */
+                ActivityMapAtom,                /*!< Qtilities::Core::Properties::qti_prop_ACTIVITY_MAP */
+                TooltipAtom,                    /*!< Qtilities::Core::Properties::qti_prop_TOOLTIP */
+                DecorationAtom,                 /*!< Qtilities::Core::Properties::qti_prop_DECORATION */
+                WhatsThisAtom,                  /*!< Qtilities::Core::Properties::qti_prop_WHATS_THIS */
+                StatusTipAtom,                  /*!< Qtilities::Core::Properties::qti_prop_STATUSTIP */
+                SizeHintAtom,                   /*!< Qtilities::Core::Properties::qti_prop_SIZE_HINT */
+                FontAtom,                       /*!< Qtilities::Core::Properties::qti_prop_FONT */
+                TextAlignmentAtom,              /*!< Qtilities::Core::Properties::qti_prop_TEXT_ALIGNMENT */
+                BackgroundAtom,                 /*!< Qtilities::Core::Properties::qti_prop_BACKGROUND */
+                ForegroundAtom,                 /*!< Qtilities::Core::Properties::qti_prop_FOREGROUND */
+                AtomCount                       /*!< The number of atoms, including NoAtom. */
+            };
+            //! The capabilities of a property.
+            enum Capability {
+                NoCapabilities          = 0,        /*!< No capabilities. */
+                Exportable              = 1 << 0,   /*!< The property is exported. \sa QtilitiesProperty::propertyIsExportable() */
+                Reserved                = 1 << 1,   /*!< The property is reserved. \sa QtilitiesProperty::propertyIsReserved() */
+                Removable               = 1 << 2,   /*!< The property is removable. \sa QtilitiesProperty::propertyIsRemovable() */
+                ChangeNotifications     = 1 << 3,   /*!< The property supports change notifications. \sa QtilitiesProperty::propertySupportsChangeNotifications() */
+                ObserverReserved        = 1 << 4,   /*!< The property is part of Observer::reservedProperties() for all observers. */
+                ObserverMonitored       = 1 << 5,   /*!< The property is part of Observer::monitoredProperties() for all observers. */
+                ViewDataRole            = 1 << 6    /*!< Changes to the property requires views to refresh their data. */
+            };
+            Q_DECLARE_FLAGS(Capabilities, Capability)
+
+            //! Returns the atom of the given property name, or NoAtom if it is not a %Qtilities property.
+            static Atom atom(const char* property_name);
+            //! Returns the atom of the given property name, or NoAtom if it is not a %Qtilities property.
+            static Atom atom(const QByteArray& property_name);
+            //! Returns the capabilities of the given atom.
+            static Capabilities capabilities(Atom atom);
+            //! Convenience function which returns the capabilities of the given property name.
+            static inline Capabilities capabilities(const char* property_name) {
+                return capabilities(atom(property_name));
+            }
+            //! Returns the property name of the given atom, or 0 for NoAtom.
+            static const char* name(Atom atom);
+            //! Checks if the given property name is a %Qtilities internal property, thus if it starts with \p "qti.".
+            /*!
+              Internal properties include all atoms, but also other properties in the \p "qti." namespace which are not part of the atom table,
+              for example the ObserverDotWriter properties.
+              */
+            static inline bool isInternalPropertyName(const QByteArray& property_name) {
+                return property_name.startsWith("qti.");
+            }
+
+        private:
+            static Atom lookup(const char* property_name, int length);
+        };
+
+        Q_DECLARE_OPERATORS_FOR_FLAGS(QtilitiesPropertyAtoms::Capabilities)
+    }
+}
+
+#endif // QTILITIES_PROPERTY_ATOMS_H
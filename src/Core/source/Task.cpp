@@ -14,6 +14,8 @@
 
 #include <LoggerEngines>
 
+#include <QElapsedTimer>
+
 using namespace Qtilities::Core::Interfaces;
 using namespace Qtilities::Core;
 
@@ -37,7 +39,11 @@ struct Qtilities::Core::TaskPrivateData {
         logging_enabled(true),
         clear_log_on_start(true),
         last_run_time(-1),
-        parent_task(0) {}
+        parent_task(0),
+        progress_update_rate(0),
+        pending_sub_tasks(0),
+        pending_message_count(0),
+        pending_message_type(Logger::Info) {}
 
     QString                         task_name;
     QString                         task_display_name;
@@ -69,6 +75,14 @@ struct Qtilities::Core::TaskPrivateData {
 
     ITask*                          parent_task;
     QPointer<QObject>               parent_task_base;
+
+    int                             progress_update_rate;
+    QElapsedTimer                   last_progress_update;
+    QTimer                          progress_update_timer;
+    int                             pending_sub_tasks;
+    int                             pending_message_count;
+    QString                         pending_message;
+    Logger::MessageType             pending_message_type;
 };
 
 Qtilities::Core::Task::Task(const QString& task_name, bool enable_logging, QObject* parent) : QObject(parent), ITask() {
@@ -79,6 +93,9 @@ Qtilities::Core::Task::Task(const QString& task_name, bool enable_logging, QObje
     d->elapsed_time_notification_timer.setInterval(1000);
     connect(&d->elapsed_time_notification_timer,SIGNAL(timeout()),SLOT(broadcastElapsedTimeChanged()));
 
+    d->progress_update_timer.setSingleShot(true);
+    connect(&d->progress_update_timer,SIGNAL(timeout()),SLOT(flushProgressUpdates()));
+
     QtilitiesCoreApplication::taskManager()->assignIdToTask(this);
 }
 
@@ -473,6 +490,11 @@ bool Qtilities::Core::Task::startTask(int expected_subtasks, const QString& mess
     //qDebug() << "Starting task " << taskName() << " with " << expected_subtasks << " subtasks.";
     d->number_of_sub_tasks = expected_subtasks;
     d->current_progress = 0;
+    d->pending_sub_tasks = 0;
+    d->pending_message_count = 0;
+    d->pending_message.clear();
+    d->progress_update_timer.stop();
+    d->last_progress_update.invalidate();
     d->task_state = ITask::TaskBusy;
 
     //qDebug() << "In startTask(): " << taskName() << ", state: " << d->task_state;
@@ -511,6 +533,7 @@ bool Task::stopTask(const QString &message, Logger::MessageType type) {
 bool Task::pauseTask(const QString &message, Logger::MessageType type) {
     ITask::TaskState current_state = state();
 
+    flushProgressUpdates();
     emit taskAboutToPause();
 
     if (!message.isEmpty())
@@ -546,6 +569,28 @@ void Qtilities::Core::Task::addCompletedSubTasks(int number_of_sub_tasks, const
         return;
     }
 
+    if (d->progress_update_rate > 0) {
+        d->current_progress = d->current_progress + number_of_sub_tasks;
+        d->pending_sub_tasks = d->pending_sub_tasks + number_of_sub_tasks;
+        if (!message.isEmpty()) {
+            // Warnings and errors change the busy state of the task and must appear in lastErrorMessages(), thus they are never collected:
+            if (type & (Logger::Warning | Logger::Error | Logger::Fatal)) {
+                logMessage(message,type);
+            } else {
+                ++d->pending_message_count;
+                d->pending_message = message;
+                d->pending_message_type = type;
+            }
+        }
+
+        int interval = 1000 / d->progress_update_rate;
+        if (!d->last_progress_update.isValid() || d->last_progress_update.elapsed() >= interval)
+            flushProgressUpdates();
+        else if (!d->progress_update_timer.isActive())
+            d->progress_update_timer.start(interval - d->last_progress_update.elapsed());
+        return;
+    }
+
     emit taskSubTaskAboutToComplete();
 
     if (d->sub_task_performance_indication == ITask::SubTaskTimeFromTaskStart)
@@ -559,12 +604,24 @@ void Qtilities::Core::Task::addCompletedSubTasks(int number_of_sub_tasks, const
     emit subTaskCompleted(number_of_sub_tasks, message, type);
 }
 
+void Qtilities::Core::Task::addExpectedSubTasks(int number_of_sub_tasks) {
+    if (d->task_state != ITask::TaskBusy && d->task_state != ITask::TaskPaused) {
+        LOG_DEBUG("Attempting to add expected sub-tasks to a task which has not been started. Task name: " + d->task_name + ", Task ID: " + QString::number(taskID()));
+        return;
+    }
+
+    if (d->number_of_sub_tasks >= 0)
+        d->number_of_sub_tasks = d->number_of_sub_tasks + number_of_sub_tasks;
+}
+
 bool Qtilities::Core::Task::completeTask(ITask::TaskResult result, const QString& message, Logger::MessageType type) {
     if (d->task_state != ITask::TaskBusy) {
         LOG_DEBUG("Attempting to complete task which is not busy. Task name: " + d->task_name + ", Task ID: " + QString::number(taskID()));
         return false;
     }
 
+    flushProgressUpdates();
+
     ITask::TaskState old_state = d->task_state;
     emit taskAboutToComplete();
 
@@ -632,6 +689,52 @@ int Qtilities::Core::Task::currentProgress() const {
     return d->current_progress;
 }
 
+void Qtilities::Core::Task::setProgressUpdateRate(int max_updates_per_second) {
+    if (max_updates_per_second < 0)
+        max_updates_per_second = 0;
+    if (d->progress_update_rate == max_updates_per_second)
+        return;
+
+    // Broadcast progress collected using the previous rate before changing it:
+    flushProgressUpdates();
+    d->progress_update_rate = max_updates_per_second;
+}
+
+int Qtilities::Core::Task::progressUpdateRate() const {
+    return d->progress_update_rate;
+}
+
 void Task::broadcastElapsedTimeChanged() {
     emit taskElapsedTimeChanged(elapsedTime());
 }
+
+void Qtilities::Core::Task::flushProgressUpdates() {
+    d->progress_update_timer.stop();
+    if (d->pending_sub_tasks == 0 && d->pending_message_count == 0)
+        return;
+
+    int completed_sub_tasks = d->pending_sub_tasks;
+    QString message;
+    Logger::MessageType type = Logger::Info;
+    if (d->pending_message_count == 1) {
+        message = d->pending_message;
+        type = d->pending_message_type;
+    } else if (d->pending_message_count > 1) {
+        message = QString(tr("%1 subtask messages collected, last message: %2")).arg(d->pending_message_count).arg(d->pending_message);
+        type = d->pending_message_type;
+    }
+
+    d->pending_sub_tasks = 0;
+    d->pending_message_count = 0;
+    d->pending_message.clear();
+    d->last_progress_update.start();
+
+    emit taskSubTaskAboutToComplete();
+
+    if (d->sub_task_performance_indication == ITask::SubTaskTimeFromTaskStart)
+        logMessage(QString(tr("%1 subtask(s) completed (%2).")).arg(completed_sub_tasks).arg(elapsedTimeString(d->timer.elapsed())));
+    if (!message.isEmpty())
+        logMessage(message,type);
+
+    emit subTaskCompleted(completed_sub_tasks,message,type);
+}
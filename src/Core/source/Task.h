@@ -210,6 +210,13 @@ namespace Qtilities {
             bool resumeTask(const QString& message = QString(), Logger::MessageType type = Logger::Info);
             //! Function which should be used to add completed tasks from the process's side.
             void addCompletedSubTasks(int number_of_sub_tasks = 1, const QString& message = QString(), Logger::MessageType type = Logger::Info);
+            //! Function which should be used to add sub tasks to a task which is already busy, for example when work is added while it runs.
+            /*!
+              Only tasks which were started with a known number of sub tasks are updated, the new total is shown with the next progress update.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void addExpectedSubTasks(int number_of_sub_tasks);
             //! Function which should be used to complete the task from the process's side.
             bool completeTask(ITask::TaskResult result = ITask::TaskResultFromBusyStateFailOnError, const QString& message = QString(), Logger::MessageType type = Logger::Info);
 
@@ -218,6 +225,32 @@ namespace Qtilities {
             // --------------------------------
         public:
             int currentProgress() const;
+            //! Sets the maximum number of progress updates per second which this task broadcasts.
+            /*!
+              By default every call to addCompletedSubTasks() emits subTaskCompleted() and logs its message. When a task completes a large
+              number of small sub tasks this becomes more expensive than the work itself, therefore progress updates can be throttled.
+
+              When throttled, the progress returned by currentProgress() is always up to date but subTaskCompleted() is emitted at most
+              \p max_updates_per_second times per second. Information and debug messages passed to addCompletedSubTasks() in between
+              updates are collected into one summary message, while warnings and errors are still logged immediately. Outstanding
+              progress is broadcast when the task is paused or completed.
+
+              \param max_updates_per_second The maximum number of updates per second, for example 30. When 0, throttling is disabled.
+
+              \note Throttled updates which are not followed by more progress are broadcast using a timer, thus an event loop is required.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setProgressUpdateRate(int max_updates_per_second);
+            //! Gets the maximum number of progress updates per second which this task broadcasts.
+            /*!
+              \return The maximum number of updates per second, 0 when throttling is disabled (the default).
+
+              \sa setProgressUpdateRate()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int progressUpdateRate() const;
 
         signals:
             void taskElapsedTimeChanged(int msec) const;
@@ -254,6 +287,8 @@ namespace Qtilities {
         private slots:
             //! Function which is responsible to emit the taskElapsedTimeChanged() signal on notifications from the internal QTimer.
             void broadcastElapsedTimeChanged();
+            //! Broadcasts progress collected while progress updates are throttled.
+            void flushProgressUpdates();
 
         private:
             //! Updates the busy state of the task. Called when messages are logged while the task is busy.
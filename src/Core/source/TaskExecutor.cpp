@@ -0,0 +1,564 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TaskExecutor.h"
+#include "Task.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QQueue>
+#include <QRunnable>
+#include <QSet>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+using namespace Qtilities::Core;
+
+// --------------------------------------------------------------------
+// TaskWorkItem
+// --------------------------------------------------------------------
+
+struct Qtilities::Core::TaskWorkItemPrivateData {
+    TaskWorkItemPrivateData() : executor(0),
+        item_id(-1),
+        expected_sub_tasks(-1),
+        cancelled(false),
+        paused(false) {}
+
+    TaskExecutor*   executor;
+    int             item_id;
+    int             expected_sub_tasks;
+    //! Protects cancelled and paused, which are accessed from the executor thread and the worker thread.
+    mutable QMutex  mutex;
+    QWaitCondition  pause_condition;
+    bool            cancelled;
+    bool            paused;
+};
+
+Qtilities::Core::TaskWorkItem::TaskWorkItem(int expected_sub_tasks) {
+    d = new TaskWorkItemPrivateData;
+    d->expected_sub_tasks = expected_sub_tasks;
+}
+
+Qtilities::Core::TaskWorkItem::~TaskWorkItem() {
+    delete d;
+}
+
+int Qtilities::Core::TaskWorkItem::workItemID() const {
+    return d->item_id;
+}
+
+int Qtilities::Core::TaskWorkItem::expectedSubTasks() const {
+    return d->expected_sub_tasks;
+}
+
+void Qtilities::Core::TaskWorkItem::setExpectedSubTasks(int expected_sub_tasks) {
+    d->expected_sub_tasks = expected_sub_tasks;
+}
+
+bool Qtilities::Core::TaskWorkItem::isCancelled() const {
+    QMutexLocker locker(&d->mutex);
+    return d->cancelled;
+}
+
+bool Qtilities::Core::TaskWorkItem::isPaused() const {
+    QMutexLocker locker(&d->mutex);
+    return d->paused;
+}
+
+bool Qtilities::Core::TaskWorkItem::checkPoint() {
+    QMutexLocker locker(&d->mutex);
+    while (d->paused && !d->cancelled)
+        d->pause_condition.wait(&d->mutex);
+    return !d->cancelled;
+}
+
+void Qtilities::Core::TaskWorkItem::addCompletedSubTasks(int number_of_sub_tasks, const QString& message, Logger::MessageType type) {
+    if (!d->executor)
+        return;
+
+    QMetaObject::invokeMethod(d->executor,"deliverSubTasksCompleted",Qt::QueuedConnection,
+                              Q_ARG(int,d->item_id),
+                              Q_ARG(int,number_of_sub_tasks),
+                              Q_ARG(QString,message),
+                              Q_ARG(Logger::MessageType,type));
+}
+
+void Qtilities::Core::TaskWorkItem::logMessage(const QString& message, Logger::MessageType type) {
+    if (!d->executor) {
+        // The logger is thread-safe, thus we can log directly when we are not managed by an executor.
+        Log->logMessage(QString(),type,message);
+        return;
+    }
+
+    QMetaObject::invokeMethod(d->executor,"deliverMessage",Qt::QueuedConnection,
+                              Q_ARG(int,d->item_id),
+                              Q_ARG(QString,message),
+                              Q_ARG(Logger::MessageType,type));
+}
+
+void Qtilities::Core::TaskWorkItem::setCancelled() {
+    QMutexLocker locker(&d->mutex);
+    d->cancelled = true;
+    d->pause_condition.wakeAll();
+}
+
+void Qtilities::Core::TaskWorkItem::setPaused(bool is_paused) {
+    QMutexLocker locker(&d->mutex);
+    d->paused = is_paused;
+    if (!is_paused)
+        d->pause_condition.wakeAll();
+}
+
+// --------------------------------------------------------------------
+// TaskExecutorRunnable
+// --------------------------------------------------------------------
+
+/*!
+  \class Qtilities::Core::TaskExecutorRunnable
+  \brief Runs a single TaskWorkItem on a thread of the TaskExecutor's thread pool.
+
+  The runnable reports back to the executor using queued calls and does not touch the work item after
+  reporting that it is done or parked, since the executor deletes or queues the work item again at that point.
+  */
+class Qtilities::Core::TaskExecutorRunnable : public QRunnable {
+public:
+    TaskExecutorRunnable(TaskWorkItem* item) : d_item(item) {}
+
+    void run() {
+        TaskExecutor* executor = d_item->d->executor;
+        int item_id = d_item->d->item_id;
+        ITask::TaskResult result = ITask::TaskFailed;
+
+        // Items paused before they were started give their thread back and are queued again when they are resumed:
+        if (d_item->isPaused() && !d_item->isCancelled()) {
+            QMetaObject::invokeMethod(executor,"deliverWorkItemParked",Qt::QueuedConnection,Q_ARG(int,item_id));
+            return;
+        }
+
+        // Items cancelled before they were started are never run:
+        bool cancelled = d_item->isCancelled();
+        if (!cancelled) {
+            QMetaObject::invokeMethod(executor,"deliverWorkItemStarted",Qt::QueuedConnection,Q_ARG(int,item_id));
+            result = d_item->run();
+            cancelled = d_item->isCancelled();
+        }
+
+        QMetaObject::invokeMethod(executor,"deliverWorkItemDone",Qt::QueuedConnection,
+                                  Q_ARG(int,item_id),
+                                  Q_ARG(ITask::TaskResult,result),
+                                  Q_ARG(bool,cancelled));
+    }
+
+private:
+    TaskWorkItem* d_item;
+};
+
+// --------------------------------------------------------------------
+// TaskExecutor
+// --------------------------------------------------------------------
+
+struct TaskExecutorEntry {
+    TaskExecutorEntry() : item(0),
+        task(0),
+        priority(TaskExecutor::NormalPriority),
+        state(TaskExecutor::WorkItemUnknown),
+        pending_dependencies(0),
+        parked(false) {}
+
+    TaskWorkItem*                   item;
+    ITask*                          task;
+    QPointer<QObject>               task_base;
+    TaskExecutor::WorkItemPriority  priority;
+    TaskExecutor::WorkItemState     state;
+    //! The number of dependencies of a waiting item which did not finish yet.
+    int                             pending_dependencies;
+    //! The waiting items which depend on this item.
+    QList<int>                      dependents;
+    //! Indicates that the item was paused before it started and gave its pool thread back.
+    bool                            parked;
+};
+
+struct TaskExecutorOutcome {
+    TaskExecutorOutcome() : state(TaskExecutor::WorkItemUnknown),
+        result(ITask::TaskNoResult) {}
+
+    TaskExecutor::WorkItemState     state;
+    ITask::TaskResult               result;
+};
+
+// The number of finished work items of which the state and result are remembered:
+const int TASK_EXECUTOR_OUTCOME_HISTORY = 1024;
+
+struct Qtilities::Core::TaskExecutorPrivateData {
+    TaskExecutorPrivateData() : next_item_id(0),
+        active_count(0) {}
+
+    QThreadPool                 pool;
+    //! The work items which did not finish yet. Items are removed as soon as they finish.
+    QMap<int,TaskExecutorEntry> entries;
+    //! The items in entries which wait for their dependencies.
+    QSet<int>                   waiting_items;
+    //! The outcome of the last TASK_EXECUTOR_OUTCOME_HISTORY finished items, oldest first in outcome_order.
+    QHash<int,TaskExecutorOutcome> outcomes;
+    QQueue<int>                 outcome_order;
+    int                         next_item_id;
+    //! The number of items in entries.
+    int                         active_count;
+};
+
+Qtilities::Core::TaskExecutor::TaskExecutor(QObject* parent) : QObject(parent) {
+    d = new TaskExecutorPrivateData;
+
+    qRegisterMetaType<ITask::TaskResult>("ITask::TaskResult");
+    qRegisterMetaType<Logger::MessageType>("Logger::MessageType");
+}
+
+Qtilities::Core::TaskExecutor::~TaskExecutor() {
+    cancelAll();
+    d->pool.waitForDone();
+    // Deliver the done notifications of items which were still running in order to complete their tasks:
+    QCoreApplication::sendPostedEvents(this,QEvent::MetaCall);
+
+    QMapIterator<int,TaskExecutorEntry> itr(d->entries);
+    while (itr.hasNext()) {
+        itr.next();
+        delete itr.value().item;
+    }
+    delete d;
+}
+
+int Qtilities::Core::TaskExecutor::submit(TaskWorkItem* item, ITask* task, WorkItemPriority priority, const QList<int>& dependencies) {
+    if (!item)
+        return -1;
+    if (item->d->executor) {
+        LOG_DEBUG("TaskExecutor::submit() called with a work item which was already submitted.");
+        return -1;
+    }
+
+    int item_id = d->next_item_id++;
+    item->d->executor = this;
+    item->d->item_id = item_id;
+
+    TaskExecutorEntry entry;
+    entry.item = item;
+    entry.task = task;
+    entry.priority = priority;
+    entry.state = WorkItemWaiting;
+
+    // Dependencies which already finished are resolved here, the others notify this item when they finish:
+    bool dependency_failed = false;
+    QList<int> pending_dependencies;
+    foreach (int dependency, dependencies) {
+        if (d->entries.contains(dependency)) {
+            if (!pending_dependencies.contains(dependency))
+                pending_dependencies << dependency;
+        } else if (d->outcomes.contains(dependency)) {
+            const TaskExecutorOutcome& outcome = d->outcomes[dependency];
+            if (outcome.state == WorkItemCancelled || outcome.result == ITask::TaskFailed)
+                dependency_failed = true;
+        } else {
+            LOG_DEBUG(QString("TaskExecutor::submit() ignored unknown dependency %1 of work item %2.").arg(dependency).arg(item_id));
+        }
+    }
+
+    if (task) {
+        entry.task_base = task->objectBase();
+        Task* task_obj = qobject_cast<Task*> (entry.task_base);
+        if (task_obj) {
+            task_obj->setCanStop(true);
+            task_obj->setCanPause(true);
+            connect(task_obj,SIGNAL(stopTaskRequest()),SLOT(handleTaskStopRequest()),Qt::UniqueConnection);
+            connect(task_obj,SIGNAL(pauseTaskRequest()),SLOT(handleTaskPauseRequest()),Qt::UniqueConnection);
+            connect(task_obj,SIGNAL(resumeTaskRequest()),SLOT(handleTaskResumeRequest()),Qt::UniqueConnection);
+        }
+    }
+
+    if (!dependency_failed) {
+        entry.pending_dependencies = pending_dependencies.count();
+        foreach (int dependency, pending_dependencies)
+            d->entries[dependency].dependents << item_id;
+    }
+    d->entries[item_id] = entry;
+    d->waiting_items.insert(item_id);
+    ++d->active_count;
+
+    if (dependency_failed) {
+        ITask::logMessageToTask(tr("Work item cancelled because one of its dependencies failed."),task,Logger::Warning);
+        finishWorkItem(item_id,ITask::TaskFailed,true);
+    } else if (entry.pending_dependencies == 0) {
+        queueWorkItem(item_id);
+    }
+    return item_id;
+}
+
+Qtilities::Core::TaskExecutor::WorkItemState Qtilities::Core::TaskExecutor::workItemState(int item_id) const {
+    QMap<int,TaskExecutorEntry>::const_iterator itr = d->entries.constFind(item_id);
+    if (itr != d->entries.constEnd())
+        return itr.value().state;
+    return d->outcomes.value(item_id).state;
+}
+
+Qtilities::Core::Interfaces::ITask::TaskResult Qtilities::Core::TaskExecutor::workItemResult(int item_id) const {
+    return d->outcomes.value(item_id).result;
+}
+
+int Qtilities::Core::TaskExecutor::activeWorkItemCount() const {
+    return d->active_count;
+}
+
+bool Qtilities::Core::TaskExecutor::waitForDone(int msecs) {
+    QElapsedTimer timer;
+    timer.start();
+
+    // Progress, completion and the queuing of dependent items are all delivered through queued calls to this object,
+    // thus we deliver them while waiting instead of only waiting for the thread pool.
+    forever {
+        QCoreApplication::sendPostedEvents(this,QEvent::MetaCall);
+        if (activeWorkItemCount() == 0)
+            return true;
+        if (msecs >= 0 && timer.elapsed() >= msecs)
+            return false;
+        d->pool.waitForDone(10);
+    }
+    return false;
+}
+
+void Qtilities::Core::TaskExecutor::setMaxThreadCount(int max_thread_count) {
+    d->pool.setMaxThreadCount(max_thread_count);
+}
+
+int Qtilities::Core::TaskExecutor::maxThreadCount() const {
+    return d->pool.maxThreadCount();
+}
+
+void Qtilities::Core::TaskExecutor::cancel(int item_id) {
+    if (!d->entries.contains(item_id))
+        return;
+
+    TaskExecutorEntry& entry = d->entries[item_id];
+    if (entry.state == WorkItemWaiting || entry.parked) {
+        // Not on the thread pool, thus no runnable will report back for it:
+        finishWorkItem(item_id,ITask::TaskFailed,true);
+    } else if (entry.state == WorkItemQueued || entry.state == WorkItemRunning) {
+        // The runnable reports back through deliverWorkItemDone() once run() returned:
+        entry.item->setCancelled();
+    }
+}
+
+void Qtilities::Core::TaskExecutor::pause(int item_id) {
+    if (!d->entries.contains(item_id))
+        return;
+
+    TaskExecutorEntry& entry = d->entries[item_id];
+    if (entry.state != WorkItemWaiting && entry.state != WorkItemQueued && entry.state != WorkItemRunning)
+        return;
+    if (entry.item->isPaused())
+        return;
+
+    entry.item->setPaused(true);
+    Task* task_obj = qobject_cast<Task*> (entry.task_base);
+    if (task_obj && task_obj->state() == ITask::TaskBusy)
+        task_obj->pauseTask();
+}
+
+void Qtilities::Core::TaskExecutor::resume(int item_id) {
+    if (!d->entries.contains(item_id))
+        return;
+
+    TaskExecutorEntry& entry = d->entries[item_id];
+    if (entry.state != WorkItemWaiting && entry.state != WorkItemQueued && entry.state != WorkItemRunning)
+        return;
+    if (!entry.item->isPaused())
+        return;
+
+    entry.item->setPaused(false);
+    Task* task_obj = qobject_cast<Task*> (entry.task_base);
+    if (task_obj && task_obj->state() == ITask::TaskPaused)
+        task_obj->resumeTask();
+    if (entry.parked)
+        queueWorkItem(item_id);
+}
+
+void Qtilities::Core::TaskExecutor::cancelAll() {
+    // Only unfinished items are kept in entries, thus this is proportional to the number of active items:
+    QList<int> item_ids = d->entries.keys();
+    for (int i = 0; i < item_ids.count(); ++i)
+        cancel(item_ids.at(i));
+}
+
+void Qtilities::Core::TaskExecutor::handleTaskStopRequest() {
+    int item_id = workItemForTask(sender());
+    if (item_id != -1)
+        cancel(item_id);
+}
+
+void Qtilities::Core::TaskExecutor::handleTaskPauseRequest() {
+    int item_id = workItemForTask(sender());
+    if (item_id != -1)
+        pause(item_id);
+}
+
+void Qtilities::Core::TaskExecutor::handleTaskResumeRequest() {
+    int item_id = workItemForTask(sender());
+    if (item_id != -1)
+        resume(item_id);
+}
+
+void Qtilities::Core::TaskExecutor::deliverWorkItemStarted(int item_id) {
+    if (!d->entries.contains(item_id))
+        return;
+
+    TaskExecutorEntry& entry = d->entries[item_id];
+    entry.state = WorkItemRunning;
+
+    Task* task_obj = qobject_cast<Task*> (entry.task_base);
+    if (task_obj) {
+        task_obj->startTask(entry.item->expectedSubTasks());
+        if (entry.item->isPaused())
+            task_obj->pauseTask();
+    }
+
+    emit workItemStarted(item_id);
+}
+
+void Qtilities::Core::TaskExecutor::deliverWorkItemParked(int item_id) {
+    if (!d->entries.contains(item_id))
+        return;
+
+    TaskExecutorEntry& entry = d->entries[item_id];
+    if (entry.item->isCancelled())
+        finishWorkItem(item_id,ITask::TaskFailed,true);
+    else if (!entry.item->isPaused())
+        queueWorkItem(item_id); // Resumed while the runnable was parking it.
+    else
+        entry.parked = true;
+}
+
+void Qtilities::Core::TaskExecutor::deliverWorkItemDone(int item_id, ITask::TaskResult result, bool cancelled) {
+    if (!d->entries.contains(item_id))
+        return;
+
+    finishWorkItem(item_id,result,cancelled);
+}
+
+void Qtilities::Core::TaskExecutor::deliverSubTasksCompleted(int item_id, int number_of_sub_tasks, const QString& message, Logger::MessageType type) {
+    if (!d->entries.contains(item_id))
+        return;
+
+    Task* task_obj = qobject_cast<Task*> (d->entries[item_id].task_base);
+    if (task_obj)
+        task_obj->addCompletedSubTasks(number_of_sub_tasks,message,type);
+}
+
+void Qtilities::Core::TaskExecutor::deliverMessage(int item_id, const QString& message, Logger::MessageType type) {
+    if (!d->entries.contains(item_id))
+        return;
+
+    const TaskExecutorEntry& entry = d->entries[item_id];
+    ITask::logMessageToTask(message,entry.task_base ? entry.task : 0,type);
+}
+
+int Qtilities::Core::TaskExecutor::workItemForTask(QObject* task_obj) const {
+    if (!task_obj)
+        return -1;
+
+    QMapIterator<int,TaskExecutorEntry> itr(d->entries);
+    while (itr.hasNext()) {
+        itr.next();
+        if (itr.value().task_base == task_obj && itr.value().state != WorkItemFinished && itr.value().state != WorkItemCancelled)
+            return itr.key();
+    }
+    return -1;
+}
+
+void Qtilities::Core::TaskExecutor::queueWorkItem(int item_id) {
+    TaskExecutorEntry& entry = d->entries[item_id];
+    entry.state = WorkItemQueued;
+    entry.parked = false;
+    d->waiting_items.remove(item_id);
+
+    TaskExecutorRunnable* runnable = new TaskExecutorRunnable(entry.item);
+    runnable->setAutoDelete(true);
+    d->pool.start(runnable,entry.priority);
+}
+
+void Qtilities::Core::TaskExecutor::finishWorkItem(int item_id, ITask::TaskResult result, bool cancelled) {
+    // Cancelling an item cancels the items waiting for it, which are handled here instead of recursively:
+    QQueue<int> cancelled_dependents;
+    completeWorkItem(item_id,result,cancelled,cancelled_dependents);
+    while (!cancelled_dependents.isEmpty()) {
+        int dependent_id = cancelled_dependents.dequeue();
+        if (!d->waiting_items.contains(dependent_id))
+            continue;
+
+        const TaskExecutorEntry& dependent = d->entries[dependent_id];
+        ITask::logMessageToTask(tr("Work item cancelled because one of its dependencies failed."),dependent.task_base ? dependent.task : 0,Logger::Warning);
+        completeWorkItem(dependent_id,ITask::TaskFailed,true,cancelled_dependents);
+    }
+
+    if (d->active_count == 0)
+        emit allWorkItemsFinished();
+}
+
+void Qtilities::Core::TaskExecutor::completeWorkItem(int item_id, ITask::TaskResult result, bool cancelled, QQueue<int>& cancelled_dependents) {
+    TaskExecutorEntry entry = d->entries.take(item_id);
+    d->waiting_items.remove(item_id);
+    --d->active_count;
+
+    TaskExecutorOutcome outcome;
+    outcome.state = cancelled ? WorkItemCancelled : WorkItemFinished;
+    outcome.result = cancelled ? ITask::TaskFailed : result;
+    d->outcomes[item_id] = outcome;
+    d->outcome_order.enqueue(item_id);
+    while (d->outcome_order.count() > TASK_EXECUTOR_OUTCOME_HISTORY)
+        d->outcomes.remove(d->outcome_order.dequeue());
+
+    Task* task_obj = qobject_cast<Task*> (entry.task_base);
+    if (task_obj) {
+        // Tasks can only be completed from the busy state:
+        if (task_obj->state() == ITask::TaskPaused)
+            task_obj->resumeTask();
+        else if (task_obj->state() != ITask::TaskBusy)
+            task_obj->startTask(entry.item->expectedSubTasks());
+
+        if (cancelled)
+            task_obj->stopTask();
+        else
+            task_obj->completeTask(result);
+
+        task_obj->disconnect(this);
+    }
+
+    // The runnable does not touch the item after reporting back, thus it is safe to delete it here:
+    delete entry.item;
+
+    // Only the items depending on this item are updated:
+    bool failed = (outcome.result == ITask::TaskFailed);
+    for (int i = 0; i < entry.dependents.count(); ++i) {
+        int dependent_id = entry.dependents.at(i);
+        if (!d->waiting_items.contains(dependent_id))
+            continue;
+
+        if (failed)
+            cancelled_dependents.enqueue(dependent_id);
+        else if (--d->entries[dependent_id].pending_dependencies == 0)
+            queueWorkItem(dependent_id);
+    }
+
+    emit workItemFinished(item_id,outcome.result);
+}
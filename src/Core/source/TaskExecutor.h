@@ -0,0 +1,262 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TASK_EXECUTOR_H
+#define TASK_EXECUTOR_H
+
+#include "QtilitiesCore_global.h"
+#include "ITask.h"
+
+#include <Logger>
+
+#include <QObject>
+#include <QList>
+#include <QQueue>
+
+using namespace Qtilities::Core::Interfaces;
+using namespace Qtilities::Logging;
+
+namespace Qtilities {
+    namespace Core {
+        class TaskExecutor;
+        class TaskExecutorRunnable;
+
+        /*!
+        \struct TaskWorkItemPrivateData
+        \brief Structure used by TaskWorkItem to store private data.
+          */
+        struct TaskWorkItemPrivateData;
+
+        /*!
+        \class TaskWorkItem
+        \brief The TaskWorkItem class is the base class of all work executed by a TaskExecutor.
+
+        Subclasses implement run(), which is called on a worker thread of the executor. Progress and messages must be reported
+        through addCompletedSubTasks() and logMessage() which marshal the information back to the thread in which
+        the TaskExecutor lives, where it is passed on to the ITask attached to the work item. Long running work should call
+        checkPoint() regularly: it blocks while the work item is paused and returns false when the work item was cancelled.
+
+\code
+class FileScanWorkItem : public TaskWorkItem
+{
+public:
+    FileScanWorkItem(const QStringList& dirs) : TaskWorkItem(dirs.count()), d_dirs(dirs) {}
+
+    ITask::TaskResult run() {
+        foreach (const QString& dir, d_dirs) {
+            if (!checkPoint())
+                return ITask::TaskFailed;
+            scanDir(dir);
+            addCompletedSubTasks(1,"Scanned " + dir);
+        }
+        return ITask::TaskSuccessful;
+    }
+
+private:
+    QStringList d_dirs;
+};
+
+Task* task = new Task("Scanning Files");
+OBJECT_MANAGER->registerObject(task);
+TASK_EXECUTOR->submit(new FileScanWorkItem(dirs),task);
+\endcode
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT TaskWorkItem
+        {
+            friend class TaskExecutor;
+            friend class TaskExecutorRunnable;
+
+        public:
+            //! Constructs a work item.
+            /*!
+              \param expected_sub_tasks The number of sub tasks with which the attached task will be started, or -1 when it is not known.
+              */
+            TaskWorkItem(int expected_sub_tasks = -1);
+            virtual ~TaskWorkItem();
+
+            //! Performs the work of this item. This function is called on a worker thread.
+            /*!
+              \return The result with which the attached task will be completed.
+              */
+            virtual ITask::TaskResult run() = 0;
+
+            //! Returns the ID assigned to this work item by its executor, or -1 if it was not submitted yet.
+            int workItemID() const;
+            //! Returns the number of sub tasks with which the attached task will be started.
+            int expectedSubTasks() const;
+            //! Sets the number of sub tasks with which the attached task will be started. Must be called before the work item is submitted.
+            void setExpectedSubTasks(int expected_sub_tasks);
+            //! Checks if the work item was cancelled. This function is thread-safe.
+            bool isCancelled() const;
+            //! Checks if the work item is paused. This function is thread-safe.
+            bool isPaused() const;
+
+        protected:
+            //! Blocks the calling thread while the work item is paused.
+            /*!
+              \return False when the work item was cancelled and run() should return as soon as possible, true otherwise.
+              */
+            bool checkPoint();
+            //! Reports completed sub tasks to the attached task. Can be called from run().
+            void addCompletedSubTasks(int number_of_sub_tasks, const QString& message = QString(), Logger::MessageType type = Logger::Info);
+            //! Logs a message to the attached task, or to the logger when no task is attached. Can be called from run().
+            void logMessage(const QString& message, Logger::MessageType type = Logger::Info);
+
+        private:
+            void setCancelled();
+            void setPaused(bool is_paused);
+
+            TaskWorkItemPrivateData* d;
+        };
+
+        /*!
+        \struct TaskExecutorPrivateData
+        \brief Structure used by TaskExecutor to store private data.
+          */
+        struct TaskExecutorPrivateData;
+
+        /*!
+        \class TaskExecutor
+        \brief The TaskExecutor class runs TaskWorkItem instances on a thread pool and reports their progress through ITask.
+
+        Work items are submitted using submit(), optionally together with an ITask which represents the work in the TaskManager (and therefore
+        in the task views of %Qtilities GUI applications). The executor starts the task when the work item starts running, forwards all progress
+        and messages of the work item to it and completes it with the result returned by TaskWorkItem::run(). All interaction with the task happens
+        in the thread in which the executor lives, thus the executor must be used from that thread (normally the GUI thread).
+
+        When the attached task is a Qtilities::Core::Task, stopping, pausing and resuming the task (for example from the task widget) cancels,
+        pauses and resumes the work item. The same can be done directly using cancel(), pause() and resume().
+
+        Work items can depend on other work items. A work item with dependencies is only queued once all its dependencies finished successfully.
+        When one of its dependencies fails or is cancelled, the work item is cancelled as well.
+
+        Work items are queued on a QThreadPool according to their priority, items with a higher priority are started first.
+
+        The application wide executor is available through the TASK_EXECUTOR macro, but local executors can be created where needed.
+
+        See the \ref page_tasking article for more information on tasking.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT TaskExecutor : public QObject
+        {
+            Q_OBJECT
+            Q_ENUMS(WorkItemPriority)
+            Q_ENUMS(WorkItemState)
+
+            friend class TaskExecutorRunnable;
+            friend class TaskWorkItem;
+
+        public:
+            //! The priorities with which work items can be submitted.
+            enum WorkItemPriority {
+                LowPriority     = -1,   /*!< Started after all normal and high priority work items. */
+                NormalPriority  = 0,    /*!< The default priority. */
+                HighPriority    = 1     /*!< Started before all normal and low priority work items. */
+            };
+            //! The states in which a work item can be.
+            enum WorkItemState {
+                WorkItemUnknown     = 0,    /*!< No work item with the given ID is known to the executor. */
+                WorkItemWaiting     = 1,    /*!< The work item waits for its dependencies to finish. */
+                WorkItemQueued      = 2,    /*!< The work item was queued on the thread pool. */
+                WorkItemRunning     = 4,    /*!< The work item is running. */
+                WorkItemFinished    = 8,    /*!< The work item finished running. */
+                WorkItemCancelled   = 16    /*!< The work item was cancelled. */
+            };
+
+            TaskExecutor(QObject* parent = 0);
+            virtual ~TaskExecutor();
+
+            //! Submits a work item to the executor.
+            /*!
+              \param item The work item. The executor takes ownership of the item and deletes it after it finished.
+              \param task The task which represents the work item, can be 0.
+              \param priority The priority of the work item.
+              \param dependencies The IDs of work items which must finish successfully before this work item is started. Dependencies which already
+              finished are resolved using their remembered result, see workItemState().
+
+              \return The ID of the work item, or -1 if it could not be submitted.
+              */
+            int submit(TaskWorkItem* item, ITask* task = 0, WorkItemPriority priority = NormalPriority, const QList<int>& dependencies = QList<int>());
+            //! Returns the state of the work item with the given ID.
+            /*!
+              Work items are removed from the executor as soon as they finished, only the state and result of the last 1024 finished
+              work items are remembered. WorkItemUnknown is returned for older work items.
+              */
+            WorkItemState workItemState(int item_id) const;
+            //! Returns the result of the work item with the given ID, TaskNoResult if it did not finish yet or when it is not remembered anymore.
+            ITask::TaskResult workItemResult(int item_id) const;
+            //! Returns the number of work items which did not finish or were not cancelled yet.
+            int activeWorkItemCount() const;
+
+            //! Waits until all submitted work items finished or were cancelled.
+            /*!
+              Progress of the work items is delivered to their tasks while waiting.
+
+              \param msecs The maximum time to wait, -1 waits forever.
+              \return True if all work items finished, false if the timeout expired.
+              */
+            bool waitForDone(int msecs = -1);
+
+            //! Sets the maximum number of threads used by the executor.
+            void setMaxThreadCount(int max_thread_count);
+            //! Gets the maximum number of threads used by the executor. By default QThread::idealThreadCount().
+            int maxThreadCount() const;
+
+        public slots:
+            //! Cancels the work item with the given ID. Work items depending on it are cancelled as well.
+            void cancel(int item_id);
+            //! Pauses the work item with the given ID.
+            /*!
+              Work items which did not start running yet do not occupy a thread of the pool while they are paused, they are queued again when
+              they are resumed. Running work items are paused at their next TaskWorkItem::checkPoint() and keep their thread while they are paused.
+              */
+            void pause(int item_id);
+            //! Resumes the work item with the given ID.
+            void resume(int item_id);
+            //! Cancels all work items.
+            void cancelAll();
+
+        signals:
+            //! Signal emitted when a work item starts running.
+            void workItemStarted(int item_id);
+            //! Signal emitted when a work item finished running or was cancelled.
+            void workItemFinished(int item_id, ITask::TaskResult result);
+            //! Signal emitted when all work items finished.
+            void allWorkItemsFinished();
+
+        private slots:
+            void handleTaskStopRequest();
+            void handleTaskPauseRequest();
+            void handleTaskResumeRequest();
+
+            void deliverWorkItemStarted(int item_id);
+            void deliverWorkItemParked(int item_id);
+            void deliverWorkItemDone(int item_id, ITask::TaskResult result, bool cancelled);
+            void deliverSubTasksCompleted(int item_id, int number_of_sub_tasks, const QString& message, Logger::MessageType type);
+            void deliverMessage(int item_id, const QString& message, Logger::MessageType type);
+
+        private:
+            int workItemForTask(QObject* task_obj) const;
+            void queueWorkItem(int item_id);
+            //! Removes a finished or cancelled work item and cancels the items waiting for it when it failed.
+            void finishWorkItem(int item_id, ITask::TaskResult result, bool cancelled);
+            //! Completes the task of a work item, removes it and queues or collects the items waiting for it.
+            void completeWorkItem(int item_id, ITask::TaskResult result, bool cancelled, QQueue<int>& cancelled_dependents);
+
+            TaskExecutorPrivateData* d;
+        };
+    }
+}
+
+#endif // TASK_EXECUTOR_H
@@ -14,6 +14,7 @@
 
 #include <QObject>
 #include <QString>
+#include <QVector>
 
 #include <QtilitiesLogging>
 
@@ -101,12 +102,13 @@ rootTop->attachSubject(rootNodeA);
 rootTop->attachSubject(rootNodeB);
 \endcode
 
-        When TreeIterator iterates through this tree two things can happen:
-        - When you iterate forward in the tree it will remember the path it has taken to get to any point and you don't have to worry about it. TreeIterator will be able
-          to iterate through the tree regardless of any multiple parents that it might find on its way.
-        - When iterating backwards through the tree, the iterator will always iterate through the tree from front to back to get to the last value which you want to start
-          with. Thus, the path information will also be stored for you and TreeIterator will be able to iterate through the tree regardless of any multiple parents that
-          it might find on its way.
+        TreeIterator visits shared subjects once for every parent through which they are reached, thus \p A3 in the above example is
+        returned twice. Forward and backward iteration through such trees works without any extra work from your side.
+
+        TreeIterator iterates over the snapshot returned by Observer::treeSnapshot() on the top node at the time the iterator was constructed.
+        Thus next(), previous(), first(), last() and setCurrent() are constant time operations, no properties are set on the subjects in the tree during
+        iteration and the snapshot is shared by all iterators on an unchanged tree. Changes made to the tree after the iterator was constructed
+        are not visible to the iterator, construct a new iterator to iterate over the changed tree.
 
         \sa SubjectIterator, ConstSubjectIterator
 
@@ -118,184 +120,80 @@ rootTop->attachSubject(rootNodeB);
             /*!
              * \brief TreeIterator Constructs a new iterator
              * \param top_node The top node of the tree on which the iterator should operate.
+             * \param iterator_id Not used anymore since %Qtilities v1.5. Kept for source compatibility.
              */
             TreeIterator(const Observer* top_node = 0,
                          int iterator_id = -1) :
-                  d_top_node(top_node)
+                  d_top_node(top_node),
+                  d_position(-1)
             {
-                d_current = top_node;
-                if (iterator_id == -1)
-                    d_iterator_id = OBJECT_MANAGER->getNewIteratorID();
-                else
-                    d_iterator_id = iterator_id;
+                Q_UNUSED(iterator_id)
+                if (top_node)
+                    d_snapshot = top_node->treeSnapshot();
             }
 
             QObject* first()
             {
-                d_current = d_top_node;
-                return const_cast<QObject*> (d_current);
+                d_position = -1;
+                return current();
             }
 
             QObject* last()
             {
-                d_current = d_top_node->treeChildren("QObject",-1,d_iterator_id).last();
-                return const_cast<QObject*> (d_current);
+                d_position = d_snapshot.objects.count() - 1;
+                return current();
             }
 
             QObject* current() const
             {
-                return const_cast<QObject*> (d_current);
+                if (d_position < 0)
+                    return const_cast<Observer*> (d_top_node);
+                return d_snapshot.objects.at(d_position);
             }
 
+            //! Sets the current item of the iterator.
+            /*!
+              When \p current is reached through more than one parent in the tree, the first occurrence following the current position is used,
+              or the last occurrence before it when there is none. Use setCurrent(const QObject*, const Observer*) to select the occurrence explicitly.
+              */
             void setCurrent(const QObject* current)
             {
-                d_current = current;
+                d_position = positionOf(current,0);
+            }
+
+            //! Sets the current item of the iterator to the occurrence of \p current underneath \p parent.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setCurrent(const QObject* current, const Observer* parent)
+            {
+                d_position = positionOf(current,parent);
             }
 
             QObject* next()
             {
-                //qDebug() << "Starting next(): from current" << d_current << ", previous parent" << findParentPrevious(d_current);
-                Observer* obs = qobject_cast<Observer*> (const_cast<QObject*> (d_current));
-                if (obs) {
-                    if (obs->subjectCount() > 0) {
-                        d_current = obs->subjectAt(0);
-
-                        // Check if any subjects under this observer has multiple parents. If so, we need to set the qti_prop_TREE_ITERATOR_SOURCE_OBS on all
-                        // subjects in this context since SubjectIterator needs it on all subjects. TreeIterator only needs it on the first and last subject.
-                        bool add_prop = false;
-                        for (int i = 0; i < obs->subjectCount(); i++) {
-                            if (Observer::parentCount(obs->subjectAt(i)) > 1) {
-                                add_prop = true;
-                                continue;
-                            }
-                        }
-
-                        if (add_prop) {
-                            for (int i = 0; i < obs->subjectCount(); i++) {
-                                MultiContextProperty existing_prop = ObjectManager::getMultiContextProperty(obs->subjectAt(i),qti_prop_TREE_ITERATOR_SOURCE_OBS);
-                                if (existing_prop.isValid()) {
-                                    existing_prop.setValue(obs->observerID(),d_iterator_id);
-                                    ObjectManager::setMultiContextProperty(obs->subjectAt(i),existing_prop);
-                                } else {
-                                    MultiContextProperty prop(qti_prop_TREE_ITERATOR_SOURCE_OBS);
-                                    prop.setValue(obs->observerID(),d_iterator_id);
-                                    ObjectManager::setMultiContextProperty(obs->subjectAt(i),prop);
-                                }
-                            }
-                        }
-
-                        return const_cast<QObject*> (d_current);
-                    } else {
-                        if (d_current == d_top_node)
-                            return 0;
-                        else {
-                            SubjectIterator<QObject> sibling_itr(obs,
-                                                                 SubjectIterator<QObject>::IterateSiblings,
-                                                                 findParentPreviousObserver(obs),
-                                                                 d_iterator_id);
-                            if (sibling_itr.hasNext()) {
-                                d_current = sibling_itr.next();
-                                return const_cast<QObject*> (d_current);
-                            } else {
-                                const QObject* obj = findParentNext(d_current);
-                                if (obj) {
-                                    d_current = obj;
-                                    return const_cast<QObject*> (d_current);
-                                } else
-                                    return 0;
-                            }
-                        }
-                    }
-                } else {
-                    SubjectIterator<QObject> sibling_itr(d_current,
-                                                         findParentPreviousObserver(d_current),
-                                                         d_iterator_id);
-                    if (sibling_itr.hasNext()) {
-                        d_current = sibling_itr.next();
-                        return const_cast<QObject*> (d_current);
-                    } else {
-                        const QObject* obj = findParentNext(d_current);
-                        //qDebug() << "LAST SIBLING, FINDING NEXT PARENT" << obj;
-                        if (obj) {
-                            d_current = obj;
-                            return const_cast<QObject*> (d_current);
-                        } else
-                            return 0;
-                    }
-                }
+                if (d_position + 1 >= d_snapshot.objects.count())
+                    return 0;
+                ++d_position;
+                return d_snapshot.objects.at(d_position);
             }
 
             QObject* previous()
             {
-                if (d_current == d_top_node)
+                if (d_position < 0)
                     return 0;
+                --d_position;
+                return current();
+            }
 
-                Observer* obs = qobject_cast<Observer*> (const_cast<QObject*> (d_current));
-                if (obs) {
-                    SubjectIterator<Observer> sibling_itr(obs,
-                                                          SubjectIterator<Observer>::IterateSiblings,
-                                                          findParentPreviousObserver(obs),
-                                                          d_iterator_id);
-                    if (sibling_itr.hasPrevious()) {
-                        Observer* previous_obs = sibling_itr.previous();
-
-                        // If previous observer has children, take the last child, otherwise take previous observer.
-                        QList<QObject*> previous_obs_children = previous_obs->treeChildren("QObject",-1,d_iterator_id);
-                        if (previous_obs_children.count() > 0) {
-                            d_current = previous_obs_children.last();
-
-                            // Check if any subjects under this observer has multiple parents. If so, we need to set the qti_prop_TREE_ITERATOR_SOURCE_OBS on all
-                            // subjects in this context since SubjectIterator needs it on all subjects. TreeIterator only needs it on the first and last subject.
-                            bool add_prop = false;
-                            for (int i = 0; i < previous_obs->subjectCount(); i++) {
-                                if (Observer::parentCount(previous_obs->subjectAt(i)) > 1) {
-                                    add_prop = true;
-                                    continue;
-                                }
-                            }
-                            if (add_prop) {
-                                for (int i = 0; i < previous_obs->subjectCount(); i++) {
-                                    MultiContextProperty existing_prop = ObjectManager::getMultiContextProperty(previous_obs->subjectAt(i),qti_prop_TREE_ITERATOR_SOURCE_OBS);
-                                    if (existing_prop.isValid()) {
-                                        existing_prop.setValue(previous_obs->observerID(),d_iterator_id);
-                                        ObjectManager::setMultiContextProperty(previous_obs->subjectAt(i),existing_prop);
-                                    } else {
-                                        MultiContextProperty prop(qti_prop_TREE_ITERATOR_SOURCE_OBS);
-                                        prop.setValue(previous_obs->observerID(),d_iterator_id);
-                                        ObjectManager::setMultiContextProperty(previous_obs->subjectAt(i),prop);
-                                    }
-                                }
-                            }
-
-                            return const_cast<QObject*> (d_current);
-                        } else {
-                            d_current = previous_obs;
-                            return const_cast<QObject*> (d_current);
-                        }
-                    } else {
-                        const QObject* obj = findParentPrevious(d_current);
-                        if (obj) {
-                            d_current = obj;
-                            return const_cast<QObject*> (d_current);
-                        } else
-                            return 0;
-                    }
-                } else {
-                    SubjectIterator<QObject> sibling_itr(d_current,
-                                                         findParentPreviousObserver(d_current),
-                                                         d_iterator_id);
-                    if (sibling_itr.hasPrevious()) {
-                        d_current = sibling_itr.previous();
-                        return const_cast<QObject*> (d_current);
-                    } else {
-                        const QObject* obj = findParentPrevious(d_current);
-                        if (obj) {
-                            d_current = obj;
-                            return const_cast<QObject*> (d_current);
-                        } else
-                            return 0;
-                    }
-                }
+            bool hasNext()
+            {
+                return d_position + 1 < d_snapshot.objects.count();
+            }
+
+            bool hasPrevious()
+            {
+                return d_position >= 0;
             }
 
             Observer* topNode() const {
@@ -322,100 +220,85 @@ rootTop->attachSubject(rootNodeB);
             }
 
             //! Finds the next parent of an object.
+            /*!
+              Returns the object following the tree underneath the parent of \p obj, thus the next sibling of its parent or of the first
+              observer above it which has a next sibling. Returns 0 when the parent of \p obj is the top node or when no such object exists.
+              */
             const QObject* findParentNext(const QObject* obj) {
-                if (!obj)
+                int position = positionOf(obj,0);
+                if (position < 0)
                     return 0;
 
-                QList<Observer*> parents = Observer::parentReferences(obj);
-                if (parents.count() == 1) {
-                    if (parents.front() == d_top_node)
-                        return 0;
-                    else {
-                        SubjectIterator<QObject> parent_itr(parents.front(),
-                                                            SubjectIterator<QObject>::IterateSiblings,
-                                                            findParentPreviousObserver(parents.front()),
-                                                            d_iterator_id);
-                        if (parent_itr.hasNext()) {
-                            return parent_itr.next();
-                        } else {
-                            return findParentNext(parents.front());
-                        }
-                    }
-                } else if (parents.count() > 1) {
-                    // In here we set the observer ID of obs on the last and the first subjects in the observer context.
-                    MultiContextProperty prop = ObjectManager::getMultiContextProperty(obj,qti_prop_TREE_ITERATOR_SOURCE_OBS);
-//                    QObject* non_const_obj = const_cast<QObject*> (obj);
-//                    non_const_obj->setProperty(qti_prop_TREE_ITERATOR_SOURCE_OBS,QVariant());
-                    if (prop.isValid() && prop.hasContext(d_iterator_id)) {
-                        int obs_id = prop.value(d_iterator_id).toInt();
-                        Observer* parent_obs = OBJECT_MANAGER->observerReference(obs_id);
-                        if (parent_obs) {
-                            if (parent_obs == d_top_node)
-                                return 0;
-
-                            SubjectIterator<QObject> parent_itr(parent_obs,
-                                                                SubjectIterator<QObject>::IterateSiblings,
-                                                                findParentPreviousObserver(parent_obs),
-                                                                d_iterator_id);
-                            if (parent_itr.hasNext()) {
-                                return parent_itr.next();
-                            } else {
-                                //qDebug() << "Finding next parent, done with level of" << parent_obs->objectName() << ", navigating level up";
-                                return findParentNext(parent_obs);
-                            }
-                        }
-                    }
+                int parent_position = d_snapshot.parent_positions.at(position);
+                if (parent_position < 0)
+                    return 0;
 
-                    QString warning_string;
-                    warning_string.append(Q_FUNC_INFO);
-                    warning_string.append("- A subject was found with multiple parents during tree iteratrion. In such cases, you must specify the parent observer in which context you are iterating. Please see the SubjectIterator documentation for more information.");
-                    QStringList parents_string;
-                    foreach (Observer* obs, parents)
-                        parents_string << QString("\"" + obs->observerName() + "\"");
-                    warning_string.append("\nDetails: object name = \"" + obj->objectName() + "\" parents = " + parents_string.join(","));
-
-                    qWarning() << warning_string;
-                    LOG_FATAL(warning_string);
-                    Q_ASSERT(0);
-                }
-                return 0;
+                int parent_end = d_snapshot.subtree_ends.at(parent_position);
+                if (parent_end >= d_snapshot.objects.count())
+                    return 0;
+                return d_snapshot.objects.at(parent_end);
             }
             //! Finds the previous parent of an object.
+            /*!
+              Returns the observer through which \p obj is reached, which is the top node for subjects attached directly to it.
+              */
             const QObject* findParentPrevious(const QObject* obj) {
-                QList<Observer*> parents = Observer::parentReferences(obj);
-                if (parents.count() == 1)
-                    return parents.front();
-                else if (parents.count() > 1) {
-                    // In here we set the observer ID of obs on the last and the first subjects in the observer context.
-                    MultiContextProperty prop = ObjectManager::getMultiContextProperty(obj,qti_prop_TREE_ITERATOR_SOURCE_OBS);
-//                    QObject* non_const_obj = const_cast<QObject*> (obj);
-//                    non_const_obj->setProperty(qti_prop_TREE_ITERATOR_SOURCE_OBS,QVariant());
-                    if (prop.isValid() && prop.hasContext(d_iterator_id)) {
-                        int obs_id = prop.value(d_iterator_id).toInt();
-                        Observer* parent_obs = OBJECT_MANAGER->observerReference(obs_id);
-                        if (parent_obs)
-                            return parent_obs;
-                    }
+                int position = positionOf(obj,0);
+                if (position < 0)
+                    return 0;
 
-                    QString warning_string;
-                    warning_string.append(Q_FUNC_INFO);
-                    warning_string.append("- A subject was found with multiple parents during tree iteratrion. In such cases, you must specify the parent observer in which context you are iterating. Please see the SubjectIterator documentation for more information.");
-                    QStringList parents_string;
-                    foreach (Observer* obs, parents)
-                        parents_string << QString("\"" + obs->observerName() + "\"");
-                    warning_string.append("\nDetails: object name = \"" + obj->objectName() + "\" parents = " + parents_string.join(","));
-
-                    qWarning() << warning_string;
-                    LOG_FATAL(warning_string);
-                    Q_ASSERT(0);
-                }
-                return 0;
+                int parent_position = d_snapshot.parent_positions.at(position);
+                if (parent_position < 0)
+                    return d_top_node;
+                return d_snapshot.objects.at(parent_position);
             }
 
         private:
-            const QObject* d_current;
+            //! Returns the position of \p obj in the snapshot, -1 for the top node and for objects which are not in the tree.
+            /*!
+              The neighbours of the current position are checked first, after which the occurrences of \p obj are followed. Objects
+              only appear more than once when they have more than one parent, thus this is a constant time operation in practice.
+              */
+            int positionOf(const QObject* obj, const Observer* parent) const
+            {
+                if (!obj || obj == d_top_node)
+                    return -1;
+
+                const QVector<QObject*>& objects = d_snapshot.objects;
+                const int neighbours[3] = { d_position, d_position + 1, d_position - 1 };
+                for (int i = 0; i < 3; ++i) {
+                    int position = neighbours[i];
+                    if (position >= 0 && position < objects.count() && objects.at(position) == obj && isOccurrenceUnder(position,parent))
+                        return position;
+                }
+
+                int closest = -1;
+                int position = d_snapshot.first_positions.value(obj,-1);
+                while (position != -1) {
+                    if (isOccurrenceUnder(position,parent)) {
+                        closest = position;
+                        if (position >= d_position)
+                            break;
+                    }
+                    position = d_snapshot.next_occurrences.at(position);
+                }
+                return closest;
+            }
+
+            //! Returns true if the object at \p position is reached through \p parent, or if \p parent is 0.
+            bool isOccurrenceUnder(int position, const Observer* parent) const
+            {
+                if (!parent)
+                    return true;
+                int parent_position = d_snapshot.parent_positions.at(position);
+                if (parent_position < 0)
+                    return parent == d_top_node;
+                return d_snapshot.objects.at(parent_position) == parent;
+            }
+
             const Observer* const d_top_node;
-            int d_iterator_id;
+            ObserverTreeSnapshot d_snapshot;
+            int d_position;
         };
     }
 }
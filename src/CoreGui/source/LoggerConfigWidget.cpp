@@ -139,7 +139,7 @@ void Qtilities::CoreGui::LoggerConfigWidget::handle_NewLoggerEngineRequest() {
 
     if (ok && !new_item_selection.isEmpty() && !engine_name.isEmpty()) {
         // Handle new widget
-        if (new_item_selection == QString(qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE)) {
+        if (new_item_selection == QString(qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE) || new_item_selection == QString(qti_def_FACTORY_TAG_ROTATING_FILE_LOGGER_ENGINE)) {
             // Prompt the correct file extensions and select the formatting engine according to the user's selection.
             QString file_ext = "";
             for (int i = 0; i < Log->availableFormattingEnginesInFactory().count(); ++i) {
@@ -152,7 +152,10 @@ void Qtilities::CoreGui::LoggerConfigWidget::handle_NewLoggerEngineRequest() {
 
             QString fileName = QFileDialog::getSaveFileName(this,tr("Select Output File"),QtilitiesApplication::applicationSessionPath(),file_ext);
             if (!fileName.isEmpty()) {
-                Log->newFileEngine(engine_name,fileName,QString());
+                if (new_item_selection == QString(qti_def_FACTORY_TAG_ROTATING_FILE_LOGGER_ENGINE))
+                    Log->newRotatingFileEngine(engine_name,fileName);
+                else
+                    Log->newFileEngine(engine_name,fileName,QString());
             }
         }
     }
@@ -30,6 +30,7 @@
 #include <QRegExpValidator>
 #include <QCoreApplication>
 #include <QDomDocument>
+#include <QSet>
 
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::Core::Properties;
@@ -247,44 +248,14 @@ Qtilities::CoreGui::NamingPolicyFilter::ResolutionPolicy Qtilities::CoreGui::Nam
 Qtilities::CoreGui::NamingPolicyFilter::NameValidity Qtilities::CoreGui::NamingPolicyFilter::evaluateName(const QString& name, QObject* object) const {
     NamingPolicyFilter::NameValidity result = Acceptable;
 
-    bool do_uniqueness_test = true;
-    if (observer->isProcessingCycleActive() && !(d->processing_cycle_validation_check_flags & Uniqueness))
-        do_uniqueness_test = false;
-    else if (!observer->isProcessingCycleActive() && !(d->validation_check_flags & Uniqueness))
-        do_uniqueness_test = false;
-
-    if (do_uniqueness_test && (d->uniqueness_policy == ProhibitDuplicateNames || d->uniqueness_policy == ProhibitDuplicateNamesCaseSensitive)) {
-        Qt::CaseSensitivity case_sensitivity;
+    if (isUniquenessTestEnabled()) {
+        Qt::CaseSensitivity case_sensitivity = Qt::CaseSensitive;
         if (d->uniqueness_policy == ProhibitDuplicateNames)
             case_sensitivity = Qt::CaseInsensitive;
-        else if (d->uniqueness_policy == ProhibitDuplicateNamesCaseSensitive)
-            case_sensitivity = Qt::CaseSensitive;
-
-        if (!object) {
-            // Check uniqueness of name:
-            QStringList string_list = observer->subjectNames();
-            if (string_list.contains(name,case_sensitivity))
-                result |= Duplicate;
-        } else {
-            if (observer->subjectCount() > 0) {
-                // Check if the observer has an object model with this name:
-                SubjectIterator<QObject> itr(observer->subjectAt(0),
-                                             observer);
-
-                QMap<QString,QObject*> actual_paths;
-                actual_paths[itr.current()->objectName()] = itr.current();
-                while (itr.next()) {
-                    actual_paths[itr.current()->objectName()] = itr.current();
-                }
 
-                // Check uniqueness of name
-                QStringList string_list = QStringList(actual_paths.keys());
-                if (string_list.contains(name,case_sensitivity)) {
-                    if (actual_paths[name] != object)
-                        result |= Duplicate;
-                }
-            }
-        }
+        // Check uniqueness of name, when object is specified it is allowed to have the name already:
+        if (findIndexedObject(name,case_sensitivity,object))
+            result |= Duplicate;
     }
 
     bool do_validation_test = true;
@@ -305,23 +276,171 @@ Qtilities::CoreGui::NamingPolicyFilter::NameValidity Qtilities::CoreGui::NamingP
 }
 
 QObject* Qtilities::CoreGui::NamingPolicyFilter::getConflictingObject(const QString& name) const {
-    if (observer->subjectNames().contains(name) && d->uniqueness_policy == ProhibitDuplicateNames) {
-        for (int i = 0; i < observer->subjectCount(); ++i) {
-            if (observer->subjectNames().at(i) == name)
-                return observer->subjectAt(i);
+    if (d->uniqueness_policy == ProhibitDuplicateNames)
+        return findIndexedObject(name,Qt::CaseSensitive,0);
+
+    return 0;
+}
+
+QString Qtilities::CoreGui::NamingPolicyFilter::indexedNameOf(QObject* obj) const {
+    // The alias in this context takes preference, otherwise we use qti_prop_NAME since objectName() is only
+    // sync'ed with it after the object name manager handled a name change:
+    QVariant alias = observer->getMultiContextPropertyValue(obj,qti_prop_ALIAS_MAP);
+    if (alias.isValid())
+        return alias.toString();
+    QVariant name_property = observer->getMultiContextPropertyValue(obj,qti_prop_NAME);
+    if (name_property.isValid())
+        return name_property.toString();
+    return obj->objectName();
+}
+
+void Qtilities::CoreGui::NamingPolicyFilter::ensureNameIndex() const {
+    // Renames which happened while subject event filtering was disabled were not seen by this filter:
+    const int revision = observer ? observer->unfilteredSubjectChangeRevision() : -1;
+    if (d->name_index_valid && d->indexed_observer == observer && (revision == -1 || revision == d->indexed_revision))
+        return;
+
+    d->name_index.clear();
+    d->folded_name_index.clear();
+    d->indexed_names.clear();
+    d->indexed_observer = observer;
+    d->indexed_revision = revision;
+    d->name_index_valid = true;
+    if (!observer)
+        return;
+
+    int count = observer->subjectCount();
+    d->name_index.reserve(count);
+    d->folded_name_index.reserve(count);
+    d->indexed_names.reserve(count);
+    for (int i = 0; i < count; ++i)
+        indexName(observer->subjectAt(i));
+}
+
+void Qtilities::CoreGui::NamingPolicyFilter::indexName(QObject* obj) const {
+    if (!obj || !observer)
+        return;
+    if (!d->name_index_valid || d->indexed_observer != observer) {
+        // The complete index will be built the next time it is needed:
+        return;
+    }
+
+    unindexName(obj);
+    QString name = indexedNameOf(obj);
+    d->name_index.insert(name,obj);
+    d->folded_name_index.insert(name.toCaseFolded(),obj);
+    d->indexed_names.insert(obj,name);
+}
+
+void Qtilities::CoreGui::NamingPolicyFilter::unindexName(const QObject* obj) const {
+    QHash<const QObject*,QString>::iterator itr = d->indexed_names.find(obj);
+    if (itr == d->indexed_names.end())
+        return;
+
+    // Only compare pointers here, obj might already be deleted:
+    QObject* non_const_obj = const_cast<QObject*> (obj);
+    d->name_index.remove(itr.value(),non_const_obj);
+    d->folded_name_index.remove(itr.value().toCaseFolded(),non_const_obj);
+    d->indexed_names.erase(itr);
+}
+
+QObject* Qtilities::CoreGui::NamingPolicyFilter::findIndexedObject(const QString& name, Qt::CaseSensitivity case_sensitivity, const QObject* ignore) const {
+    if (!observer)
+        return 0;
+
+    // Subjects can be renamed or deleted without the filter seeing it, for example when subject event filtering is disabled
+    // on the observer. Thus we verify matches and rebuild the index once when we find a stale entry:
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        ensureNameIndex();
+
+        bool stale = false;
+        QString key = (case_sensitivity == Qt::CaseSensitive) ? name : name.toCaseFolded();
+        const QMultiHash<QString,QObject*>& index = (case_sensitivity == Qt::CaseSensitive) ? d->name_index : d->folded_name_index;
+        QMultiHash<QString,QObject*>::const_iterator itr = index.constFind(key);
+        while (itr != index.constEnd() && itr.key() == key) {
+            QObject* obj = itr.value();
+            if (!observer->contains(obj) || QString::compare(indexedNameOf(obj),name,case_sensitivity) != 0) {
+                stale = true;
+                break;
+            }
+            if (obj != ignore)
+                return obj;
+            ++itr;
+        }
+
+        if (!stale)
+            break;
+        d->name_index_valid = false;
+    }
+
+    // Renames of subjects which are not monitored by the observer are never seen, thus a miss is verified against the subjects:
+    if (observer->unfilteredSubjectChangeRevision() == -1) {
+        int count = observer->subjectCount();
+        for (int i = 0; i < count; ++i) {
+            QObject* obj = observer->subjectAt(i);
+            if (obj != ignore && QString::compare(indexedNameOf(obj),name,case_sensitivity) == 0) {
+                indexName(obj);
+                return obj;
+            }
         }
     }
 
     return 0;
 }
 
-Qtilities::CoreGui::AbstractSubjectFilter::EvaluationResult Qtilities::CoreGui::NamingPolicyFilter::evaluateAttachment(QObject* obj, QString* rejectMsg, bool silent) const {
-    // Check the validity of obj's name:
+bool Qtilities::CoreGui::NamingPolicyFilter::isUniquenessTestEnabled() const {
+    if (observer->isProcessingCycleActive() && !(d->processing_cycle_validation_check_flags & Uniqueness))
+        return false;
+    else if (!observer->isProcessingCycleActive() && !(d->validation_check_flags & Uniqueness))
+        return false;
+
+    return (d->uniqueness_policy == ProhibitDuplicateNames || d->uniqueness_policy == ProhibitDuplicateNamesCaseSensitive);
+}
+
+QString Qtilities::CoreGui::NamingPolicyFilter::attachmentEvaluationName(QObject* obj) const {
     QString evaluation_name = getEvaluationName(obj);
     if (evaluation_name.isEmpty())
         evaluation_name = obj->objectName();
-    NamingPolicyFilter::NameValidity validity_result = evaluateName(evaluation_name);
+    return evaluation_name;
+}
+
+Qtilities::CoreGui::AbstractSubjectFilter::EvaluationResult Qtilities::CoreGui::NamingPolicyFilter::evaluateAttachment(QObject* obj, QString* rejectMsg, bool silent) const {
+    // Check the validity of obj's name:
+    NamingPolicyFilter::NameValidity validity_result = evaluateName(attachmentEvaluationName(obj));
+    return resolveAttachmentEvaluation(obj,validity_result,rejectMsg,silent);
+}
+
+QList<Qtilities::CoreGui::AbstractSubjectFilter::EvaluationResult> Qtilities::CoreGui::NamingPolicyFilter::evaluateAttachments(const QList<QObject*>& objects, QStringList* rejectMsgs, bool silent) const {
+    QList<AbstractSubjectFilter::EvaluationResult> results;
+    bool uniqueness_test = isUniquenessTestEnabled();
+    bool case_sensitive = (d->uniqueness_policy == ProhibitDuplicateNamesCaseSensitive);
+
+    // Objects earlier in the batch will be attached before later objects, thus later objects
+    // with the same names are duplicates even though they are not in the context yet:
+    QSet<QString> batch_names;
+    for (int i = 0; i < objects.count(); ++i) {
+        QObject* obj = objects.at(i);
+        QString evaluation_name = attachmentEvaluationName(obj);
+        NamingPolicyFilter::NameValidity validity_result = evaluateName(evaluation_name);
+        if (uniqueness_test) {
+            QString batch_key = case_sensitive ? evaluation_name : evaluation_name.toCaseFolded();
+            if (batch_names.contains(batch_key))
+                validity_result |= Duplicate;
+            else
+                batch_names.insert(batch_key);
+        }
 
+        QString reject_msg;
+        AbstractSubjectFilter::EvaluationResult result = resolveAttachmentEvaluation(obj,validity_result,&reject_msg,silent);
+        if (result == AbstractSubjectFilter::Rejected && rejectMsgs)
+            rejectMsgs->append(reject_msg);
+        results << result;
+    }
+
+    return results;
+}
+
+Qtilities::CoreGui::AbstractSubjectFilter::EvaluationResult Qtilities::CoreGui::NamingPolicyFilter::resolveAttachmentEvaluation(QObject* obj, NamingPolicyFilter::NameValidity validity_result, QString* rejectMsg, bool silent) const {
     if ((validity_result & Invalid) && d->validity_resolution_policy == Reject) {
         if (rejectMsg)
             *rejectMsg = QString(tr("Naming Policy Filter: Subject name \"%1\" is not valid in this context.")).arg(obj->objectName());
@@ -455,6 +574,9 @@ bool Qtilities::CoreGui::NamingPolicyFilter::initializeAttachment(QObject* obj,
 }
 
 void Qtilities::CoreGui::NamingPolicyFilter::finalizeAttachment(QObject* obj, bool attachment_successful, bool import_cycle) {
+    if (attachment_successful)
+        indexName(obj);
+
     if (import_cycle)
         return;
 
@@ -480,6 +602,9 @@ void Qtilities::CoreGui::NamingPolicyFilter::finalizeAttachment(QObject* obj, bo
 }
 
 void Qtilities::CoreGui::NamingPolicyFilter::finalizeDetachment(QObject* obj, bool detachment_successful, bool subject_deleted) {
+    if (detachment_successful || subject_deleted)
+        unindexName(obj);
+
     if (detachment_successful && !subject_deleted)
         assignNewNameManager(obj);
 }
@@ -497,6 +622,9 @@ QStringList Qtilities::CoreGui::NamingPolicyFilter::reservedProperties() const {
 }
 
 bool Qtilities::CoreGui::NamingPolicyFilter::handleMonitoredPropertyChange(QObject* obj, const char* property_name, QDynamicPropertyChangeEvent* propertyChangeEvent) {
+    // The property is already changed when we get here. Rejected changes are reverted through a new property change:
+    indexName(obj);
+
     if (!filter_mutex.tryLock())
         return false;
 
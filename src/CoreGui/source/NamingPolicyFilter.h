@@ -22,6 +22,8 @@
 
 #include <QItemDelegate>
 #include <QValidator>
+#include <QHash>
+#include <QPointer>
 
 namespace Qtilities {
     namespace CoreGui {
@@ -211,6 +213,8 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
             // AbstractSubjectFilter Implementation
             // --------------------------------
             AbstractSubjectFilter::EvaluationResult evaluateAttachment(QObject* obj, QString* rejectMsg = 0, bool silent = false) const;
+            //! Evaluates a batch of objects against the names in the observer context as well as against the names of the objects before them in the batch.
+            QList<AbstractSubjectFilter::EvaluationResult> evaluateAttachments(const QList<QObject*>& objects, QStringList* rejectMsgs = 0, bool silent = false) const;
             bool initializeAttachment(QObject* obj, QString* rejectMsg = 0, bool import_cycle = false);
             void finalizeAttachment(QObject* obj, bool attachment_successful, bool import_cycle = false);
             void finalizeDetachment(QObject* obj, bool detachment_successful, bool subject_deleted = false);
@@ -412,6 +416,24 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
             virtual bool validateNamePropertyChange(QObject* obj, const char* property_name);
 
             NamingPolicyFilterData* d;
+
+        private:
+            //! Returns the name which is evaluated when \p obj is attached.
+            QString attachmentEvaluationName(QObject* obj) const;
+            //! Checks if evaluateName() must test uniqueness of names in the current state of the observer context.
+            bool isUniquenessTestEnabled() const;
+            //! Applies the resolution policies to the result of evaluateName() for an object which is being attached.
+            AbstractSubjectFilter::EvaluationResult resolveAttachmentEvaluation(QObject* obj, NamingPolicyFilter::NameValidity validity_result, QString* rejectMsg, bool silent) const;
+            //! Returns the name of \p obj in the observer context as it is stored in the name index.
+            QString indexedNameOf(QObject* obj) const;
+            //! Builds the name index from the subjects in the observer context when it is not valid.
+            void ensureNameIndex() const;
+            //! Adds \p obj to the name index, replacing its previous entry.
+            void indexName(QObject* obj) const;
+            //! Removes \p obj from the name index.
+            void unindexName(const QObject* obj) const;
+            //! Returns a subject with \p name in the observer context other than \p ignore, or 0 if no such subject exists.
+            QObject* findIndexedObject(const QString& name, Qt::CaseSensitivity case_sensitivity, const QObject* ignore) const;
         };
 
         /*!
@@ -420,7 +442,10 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
           */
         struct NamingPolicyFilterData {
             NamingPolicyFilterData() : is_modified(false),
-                conflicting_object(0) { }
+                conflicting_object(0),
+                indexed_observer(0),
+                indexed_revision(-1),
+                name_index_valid(false) { }
 
             bool is_modified;
             QValidator* validator;
@@ -436,6 +461,19 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
             NamingPolicyFilter::ValidationCheckFlags processing_cycle_validation_check_flags;
             //! Validation checks done while the observer context is NOT busy with a processing cycle.
             NamingPolicyFilter::ValidationCheckFlags validation_check_flags;
+
+            //! The observer context for which the name index was built.
+            const Observer* indexed_observer;
+            //! The Observer::unfilteredSubjectChangeRevision() of indexed_observer when the name index was built.
+            int indexed_revision;
+            //! Indicates if the name index is valid. When false, it is rebuilt the next time it is needed.
+            bool name_index_valid;
+            //! The subjects in the observer context keyed on their names in the context.
+            QMultiHash<QString,QObject*> name_index;
+            //! The subjects in the observer context keyed on their case folded names in the context, used for ProhibitDuplicateNames.
+            QMultiHash<QString,QObject*> folded_name_index;
+            //! The name under which each subject is stored in the name index.
+            QHash<const QObject*,QString> indexed_names;
         };
 
         Q_DECLARE_OPERATORS_FOR_FLAGS(NamingPolicyFilter::NameValidity)
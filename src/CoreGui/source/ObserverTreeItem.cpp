@@ -24,6 +24,7 @@ Qtilities::CoreGui::ObserverTreeItem::ObserverTreeItem(QObject* object,
     obj = object;
     type = item_type;
     contained_observer_ref = 0;
+    populated = true;
     //qDebug() << type;
 
     if (obj) {
@@ -39,6 +40,7 @@ Qtilities::CoreGui::ObserverTreeItem::ObserverTreeItem(const ObserverTreeItem& r
     obj = ref.obj;
     type = ref.type;
     contained_observer_ref = 0;
+    populated = ref.populated;
 
     if (ref.obj) {
         setObjectName(ref.obj->objectName());
@@ -58,9 +60,33 @@ Qtilities::CoreGui::ObserverTreeItem::~ObserverTreeItem() {
 void Qtilities::CoreGui::ObserverTreeItem::appendChild(ObserverTreeItem *child_item) {
     childItemHash[child_item->getObject()->objectName()] = child_item;
     childItemList << child_item;
+    child_item->parent_item = this;
     child_item->setParent(this);
 }
 
+void Qtilities::CoreGui::ObserverTreeItem::insertChild(int row, ObserverTreeItem *child_item) {
+    if (row < 0 || row > childItemList.count())
+        row = childItemList.count();
+    childItemHash[child_item->getObject()->objectName()] = child_item;
+    childItemList.insert(row,child_item);
+    child_item->parent_item = this;
+    child_item->setParent(this);
+}
+
+Qtilities::CoreGui::ObserverTreeItem* Qtilities::CoreGui::ObserverTreeItem::takeChild(int row) {
+    if (row < 0 || row >= childItemList.count())
+        return 0;
+
+    ObserverTreeItem* child_item = childItemList.takeAt(row);
+    if (child_item) {
+        // The hash is keyed on the name the item was created with, only remove the entry if it still refers to this child:
+        if (childItemHash.value(child_item->objectName()) == child_item)
+            childItemHash.remove(child_item->objectName());
+        child_item->setParent(0);
+    }
+    return child_item;
+}
+
 Qtilities::CoreGui::ObserverTreeItem* Qtilities::CoreGui::ObserverTreeItem::childWithName(const QString& name) const {
     if (childItemHash.contains(name))
         return childItemHash[name];
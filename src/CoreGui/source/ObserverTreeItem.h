@@ -54,6 +54,16 @@ namespace Qtilities {
 
             ObserverTreeItem *child(int row);
             void appendChild(ObserverTreeItem *child_item);
+            //! Inserts a child at the given row.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void insertChild(int row, ObserverTreeItem *child_item);
+            //! Removes the child at the given row and returns it. The caller takes ownership of the returned item.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverTreeItem* takeChild(int row);
             //! Checks if a child with the name already exists.
             /*!
               If the child already exists a reference is returned to it. If not 0 is returned.
@@ -75,6 +85,19 @@ namespace Qtilities {
             inline void setContainedObserver(Observer* contained_observer) { contained_observer_ref = contained_observer; }
             //! Gets the contained observer reference. The reference is held by the category item.
             inline Observer* containedObserver() const { return contained_observer_ref; }
+            //! Indicates if all children of this item were created.
+            /*!
+              When ObserverTreeModel populates its tree on demand, items for observers are created unpopulated and their children
+              are created in batches when the item is expanded. Items are populated by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline bool isPopulated() const { return populated; }
+            //! Sets if all children of this item were created.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline void setPopulated(bool is_populated) { populated = is_populated; }
 
         signals:
             void newObjectAdded(QObject* obj, ObserverTreeItem* new_item);
@@ -88,6 +111,7 @@ namespace Qtilities {
             TreeItemType type;
             QtilitiesCategory category_id;
             QPointer<Observer> contained_observer_ref;
+            bool populated;
         };
 
         Q_DECLARE_OPERATORS_FOR_FLAGS(ObserverTreeItem::TreeItemTypeFlags);
@@ -26,6 +26,7 @@
 #include <QIcon>
 #include <QDropEvent>
 #include <QFileIconProvider>
+#include <QSet>
 
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Icons;
@@ -37,7 +38,12 @@ struct Qtilities::CoreGui::ObserverTreeModelData  {
     ObserverTreeModelData() : tree_model_up_to_date(true),
         tree_rebuild_queued(false),
         tree_building_threading_enabled(false),
-        tree_build_count(0) {}
+        tree_build_count(0),
+        pending_layout_notifications(0),
+        on_demand_population(false),
+        fetch_batch_size(1000),
+        parallel_tree_building(false),
+        tree_building_thread_count(QThread::idealThreadCount()) {}
 
     QPointer<ObserverTreeItem>  rootItem;
     QPointer<Observer>          selection_parent;
@@ -66,6 +72,26 @@ struct Qtilities::CoreGui::ObserverTreeModelData  {
     QMap<QString,QString>       expanded_items_replace_map;
 
     QMutex                      build_mutex;
+
+    //! The items displaying each observer in the tree, used to update branches without rebuilding the tree.
+    QHash<Observer*,QList<QPointer<ObserverTreeItem> > > observer_items;
+    //! The observers for which change signals are connected.
+    QList<QPointer<Observer> >  monitored_observers;
+    //! The number of layoutChanged() notifications still to arrive for the changes applied by the last handleSubjectsChanged() call.
+    /*!
+      An observer emits layoutChanged() right after numberOfSubjectsChanged() and the signal reaches the model once through every
+      path from the observer to the context observer, thus an observer attached to multiple parents notifies the model more than once.
+      */
+    int                         pending_layout_notifications;
+
+    //! Indicates if the children of observers are only created when needed by the view.
+    bool                        on_demand_population;
+    //! The maximum number of children created at once when populating on demand.
+    int                         fetch_batch_size;
+
+    //! Indicates if independent subtrees are built concurrently.
+    bool                        parallel_tree_building;
+    int                         tree_building_thread_count;
 };
 
 Qtilities::CoreGui::ObserverTreeModel::ObserverTreeModel(QObject* parent) :
@@ -834,6 +860,184 @@ QModelIndex Qtilities::CoreGui::ObserverTreeModel::parent(const QModelIndex &ind
     return createIndex(parentItem->row(), 0, parentItem);
 }
 
+bool Qtilities::CoreGui::ObserverTreeModel::hasChildren(const QModelIndex &parent) const {
+    if (!d->tree_model_up_to_date)
+        return false;
+
+    if (parent.column() > 0)
+        return false;
+
+    ObserverTreeItem *parentItem;
+    if (!parent.isValid())
+        parentItem = d->rootItem;
+    else
+        parentItem = static_cast<ObserverTreeItem*>(parent.internalPointer());
+
+    if (!parentItem)
+        return false;
+
+    if (parentItem->childCount() > 0)
+        return true;
+
+    // Unpopulated observers show an expansion indicator when they have subjects, the subjects are created in fetchMore():
+    if (!parentItem->isPopulated()) {
+        Observer* observer = qobject_cast<Observer*> (parentItem->getObject());
+        if (observer)
+            return (observer->subjectCount() > 0 && observer->accessMode() != Observer::LockedAccess);
+    }
+
+    return false;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::canFetchMore(const QModelIndex &parent) const {
+    if (!d->tree_model_up_to_date)
+        return false;
+
+    ObserverTreeItem *parentItem;
+    if (!parent.isValid())
+        parentItem = d->rootItem;
+    else
+        parentItem = static_cast<ObserverTreeItem*>(parent.internalPointer());
+
+    if (!parentItem)
+        return false;
+
+    return !parentItem->isPopulated();
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::fetchMore(const QModelIndex &parent) {
+    if (!d->tree_model_up_to_date)
+        return;
+
+    ObserverTreeItem *parentItem;
+    if (!parent.isValid())
+        parentItem = d->rootItem;
+    else
+        parentItem = static_cast<ObserverTreeItem*>(parent.internalPointer());
+
+    if (!parentItem || parentItem->isPopulated())
+        return;
+
+    if (!d->build_mutex.tryLock())
+        return;
+
+    fetchItemChildren(parentItem);
+    d->build_mutex.unlock();
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::fetchItemChildren(ObserverTreeItem* item) {
+    int child_count = item->childCount();
+    QList<ObserverTreeItem*> new_items = d->tree_builder.fetchChildren(item);
+    if (new_items.count() > 0) {
+        beginInsertRows(indexForItem(item),child_count,child_count + new_items.count() - 1);
+        for (int i = 0; i < new_items.count(); ++i)
+            item->appendChild(new_items.at(i));
+        endInsertRows();
+
+        for (int i = 0; i < new_items.count(); ++i)
+            registerObserverItems(new_items.at(i));
+    }
+
+    return (new_items.count() > 0 || item->isPopulated());
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::populatePathTo(QObject* obj) {
+    if (!d->on_demand_population || !d->tree_model_up_to_date || !d_observer || !obj || !d->rootItem)
+        return false;
+
+    // The root item displays the observer context when the root index is hidden:
+    ObserverTreeItem* item = d->rootItem;
+    if (item->getObject() != d_observer)
+        item = (item->childCount() > 0) ? item->child(0) : 0;
+    if (!item || item->getObject() != d_observer)
+        return false;
+
+    QList<Observer*> path;
+    QSet<QObject*> visited;
+    if (!findObserverPath(obj,path,visited))
+        return false;
+
+    // The first observer in the path is the observer context, we create the children of each observer in the path
+    // until the next observer in the path (or obj itself at the end of the path) was created:
+    bool populated = false;
+    for (int i = 1; i <= path.count(); ++i) {
+        QObject* next_obj = obj;
+        if (i < path.count())
+            next_obj = path.at(i);
+
+        ObserverTreeItem* next_item = findChildItem(item,next_obj);
+        while (!next_item && !item->isPopulated()) {
+            if (!fetchItemChildren(item))
+                return populated;
+            populated = true;
+            next_item = findChildItem(item,next_obj);
+        }
+        if (!next_item)
+            return populated;
+        item = next_item;
+    }
+
+    return populated;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::findObserverPath(QObject* obj, QList<Observer*>& path, QSet<QObject*>& visited) const {
+    QList<Observer*> parents = Observer::parentReferences(obj);
+    for (int i = 0; i < parents.count(); ++i) {
+        Observer* parent = parents.at(i);
+        if (parent != d_observer) {
+            if (visited.contains(parent))
+                continue;
+            visited.insert(parent);
+            if (!findObserverPath(parent,path,visited))
+                continue;
+        }
+
+        path << parent;
+        return true;
+    }
+
+    return false;
+}
+
+Qtilities::CoreGui::ObserverTreeItem* Qtilities::CoreGui::ObserverTreeModel::findChildItem(ObserverTreeItem* item, QObject* obj) const {
+    // Children displayed in a categorized hierarchy are found underneath category items:
+    for (int i = 0; i < item->childCount(); ++i) {
+        ObserverTreeItem* child = item->child(i);
+        if (!child)
+            continue;
+        if (child->getObject() == obj)
+            return child;
+        if (child->itemType() == ObserverTreeItem::CategoryItem) {
+            ObserverTreeItem* category_child = findChildItem(child,obj);
+            if (category_child)
+                return category_child;
+        }
+    }
+
+    return 0;
+}
+
+QModelIndexList Qtilities::CoreGui::ObserverTreeModel::populateExpandedNodes(const QStringList& node_names) {
+    QModelIndexList expanded_indexes = findExpandedNodeIndexes(node_names);
+    if (!d->on_demand_population)
+        return expanded_indexes;
+
+    // Expanded nodes underneath an expanded node can only be found once the children of that node were created:
+    bool fetched = true;
+    while (fetched) {
+        fetched = false;
+        for (int i = 0; i < expanded_indexes.count(); ++i) {
+            ObserverTreeItem* item = getItem(expanded_indexes.at(i));
+            while (item && !item->isPopulated() && fetchItemChildren(item))
+                fetched = true;
+        }
+        if (fetched)
+            expanded_indexes = findExpandedNodeIndexes(node_names);
+    }
+
+    return expanded_indexes;
+}
+
 bool Qtilities::CoreGui::ObserverTreeModel::dropMimeData(const QMimeData * data, Qt::DropAction action, int row, int column, const QModelIndex & parent) {
     Q_UNUSED(data)
     Q_UNUSED(action)
@@ -1110,6 +1314,14 @@ void Qtilities::CoreGui::ObserverTreeModel::recordObserverChange(QList<QPointer<
         return;
     }
 
+    // The changed branches were already updated in handleSubjectsChanged(), thus we don't need to rebuild the tree:
+    if (d->pending_layout_notifications > 0) {
+        --d->pending_layout_notifications;
+        if (new_selection.count() > 0)
+            emit selectObjects(new_selection);
+        return;
+    }
+
     if (d->tree_model_up_to_date) {
         if (d->build_mutex.tryLock()) {
             d->new_selection = new_selection;
@@ -1139,6 +1351,7 @@ void Qtilities::CoreGui::ObserverTreeModel::clearTreeStructure() {
     beginResetModel();
     emit layoutAboutToBeChanged();
     d->tree_model_up_to_date = false;
+    clearObserverItems();
     deleteRootItem();
     QVector<QVariant> columns;
     columns.push_back(QString("Child Count"));
@@ -1183,6 +1396,7 @@ void Qtilities::CoreGui::ObserverTreeModel::rebuildTreeStructure() {
     beginResetModel();
     d->tree_model_up_to_date = false;
     QApplication::processEvents();
+    clearObserverItems();
     deleteRootItem();
 
     // The root index display hint determines how we create the root node:
@@ -1215,6 +1429,10 @@ void Qtilities::CoreGui::ObserverTreeModel::rebuildTreeStructure() {
         d->tree_builder.setRootItem(item_to_send_to_builder);
         d->tree_builder.setUseObserverHints(model->use_observer_hints);
         d->tree_builder.setActiveHints(activeHints());
+        d->tree_builder.setOnDemandPopulationEnabled(d->on_demand_population);
+        d->tree_builder.setFetchBatchSize(d->fetch_batch_size);
+        d->tree_builder.setParallelBuildEnabled(d->parallel_tree_building);
+        d->tree_builder.setParallelThreadCount(d->tree_building_thread_count);
         d->tree_builder.setThreadingEnabled(true);
 
         item_to_send_to_builder->setParent(0);
@@ -1231,6 +1449,10 @@ void Qtilities::CoreGui::ObserverTreeModel::rebuildTreeStructure() {
         d->tree_builder.setRootItem(item_to_send_to_builder);
         d->tree_builder.setUseObserverHints(model->use_observer_hints);
         d->tree_builder.setActiveHints(activeHints());
+        d->tree_builder.setOnDemandPopulationEnabled(d->on_demand_population);
+        d->tree_builder.setFetchBatchSize(d->fetch_batch_size);
+        d->tree_builder.setParallelBuildEnabled(d->parallel_tree_building);
+        d->tree_builder.setParallelThreadCount(d->tree_building_thread_count);
 
         connect(&d->tree_builder,SIGNAL(buildCompleted(ObserverTreeItem*)),SLOT(receiveBuildObserverTreeItem(ObserverTreeItem*)),Qt::UniqueConnection);
         d->tree_builder.startBuild();
@@ -1259,12 +1481,14 @@ void Qtilities::CoreGui::ObserverTreeModel::receiveBuildObserverTreeItem(Observe
     if (d->tree_rebuild_queued) {
         rebuildTreeStructure();
     } else {
+        registerObserverItems(d->rootItem);
+
         // From my understanding not needed because we do a proper reset sequence.
         emit layoutAboutToBeChanged();
         emit layoutChanged();
 
         // Restore expanded items:
-        QModelIndexList expanded_indexes = findExpandedNodeIndexes(d->expanded_items);
+        QModelIndexList expanded_indexes = populateExpandedNodes(d->expanded_items);
         emit expandItemsRequest(expanded_indexes);
 
         // Handle item selection after tree has been rebuilt:
@@ -1281,6 +1505,277 @@ void Qtilities::CoreGui::ObserverTreeModel::receiveBuildObserverTreeItem(Observe
     emit treeModelBuildEnded();
 }
 
+void Qtilities::CoreGui::ObserverTreeModel::handleSubjectsChanged(Observer::SubjectChangeIndication change_indication, QList<QPointer<QObject> > objects) {
+    Q_UNUSED(change_indication)
+    Q_UNUSED(objects)
+
+    Observer* observer = qobject_cast<Observer*> (sender());
+    if (!observer || !respondToObserverChanges())
+        return;
+
+    // When the tree is busy being built, the layoutChanged() signal which follows will queue a rebuild:
+    if (!d->tree_model_up_to_date)
+        return;
+    if (!d->build_mutex.tryLock())
+        return;
+
+    // The displayed children are compared against the current subjects of the observer, thus we don't use objects. It is empty
+    // at the end of processing cycles and when subjects went out of scope.
+    bool updated = false;
+    bool rebuild_needed = false;
+    QList<QPointer<ObserverTreeItem> > items = d->observer_items.value(observer);
+    for (int i = 0; i < items.count(); ++i) {
+        if (!items.at(i))
+            continue;
+
+        if (synchronizeObserverItem(items.at(i),observer)) {
+            updated = true;
+        } else {
+            rebuild_needed = true;
+            break;
+        }
+    }
+    d->build_mutex.unlock();
+
+    if (!updated && !rebuild_needed) {
+        // The observer is not displayed anymore:
+        d->observer_items.remove(observer);
+        observer->disconnect(SIGNAL(numberOfSubjectsChanged(Observer::SubjectChangeIndication,QList<QPointer<QObject> >)),this,SLOT(handleSubjectsChanged(Observer::SubjectChangeIndication,QList<QPointer<QObject> >)));
+        observer->disconnect(SIGNAL(monitoredPropertyChanged(const char*,QList<QObject*>)),this,SLOT(handleMonitoredPropertyChanged(const char*,QList<QObject*>)));
+        d->monitored_observers.removeOne(observer);
+    }
+
+    // Notifications of earlier changes were all delivered before this change was announced, thus we don't add to the count:
+    if (updated && !rebuild_needed) {
+        QHash<Observer*,int> path_counts;
+        d->pending_layout_notifications = layoutNotificationCount(observer,path_counts);
+    } else {
+        d->pending_layout_notifications = 0;
+    }
+}
+
+int Qtilities::CoreGui::ObserverTreeModel::layoutNotificationCount(Observer* observer, QHash<Observer*,int>& path_counts) const {
+    if (observer == d_observer)
+        return 1;
+    if (path_counts.contains(observer))
+        return path_counts.value(observer);
+
+    int count = 0;
+    QList<Observer*> parents = Observer::parentReferences(observer);
+    for (int i = 0; i < parents.count(); ++i)
+        count += layoutNotificationCount(parents.at(i),path_counts);
+    path_counts[observer] = count;
+    return count;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::handleMonitoredPropertyChanged(const char* property_name, QList<QObject*> objects) {
+    Q_UNUSED(property_name)
+
+    Observer* observer = qobject_cast<Observer*> (sender());
+    if (!observer || objects.isEmpty() || !respondToObserverChanges() || !d->tree_model_up_to_date)
+        return;
+
+    QSet<QObject*> changed_objects = objects.toSet();
+    int last_column = columnPosition(AbstractObserverItemModel::ColumnLast);
+    QList<QPointer<ObserverTreeItem> > items = d->observer_items.value(observer);
+    for (int i = 0; i < items.count(); ++i) {
+        if (!items.at(i))
+            continue;
+
+        // Subjects of categorized observers live underneath category items:
+        QList<ObserverTreeItem*> items_to_check;
+        items_to_check << items.at(i);
+        while (!items_to_check.isEmpty()) {
+            ObserverTreeItem* item = items_to_check.takeLast();
+            for (int row = 0; row < item->childCount(); ++row) {
+                ObserverTreeItem* child_item = item->child(row);
+                if (!child_item)
+                    continue;
+                if (child_item->itemType() == ObserverTreeItem::CategoryItem)
+                    items_to_check << child_item;
+                else if (changed_objects.contains(child_item->getObject()))
+                    emit dataChanged(createIndex(row,0,child_item),createIndex(row,last_column,child_item));
+            }
+        }
+    }
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::synchronizeObserverItem(ObserverTreeItem* item, Observer* observer) {
+    if (!item || !observer)
+        return false;
+
+    // Categories are built from the category map of the complete observer, we rebuild these:
+    if (usesCategorizedHierarchy(observer))
+        return false;
+
+    // The children of locked observers are not shown:
+    if (observer->accessMode() == Observer::LockedAccess)
+        return (item->childCount() == 0);
+
+    QModelIndex parent_index = indexForItem(item);
+    QList<QObject*> subjects = observer->subjectReferences();
+    QSet<QObject*> subject_set = subjects.toSet();
+
+    // Remove the items of subjects which are not observed anymore, or which went out of scope.
+    // Consecutive rows are removed together:
+    QSet<QObject*> displayed_subjects;
+    QVector<bool> keep_row(item->childCount(),false);
+    for (int row = 0; row < item->childCount(); ++row) {
+        ObserverTreeItem* child_item = item->child(row);
+        QObject* obj = child_item ? child_item->getObject().data() : 0;
+        if (obj && subject_set.contains(obj)) {
+            keep_row[row] = true;
+            displayed_subjects << obj;
+        }
+    }
+
+    int row = item->childCount() - 1;
+    while (row >= 0) {
+        if (keep_row.at(row)) {
+            --row;
+            continue;
+        }
+
+        int last_row = row;
+        while (row > 0 && !keep_row.at(row - 1))
+            --row;
+
+        beginRemoveRows(parent_index,row,last_row);
+        for (int i = last_row; i >= row; --i)
+            delete item->takeChild(i);
+        endRemoveRows();
+        --row;
+    }
+
+    // Insert items for new subjects at the position of the subjects in the observer. Since the remaining items are
+    // in the same order as the subjects, the position of a subject is also its row. Consecutive rows are inserted together:
+    int subject_count = subjects.count();
+    int i = 0;
+    while (i < subject_count) {
+        if (displayed_subjects.contains(subjects.at(i))) {
+            ++i;
+            continue;
+        }
+
+        // Subjects after the last created child of an unpopulated item are created when the view fetches them:
+        if (!item->isPopulated() && i >= item->childCount())
+            break;
+
+        int first_row = i;
+        QList<ObserverTreeItem*> new_items;
+        while (i < subject_count && !displayed_subjects.contains(subjects.at(i))) {
+            QObject* obj = subjects.at(i);
+            Observer* obs = qobject_cast<Observer*> (obj);
+            QVector<QVariant> column_data;
+            column_data << QVariant(observer->subjectNameInContext(obj));
+            ObserverTreeItem* new_item;
+            if (obs) {
+                new_item = new ObserverTreeItem(obj,item,column_data,ObserverTreeItem::TreeNode);
+                d->tree_builder.buildSubtree(new_item);
+            } else
+                new_item = new ObserverTreeItem(obj,item,column_data,ObserverTreeItem::TreeItem);
+            new_items << new_item;
+            ++i;
+        }
+
+        beginInsertRows(parent_index,first_row,first_row + new_items.count() - 1);
+        for (int n = 0; n < new_items.count(); ++n)
+            item->insertChild(first_row + n,new_items.at(n));
+        endInsertRows();
+
+        for (int n = 0; n < new_items.count(); ++n)
+            registerObserverItems(new_items.at(n));
+    }
+
+    // The child count of the item changed:
+    if (parent_index.isValid())
+        emit dataChanged(parent_index,createIndex(item->row(),columnPosition(AbstractObserverItemModel::ColumnLast),item));
+
+    return true;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::usesCategorizedHierarchy(Observer* observer) const {
+    // Must match the way ObserverTreeModelBuilder decides on the hierarchy:
+    if (model->use_observer_hints) {
+        if (observer->displayHints())
+            return (observer->displayHints()->hierarchicalDisplayHint() == ObserverHints::CategorizedHierarchy);
+        else
+            return false;
+    }
+
+    if (activeHints())
+        return (activeHints()->hierarchicalDisplayHint() == ObserverHints::CategorizedHierarchy);
+    return false;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::registerObserverItems(ObserverTreeItem* item) {
+    if (!item)
+        return;
+
+    Observer* observer = qobject_cast<Observer*> (item->getObject());
+    if (observer && item->itemType() != ObserverTreeItem::CategoryItem) {
+        if (!d->observer_items.contains(observer)) {
+            connect(observer,SIGNAL(numberOfSubjectsChanged(Observer::SubjectChangeIndication,QList<QPointer<QObject> >)),SLOT(handleSubjectsChanged(Observer::SubjectChangeIndication,QList<QPointer<QObject> >)),Qt::UniqueConnection);
+            connect(observer,SIGNAL(monitoredPropertyChanged(const char*,QList<QObject*>)),SLOT(handleMonitoredPropertyChanged(const char*,QList<QObject*>)),Qt::UniqueConnection);
+            d->monitored_observers << observer;
+        }
+        d->observer_items[observer] << item;
+    }
+
+    for (int i = 0; i < item->childCount(); ++i)
+        registerObserverItems(item->child(i));
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::clearObserverItems() {
+    for (int i = 0; i < d->monitored_observers.count(); ++i) {
+        Observer* observer = d->monitored_observers.at(i);
+        if (!observer)
+            continue;
+        observer->disconnect(SIGNAL(numberOfSubjectsChanged(Observer::SubjectChangeIndication,QList<QPointer<QObject> >)),this,SLOT(handleSubjectsChanged(Observer::SubjectChangeIndication,QList<QPointer<QObject> >)));
+        observer->disconnect(SIGNAL(monitoredPropertyChanged(const char*,QList<QObject*>)),this,SLOT(handleMonitoredPropertyChanged(const char*,QList<QObject*>)));
+    }
+    d->monitored_observers.clear();
+    d->observer_items.clear();
+    d->pending_layout_notifications = 0;
+}
+
+QModelIndex Qtilities::CoreGui::ObserverTreeModel::indexForItem(ObserverTreeItem* item) const {
+    if (!item || item == d->rootItem)
+        return QModelIndex();
+
+    return createIndex(item->row(),0,item);
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::toggleOnDemandPopulation(bool enabled) {
+    d->on_demand_population = enabled;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::onDemandPopulationEnabled() const {
+    return d->on_demand_population;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::setFetchBatchSize(int batch_size) {
+    if (batch_size > 0)
+        d->fetch_batch_size = batch_size;
+}
+
+int Qtilities::CoreGui::ObserverTreeModel::fetchBatchSize() const {
+    return d->fetch_batch_size;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::toggleParallelTreeBuilding(bool enabled) {
+    d->parallel_tree_building = enabled;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::parallelTreeBuildingEnabled() const {
+    return d->parallel_tree_building;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::setTreeBuildingThreadCount(int thread_count) {
+    if (thread_count > 0)
+        d->tree_building_thread_count = thread_count;
+}
+
 void Qtilities::CoreGui::ObserverTreeModel::setExpandedItems(QStringList expanded_items) {
     //qDebug() << "setExpandedItems" << expanded_items;
     d->expanded_items = expanded_items;
@@ -1451,7 +1946,16 @@ QModelIndexList Qtilities::CoreGui::ObserverTreeModel::getPersistentIndexList()
 
 QModelIndex Qtilities::CoreGui::ObserverTreeModel::findObject(QObject* obj, int column) const {
     QModelIndex root = index(0,0);
-    return findObject(root,obj,column);
+    QModelIndex obj_index = findObject(root,obj,column);
+
+    // Objects underneath observers which were not populated yet are created on demand. This only adds rows which the
+    // model would have created when the view fetched them, thus we allow it in this const function:
+    if (!obj_index.isValid() && d->on_demand_population) {
+        if (const_cast<ObserverTreeModel*> (this)->populatePathTo(obj))
+            obj_index = findObject(root,obj,column);
+    }
+
+    return obj_index;
 }
 
 QModelIndex Qtilities::CoreGui::ObserverTreeModel::getIndex(QObject *obj, int column) const {
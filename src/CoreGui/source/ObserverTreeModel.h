@@ -20,6 +20,8 @@
 
 #include <QMutex>
 #include <QAbstractItemModel>
+#include <QHash>
+#include <QSet>
 #include <QStack>
 #include <QItemSelection>
 
@@ -67,6 +69,9 @@ namespace Qtilities {
             virtual bool setData(const QModelIndex &index, const QVariant &value, int role);
             virtual QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
             virtual QModelIndex parent(const QModelIndex &index) const;
+            virtual bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+            virtual bool canFetchMore(const QModelIndex &parent) const;
+            virtual void fetchMore(const QModelIndex &parent);
             virtual bool dropMimeData(const QMimeData * data, Qt::DropAction action, int row, int column, const QModelIndex & parent);
             virtual Qt::DropActions supportedDropActions() const;
 
@@ -106,6 +111,9 @@ namespace Qtilities {
             ObserverTreeItem* getItem(const QModelIndex &index) const;
             //! Function to get the model index of an object in the tree. If the object does not exist, QModelIndex() is returned.
             /*!
+              When on demand population is enabled and \p obj is underneath observers which were not populated yet, the children of
+              the observers between the observer context and \p obj are created first.
+
               \param obj The object to find.
               \param column The column requested.
               \returns The QModelIndex of the specified object. If the object was not found QModelIndex() is returned.
@@ -130,6 +138,77 @@ namespace Qtilities {
               */
             QModelIndexList findExpandedNodeIndexes(const QStringList& node_names) const;
 
+            //! Enables/disables on demand population of the tree.
+            /*!
+              By default the complete tree underneath the observer context is built when the model is initialized. When on demand population is
+              enabled, only the children of the top level observer are built. The children of other observers are created in batches through
+              fetchMore() when they are expanded in the view, thus the time it takes to build the tree becomes proportional to the number of
+              visible rows instead of the size of the tree.
+
+              Observers displayed in a categorized hierarchy create all their children (but not the children of observers underneath them) at once.
+
+              \note Objects underneath observers which were not populated yet are populated when they are looked up using findObject(), thus
+              selecting such objects works as before. The observers leading to expanded items are also populated when expanded items are
+              restored after a rebuild of the tree. Categories underneath observers which were not populated yet can't be found using findCategory().
+              \note You must call this function before setObserverContext() for it to have any effect.
+
+              \sa onDemandPopulationEnabled(), setFetchBatchSize()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void toggleOnDemandPopulation(bool enabled);
+            //! Gets if on demand population of the tree is enabled.
+            /*!
+              \sa toggleOnDemandPopulation()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool onDemandPopulationEnabled() const;
+            //! Sets the maximum number of children created at once for an observer when populating the tree on demand.
+            /*!
+              The default is 1000.
+
+              \sa toggleOnDemandPopulation()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFetchBatchSize(int batch_size);
+            //! Gets the maximum number of children created at once for an observer when populating the tree on demand.
+            /*!
+              \sa setFetchBatchSize()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int fetchBatchSize() const;
+            //! Enables/disables parallel building of the tree.
+            /*!
+              When enabled, the subtrees of independent observers in the tree are built concurrently on a thread pool. See
+              ObserverTreeModelBuilder::setParallelBuildEnabled() for more details.
+
+              Parallel tree building is disabled by default and it is not used when on demand population is enabled.
+
+              \sa parallelTreeBuildingEnabled(), setTreeBuildingThreadCount()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void toggleParallelTreeBuilding(bool enabled);
+            //! Gets if parallel building of the tree is enabled.
+            /*!
+              \sa toggleParallelTreeBuilding()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool parallelTreeBuildingEnabled() const;
+            //! Sets the maximum number of threads used when building the tree in parallel.
+            /*!
+              The default is QThread::idealThreadCount().
+
+              \sa toggleParallelTreeBuilding()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setTreeBuildingThreadCount(int thread_count);
+
         public slots:
             //! When the observer context changes, this function will take note of the change and when needed, the model will rebuild the internal tree structure using rebuildTreeStructure();
             /*!
@@ -216,6 +295,20 @@ namespace Qtilities {
             void rebuildTreeStructure();
             //! Slot which receives ready-built ObserverTreeItem from ObserverTreeModelBuilder.
             void receiveBuildObserverTreeItem(ObserverTreeItem* item);
+            //! Updates the branches of the observer which emitted the numberOfSubjectsChanged() signal without rebuilding the tree.
+            /*!
+              When all branches displaying the observer could be updated, the layoutChanged() signals which follow numberOfSubjectsChanged()
+              will not trigger a rebuild of the tree. One such signal arrives for every path from the observer to the observer context. Branches which are displayed using a categorized hierarchy are not updated incrementally
+              and the tree will be rebuilt as before.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSubjectsChanged(Observer::SubjectChangeIndication change_indication, QList<QPointer<QObject> > objects);
+            //! Emits dataChanged() for the rows of the objects which changed in the observer which emitted the monitoredPropertyChanged() signal.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleMonitoredPropertyChanged(const char* property_name, QList<QObject*> objects);
 
         protected:
             //! Recursive function used by findObject() to traverse through the tree trying to find an object.
@@ -229,6 +322,37 @@ namespace Qtilities {
             ObserverTreeItem* findCategory(ObserverTreeItem* item, QtilitiesCategory category) const;
             //! Deletes all tree items, starting with the root item.
             void deleteRootItem();
+            //! Returns the model index of column 0 for \p item, or an invalid index for the root item.
+            QModelIndex indexForItem(ObserverTreeItem* item) const;
+            //! Indicates if the children of \p observer are displayed in a categorized hierarchy.
+            bool usesCategorizedHierarchy(Observer* observer) const;
+            //! Synchronizes the children of \p item with the subjects of \p observer using row insertions and removals.
+            /*!
+              \returns True when the branch was updated, false when it can only be updated through a rebuild of the tree.
+              */
+            bool synchronizeObserverItem(ObserverTreeItem* item, Observer* observer);
+            //! Returns the number of times a layoutChanged() signal emitted by \p observer reaches this model through its parent observers.
+            int layoutNotificationCount(Observer* observer, QHash<Observer*,int>& path_counts) const;
+            //! Creates the next batch of children of \p item when populating on demand.
+            /*!
+              \returns True when children were created or all children of \p item exist, false otherwise.
+              */
+            bool fetchItemChildren(ObserverTreeItem* item);
+            //! Creates the children of all observers between the observer context and \p obj when populating on demand.
+            /*!
+              \returns True when any children were created.
+              */
+            bool populatePathTo(QObject* obj);
+            //! Finds a path of observers from the observer context to a parent of \p obj, in the order from the observer context down to the parent.
+            bool findObserverPath(QObject* obj, QList<Observer*>& path, QSet<QObject*>& visited) const;
+            //! Returns the child of \p item displaying \p obj, looking inside category items as well.
+            ObserverTreeItem* findChildItem(ObserverTreeItem* item, QObject* obj) const;
+            //! Finds the indexes for expanded nodes like findExpandedNodeIndexes(), populating expanded nodes when populating on demand.
+            QModelIndexList populateExpandedNodes(const QStringList& node_names);
+            //! Registers all observer items underneath and including \p item for incremental updates.
+            void registerObserverItems(ObserverTreeItem* item);
+            //! Removes all observer items registered for incremental updates.
+            void clearObserverItems();
 
             ObserverTreeModelData* d;
         };
@@ -12,6 +12,9 @@
 #include "ObserverTreeModelBuilder.h"
 #include <QtilitiesCoreGui>
 
+#include <QThreadPool>
+#include <QRunnable>
+
 #include <stdio.h>
 #include <time.h>
 
@@ -21,7 +24,12 @@ struct Qtilities::CoreGui::ObserverTreeModelBuilderPrivateData  {
     ObserverTreeModelBuilderPrivateData() : hints(0),
         root_item(0),
         task(QObject::tr("Tree Builder"),false),
-        threading_enabled(false) {}
+        threading_enabled(false),
+        subtree_build(false),
+        on_demand_population(false),
+        fetch_batch_size(1000),
+        parallel_build(false),
+        deferred_items(0) {}
 
     QMutex                          build_lock;
     ObserverHints*                  hints;
@@ -30,6 +38,64 @@ struct Qtilities::CoreGui::ObserverTreeModelBuilderPrivateData  {
     Task                            task;
     QThread*                        thread;
     bool                            threading_enabled;
+    //! Indicates that buildSubtree() is busy, in which case events must not be processed during the build.
+    bool                            subtree_build;
+    bool                            on_demand_population;
+    int                             fetch_batch_size;
+    bool                            parallel_build;
+    QThreadPool                     build_pool;
+    //! When set, observer items are not built but collected in this list. Used to find the tasks of parallel builds.
+    QList<ObserverTreeItem*>*       deferred_items;
+};
+
+/*!
+  \class Qtilities::CoreGui::ObserverTreeModelBuilderTask
+  \brief Builds the subtree of a single observer during parallel builds of ObserverTreeModelBuilder.
+
+  The subtree is built underneath a temporary item which is moved to the thread of the builder when done, since items
+  created in the thread pool can't be added to the tree from there.
+  */
+class Qtilities::CoreGui::ObserverTreeModelBuilderTask : public QRunnable {
+public:
+    ObserverTreeModelBuilderTask(ObserverTreeModelBuilder* builder, ObserverTreeItem* item, QThread* target_thread) :
+        builder(builder),
+        item(item),
+        target_thread(target_thread),
+        built_item(0) {
+        setAutoDelete(false);
+        observer = item->getObject();
+        item_type = item->itemType();
+    }
+
+    void run() {
+        built_item = new ObserverTreeItem(observer,0,QVector<QVariant>(),item_type);
+        builder->buildRecursive(built_item);
+        built_item->moveToThread(target_thread);
+    }
+
+    //! Moves the built children to the item in the tree, must be called in the thread of the builder.
+    void stitch() {
+        if (!built_item)
+            return;
+
+        QList<ObserverTreeItem*> children;
+        for (int i = built_item->childCount() - 1; i >= 0; --i)
+            children.prepend(built_item->takeChild(i));
+        for (int i = 0; i < children.count(); ++i)
+            item->appendChild(children.at(i));
+        item->setPopulated(built_item->isPopulated());
+
+        delete built_item;
+        built_item = 0;
+    }
+
+private:
+    ObserverTreeModelBuilder*           builder;
+    ObserverTreeItem*                   item;
+    QThread*                            target_thread;
+    QPointer<QObject>                   observer;
+    ObserverTreeItem::TreeItemType      item_type;
+    ObserverTreeItem*                   built_item;
 };
 
 Qtilities::CoreGui::ObserverTreeModelBuilder::ObserverTreeModelBuilder(ObserverTreeItem* item, bool use_observer_hints, ObserverHints* observer_hints, QObject* parent) : QObject(parent) {
@@ -89,7 +155,10 @@ void Qtilities::CoreGui::ObserverTreeModelBuilder::startBuild() {
 
     d->task.startTask();
     QApplication::processEvents();
-    buildRecursive(d->root_item);
+    if (d->parallel_build && !d->on_demand_population)
+        buildParallel(d->root_item);
+    else
+        buildRecursive(d->root_item);
 
     if (d->threading_enabled) {
         d->root_item->moveToThread(d->thread);
@@ -103,13 +172,164 @@ void Qtilities::CoreGui::ObserverTreeModelBuilder::startBuild() {
     emit buildCompleted(d->root_item);
 }
 
+void Qtilities::CoreGui::ObserverTreeModelBuilder::buildSubtree(ObserverTreeItem* item) {
+    if (!item)
+        return;
+
+    d->build_lock.lock();
+    d->subtree_build = true;
+    buildRecursive(item);
+    d->subtree_build = false;
+    d->build_lock.unlock();
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::setParallelBuildEnabled(bool is_enabled) {
+    d->parallel_build = is_enabled;
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::setParallelThreadCount(int thread_count) {
+    if (thread_count > 0)
+        d->build_pool.setMaxThreadCount(thread_count);
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::buildParallel(ObserverTreeItem* item) {
+    if (!item)
+        return;
+
+    // Events may not be processed while tasks are running:
+    bool current_subtree_build = d->subtree_build;
+    d->subtree_build = true;
+
+    // Expand the top levels of the tree in this thread until there are enough observers to keep all threads busy. Deep trees
+    // with few observers per level are expanded further than wide trees:
+    QList<ObserverTreeItem*> frontier;
+    d->deferred_items = &frontier;
+    buildRecursive(item);
+    int task_target = 4 * d->build_pool.maxThreadCount();
+    while (frontier.count() > 0 && frontier.count() < task_target) {
+        QList<ObserverTreeItem*> level = frontier;
+        frontier.clear();
+        for (int i = 0; i < level.count(); ++i) {
+            level.at(i)->setPopulated(true);
+            buildRecursive(level.at(i));
+        }
+    }
+    d->deferred_items = 0;
+
+    // Build the subtrees of the remaining observers concurrently:
+    QList<ObserverTreeModelBuilderTask*> tasks;
+    for (int i = 0; i < frontier.count(); ++i) {
+        ObserverTreeModelBuilderTask* task = new ObserverTreeModelBuilderTask(this,frontier.at(i),QThread::currentThread());
+        tasks << task;
+        d->build_pool.start(task);
+    }
+    d->build_pool.waitForDone();
+
+    for (int i = 0; i < tasks.count(); ++i) {
+        tasks.at(i)->stitch();
+        delete tasks.at(i);
+    }
+
+    d->subtree_build = current_subtree_build;
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::buildObserverItem(ObserverTreeItem* item) {
+    if (d->on_demand_population) {
+        item->setPopulated(false);
+    } else if (d->deferred_items) {
+        item->setPopulated(false);
+        d->deferred_items->append(item);
+    } else
+        buildRecursive(item);
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::setOnDemandPopulationEnabled(bool is_enabled) {
+    d->on_demand_population = is_enabled;
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::setFetchBatchSize(int batch_size) {
+    if (batch_size > 0)
+        d->fetch_batch_size = batch_size;
+}
+
+QList<Qtilities::CoreGui::ObserverTreeItem*> Qtilities::CoreGui::ObserverTreeModelBuilder::fetchChildren(ObserverTreeItem* item) {
+    QList<ObserverTreeItem*> children;
+    if (!item || item->isPopulated())
+        return children;
+
+    Observer* observer = qobject_cast<Observer*> (item->getObject());
+    if (!observer || item->itemType() == ObserverTreeItem::CategoryItem) {
+        item->setPopulated(true);
+        return children;
+    }
+
+    d->build_lock.lock();
+    d->subtree_build = true;
+
+    if (observer->accessMode() == Observer::LockedAccess) {
+        item->setPopulated(true);
+    } else if (useCategorizedHierarchy(observer)) {
+        // Categories are built from the complete category map of the observer, thus we build all children together
+        // underneath a temporary item and hand them over:
+        ObserverTreeItem* temp_item = new ObserverTreeItem(observer,0,QVector<QVariant>(),item->itemType());
+        buildRecursive(temp_item);
+        for (int i = temp_item->childCount() - 1; i >= 0; --i)
+            children.prepend(temp_item->takeChild(i));
+        delete temp_item;
+        item->setPopulated(true);
+    } else {
+        int start = item->childCount();
+        int count = qMin(d->fetch_batch_size,observer->subjectCount() - start);
+        if (count > 0)
+            children = buildSubjectItems(item,observer,start,count);
+        if (start + children.count() >= observer->subjectCount())
+            item->setPopulated(true);
+    }
+
+    d->subtree_build = false;
+    d->build_lock.unlock();
+    return children;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModelBuilder::useCategorizedHierarchy(Observer* observer) const {
+    // Remember we can't use the active hints for observers in the tree, those are linked to the selection parent.
+    if (d->use_hints) {
+        if (observer->displayHints())
+            return (observer->displayHints()->hierarchicalDisplayHint() == ObserverHints::CategorizedHierarchy);
+        else
+            return false;
+    } else
+        return (d->hints->hierarchicalDisplayHint() == ObserverHints::CategorizedHierarchy);
+}
+
+QList<Qtilities::CoreGui::ObserverTreeItem*> Qtilities::CoreGui::ObserverTreeModelBuilder::buildSubjectItems(ObserverTreeItem* item, Observer* observer, int start, int count) {
+    QList<ObserverTreeItem*> new_items;
+    ObserverTreeItem* new_item;
+    int end = qMin(start + count,observer->subjectCount());
+    for (int i = start; i < end; ++i) {
+        QObject* obj_at = observer->subjectAt(i);
+        Observer* obs = qobject_cast<Observer*> (obj_at);
+        QVector<QVariant> column_data;
+        column_data << QVariant(observer->subjectNameInContext(obj_at));
+        if (obs)
+            new_item = new ObserverTreeItem(obj_at,item,column_data,ObserverTreeItem::TreeNode);
+        else
+            new_item = new ObserverTreeItem(obj_at,item,column_data,ObserverTreeItem::TreeItem);
+        new_items << new_item;
+
+        if (obs)
+            buildObserverItem(new_item);
+    }
+    return new_items;
+}
+
 void Qtilities::CoreGui::ObserverTreeModelBuilder::buildRecursive(ObserverTreeItem* item, QList<QPointer<QObject> > category_objects) {
      // In here we build the complete structure of all the children below item.
     Observer* observer = qobject_cast<Observer*> (item->getObject());
     ObserverTreeItem* new_item;
     //d->task.addCompletedSubTasks(1,"Building item: " + item->objectName());
 
-    if (!d->threading_enabled)
+    if (!d->threading_enabled && !d->subtree_build)
         QApplication::processEvents();
 
     if (!observer && item->getObject()) {
@@ -136,7 +356,7 @@ void Qtilities::CoreGui::ObserverTreeModelBuilder::buildRecursive(ObserverTreeIt
                             item->appendChild(new_item);
 
                             if (obs)
-                                buildRecursive(new_item);
+                                buildObserverItem(new_item);
                         }
                     }
                 }
@@ -149,26 +369,20 @@ void Qtilities::CoreGui::ObserverTreeModelBuilder::buildRecursive(ObserverTreeIt
         if (observer->accessMode() != Observer::LockedAccess) {
             // Check the HierarchicalDisplay hint of the observer:
             // Remember this is an recursive function, we can't use hints directly since thats linked to the selection parent.
-            bool use_categorized;
+            bool use_categorized = useCategorizedHierarchy(observer);
             ObserverHints* hints_to_use = 0;
-            if (d->use_hints) {
-                if (observer->displayHints()) {
-                    use_categorized = (observer->displayHints()->hierarchicalDisplayHint() == ObserverHints::CategorizedHierarchy);
-                    hints_to_use = observer->displayHints();
-                } else
-                    use_categorized = false;
-            } else {
-                use_categorized = (d->hints->hierarchicalDisplayHint() == ObserverHints::CategorizedHierarchy);
+            if (d->use_hints)
+                hints_to_use = observer->displayHints();
+            else
                 hints_to_use = d->hints;
-            }
 
             if (use_categorized) {
-                // Get the object / category hash:
-                QMap<QPointer<QObject>, QString> category_map = observer->subjectReferenceCategoryMap();
-                QSet<QString> categories = category_map.values().toSet();
+                // Get the categories from the category index of the observer, uncategorized subjects are added below:
+                QList<QtilitiesCategory> categories = observer->subjectCategories();
 
-                foreach (const QString& category_string, categories) {
-                    QtilitiesCategory category = QtilitiesCategory(category_string,"::");
+                foreach (const QtilitiesCategory& category, categories) {
+                    if (category.isEmpty())
+                        continue;
                     // Check the category against the displayed category list:
                     bool valid_category = true;
                     if (hints_to_use) {
@@ -233,7 +447,10 @@ void Qtilities::CoreGui::ObserverTreeModelBuilder::buildRecursive(ObserverTreeIt
 
                                 // If this item has locked access, we don't dig into any items underneath it:
                                 if (observer->accessMode(shortened_category) != Observer::LockedAccess) {
-                                    QList<QPointer<QObject> > safe_list = category_map.keys(category_levels.join("::"));
+                                    QList<QObject*> category_subjects = observer->subjectReferencesByCategory(shortened_category);
+                                    QList<QPointer<QObject> > safe_list;
+                                    for (int i = 0; i < category_subjects.count(); ++i)
+                                        safe_list << category_subjects.at(i);
                                     buildRecursive(new_item,safe_list);
                                 } else
                                     break;
@@ -261,28 +478,22 @@ void Qtilities::CoreGui::ObserverTreeModelBuilder::buildRecursive(ObserverTreeIt
                         item->appendChild(new_item);
                         // If this item has locked access, we don't dig into any items underneath it:
                         if (obs->accessMode(QtilitiesCategory()) != Observer::LockedAccess && obs)
-                            buildRecursive(new_item);
+                            buildObserverItem(new_item);
                     } else {
                         new_item = new ObserverTreeItem(obj_at,item,column_data,ObserverTreeItem::TreeItem);
                         item->appendChild(new_item);
                     }
                 }
             } else {
+                // When populating on demand, only the first batch of children is created. The rest is created through fetchChildren():
                 int count = observer->subjectCount();
-                for (int i = 0; i < count; ++i) {
-                    QObject* obj_at = observer->subjectAt(i);
-                    Observer* obs = qobject_cast<Observer*> (obj_at);
-                    QVector<QVariant> column_data;
-                    column_data << QVariant(observer->subjectNameInContext(obj_at));
-                    if (obs)
-                        new_item = new ObserverTreeItem(obj_at,item,column_data,ObserverTreeItem::TreeNode);
-                    else
-                        new_item = new ObserverTreeItem(obj_at,item,column_data,ObserverTreeItem::TreeItem);
-                    item->appendChild(new_item);
+                if (d->on_demand_population && count > d->fetch_batch_size)
+                    count = d->fetch_batch_size;
 
-                    if (obs)
-                        buildRecursive(new_item);
-                }
+                QList<ObserverTreeItem*> new_items = buildSubjectItems(item,observer,0,count);
+                for (int i = 0; i < new_items.count(); ++i)
+                    item->appendChild(new_items.at(i));
+                item->setPopulated(count == observer->subjectCount());
             }
         }
     }
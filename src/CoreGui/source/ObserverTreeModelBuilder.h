@@ -26,6 +26,7 @@ namespace Qtilities {
         \brief Structure used by ObserverTreeModelBuilder to store private data.
           */
         struct ObserverTreeModelBuilderPrivateData;
+        class ObserverTreeModelBuilderTask;
 
         /*!
         \class ObserverTreeModelBuilder
@@ -45,6 +46,58 @@ namespace Qtilities {
             int taskID() const;
             //! Sets if threading is enabled in the builder.
             void setThreadingEnabled(bool is_enabled);
+            //! Builds the structure underneath \p item in the calling thread.
+            /*!
+              Used by ObserverTreeModel to populate items which are inserted into an existing tree. The item does not have to be
+              part of the tree built from the root item and buildCompleted() is not emitted.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void buildSubtree(ObserverTreeItem* item);
+            //! Sets if the tree must be populated on demand.
+            /*!
+              When enabled, items for observers are created unpopulated and the children of an observer are only created
+              when fetchChildren() is called on its item. Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setOnDemandPopulationEnabled(bool is_enabled);
+            //! Sets the maximum number of children created at once for an observer when populating on demand.
+            /*!
+              Children of observers displayed in a categorized hierarchy are always created together. The default is 1000.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFetchBatchSize(int batch_size);
+            //! Creates the next batch of children of the unpopulated \p item.
+            /*!
+              The children are returned without being added to \p item, allowing the model to announce the insertion before adding them.
+              The returned items must be appended to \p item in the order in which they are returned. When the batch completes the children
+              of \p item, it is marked as populated.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<ObserverTreeItem*> fetchChildren(ObserverTreeItem* item);
+            //! Sets if startBuild() must build independent observers in the tree concurrently.
+            /*!
+              When enabled, the builder expands the top levels of the tree until it has enough observers to keep the threads
+              busy. The subtrees underneath these observers are then built as separate tasks on a thread pool, after which they are
+              stitched into the tree. Small tasks are queued until a thread becomes free, thus threads which finish their subtrees early
+              pick up the remaining work.
+
+              The observers in the tree are only read during the build, thus like a threaded build the tree must not be changed while it
+              is being built. Parallel builds are not used when populating on demand. Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setParallelBuildEnabled(bool is_enabled);
+            //! Sets the maximum number of threads used during parallel builds.
+            /*!
+              The default is QThread::idealThreadCount().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setParallelThreadCount(int thread_count);
 
         public slots:
             //! Starts the build.
@@ -62,6 +115,16 @@ namespace Qtilities {
         private:
             //! Function which will rebuild the complete tree structure under the top level observer.
             void buildRecursive(ObserverTreeItem* item, QList<QPointer<QObject> > category_objects = QList<QPointer<QObject> >());
+            //! Creates items for \p count subjects of \p observer starting at \p start, without adding them to \p item.
+            QList<ObserverTreeItem*> buildSubjectItems(ObserverTreeItem* item, Observer* observer, int start, int count);
+            //! Indicates if the children of \p observer are built in a categorized hierarchy.
+            bool useCategorizedHierarchy(Observer* observer) const;
+            //! Builds the children of an observer item, or defers it when populating on demand or during parallel builds.
+            void buildObserverItem(ObserverTreeItem* item);
+            //! Builds the tree underneath \p item using the thread pool of the builder.
+            void buildParallel(ObserverTreeItem* item);
+
+            friend class ObserverTreeModelBuilderTask;
             //! Prints the structure of the tree as trace messages.
             /*!
               \sa LOG_TRACE
@@ -125,6 +125,7 @@ struct Qtilities::CoreGui::ObserverWidgetData {
         button_copy(Qt::LeftButton),
         disable_proxy_models(false),
         lazy_init(false),
+        on_demand_population(false),
         search_item_filter_flags(ObserverTreeItem::TreeItem){ }
 
     QAction* actionRemoveItem;
@@ -257,6 +258,8 @@ struct Qtilities::CoreGui::ObserverWidgetData {
 
     //! Stores if lazy initialization has been enabled on this widget.
     bool lazy_init;
+    //! Stores if on demand population of the tree has been enabled on this widget.
+    bool on_demand_population;
 
     ObserverTreeItem::TreeItemTypeFlags search_item_filter_flags;
 };
@@ -450,6 +453,16 @@ bool Qtilities::CoreGui::ObserverWidget::lazyInitEnabled() const {
     return d->lazy_init;
 }
 
+void Qtilities::CoreGui::ObserverWidget::toggleOnDemandPopulation(bool enabled) {
+    d->on_demand_population = enabled;
+    if (d->tree_model)
+        d->tree_model->toggleOnDemandPopulation(enabled);
+}
+
+bool Qtilities::CoreGui::ObserverWidget::onDemandPopulationEnabled() const {
+    return d->on_demand_population;
+}
+
 int Qtilities::CoreGui::ObserverWidget::topLevelObserverID() {
     if (d->top_level_observer)
         return d->top_level_observer->observerID();
@@ -486,6 +499,7 @@ bool Qtilities::CoreGui::ObserverWidget::setCustomTreeModel(ObserverTreeModel* t
     d->tree_model = tree_model;
     d->tree_model->setParent(this);
     d->tree_model->toggleLazyInit(d->lazy_init);
+    d->tree_model->toggleOnDemandPopulation(d->on_demand_population);
 
     connect(d->tree_model,SIGNAL(dataChanged(const QModelIndex &, const QModelIndex& )),this,SLOT(adaptColumns(const QModelIndex &, const QModelIndex&)));
     connect(d->tree_model,SIGNAL(treeModelBuildStarted(int)),SLOT(showProgressInfo(int)));
@@ -739,6 +753,7 @@ void Qtilities::CoreGui::ObserverWidget::initialize(bool hints_only) {
                 if (!d->tree_model) {
                     d->tree_model = new ObserverTreeModel(d->tree_view);
                     d->tree_model->toggleLazyInit(d->lazy_init);
+                    d->tree_model->toggleOnDemandPopulation(d->on_demand_population);
 
                     connect(d->tree_model,SIGNAL(treeModelBuildAboutToStart()),SLOT(handleTreeModelBuildAboutToStart()));
                     connect(d->tree_model,SIGNAL(treeModelBuildStarted(int)),SLOT(showProgressInfo(int)));
@@ -130,6 +130,28 @@ categorized_widget->show();
               <i>This function was added in %Qtilities v1.1.</i>
               */
             bool lazyInitEnabled() const;
+            //! Enables/disables on demand population of the tree in TreeView mode.
+            /*!
+              When enabled, the children of observers in the tree are only created when they are expanded in the view. This makes the
+              time it takes to initialize the widget on large trees proportional to the number of visible rows.
+
+              On demand population is disabled by default.
+
+              \note You must call this function before initialize() for it to have any effect.
+              \note Only usefull when in TreeView mode, in TableView mode this does not have any effect.
+
+              \sa onDemandPopulationEnabled(), ObserverTreeModel::toggleOnDemandPopulation()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void toggleOnDemandPopulation(bool enabled);
+            //! Gets if on demand population of the tree is enabled.
+            /*!
+              \sa toggleOnDemandPopulation()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool onDemandPopulationEnabled() const;
             //! Initializes the observer widget. Make sure to set the item model as well as the flags you would like to use before calling initialize.
             /*!
               \sa toggleLazyInit(), lazyInitEnabled()
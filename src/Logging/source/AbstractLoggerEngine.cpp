@@ -93,22 +93,24 @@ QString Qtilities::Logging::AbstractLoggerEngine::formattingEngineName() {
 }
 
 void Qtilities::Logging::AbstractLoggerEngine::newMessages(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
-    if ((!engine_name.isEmpty()) && (engine_name != name()))
+    if (!acceptsMessage(engine_name,message_type,message_context))
         return;
 
+    // Check if there is a formatting engine present
+    if (abstractLoggerEngineData->formatting_engine)
+        logMessage(Log->formatMessage(abstractLoggerEngineData->formatting_engine,message_type,messages),message_type);
+}
+
+bool Qtilities::Logging::AbstractLoggerEngine::acceptsMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context) const {
+    if ((!engine_name.isEmpty()) && (engine_name != name()))
+        return false;
+
     // Check the message context:
     if (!(abstractLoggerEngineData->message_contexts & message_context))
-        return;
+        return false;
 
-    // Check if active
-    if (abstractLoggerEngineData->is_enabled) {
-        // Check if there is a formatting engine present
-        if (abstractLoggerEngineData->formatting_engine) {
-            //Check if this message type is allowed
-            if (abstractLoggerEngineData->enabled_message_types & message_type)
-                logMessage(abstractLoggerEngineData->formatting_engine->formatMessage(message_type,messages),message_type);
-        }
-    }
+    // Check if active and if this message type is allowed
+    return abstractLoggerEngineData->is_enabled && (abstractLoggerEngineData->enabled_message_types & message_type);
 }
 
 bool Qtilities::Logging::AbstractLoggerEngine::removable() const {
@@ -120,10 +120,24 @@ namespace Qtilities {
         public slots:
             //! Function which is called to finalize the logger engine.
             virtual void finalize() = 0;
-            //! Slot which is connected to the newMessage() signal of the Logger class.
+            //! Slot through which the Logger delivers messages to the engine.
+            /*!
+              The Logger calls this function directly when the engine lives in the thread in which the message was logged, otherwise the
+              call is queued to the thread of the engine. When several engines in the same thread share a formatting engine, the message is
+              only formatted once.
+              */
             virtual void newMessages(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages);
 
         protected:
+            //! Checks if a message passed to newMessages() must be logged by this engine.
+            /*!
+              Checks the target engine name, message context, activity and enabled message types of the engine. Use this function when
+              reimplementing newMessages().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool acceptsMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context) const;
+
             AbstractLoggerEngineData* abstractLoggerEngineData;
         };
     }
@@ -0,0 +1,326 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "BinaryLogReader.h"
+#include "FormattingEngines.h"
+#include "LoggingConstants.h"
+
+#include <QFile>
+#include <QHash>
+#include <QtEndian>
+
+#include <string.h>
+
+using namespace Qtilities::Logging::Constants;
+
+namespace {
+    // Offsets of the fields in a record header, see FormattingEngine_Binary:
+    const int RECORD_SIZE_OFFSET        = 0;
+    const int RECORD_TYPE_OFFSET        = 4;
+    const int RECORD_MESSAGE_TYPE_OFFSET = 6;
+    const int RECORD_ARGUMENT_COUNT_OFFSET = 7;
+    const int RECORD_TIMESTAMP_OFFSET   = 8;
+    const int RECORD_ENGINE_ID_OFFSET   = 16;
+    const int RECORD_TEMPLATE_ID_OFFSET = 20;
+}
+
+struct Qtilities::Logging::BinaryLogReaderData {
+    BinaryLogReaderData() : data(0),
+        size(0),
+        version(0),
+        position(0),
+        message_types(Logger::AllLogLevels),
+        time_from(0),
+        time_to(0),
+        has_time_range(false) {}
+
+    QFile                   file;
+    uchar*                  data;
+    qint64                  size;
+    quint32                 version;
+    qint64                  position;
+    QString                 error_string;
+
+    int                     message_types;
+    qint64                  time_from;
+    qint64                  time_to;
+    bool                    has_time_range;
+
+    //! The offsets of the definition records seen so far. Definitions are only decoded when they are used.
+    QHash<quint32,qint64>   template_offsets;
+    QHash<quint32,qint64>   engine_offsets;
+    QHash<quint32,QString>  templates;
+    QHash<quint32,QString>  engines;
+};
+
+Qtilities::Logging::BinaryLogReader::BinaryLogReader() {
+    d = new BinaryLogReaderData;
+}
+
+Qtilities::Logging::BinaryLogReader::~BinaryLogReader() {
+    close();
+    delete d;
+}
+
+bool Qtilities::Logging::BinaryLogReader::open(const QString& file_name) {
+    close();
+
+    d->file.setFileName(file_name);
+    if (!d->file.open(QIODevice::ReadOnly)) {
+        d->error_string = QObject::tr("Failed to open binary log file %1: %2").arg(file_name).arg(d->file.errorString());
+        return false;
+    }
+
+    d->size = d->file.size();
+    if (d->size < FormattingEngine_Binary::FileHeaderSize) {
+        d->error_string = QObject::tr("Binary log file %1 does not contain a valid header.").arg(file_name);
+        close();
+        return false;
+    }
+
+    d->data = d->file.map(0,d->size);
+    if (!d->data) {
+        d->error_string = QObject::tr("Failed to map binary log file %1: %2").arg(file_name).arg(d->file.errorString());
+        close();
+        return false;
+    }
+
+    if (memcmp(d->data,qti_def_BINARY_LOG_MAGIC,8) != 0) {
+        d->error_string = QObject::tr("File %1 is not a binary log file.").arg(file_name);
+        close();
+        return false;
+    }
+    const quint32 version = qFromLittleEndian<quint32>(d->data + 8);
+    if (version < 1 || version > FormattingEngine_Binary::FormatVersion) {
+        d->error_string = QObject::tr("Binary log file %1 has an unsupported version: %2").arg(file_name).arg(version);
+        close();
+        return false;
+    }
+
+    d->version = version;
+    d->error_string.clear();
+    rewind();
+    return true;
+}
+
+void Qtilities::Logging::BinaryLogReader::close() {
+    if (d->data)
+        d->file.unmap(d->data);
+    d->data = 0;
+    d->size = 0;
+    d->position = 0;
+    d->version = 0;
+    d->template_offsets.clear();
+    d->engine_offsets.clear();
+    d->templates.clear();
+    d->engines.clear();
+    if (d->file.isOpen())
+        d->file.close();
+}
+
+bool Qtilities::Logging::BinaryLogReader::isOpen() const {
+    return d->data != 0;
+}
+
+QString Qtilities::Logging::BinaryLogReader::errorString() const {
+    return d->error_string;
+}
+
+void Qtilities::Logging::BinaryLogReader::setMessageTypeFilter(Logger::MessageTypeFlags message_types) {
+    d->message_types = message_types;
+}
+
+Qtilities::Logging::Logger::MessageTypeFlags Qtilities::Logging::BinaryLogReader::messageTypeFilter() const {
+    return Logger::MessageTypeFlags(d->message_types);
+}
+
+void Qtilities::Logging::BinaryLogReader::setTimeRange(const QDateTime& from, const QDateTime& to) {
+    setTimeRange(from.toMSecsSinceEpoch(),to.toMSecsSinceEpoch());
+}
+
+void Qtilities::Logging::BinaryLogReader::setTimeRange(qint64 from_msecs, qint64 to_msecs) {
+    d->time_from = from_msecs;
+    d->time_to = to_msecs;
+    d->has_time_range = true;
+}
+
+void Qtilities::Logging::BinaryLogReader::clearTimeRange() {
+    d->has_time_range = false;
+}
+
+void Qtilities::Logging::BinaryLogReader::rewind() {
+    const quint32 header_size = d->data ? qFromLittleEndian<quint32>(d->data + 12) : 0;
+    d->position = header_size;
+}
+
+bool Qtilities::Logging::BinaryLogReader::readNext(BinaryLogRecord* record) {
+    qint64 record_offset;
+    if (!nextMatchingRecord(&record_offset))
+        return false;
+
+    const uchar* header = d->data + record_offset;
+    const qint64 record_end = record_offset + qFromLittleEndian<quint32>(header + RECORD_SIZE_OFFSET);
+    const int argument_count = header[RECORD_ARGUMENT_COUNT_OFFSET];
+
+    record->offset = record_offset;
+    record->timestamp = qFromLittleEndian<qint64>(header + RECORD_TIMESTAMP_OFFSET);
+    record->message_type = (Logger::MessageType) header[RECORD_MESSAGE_TYPE_OFFSET];
+    record->engine_id = qFromLittleEndian<quint32>(header + RECORD_ENGINE_ID_OFFSET);
+    record->template_id = qFromLittleEndian<quint32>(header + RECORD_TEMPLATE_ID_OFFSET);
+    record->arguments.clear();
+
+    // Decode the packed arguments, stopping at the end of the record if it is malformed:
+    qint64 position = record_offset + FormattingEngine_Binary::RecordHeaderSize;
+    for (int i = 0; i < argument_count && position < record_end; ++i) {
+        const uchar argument_type = d->data[position++];
+        switch (argument_type) {
+        case FormattingEngine_Binary::IntegerArgument:
+            if (position + 8 > record_end)
+                return true;
+            record->arguments << QVariant(qFromLittleEndian<qint64>(d->data + position));
+            position += 8;
+            break;
+        case FormattingEngine_Binary::DoubleArgument: {
+            if (position + 8 > record_end)
+                return true;
+            const quint64 bits = qFromLittleEndian<quint64>(d->data + position);
+            double value;
+            memcpy(&value,&bits,sizeof(value));
+            record->arguments << QVariant(value);
+            position += 8;
+            break;
+        }
+        case FormattingEngine_Binary::BoolArgument:
+            if (position + 1 > record_end)
+                return true;
+            record->arguments << QVariant(d->data[position] != 0);
+            position += 1;
+            break;
+        case FormattingEngine_Binary::StringArgument: {
+            if (position + 4 > record_end)
+                return true;
+            const quint32 length = qFromLittleEndian<quint32>(d->data + position);
+            position += 4;
+            if (position + length > record_end)
+                return true;
+            record->arguments << QVariant(QString::fromUtf8((const char*) d->data + position,length));
+            position += length;
+            break;
+        }
+        default:
+            record->arguments << QVariant();
+            break;
+        }
+    }
+
+    return true;
+}
+
+int Qtilities::Logging::BinaryLogReader::countMatching() {
+    rewind();
+    int count = 0;
+    qint64 record_offset;
+    while (nextMatchingRecord(&record_offset))
+        ++count;
+    rewind();
+    return count;
+}
+
+QString Qtilities::Logging::BinaryLogReader::messageTemplate(quint32 template_id) const {
+    return definition(d->templates,d->template_offsets,template_id);
+}
+
+QString Qtilities::Logging::BinaryLogReader::engineName(quint32 engine_id) const {
+    return definition(d->engines,d->engine_offsets,engine_id);
+}
+
+QString Qtilities::Logging::BinaryLogReader::message(const BinaryLogRecord& record) const {
+    if (record.template_id == (quint32) FormattingEngine_Binary::InlineTemplateId) {
+        QString message = record.arguments.value(0).toString();
+        for (int i = 1; i < record.arguments.count(); ++i)
+            message.append(" " + record.arguments.at(i).toString());
+        return message;
+    }
+
+    // Version 1 templates are plain text without placeholders:
+    if (d->version < 2) {
+        QString message = messageTemplate(record.template_id);
+        for (int i = 0; i < record.arguments.count(); ++i)
+            message.append(" " + record.arguments.at(i).toString());
+        return message;
+    }
+
+    return FormattingEngine_Binary::instance().formatTemplate(messageTemplate(record.template_id),record.arguments);
+}
+
+bool Qtilities::Logging::BinaryLogReader::nextMatchingRecord(qint64* record_offset) {
+    if (!d->data)
+        return false;
+
+    while (d->position + FormattingEngine_Binary::RecordHeaderSize <= d->size) {
+        const uchar* header = d->data + d->position;
+        const quint32 record_size = qFromLittleEndian<quint32>(header + RECORD_SIZE_OFFSET);
+        // Stop at incomplete records, they are still being written or the file was truncated:
+        if (record_size < (quint32) FormattingEngine_Binary::RecordHeaderSize || d->position + record_size > d->size)
+            return false;
+
+        const qint64 offset = d->position;
+        d->position += record_size;
+
+        const quint16 record_type = qFromLittleEndian<quint16>(header + RECORD_TYPE_OFFSET);
+        // Only the offsets of definitions are stored while scanning, see definition():
+        if (record_type != FormattingEngine_Binary::MessageRecord) {
+            const quint32 id = qFromLittleEndian<quint32>(header + RECORD_TEMPLATE_ID_OFFSET);
+            if (record_type == FormattingEngine_Binary::TemplateRecord) {
+                d->template_offsets[id] = offset;
+                d->templates.remove(id);
+            } else if (record_type == FormattingEngine_Binary::EngineRecord) {
+                d->engine_offsets[id] = offset;
+                d->engines.remove(id);
+            }
+            continue;
+        }
+
+        if (!(d->message_types & header[RECORD_MESSAGE_TYPE_OFFSET]))
+            continue;
+        if (d->has_time_range) {
+            const qint64 timestamp = qFromLittleEndian<qint64>(header + RECORD_TIMESTAMP_OFFSET);
+            if (timestamp < d->time_from || timestamp > d->time_to)
+                continue;
+        }
+
+        *record_offset = offset;
+        return true;
+    }
+
+    return false;
+}
+
+QString Qtilities::Logging::BinaryLogReader::definition(QHash<quint32,QString>& decoded, const QHash<quint32,qint64>& offsets, quint32 id) const {
+    QHash<quint32,QString>::const_iterator itr = decoded.constFind(id);
+    if (itr != decoded.constEnd())
+        return itr.value();
+
+    QHash<quint32,qint64>::const_iterator offset_itr = offsets.constFind(id);
+    if (offset_itr == offsets.constEnd() || !d->data)
+        return QString();
+
+    const uchar* record = d->data + offset_itr.value();
+    const quint32 record_size = qFromLittleEndian<quint32>(record + RECORD_SIZE_OFFSET);
+    QString text;
+    if (record_size >= (quint32) FormattingEngine_Binary::RecordHeaderSize + 4) {
+        const quint32 length = qFromLittleEndian<quint32>(record + FormattingEngine_Binary::RecordHeaderSize);
+        if (FormattingEngine_Binary::RecordHeaderSize + 4 + length <= record_size)
+            text = QString::fromUtf8((const char*) record + FormattingEngine_Binary::RecordHeaderSize + 4,length);
+    }
+    decoded[id] = text;
+    return text;
+}
@@ -0,0 +1,150 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef BINARY_LOG_READER_H
+#define BINARY_LOG_READER_H
+
+#include "Logging_global.h"
+#include "Logger.h"
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QVariant>
+#include <QDateTime>
+
+namespace Qtilities {
+    namespace Logging {
+        /*!
+          \struct BinaryLogRecord
+          \brief A message record read from a binary log file by the BinaryLogReader.
+
+          <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct LOGGING_SHARED_EXPORT BinaryLogRecord {
+            BinaryLogRecord() : timestamp(0),
+                message_type(Logger::None),
+                engine_id(0),
+                template_id(0),
+                offset(0) {}
+
+            //! The time at which the message was logged in milliseconds since the epoch (UTC).
+            qint64                  timestamp;
+            //! The type of the message.
+            Logger::MessageType     message_type;
+            //! The id of the engine the message was logged to, 0 for system wide messages. See BinaryLogReader::engineName().
+            quint32                 engine_id;
+            //! The id of the message template. See BinaryLogReader::messageTemplate().
+            quint32                 template_id;
+            //! The arguments of the message.
+            QList<QVariant>         arguments;
+            //! The offset of the record in the file.
+            qint64                  offset;
+        };
+
+        /*!
+        \struct BinaryLogReaderData
+        \brief Structure used by the BinaryLogReader to store its private data.
+          */
+        struct BinaryLogReaderData;
+
+        /*!
+          \class BinaryLogReader
+          \brief The BinaryLogReader class reads binary log files written by the BinaryFileLoggerEngine.
+
+          The reader memory maps the log file and walks over its records. Records are filtered on their message type and timestamp using only
+          their fixed size headers, thus the arguments of a record are only decoded when the record matches the filter. This makes it possible to
+          scan logs with millions of messages in a couple of seconds:
+
+\code
+BinaryLogReader reader;
+if (reader.open("session.qlog")) {
+    reader.setMessageTypeFilter(Logger::Error | Logger::Fatal);
+    reader.setTimeRange(QDateTime::currentDateTime().addSecs(-3600),QDateTime::currentDateTime());
+
+    BinaryLogRecord record;
+    while (reader.readNext(&record))
+        qDebug() << QDateTime::fromMSecsSinceEpoch(record.timestamp) << reader.message(record);
+}
+\endcode
+
+          Message templates and engine names are defined inside the file before they are used, and the reader learns them while it walks over
+          the file. Thus messageTemplate() and engineName() know all ids used by the records returned so far. Only the locations of the definitions
+          are remembered while scanning, their text is decoded the first time it is used.
+
+          Files which are still being written can be read, the reader stops at the last complete record which existed when open() was called.
+
+          The format of the file is described in FormattingEngine_Binary.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+         */
+        class LOGGING_SHARED_EXPORT BinaryLogReader
+        {
+        public:
+            BinaryLogReader();
+            ~BinaryLogReader();
+
+            //! Opens and maps the given binary log file.
+            /*!
+              \returns True when the file could be mapped and has a valid header, false otherwise in which case errorString() describes the problem.
+              */
+            bool open(const QString& file_name);
+            //! Closes the file.
+            void close();
+            //! Indicates if a file is open.
+            bool isOpen() const;
+            //! Returns a description of the last error.
+            QString errorString() const;
+
+            //! Sets the message types which are returned by readNext(). By default all message types are returned.
+            void setMessageTypeFilter(Logger::MessageTypeFlags message_types);
+            //! Gets the message types which are returned by readNext().
+            Logger::MessageTypeFlags messageTypeFilter() const;
+            //! Only returns messages logged in the given time range (inclusive) from readNext().
+            void setTimeRange(const QDateTime& from, const QDateTime& to);
+            //! Only returns messages logged in the given time range (inclusive) from readNext(), where the times are in milliseconds since the epoch.
+            void setTimeRange(qint64 from_msecs, qint64 to_msecs);
+            //! Clears the time range filter.
+            void clearTimeRange();
+
+            //! Moves back to the first record in the file.
+            void rewind();
+            //! Reads the next record matching the filters.
+            /*!
+              \returns True when a record was read, false at the end of the file.
+              */
+            bool readNext(BinaryLogRecord* record);
+            //! Counts the records matching the filters, starting from the first record in the file.
+            /*!
+              Only the record headers are inspected. The reader is rewinded afterwards.
+              */
+            int countMatching();
+
+            //! Returns the text of the message template with the given id.
+            QString messageTemplate(quint32 template_id) const;
+            //! Returns the name of the engine with the given id. Id 0 is used for system wide messages and returns an empty string.
+            QString engineName(quint32 engine_id) const;
+            //! Returns the complete message text of a record, which is its template followed by its arguments.
+            QString message(const BinaryLogRecord& record) const;
+
+        private:
+            Q_DISABLE_COPY(BinaryLogReader)
+
+            bool nextMatchingRecord(qint64* record_offset);
+            //! Returns the text of the definition record with \p id, decoding it into \p decoded the first time it is used.
+            QString definition(QHash<quint32,QString>& decoded, const QHash<quint32,qint64>& offsets, quint32 id) const;
+
+            BinaryLogReaderData* d;
+        };
+    }
+}
+
+#endif // BINARY_LOG_READER_H
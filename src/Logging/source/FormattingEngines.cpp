@@ -11,6 +11,10 @@
 
 #include "FormattingEngines.h"
 
+#include <QtEndian>
+
+#include <string.h>
+
 // -----------------------------------
 // Default Formatting Engine
 // -----------------------------------
@@ -232,3 +236,188 @@ QString Qtilities::Logging::FormattingEngine_QtMsgEngineFormat::finalizeString()
     return QString();
 }
 
+
+// -----------------------------------
+// Binary Formatting Engine
+// -----------------------------------
+namespace {
+    template <typename T> inline void appendLittleEndian(QByteArray& buffer, T value) {
+        uchar data[sizeof(T)];
+        qToLittleEndian<T>(value,data);
+        buffer.append((const char*) data,sizeof(T));
+    }
+
+    inline void appendString(QByteArray& buffer, const QString& value) {
+        const QByteArray utf8 = value.toUtf8();
+        appendLittleEndian<quint32>(buffer,utf8.size());
+        buffer.append(utf8);
+    }
+
+    // Appends a record header with a zero size, which is filled in by finishRecord():
+    inline int startRecord(QByteArray& buffer, quint16 record_type, quint8 message_type, quint8 argument_count, qint64 timestamp, quint32 engine_id, quint32 template_id) {
+        const int start = buffer.size();
+        appendLittleEndian<quint32>(buffer,0);
+        appendLittleEndian<quint16>(buffer,record_type);
+        buffer.append((char) message_type);
+        buffer.append((char) argument_count);
+        appendLittleEndian<qint64>(buffer,timestamp);
+        appendLittleEndian<quint32>(buffer,engine_id);
+        appendLittleEndian<quint32>(buffer,template_id);
+        return start;
+    }
+
+    inline void finishRecord(QByteArray& buffer, int start) {
+        qToLittleEndian<quint32>(buffer.size() - start,(uchar*) buffer.data() + start);
+    }
+}
+
+QString Qtilities::Logging::FormattingEngine_Binary::initializeString() const {
+    return QString();
+}
+
+QString Qtilities::Logging::FormattingEngine_Binary::formatMessage(Logger::MessageType message_type, const QList<QVariant>& messages) const {
+    QString message = QString("%1 [%2] ").arg(QTime::currentTime().toString()).arg(Log->logLevelToString(message_type),-8,QChar(' '));
+    if (!messages.isEmpty())
+        message.append(messages.front().toString());
+    for (int i = 1; i < messages.count(); ++i)
+        message.append(" " + messages.at(i).toString());
+    return message;
+}
+
+QString Qtilities::Logging::FormattingEngine_Binary::finalizeString() const {
+    return QString();
+}
+
+QByteArray Qtilities::Logging::FormattingEngine_Binary::fileHeader() const {
+    QByteArray header(qti_def_BINARY_LOG_MAGIC,8);
+    appendLittleEndian<quint32>(header,FormatVersion);
+    appendLittleEndian<quint32>(header,FileHeaderSize);
+    return header;
+}
+
+void Qtilities::Logging::FormattingEngine_Binary::appendMessageRecord(QByteArray& buffer, Logger::MessageType message_type, qint64 timestamp, quint32 engine_id, quint32 template_id, const QList<QVariant>& arguments) const {
+    const int argument_count = qMin(arguments.count(),255);
+    const int start = startRecord(buffer,MessageRecord,(quint8) message_type,(quint8) argument_count,timestamp,engine_id,template_id);
+
+    for (int i = 0; i < argument_count; ++i) {
+        const QVariant& argument = arguments.at(i);
+        switch (argument.type()) {
+        case QVariant::Invalid:
+            buffer.append((char) NullArgument);
+            break;
+        case QVariant::Int:
+        case QVariant::UInt:
+        case QVariant::LongLong:
+        case QVariant::ULongLong:
+            buffer.append((char) IntegerArgument);
+            appendLittleEndian<qint64>(buffer,argument.toLongLong());
+            break;
+        case QVariant::Double: {
+            buffer.append((char) DoubleArgument);
+            const double value = argument.toDouble();
+            quint64 bits;
+            memcpy(&bits,&value,sizeof(bits));
+            appendLittleEndian<quint64>(buffer,bits);
+            break;
+        }
+        case QVariant::Bool:
+            buffer.append((char) BoolArgument);
+            buffer.append(argument.toBool() ? (char) 1 : (char) 0);
+            break;
+        default:
+            buffer.append((char) StringArgument);
+            appendString(buffer,argument.toString());
+            break;
+        }
+    }
+
+    finishRecord(buffer,start);
+}
+
+void Qtilities::Logging::FormattingEngine_Binary::appendDefinitionRecord(QByteArray& buffer, RecordType record_type, quint32 id, const QString& text) const {
+    const int start = startRecord(buffer,record_type,0,0,QDateTime::currentMSecsSinceEpoch(),0,id);
+    appendString(buffer,text);
+    finishRecord(buffer,start);
+}
+
+QString Qtilities::Logging::FormattingEngine_Binary::extractTemplate(const QString& message, QList<QVariant>* arguments) const {
+    QString message_template;
+    message_template.reserve(message.size());
+    const QChar* data = message.constData();
+    const int size = message.size();
+
+    int i = 0;
+    while (i < size) {
+        const ushort c = data[i].unicode();
+        if (c == '{') {
+            message_template.append(QLatin1String("{{"));
+            ++i;
+        } else if (c == '"') {
+            const int end = message.indexOf(QLatin1Char('"'),i + 1);
+            if (end == -1) {
+                message_template.append(data[i]);
+                ++i;
+                continue;
+            }
+            arguments->append(QVariant(message.mid(i + 1,end - i - 1)));
+            message_template.append(QLatin1String("\"{}\""));
+            i = end + 1;
+        } else if (c >= '0' && c <= '9') {
+            int end = i;
+            while (end < size && data[end].unicode() >= '0' && data[end].unicode() <= '9')
+                ++end;
+
+            // Digits which are part of a word, for example "utf8" or "0x1F", are part of the template:
+            const bool in_word = (i > 0 && (data[i - 1].isLetter() || data[i - 1] == QLatin1Char('_'))) ||
+                                 (end < size && (data[end].isLetter() || data[end] == QLatin1Char('_')));
+            if (in_word) {
+                message_template.append(message.midRef(i,end - i));
+            } else {
+                // Numbers with leading zeros or too many digits for a qint64 are stored as text to reproduce them exactly:
+                const QString digits = message.mid(i,end - i);
+                if ((digits.size() > 1 && digits.at(0) == QLatin1Char('0')) || digits.size() > 18)
+                    arguments->append(QVariant(digits));
+                else
+                    arguments->append(QVariant(digits.toLongLong()));
+                message_template.append(QLatin1String("{}"));
+            }
+            i = end;
+        } else {
+            message_template.append(data[i]);
+            ++i;
+        }
+    }
+
+    return message_template;
+}
+
+QString Qtilities::Logging::FormattingEngine_Binary::formatTemplate(const QString& message_template, const QList<QVariant>& arguments) const {
+    QString message;
+    message.reserve(message_template.size());
+    const QChar* data = message_template.constData();
+    const int size = message_template.size();
+
+    int argument_index = 0;
+    int i = 0;
+    while (i < size) {
+        if (data[i] == QLatin1Char('{') && i + 1 < size) {
+            if (data[i + 1] == QLatin1Char('{')) {
+                message.append(data[i]);
+                i += 2;
+                continue;
+            } else if (data[i + 1] == QLatin1Char('}')) {
+                if (argument_index < arguments.count())
+                    message.append(arguments.at(argument_index).toString());
+                ++argument_index;
+                i += 2;
+                continue;
+            }
+        }
+        message.append(data[i]);
+        ++i;
+    }
+
+    for (; argument_index < arguments.count(); ++argument_index)
+        message.append(" " + arguments.at(argument_index).toString());
+    return message;
+}
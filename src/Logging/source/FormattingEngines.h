@@ -187,6 +187,109 @@ namespace Qtilities {
             QString name() const { return qti_def_FORMATTING_ENGINE_QT_MSG; }
             QString endOfLineChar() const { return QString("\n"); }
         };
+
+        //! Binary formatting engine which encodes messages into compact fixed-header records.
+        /*!
+          Text formats are expensive to produce and to parse again. This formatting engine encodes messages into binary records instead,
+          which are written to append-only files by the BinaryFileLoggerEngine and read back using the BinaryLogReader.
+
+          All values are stored in little endian byte order. A binary log file starts with a header of FileHeaderSize bytes:
+          - 8 bytes: The magic bytes Qtilities::Logging::Constants::qti_def_BINARY_LOG_MAGIC.
+          - quint32: The format version, FormatVersion.
+          - quint32: The size of the file header.
+
+          The header is followed by records, each starting with a header of RecordHeaderSize bytes:
+          - quint32: The size of the record, including its header.
+          - quint16: The RecordType.
+          - quint8: The Logger::MessageType of the message.
+          - quint8: The number of packed arguments following the header.
+          - qint64: The timestamp in milliseconds since the epoch (UTC).
+          - quint32: The engine id. 0 is used for system wide messages, other ids are defined by EngineRecord records.
+          - quint32: The template id, defined by TemplateRecord records. For definition records this is the id being defined.
+
+          The first QVariant of a message is split into a template and its variable parts using extractTemplate(). The template is interned
+          and only written once per file in a TemplateRecord. The variable parts, followed by the remaining QVariants of the message, are packed
+          as arguments, each one being an ArgumentType byte followed by its data. Definition records always appear before the first record which
+          uses them. Messages which can't be interned, for example when the writer limits the number of templates, use InlineTemplateId and
+          store their text as their first argument.
+
+          formatMessage() returns a plain text version of the message, which allows this engine to be used with text based logger engines too.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+
+          \sa Qtilities::Logging::BinaryFileLoggerEngine, Qtilities::Logging::BinaryLogReader
+          */
+        class FormattingEngine_Binary : virtual public AbstractFormattingEngine
+        {
+        public:
+            static FormattingEngine_Binary & instance() {
+                static FormattingEngine_Binary* theInstance = new FormattingEngine_Binary();
+                return *theInstance;
+            }
+            ~FormattingEngine_Binary() {}
+
+        protected:
+            FormattingEngine_Binary() : AbstractFormattingEngine() {
+                setObjectName(name());
+            }
+
+        public:
+            //! The sizes and version of the binary format.
+            enum FormatConstants {
+                FormatVersion       = 2,            /*!< The version written by this engine. Version 1 templates are plain text without placeholders. */
+                FileHeaderSize      = 16,
+                RecordHeaderSize    = 24,
+                InlineTemplateId    = 0x7FFFFFFF    /*!< The template id of messages which store their text as their first argument. */
+            };
+            //! The types of records in a binary log file.
+            enum RecordType {
+                MessageRecord       = 0,    /*!< A logged message. */
+                TemplateRecord      = 1,    /*!< Defines the text of a message template. */
+                EngineRecord        = 2     /*!< Defines the name of an engine. */
+            };
+            //! The types of packed message arguments.
+            enum ArgumentType {
+                NullArgument        = 0,    /*!< An invalid QVariant, no data follows. */
+                IntegerArgument     = 1,    /*!< A qint64 follows. */
+                DoubleArgument      = 2,    /*!< A double follows, stored as its 64 bit pattern. */
+                BoolArgument        = 3,    /*!< A single byte follows. */
+                StringArgument      = 4     /*!< A quint32 length follows, followed by the UTF-8 encoded string. All other types are converted to strings. */
+            };
+
+            QString initializeString() const;
+            QString finalizeString() const;
+            QString formatMessage(Logger::MessageType message_type, const QList<QVariant>& messages) const;
+            QString fileExtension() const { return QString(); }
+            QString name() const { return qti_def_FORMATTING_ENGINE_BINARY; }
+            QString endOfLineChar() const { return QString("\n"); }
+
+            //! Returns the header which must start every binary log file.
+            QByteArray fileHeader() const;
+            //! Appends a MessageRecord to \p buffer.
+            /*!
+              \param buffer The buffer to append the record to.
+              \param message_type The type of the message.
+              \param timestamp The time of the message in milliseconds since the epoch.
+              \param engine_id The id of the engine the message was logged to, 0 for system wide messages.
+              \param template_id The id of the message template.
+              \param arguments The arguments of the message. Only the first 255 arguments are stored.
+              */
+            void appendMessageRecord(QByteArray& buffer, Logger::MessageType message_type, qint64 timestamp, quint32 engine_id, quint32 template_id, const QList<QVariant>& arguments) const;
+            //! Appends a TemplateRecord or EngineRecord to \p buffer, defining \p text for \p id.
+            void appendDefinitionRecord(QByteArray& buffer, RecordType record_type, quint32 id, const QString& text) const;
+            //! Splits \p message into a template and the variable parts of the message, which are appended to \p arguments.
+            /*!
+              Messages are mostly formatted using QString::arg() before they are logged, thus the same message is logged with different numbers,
+              names and paths. Quoted text and numbers which are not part of a word are replaced by {} placeholders, literal { characters are
+              written as {{. Messages which only differ in these parts share the same template.
+              */
+            QString extractTemplate(const QString& message, QList<QVariant>* arguments) const;
+            //! Builds the text of a message from a template returned by extractTemplate() and its arguments.
+            /*!
+              Arguments which are not used by placeholders in the template are appended to the message, separated by spaces.
+              */
+            QString formatTemplate(const QString& message_template, const QList<QVariant>& arguments) const;
+        };
     }
 }
 
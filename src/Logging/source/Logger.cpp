@@ -21,6 +21,9 @@
 
 #include <QtDebug>
 #include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVarLengthArray>
 
 using namespace Qtilities::Logging::Constants;
 
@@ -36,6 +39,13 @@ struct Qtilities::Logging::LoggerPrivateData {
     QPointer<AbstractFormattingEngine>          priority_formatting_engine;
     QString                                     session_path;
     bool                                        settings_enabled;
+    //! Protects logger_engines, which is read by logMessage() from any thread.
+    QMutex                                      engines_mutex;
+    //! The number of receivers connected to newMessage(), engines are called directly and are not included.
+    int                                         external_receivers;
+    //! The message which is currently dispatched in the logger thread, used to format messages once per formatting engine.
+    const QList<QVariant>*                      dispatch_messages;
+    QVarLengthArray<QPair<AbstractFormattingEngine*,QString>,4> dispatch_cache;
 };
 
 Qtilities::Logging::Logger* Qtilities::Logging::Logger::m_Instance = 0;
@@ -65,6 +75,14 @@ Qtilities::Logging::Logger::Logger(QObject* parent) : QObject(parent) {
     d->priority_formatting_engine = 0;
     d->session_path = QCoreApplication::applicationDirPath() + qti_def_PATH_SESSION;
     d->settings_enabled = true;
+    d->external_receivers = 0;
+    d->dispatch_messages = 0;
+    updateLoggedMessageTypes();
+
+    // Needed to queue messages to engines living in other threads:
+    qRegisterMetaType<Logger::MessageType>("Logger::MessageType");
+    qRegisterMetaType<Logger::MessageContextFlags>("Logger::MessageContextFlags");
+    qRegisterMetaType<QList<QVariant> >("QList<QVariant>");
 }
 
 Qtilities::Logging::Logger::~Logger() {
@@ -85,10 +103,13 @@ void Qtilities::Logging::Logger::initialize(const QString& configuration_file_na
     d->formatting_engines << &FormattingEngine_XML::instance();
     d->formatting_engines << &FormattingEngine_HTML::instance();
     d->formatting_engines << &FormattingEngine_QtMsgEngineFormat::instance();
+    d->formatting_engines << &FormattingEngine_Binary::instance();
     d->default_formatting_engine = QString(qti_def_FORMATTING_ENGINE_DEFAULT);
 
     // Register the logger enigines that comes as part of the Qtilities Logging Framework
     d->logger_engine_factory.registerFactoryInterface(qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE, &FileLoggerEngine::factory);
+    d->logger_engine_factory.registerFactoryInterface(qti_def_FACTORY_TAG_ROTATING_FILE_LOGGER_ENGINE, &RotatingFileLoggerEngine::factory);
+    d->logger_engine_factory.registerFactoryInterface(qti_def_FACTORY_TAG_BINARY_FILE_LOGGER_ENGINE, &BinaryFileLoggerEngine::factory);
 
     //qDebug() << tr("> Number of formatting engines available: ") << d->formatting_engines.count();
     //qDebug() << tr("> Number of logger engine factories available: ") << d->logger_engine_factory.tags().count();
@@ -134,21 +155,18 @@ void Qtilities::Logging::Logger::clear() {
         }
 
     }
+    QMutexLocker locker(&d->engines_mutex);
     d->logger_engines.clear();
     //qDebug() << tr("Qtilities Logging Framework, clearing finished successfully...");
 }
 
 void Qtilities::Logging::Logger::logMessage(const QString& engine_name, MessageType message_type, const QVariant& message, const QVariant &msg1, const QVariant &msg2, const QVariant &msg3, const QVariant &msg4, const QVariant &msg5, const QVariant &msg6, const QVariant &msg7, const QVariant &msg8 , const QVariant &msg9) {
-    // In release mode we should not log debug and trace messages.
-    #ifdef QT_NO_DEBUG
-        if (message_type == Debug || message_type == Trace)
-            return;
-    #endif
-
-    if (message_type == AllLogLevels || message_type == None)
+    // Also filters None and, in release mode, debug and trace messages. See updateLoggedMessageTypes().
+    if (message_type == AllLogLevels || !isMessageTypeLogged(message_type))
         return;
 
-    if (message_type > d->global_log_level)
+    // Don't build the message when no one is listening:
+    if (d->logger_engines.isEmpty() && d->external_receivers == 0)
         return;
 
     QList<QVariant> message_contents;
@@ -185,20 +203,12 @@ void Qtilities::Logging::Logger::logMessage(const QString& engine_name, MessageT
     else
         context |= EngineSpecificMessages;
 
-    emit newMessage(engine_name,message_type,context,message_contents);
+    dispatchMessage(engine_name,message_type,context,message_contents);
 }
 
 void Qtilities::Logging::Logger::logPriorityMessage(const QString& engine_name, MessageType message_type, const QVariant& message, const QVariant &msg1, const QVariant &msg2, const QVariant &msg3, const QVariant &msg4, const QVariant &msg5, const QVariant &msg6, const QVariant &msg7, const QVariant &msg8 , const QVariant &msg9) {
-    // In release mode we should not log debug and trace messages.
-    #ifdef QT_NO_DEBUG
-        if (message_type == Debug || message_type == Trace)
-            return;
-    #endif
-
-    if (message_type == AllLogLevels || message_type == None)
-        return;
-
-    if (message_type > d->global_log_level)
+    // Also filters None and, in release mode, debug and trace messages. See updateLoggedMessageTypes().
+    if (message_type == AllLogLevels || !isMessageTypeLogged(message_type))
         return;
 
     QList<QVariant> message_contents;
@@ -217,7 +227,7 @@ void Qtilities::Logging::Logger::logPriorityMessage(const QString& engine_name,
     MessageContextFlags context = 0;
     context |= PriorityMessages;
 
-    emit newMessage(engine_name,message_type,context,message_contents);
+    dispatchMessage(engine_name,message_type,context,message_contents);
 
     QString formatted_message;
     if (d->priority_formatting_engine) {
@@ -228,6 +238,92 @@ void Qtilities::Logging::Logger::logPriorityMessage(const QString& engine_name,
     emit newPriorityMessage(message_type,formatted_message);
 }
 
+void Qtilities::Logging::Logger::dispatchMessage(const QString& engine_name, MessageType message_type, MessageContextFlags message_context, const QList<QVariant>& message_contents) {
+    // Take a shallow copy of the engine list, this only increments its reference count and allows engines to be
+    // attached or detached while we are calling them:
+    d->engines_mutex.lock();
+    const QList<QPointer<AbstractLoggerEngine> > engines = d->logger_engines;
+    d->engines_mutex.unlock();
+
+    // Engines in the logger thread share formatted messages through formatMessage(). Messages logged from inside
+    // an engine while we are busy dispatching are formatted by the engines themselves.
+    QThread* current_thread = QThread::currentThread();
+    const bool use_dispatch_cache = (current_thread == thread() && !d->dispatch_messages);
+    if (use_dispatch_cache)
+        d->dispatch_messages = &message_contents;
+
+    for (int i = 0; i < engines.count(); ++i) {
+        AbstractLoggerEngine* engine = engines.at(i);
+        if (!engine)
+            continue;
+
+        if (engine->thread() == current_thread)
+            engine->newMessages(engine_name,message_type,message_context,message_contents);
+        else
+            QMetaObject::invokeMethod(engine,"newMessages",Qt::QueuedConnection,Q_ARG(QString,engine_name),Q_ARG(Logger::MessageType,message_type),Q_ARG(Logger::MessageContextFlags,message_context),Q_ARG(QList<QVariant>,message_contents));
+    }
+
+    if (use_dispatch_cache) {
+        d->dispatch_messages = 0;
+        d->dispatch_cache.clear();
+    }
+
+    if (d->external_receivers > 0)
+        emit newMessage(engine_name,message_type,message_context,message_contents);
+}
+
+QString Qtilities::Logging::Logger::formatMessage(AbstractFormattingEngine* formatting_engine, MessageType message_type, const QList<QVariant>& message_contents) {
+    if (d->dispatch_messages != &message_contents || QThread::currentThread() != thread())
+        return formatting_engine->formatMessage(message_type,message_contents);
+
+    for (int i = 0; i < d->dispatch_cache.count(); ++i) {
+        if (d->dispatch_cache.at(i).first == formatting_engine)
+            return d->dispatch_cache.at(i).second;
+    }
+
+    QString formatted_message = formatting_engine->formatMessage(message_type,message_contents);
+    d->dispatch_cache.append(qMakePair(formatting_engine,formatted_message));
+    return formatted_message;
+}
+
+void Qtilities::Logging::Logger::updateLoggedMessageTypes() {
+    // All message types up to and including the global log level. The level is not always a single message type, for example
+    // AllLogLevels, thus the types are compared against it one by one:
+    int message_types = 0;
+    for (int message_type = Info; message_type <= Trace; message_type <<= 1) {
+        if (message_type <= (int) d->global_log_level)
+            message_types |= message_type;
+    }
+    // In release mode we should not log debug and trace messages.
+    #ifdef QT_NO_DEBUG
+    message_types &= ~(Debug | Trace);
+    #endif
+    logged_message_types = message_types;
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+void Qtilities::Logging::Logger::connectNotify(const QMetaMethod& signal) {
+    if (signal == QMetaMethod::fromSignal(&Logger::newMessage))
+        d->external_receivers = receivers(SIGNAL(newMessage(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)));
+}
+
+void Qtilities::Logging::Logger::disconnectNotify(const QMetaMethod& signal) {
+    // An invalid signal is passed when all signals are disconnected at once:
+    if (!signal.isValid() || signal == QMetaMethod::fromSignal(&Logger::newMessage))
+        d->external_receivers = receivers(SIGNAL(newMessage(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)));
+}
+#else
+void Qtilities::Logging::Logger::connectNotify(const char* signal) {
+    Q_UNUSED(signal)
+    d->external_receivers = receivers(SIGNAL(newMessage(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)));
+}
+
+void Qtilities::Logging::Logger::disconnectNotify(const char* signal) {
+    Q_UNUSED(signal)
+    d->external_receivers = receivers(SIGNAL(newMessage(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)));
+}
+#endif
+
 bool Qtilities::Logging::Logger::setPriorityFormattingEngine(const QString& name) {
     if (!availableLoggerEnginesInFactory().contains(name))
         return false;
@@ -343,8 +439,9 @@ bool Qtilities::Logging::Logger::attachLoggerEngine(AbstractLoggerEngine* new_lo
 
     if (new_logger_engine) {
         new_logger_engine->setObjectName(new_logger_engine->name());
+        // Engines are not connected to newMessage(), messages are delivered to them in dispatchMessage():
+        QMutexLocker locker(&d->engines_mutex);
         d->logger_engines << new_logger_engine;
-        connect(this,SIGNAL(newMessage(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)),new_logger_engine,SLOT(newMessages(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)));
     }
 
     emit loggerEngineCountChanged(new_logger_engine, EngineAdded);
@@ -353,7 +450,10 @@ bool Qtilities::Logging::Logger::attachLoggerEngine(AbstractLoggerEngine* new_lo
 
 bool Qtilities::Logging::Logger::detachLoggerEngine(AbstractLoggerEngine* logger_engine, bool delete_engine) {
     if (logger_engine) {
-        if (d->logger_engines.removeOne(logger_engine)) {
+        d->engines_mutex.lock();
+        bool removed = d->logger_engines.removeOne(logger_engine);
+        d->engines_mutex.unlock();
+        if (removed) {
             emit loggerEngineCountChanged(logger_engine, EngineRemoved);
             if (delete_engine)
                 delete logger_engine;
@@ -466,6 +566,7 @@ void Qtilities::Logging::Logger::deleteAllLoggerEngines() {
         if (d->logger_engines.at(0))
             delete d->logger_engines.at(0);
     }
+    QMutexLocker locker(&d->engines_mutex);
     d->logger_engines.clear();
 }
 
@@ -556,6 +657,7 @@ void Qtilities::Logging::Logger::setGlobalLogLevel(Logger::MessageType new_log_l
         return;
 
     d->global_log_level = new_log_level;
+    updateLoggedMessageTypes();
 
     writeSettings();
     LOG_INFO("Global log level changed to " + logLevelToString(new_log_level));
@@ -592,6 +694,7 @@ void Qtilities::Logging::Logger::readSettings() {
     settings.beginGroup("General");
     QVariant log_level =  settings.value("global_log_level", Fatal);
     d->global_log_level = (MessageType) log_level.toInt();
+    updateLoggedMessageTypes();
     if (settings.value("is_qt_message_handler", false).toBool())
         installAsQtMessageHandler(false);
     settings.endGroup();
@@ -722,6 +825,38 @@ void Qtilities::Logging::installLoggerMessageHandler(QtMsgType type, const QMess
 // Convenience functions provided to create new engines
 // ------------------------------------
 Qtilities::Logging::AbstractLoggerEngine* Qtilities::Logging::Logger::newFileEngine(const QString& engine_name, const QString& file_name, const QString& formatting_engine) {
+    QPointer<AbstractLoggerEngine> new_engine = createFileEngine(qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE,engine_name,file_name,formatting_engine);
+    if (!new_engine)
+        return 0;
+
+    if (attachLoggerEngine(new_engine, true)) {
+        return new_engine;
+    } else {
+        delete new_engine;
+        return 0;
+    }
+}
+
+Qtilities::Logging::AbstractLoggerEngine* Qtilities::Logging::Logger::newRotatingFileEngine(const QString& engine_name, const QString& file_name, qint64 max_file_size, int max_segment_count, const QString& formatting_engine) {
+    QPointer<AbstractLoggerEngine> new_engine = createFileEngine(qti_def_FACTORY_TAG_ROTATING_FILE_LOGGER_ENGINE,engine_name,file_name,formatting_engine);
+    if (!new_engine)
+        return 0;
+
+    // The policy must be in place before the engine is initialized during attachment:
+    RotatingFileLoggerEngine* rotating_engine = qobject_cast<RotatingFileLoggerEngine*> (new_engine);
+    Q_ASSERT(rotating_engine);
+    rotating_engine->setMaxFileSize(max_file_size);
+    rotating_engine->setMaxSegmentCount(max_segment_count);
+
+    if (attachLoggerEngine(new_engine, true)) {
+        return new_engine;
+    } else {
+        delete new_engine;
+        return 0;
+    }
+}
+
+Qtilities::Logging::AbstractLoggerEngine* Qtilities::Logging::Logger::createFileEngine(const char* factory_tag, const QString& engine_name, const QString& file_name, const QString& formatting_engine) {
     if (file_name.isEmpty())
         return 0;
 
@@ -732,7 +867,7 @@ Qtilities::Logging::AbstractLoggerEngine* Qtilities::Logging::Logger::newFileEng
     }
 
     QPointer<FileLoggerEngine> file_engine;
-    QPointer<AbstractLoggerEngine> new_engine = d->logger_engine_factory.createInstance(qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE);
+    QPointer<AbstractLoggerEngine> new_engine = d->logger_engine_factory.createInstance(factory_tag);
     Q_ASSERT(new_engine);
     new_engine->setName(engine_name);
 
@@ -759,12 +894,7 @@ Qtilities::Logging::AbstractLoggerEngine* Qtilities::Logging::Logger::newFileEng
         new_engine->installFormattingEngine(formatting_engine_inst);
     }
 
-    if (attachLoggerEngine(new_engine, true)) {
-        return new_engine;
-    } else {
-        delete new_engine;
-        return 0;
-    }
+    return new_engine;
 }
 
 void Qtilities::Logging::Logger::toggleQtMsgEngine(bool toggle) {
@@ -159,6 +159,18 @@ namespace Qtilities {
                       const QVariant& msg8 = QVariant(), const QVariant& msg9 = QVariant());
                       */
 
+        public:
+            //! Checks if messages of the given type will be logged at the current global log level.
+            /*!
+              This check is inlined and is used by the logging macros to skip messages before any of their arguments are
+              constructed. Debug and trace messages are never logged in release mode builds.
+
+              \sa setGlobalLogLevel()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline bool isMessageTypeLogged(MessageType message_type) const { return (logged_message_types & message_type) != 0; }
+
         public:
             // -----------------------------------------
             // Functions related to formatting engines
@@ -309,6 +321,22 @@ namespace Qtilities {
               \return The constructed logger engine if successfull, null otherwise.
             */
             AbstractLoggerEngine* newFileEngine(const QString& engine_name, const QString& file_name, const QString& formatting_engine = QString());
+            //! Convenience function to create a new instance of a rotating file engine.
+            /*!
+              Creates a Qtilities::Logging::RotatingFileLoggerEngine which rotates its log file when it becomes larger than \p max_file_size bytes. The
+              remaining rotation policy can be changed on the returned engine, see the RotatingFileLoggerEngine documentation for more details.
+
+              \param engine The of the engine. This name can be used to reference the engine at a later stage.
+              \param file_name The name of the file to which logging must be done. If no engine name is provided the function will return false.
+              \param max_file_size The size in bytes at which the log file is rotated.
+              \param max_segment_count The number of closed log file segments which are kept on disk.
+              \param formatting_engine The name of the formatting engine which must be used to format messages in the engine. See newFileEngine() for more details.
+
+              \return The constructed logger engine if successfull, null otherwise.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+            */
+            AbstractLoggerEngine* newRotatingFileEngine(const QString& engine_name, const QString& file_name, qint64 max_file_size = 10 * 1024 * 1024, int max_segment_count = 5, const QString& formatting_engine = QString());
             //! Convenience function to enable a Qt Message engine which pipes messages through to the Qt Debugging System.
             /*!
               Only one qt message engine can be created. This engine can be enabled/disabled using this function.
@@ -390,9 +418,30 @@ namespace Qtilities {
             //! Indicates that the number of logger engines changed.
             void loggerEngineCountChanged(AbstractLoggerEngine* engine, Logger::EngineChangeIndication change_indication);
 
+        protected:
+            #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+            void connectNotify(const QMetaMethod& signal);
+            void disconnectNotify(const QMetaMethod& signal);
+            #else
+            void connectNotify(const char* signal);
+            void disconnectNotify(const char* signal);
+            #endif
+
         private:
+            //! Recalculates the message types which pass the global log level, see isMessageTypeLogged().
+            void updateLoggedMessageTypes();
+            //! Delivers a message to all attached engines and to other receivers of newMessage().
+            void dispatchMessage(const QString& engine_name, MessageType message_type, MessageContextFlags message_context, const QList<QVariant>& message_contents);
+            //! Formats a message for AbstractLoggerEngine::newMessages(), messages are formatted once per formatting engine during a dispatch.
+            QString formatMessage(AbstractFormattingEngine* formatting_engine, MessageType message_type, const QList<QVariant>& message_contents);
+            friend class AbstractLoggerEngine;
+
+            //! Creates and configures a file engine from the factory with the given tag, without attaching it.
+            AbstractLoggerEngine* createFileEngine(const char* factory_tag, const QString& engine_name, const QString& file_name, const QString& formatting_engine);
+
             static Logger* m_Instance;
             LoggerPrivateData* d;
+            int logged_message_types;
         };
 
         #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
@@ -439,7 +488,7 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Trace messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_TRACE(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Trace, Msg)
+#define LOG_TRACE(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Trace) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Trace, Msg) : (void) 0)
 #else
 #define LOG_TRACE(Msg) ((void)0)
 #endif
@@ -448,18 +497,18 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Debug messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_DEBUG(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Debug, Msg)
+#define LOG_DEBUG(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Debug) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Debug, Msg) : (void) 0)
 #else
 #define LOG_DEBUG(Msg) ((void)0)
 #endif
 //! Logs an error message to all active engines.
-#define LOG_ERROR(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Error, Msg)
+#define LOG_ERROR(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Error) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Error, Msg) : (void) 0)
 //! Logs a warning message to all active engines.
-#define LOG_WARNING(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Warning, Msg)
+#define LOG_WARNING(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Warning) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Warning, Msg) : (void) 0)
 //! Logs a fatal message to all active engines.
-#define LOG_FATAL(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg)
+#define LOG_FATAL(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Fatal) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg) : (void) 0)
 //! Logs an information message to all active engines.
-#define LOG_INFO(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Info, Msg)
+#define LOG_INFO(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Info) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Info, Msg) : (void) 0)
 
 // -----------------------------------
 // Priority Logging Macros
@@ -469,7 +518,7 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Trace messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_TRACE_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Trace, Msg)
+#define LOG_TRACE_P(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Trace) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Trace, Msg) : (void) 0)
 #else
 #define LOG_TRACE_P(Msg) ((void)0)
 #endif
@@ -478,42 +527,42 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Debug messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_DEBUG_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Debug, Msg)
+#define LOG_DEBUG_P(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Debug) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Debug, Msg) : (void) 0)
 #else
 #define LOG_DEBUG_P(Msg) ((void)0)
 #endif
 //! Logs a priority error message to all active engines.
-#define LOG_ERROR_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Error, Msg)
+#define LOG_ERROR_P(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Error) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Error, Msg) : (void) 0)
 //! Logs a priority warning message to all active engines.
-#define LOG_WARNING_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Warning, Msg)
+#define LOG_WARNING_P(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Warning) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Warning, Msg) : (void) 0)
 //! Logs a priority fatal message to all active engines.
-#define LOG_FATAL_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg)
+#define LOG_FATAL_P(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Fatal) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg) : (void) 0)
 //! Logs a priority information message to all active engines.
-#define LOG_INFO_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Info, Msg)
+#define LOG_INFO_P(Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Info) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Info, Msg) : (void) 0)
 
 // -----------------------------------
 // Engine Specific Logging
 // -----------------------------------
 //! Logs a trace message to the engine specified. Note that the engine must be active for the message to be logger.
 #ifndef QT_NO_DEBUG
-#define LOG_TRACE_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Trace, Msg)
+#define LOG_TRACE_E(Engine_Name, Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Trace) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Trace, Msg) : (void) 0)
 #else
 #define LOG_TRACE_E(Engine_Name, Msg) ((void)0)
 #endif
 //! Logs a debug message to the engine specified. Note that the engine must be active for the message to be logger.
 #ifndef QT_NO_DEBUG//!
-#define LOG_DEBUG_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Debug, Msg)
+#define LOG_DEBUG_E(Engine_Name, Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Debug) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Debug, Msg) : (void) 0)
 #else
 #define LOG_DEBUG_E(Engine_Name, Msg) ((void)0)
 #endif
 //! Logs an error message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_ERROR_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Error, Msg)
+#define LOG_ERROR_E(Engine_Name, Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Error) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Error, Msg) : (void) 0)
 //! Logs a warning message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_WARNING_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Warning, Msg)
+#define LOG_WARNING_E(Engine_Name, Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Warning) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Warning, Msg) : (void) 0)
 //! Logs a fatal message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_FATAL_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Fatal, Msg)
+#define LOG_FATAL_E(Engine_Name, Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Fatal) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Fatal, Msg) : (void) 0)
 //! Logs an info message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_INFO_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Info, Msg)
+#define LOG_INFO_E(Engine_Name, Msg) (Log->isMessageTypeLogged(Qtilities::Logging::Logger::Info) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Info, Msg) : (void) 0)
 
 // -----------------------------------
 // Function Specific Logging
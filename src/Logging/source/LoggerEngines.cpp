@@ -11,12 +11,25 @@
 
 #include "LoggerEngines.h"
 #include "LoggingConstants.h"
+#include "FormattingEngines.h"
 
 #include <QFile>
 #include <QTextStream>
 #include <QList>
 #include <QString>
 #include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QThread>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QHash>
 
 #include <stdio.h>
 
@@ -33,8 +46,330 @@ namespace Qtilities {
     }
 }
 
+namespace {
+    // QAtomicInt access which works for both Qt 4 and Qt 5.
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+    inline int atomicLoadAcquire(const QAtomicInt& value) { return value.loadAcquire(); }
+    inline void atomicStoreRelease(QAtomicInt& value, int new_value) { value.storeRelease(new_value); }
+#else
+    inline int atomicLoadAcquire(const QAtomicInt& value) { return value; }
+    inline void atomicStoreRelease(QAtomicInt& value, int new_value) { value.fetchAndStoreRelease(new_value); }
+#endif
+
+    // Positions in the queue wrap around, thus differences are calculated on unsigned values.
+    inline int sequenceDiff(int a, int b) { return (int) ((uint) a - (uint) b); }
+
+    const int FILE_LOGGER_CLEAR_REQUEST = -1;
+}
+
+/*!
+  \class FileLoggerEngineMessageQueue
+  \brief A bounded lock-free multiple producer, single consumer ring buffer used by the FileLoggerEngine in BufferedWriteMode.
+
+  Each cell carries a sequence number which tells producers and the consumer if the cell is free or filled for the current lap around
+  the ring. Producers claim a position using a compare-and-swap on the enqueue position, the single consumer does not need any atomic
+  read-modify-write operations.
+  */
+class FileLoggerEngineMessageQueue {
+public:
+    FileLoggerEngineMessageQueue(int capacity) : mask(capacity - 1), dequeue_pos(0) {
+        cells = new Cell[capacity];
+        for (int i = 0; i < capacity; ++i)
+            atomicStoreRelease(cells[i].sequence,i);
+        atomicStoreRelease(enqueue_pos,0);
+    }
+    ~FileLoggerEngineMessageQueue() {
+        delete[] cells;
+    }
+
+    //! Called from any thread, returns false when the queue is full.
+    bool tryEnqueue(const QString& message, int message_type, qint64 enqueue_time) {
+        Cell* cell = 0;
+        int pos = atomicLoadAcquire(enqueue_pos);
+        forever {
+            cell = &cells[pos & mask];
+            int diff = sequenceDiff(atomicLoadAcquire(cell->sequence),pos);
+            if (diff == 0) {
+                if (enqueue_pos.testAndSetRelaxed(pos,(int) ((uint) pos + 1)))
+                    break;
+                pos = atomicLoadAcquire(enqueue_pos);
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = atomicLoadAcquire(enqueue_pos);
+            }
+        }
+
+        cell->message = message;
+        cell->message_type = message_type;
+        cell->enqueue_time = enqueue_time;
+        atomicStoreRelease(cell->sequence,(int) ((uint) pos + 1));
+        return true;
+    }
+    //! Called from the writer thread only, returns false when the queue is empty.
+    bool tryDequeue(QString* message, int* message_type, qint64* enqueue_time) {
+        Cell* cell = &cells[dequeue_pos & mask];
+        if (sequenceDiff(atomicLoadAcquire(cell->sequence),(int) ((uint) dequeue_pos + 1)) < 0)
+            return false;
+
+        *message = cell->message;
+        *message_type = cell->message_type;
+        *enqueue_time = cell->enqueue_time;
+        // Release the string data now instead of when the cell is reused:
+        cell->message = QString();
+        atomicStoreRelease(cell->sequence,(int) ((uint) dequeue_pos + mask + 1));
+        dequeue_pos = (int) ((uint) dequeue_pos + 1);
+        return true;
+    }
+    //! Called from the writer thread only.
+    bool isEmpty() const {
+        const Cell* cell = &cells[dequeue_pos & mask];
+        return sequenceDiff(atomicLoadAcquire(cell->sequence),(int) ((uint) dequeue_pos + 1)) < 0;
+    }
+
+private:
+    struct Cell {
+        Cell() : message_type(0), enqueue_time(0) {}
+        QAtomicInt  sequence;
+        QString     message;
+        int         message_type;
+        qint64      enqueue_time;
+    };
+
+    Cell*       cells;
+    const int   mask;
+    QAtomicInt  enqueue_pos;
+    int         dequeue_pos;
+};
+
+/*!
+  \class FileLoggerEngineWriter
+  \brief The background thread which writes messages to file for a FileLoggerEngine in BufferedWriteMode.
+  */
+class FileLoggerEngineWriter : public QThread {
+public:
+    //! The states of the writer thread, used by producers to decide if the writer must be woken up.
+    enum WriterState {
+        WriterBusy = 0,
+        WriterIdle = 1,     // Sleeping without any pending data, must be woken up for new messages.
+        WriterWaiting = 2   // Sleeping until the flush interval expires, only woken up for urgent messages.
+    };
+
+    FileLoggerEngineWriter(QFile* file, int capacity, int flush_size, int flush_interval, bool flush_on_error) : QThread(),
+        queue(capacity),
+        file(file),
+        flush_size(flush_size),
+        flush_interval(flush_interval),
+        flush_on_error(flush_on_error),
+        messages_written(0),
+        bytes_written(0),
+        flush_count(0),
+        latency_sum(0),
+        latency_max(0),
+        pending_count(0),
+        pending_enqueue_time_sum(0),
+        pending_oldest_enqueue_time(0)
+    {
+        atomicStoreRelease(writer_state,WriterBusy);
+        atomicStoreRelease(stop_requested,0);
+        atomicStoreRelease(buffer_full_stalls,0);
+        clock.start();
+    }
+    ~FileLoggerEngineWriter() {
+        delete file;
+    }
+
+    //! Called from any thread to queue a message.
+    void enqueue(const QString& message, int message_type) {
+        const qint64 now = clock.nsecsElapsed() / 1000;
+        if (!queue.tryEnqueue(message,message_type,now)) {
+            buffer_full_stalls.fetchAndAddRelaxed(1);
+            do {
+                wake();
+                QThread::yieldCurrentThread();
+            } while (!queue.tryEnqueue(message,message_type,now));
+        }
+
+        // The ordered read acts as a full barrier between publishing the message and checking the writer state.
+        const int state = writer_state.fetchAndAddOrdered(0);
+        if (state == WriterIdle)
+            wake();
+        else if (state == WriterWaiting && (isUrgent(message_type) || message_type == FILE_LOGGER_CLEAR_REQUEST))
+            wake();
+    }
+    //! Stops the writer thread after all queued messages were written, followed by the finalize string.
+    void stop(const QString& finalize_string) {
+        final_string = finalize_string;
+        atomicStoreRelease(stop_requested,1);
+        wake();
+        wait();
+    }
+    //! Returns a description of the writer metrics.
+    QString metrics() const {
+        QMutexLocker locker(&metrics_mutex);
+        double elapsed_secs = clock.elapsed() / 1000.0;
+        double throughput = elapsed_secs > 0 ? messages_written / elapsed_secs : 0;
+        double latency_avg = messages_written > 0 ? (double) latency_sum / messages_written : 0;
+        return QString(QObject::tr("%1 messages (%2 KiB) written in %3 flushes, %4 messages/s, latency avg %5 ms / max %6 ms, buffer full %7 times."))
+                .arg(messages_written).arg(bytes_written / 1024).arg(flush_count)
+                .arg(throughput,0,'f',1).arg(latency_avg / 1000.0,0,'f',3).arg(latency_max / 1000.0,0,'f',3)
+                .arg(atomicLoadAcquire(buffer_full_stalls));
+    }
+
+protected:
+    void run() {
+        QElapsedTimer since_flush;
+        since_flush.start();
+
+        QString message;
+        int message_type;
+        qint64 enqueue_time;
+
+        forever {
+            const bool stopping = atomicLoadAcquire(stop_requested);
+            bool urgent = false;
+            while (queue.tryDequeue(&message,&message_type,&enqueue_time)) {
+                if (message_type == FILE_LOGGER_CLEAR_REQUEST) {
+                    discardPending();
+                    file->resize(0);
+                    continue;
+                }
+
+                if (pending_count == 0)
+                    pending_oldest_enqueue_time = enqueue_time;
+                pending.append(message.toLocal8Bit());
+                pending.append('\n');
+                ++pending_count;
+                pending_enqueue_time_sum += enqueue_time;
+                if (isUrgent(message_type))
+                    urgent = true;
+                if (pending.size() >= flush_size) {
+                    flushPending();
+                    since_flush.restart();
+                }
+            }
+
+            if (pending_count > 0 && (urgent || stopping || since_flush.elapsed() >= flush_interval)) {
+                flushPending();
+                since_flush.restart();
+            }
+
+            // Messages queued after the stop request are written by the loop above, we only exit on an empty queue:
+            if (stopping && queue.isEmpty())
+                break;
+
+            QMutexLocker locker(&wait_mutex);
+            if (pending_count == 0) {
+                writer_state.fetchAndStoreOrdered(WriterIdle);
+                if (queue.isEmpty() && !atomicLoadAcquire(stop_requested))
+                    wait_condition.wait(&wait_mutex);
+            } else {
+                writer_state.fetchAndStoreOrdered(WriterWaiting);
+                const qint64 remaining = flush_interval - since_flush.elapsed();
+                if (remaining > 0 && !atomicLoadAcquire(stop_requested))
+                    wait_condition.wait(&wait_mutex,(unsigned long) remaining);
+            }
+            writer_state.fetchAndStoreOrdered(WriterBusy);
+        }
+
+        if (!final_string.isEmpty())
+            file->write(final_string.toLocal8Bit());
+        file->write("\n");
+        file->close();
+    }
+
+private:
+    bool isUrgent(int message_type) const {
+        return flush_on_error && (message_type == Logger::Error || message_type == Logger::Fatal);
+    }
+    void wake() {
+        QMutexLocker locker(&wait_mutex);
+        wait_condition.wakeOne();
+    }
+    void discardPending() {
+        pending.clear();
+        pending_count = 0;
+        pending_enqueue_time_sum = 0;
+    }
+    void flushPending() {
+        if (pending_count == 0)
+            return;
+
+        const qint64 written = file->write(pending);
+        file->flush();
+
+        // The latency of each message is the time from being queued until it was handed to the operating system:
+        const qint64 now = clock.nsecsElapsed() / 1000;
+        QMutexLocker locker(&metrics_mutex);
+        messages_written += pending_count;
+        if (written > 0)
+            bytes_written += written;
+        ++flush_count;
+        latency_sum += now * pending_count - pending_enqueue_time_sum;
+        if (now - pending_oldest_enqueue_time > latency_max)
+            latency_max = now - pending_oldest_enqueue_time;
+        locker.unlock();
+
+        discardPending();
+    }
+
+    FileLoggerEngineMessageQueue    queue;
+    QFile*                          file;
+    const int                       flush_size;
+    const int                       flush_interval;
+    const bool                      flush_on_error;
+    QString                         final_string;
+
+    QMutex                          wait_mutex;
+    QWaitCondition                  wait_condition;
+    QAtomicInt                      writer_state;
+    QAtomicInt                      stop_requested;
+    QAtomicInt                      buffer_full_stalls;
+    QElapsedTimer                   clock;
+
+    // Metrics, updated once per flush:
+    mutable QMutex                  metrics_mutex;
+    qint64                          messages_written;
+    qint64                          bytes_written;
+    qint64                          flush_count;
+    qint64                          latency_sum;
+    qint64                          latency_max;
+
+    // Only accessed by the writer thread:
+    QByteArray                      pending;
+    int                             pending_count;
+    qint64                          pending_enqueue_time_sum;
+    qint64                          pending_oldest_enqueue_time;
+};
+
+struct Qtilities::Logging::FileLoggerEngineData {
+    FileLoggerEngineData() : write_mode(FileLoggerEngine::DirectWriteMode),
+        flush_size(64 * 1024),
+        flush_interval(1000),
+        flush_on_error(true),
+        buffer_capacity(8192),
+        writer(0),
+        direct_messages_written(0),
+        direct_latency_sum(0),
+        direct_latency_max(0) {}
+
+    FileLoggerEngine::WriteMode     write_mode;
+    int                             flush_size;
+    int                             flush_interval;
+    bool                            flush_on_error;
+    int                             buffer_capacity;
+    FileLoggerEngineWriter*         writer;
+
+    // Metrics in DirectWriteMode, in microseconds:
+    QElapsedTimer                   direct_clock;
+    qint64                          direct_messages_written;
+    qint64                          direct_latency_sum;
+    qint64                          direct_latency_max;
+};
+
 Qtilities::Logging::FileLoggerEngine::FileLoggerEngine() : AbstractLoggerEngine()
 {
+    d = new FileLoggerEngineData;
     file_name = QString();
     abstractLoggerEngineData->formatting_engine = 0;
     setName(QObject::tr("File Logger Engine"));
@@ -43,6 +378,7 @@ Qtilities::Logging::FileLoggerEngine::FileLoggerEngine() : AbstractLoggerEngine(
 Qtilities::Logging::FileLoggerEngine::~FileLoggerEngine()
 {
     finalize();
+    delete d;
 }
 
 bool Qtilities::Logging::FileLoggerEngine::initialize() {
@@ -81,25 +417,58 @@ bool Qtilities::Logging::FileLoggerEngine::initialize() {
     out << abstractLoggerEngineData->formatting_engine->initializeString() << "\n";
     file.close();
 
+    if (d->write_mode == BufferedWriteMode && !d->writer) {
+        // The file stays open for the lifetime of the writer thread, which also takes ownership of it:
+        QFile* writer_file = new QFile(file_name);
+        if (!writer_file->open(QIODevice::Append | QIODevice::Text)) {
+            LOG_ERROR(QString(tr("Failed to initialize file logger engine (%1): Can't open the specified file (%2) for writing...")).arg(objectName()).arg(file_name));
+            delete writer_file;
+            return false;
+        }
+
+        d->writer = new FileLoggerEngineWriter(writer_file,d->buffer_capacity,d->flush_size,d->flush_interval,d->flush_on_error);
+        d->writer->start();
+    }
+
+    d->direct_messages_written = 0;
+    d->direct_latency_sum = 0;
+    d->direct_latency_max = 0;
+    d->direct_clock.start();
+
     abstractLoggerEngineData->is_initialized = true;
     return true;
 }
 
 void Qtilities::Logging::FileLoggerEngine::finalize() {
-    if (abstractLoggerEngineData->is_initialized) {
-        QFile file(file_name);
-        if (!file.exists())
-            return;
+    if (!abstractLoggerEngineData->is_initialized)
+        return;
 
-        if (!file.open(QIODevice::Append | QIODevice::Text))
-            return;
+    // Messages logged from here on must not end up after the finalize string, thus the engine is
+    // marked as finalized first regardless of whether the finalize string can be written:
+    abstractLoggerEngineData->is_initialized = false;
+
+    QString finalize_string;
+    if (abstractLoggerEngineData->formatting_engine)
+        finalize_string = abstractLoggerEngineData->formatting_engine->finalizeString();
 
-        QTextStream out(&file);
-        if (abstractLoggerEngineData->formatting_engine)
-            out << abstractLoggerEngineData->formatting_engine->finalizeString();
-        out << "\n";
-        file.close();
+    if (d->writer) {
+        // Drains the queue and writes the finalize string:
+        d->writer->stop(finalize_string);
+        delete d->writer;
+        d->writer = 0;
+        return;
     }
+
+    QFile file(file_name);
+    if (!file.exists())
+        return;
+
+    if (!file.open(QIODevice::Append | QIODevice::Text))
+        return;
+
+    QTextStream out(&file);
+    out << finalize_string << "\n";
+    file.close();
 }
 
 QString Qtilities::Logging::FileLoggerEngine::description() const {
@@ -108,9 +477,21 @@ QString Qtilities::Logging::FileLoggerEngine::description() const {
 
 QString Qtilities::Logging::FileLoggerEngine::status() const {
     if (abstractLoggerEngineData->is_initialized) {
-        if (abstractLoggerEngineData->is_enabled)
-            return QString(QObject::tr("Logging in progress to output file: %1")).arg(file_name);
-        else
+        if (abstractLoggerEngineData->is_enabled) {
+            QString metrics;
+            if (d->writer) {
+                metrics = d->writer->metrics();
+            } else {
+                double elapsed_secs = d->direct_clock.elapsed() / 1000.0;
+                double throughput = elapsed_secs > 0 ? d->direct_messages_written / elapsed_secs : 0;
+                double latency_avg = d->direct_messages_written > 0 ? (double) d->direct_latency_sum / d->direct_messages_written : 0;
+                metrics = QString(QObject::tr("%1 messages written, %2 messages/s, latency avg %3 ms / max %4 ms."))
+                        .arg(d->direct_messages_written).arg(throughput,0,'f',1)
+                        .arg(latency_avg / 1000.0,0,'f',3).arg(d->direct_latency_max / 1000.0,0,'f',3);
+            }
+            return QString(QObject::tr("Logging in progress to output file: %1 (%2) %3")).arg(file_name)
+                    .arg(d->writer ? QObject::tr("buffered") : QObject::tr("direct")).arg(metrics);
+        } else
             return QObject::tr("Ready but inactive.");
     } else {
         return QObject::tr("Not initialized.");
@@ -118,6 +499,12 @@ QString Qtilities::Logging::FileLoggerEngine::status() const {
 }
 
 void Qtilities::Logging::FileLoggerEngine::clearLog() {
+    if (d->writer) {
+        // The writer owns the open file, thus it must do the clearing in order with the queued messages:
+        d->writer->enqueue(QString(),FILE_LOGGER_CLEAR_REQUEST);
+        return;
+    }
+
     QFile file(file_name);
     if (!file.open(QIODevice::WriteOnly)) {
         qWarning() << tr("Failed to clear file logger engine:") << file_name;
@@ -127,11 +514,15 @@ void Qtilities::Logging::FileLoggerEngine::clearLog() {
 }
 
 void Qtilities::Logging::FileLoggerEngine::logMessage(const QString& message, Logger::MessageType message_type) {
-    Q_UNUSED(message_type)
-
     if (!abstractLoggerEngineData->is_initialized)
         return;
 
+    if (d->writer) {
+        d->writer->enqueue(message,message_type);
+        return;
+    }
+
+    const qint64 start = d->direct_clock.nsecsElapsed();
     QFile file(file_name);
     if (!file.open(QIODevice::Append | QIODevice::Text))
         return;
@@ -139,6 +530,12 @@ void Qtilities::Logging::FileLoggerEngine::logMessage(const QString& message, Lo
     QTextStream out(&file);
     out << message << "\n";
     file.close();
+
+    const qint64 latency = (d->direct_clock.nsecsElapsed() - start) / 1000;
+    ++d->direct_messages_written;
+    d->direct_latency_sum += latency;
+    if (latency > d->direct_latency_max)
+        d->direct_latency_max = latency;
 }
 
 
@@ -163,10 +560,581 @@ void Qtilities::Logging::FileLoggerEngine::setFileName(const QString& fileName)
         file_name = fileName;
 }
 
-QString Qtilities::Logging::FileLoggerEngine::getFileName() {
+QString Qtilities::Logging::FileLoggerEngine::getFileName() const {
     return file_name;
 }
 
+void Qtilities::Logging::FileLoggerEngine::setWriteMode(WriteMode write_mode) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->write_mode = write_mode;
+}
+
+Qtilities::Logging::FileLoggerEngine::WriteMode Qtilities::Logging::FileLoggerEngine::writeMode() const {
+    return d->write_mode;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setFlushSize(int flush_size) {
+    d->flush_size = qMax(0,flush_size);
+}
+
+int Qtilities::Logging::FileLoggerEngine::flushSize() const {
+    return d->flush_size;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setFlushInterval(int msecs) {
+    d->flush_interval = qMax(0,msecs);
+}
+
+int Qtilities::Logging::FileLoggerEngine::flushInterval() const {
+    return d->flush_interval;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setFlushOnError(bool flush_on_error) {
+    d->flush_on_error = flush_on_error;
+}
+
+bool Qtilities::Logging::FileLoggerEngine::flushOnError() const {
+    return d->flush_on_error;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setBufferCapacity(int capacity) {
+    if (abstractLoggerEngineData->is_initialized)
+        return;
+
+    // Round up to a power of two, the ring buffer indexes using a mask:
+    int rounded = 2;
+    while (rounded < capacity && rounded < (1 << 24))
+        rounded <<= 1;
+    d->buffer_capacity = rounded;
+}
+
+int Qtilities::Logging::FileLoggerEngine::bufferCapacity() const {
+    return d->buffer_capacity;
+}
+
+// ------------------------------------
+// RotatingFileLoggerEngine implementation
+// ------------------------------------
+namespace Qtilities {
+    namespace Logging {
+        LoggerFactoryItem<AbstractLoggerEngine, RotatingFileLoggerEngine> RotatingFileLoggerEngine::factory;
+    }
+}
+
+namespace {
+    const char * const ROTATING_SEGMENT_TIMESTAMP_FORMAT = "yyyyMMdd-hhmmss-zzz";
+    const char * const ROTATING_SEGMENT_COMPRESSED_SUFFIX = ".qz";
+    const quint32 ROTATING_POLICY_VERSION = 1;
+
+    // Segments are named <base>.<timestamp>[-<n>][.<suffix>][.qz] next to the log file.
+    QRegExp rotatingSegmentPattern(const QFileInfo& log_file) {
+        QString pattern = QRegExp::escape(log_file.completeBaseName()) + "\\.\\d{8}-\\d{6}-\\d{3}(-\\d+)?";
+        if (!log_file.suffix().isEmpty())
+            pattern += "\\." + QRegExp::escape(log_file.suffix());
+        pattern += "(" + QRegExp::escape(ROTATING_SEGMENT_COMPRESSED_SUFFIX) + ")?";
+        return QRegExp(pattern);
+    }
+
+    // Returns the segments of the log file ordered from oldest to newest. The timestamps sort in the same order as the names.
+    QStringList rotatingSegments(const QString& file_name) {
+        QFileInfo log_file(file_name);
+        QRegExp pattern = rotatingSegmentPattern(log_file);
+        QStringList segments;
+        foreach (const QString& entry, log_file.absoluteDir().entryList(QDir::Files,QDir::Name)) {
+            if (pattern.exactMatch(entry))
+                segments << log_file.absoluteDir().absoluteFilePath(entry);
+        }
+        return segments;
+    }
+}
+
+/*!
+  \class RotatingFileLoggerEngineJob
+  \brief Compresses a closed segment and enforces the segment count of a RotatingFileLoggerEngine.
+
+  Jobs run one at a time on the thread pool of the engine, thus the file system work of consecutive rotations never overlaps.
+  */
+class RotatingFileLoggerEngineJob : public QRunnable {
+public:
+    RotatingFileLoggerEngineJob(const QString& file_name, const QString& segment, bool compress, int max_segment_count) :
+        file_name(file_name),
+        segment(segment),
+        compress(compress),
+        max_segment_count(max_segment_count) {}
+
+    void run() {
+        if (compress && !segment.isEmpty())
+            compressSegment();
+        if (max_segment_count > 0)
+            removeOldSegments();
+    }
+
+private:
+    void compressSegment() {
+        QFile source(segment);
+        if (!source.open(QIODevice::ReadOnly))
+            return;
+        const QByteArray compressed = qCompress(source.readAll());
+        source.close();
+
+        // Write to a temporary name first, a half written .qz file must never replace the segment:
+        const QString target_name = segment + ROTATING_SEGMENT_COMPRESSED_SUFFIX;
+        const QString temp_name = target_name + ".tmp";
+        QFile target(temp_name);
+        if (!target.open(QIODevice::WriteOnly))
+            return;
+        const bool written = (target.write(compressed) == compressed.size());
+        target.close();
+        if (!written || !QFile::rename(temp_name,target_name)) {
+            QFile::remove(temp_name);
+            return;
+        }
+        QFile::remove(segment);
+    }
+    void removeOldSegments() {
+        QStringList segments = rotatingSegments(file_name);
+        // A segment and its compressed version count as one segment:
+        QStringList stems;
+        foreach (const QString& name, segments) {
+            QString stem = name;
+            if (stem.endsWith(ROTATING_SEGMENT_COMPRESSED_SUFFIX))
+                stem.chop(qstrlen(ROTATING_SEGMENT_COMPRESSED_SUFFIX));
+            if (stems.isEmpty() || stems.last() != stem)
+                stems << stem;
+        }
+
+        for (int i = 0; i < stems.count() - max_segment_count; ++i) {
+            QFile::remove(stems.at(i));
+            QFile::remove(stems.at(i) + ROTATING_SEGMENT_COMPRESSED_SUFFIX);
+        }
+    }
+
+    const QString   file_name;
+    const QString   segment;
+    const bool      compress;
+    const int       max_segment_count;
+};
+
+struct Qtilities::Logging::RotatingFileLoggerEngineData {
+    RotatingFileLoggerEngineData() : max_file_size(10 * 1024 * 1024),
+        max_age(0),
+        max_segment_count(5),
+        compress_segments(true),
+        current_size(0),
+        rotation_count(0),
+        is_rotating(false) {
+        // Jobs must run in order, see RotatingFileLoggerEngineJob:
+        job_pool.setMaxThreadCount(1);
+    }
+
+    qint64          max_file_size;
+    int             max_age;
+    int             max_segment_count;
+    bool            compress_segments;
+
+    qint64          current_size;
+    QElapsedTimer   current_age;
+    int             rotation_count;
+    bool            is_rotating;
+    QThreadPool     job_pool;
+};
+
+Qtilities::Logging::RotatingFileLoggerEngine::RotatingFileLoggerEngine() : FileLoggerEngine()
+{
+    rotatingEngineData = new RotatingFileLoggerEngineData;
+    setName(QObject::tr("Rotating File Logger Engine"));
+}
+
+Qtilities::Logging::RotatingFileLoggerEngine::~RotatingFileLoggerEngine()
+{
+    // The log file itself is finalized by ~FileLoggerEngine(), we only need to wait for pending segment jobs:
+    rotatingEngineData->job_pool.waitForDone();
+    delete rotatingEngineData;
+}
+
+bool Qtilities::Logging::RotatingFileLoggerEngine::initialize() {
+    // Keep the log of a previous session as a segment instead of overwriting it:
+    const QString file_name = getFileName();
+    if (!rotatingEngineData->is_rotating && !abstractLoggerEngineData->is_initialized && !file_name.isEmpty()) {
+        QFileInfo fi(file_name);
+        if (fi.exists() && fi.size() > 0) {
+            QString segment;
+            QString new_name = fi.absoluteDir().absoluteFilePath(fi.completeBaseName() + "." + fi.lastModified().toString(ROTATING_SEGMENT_TIMESTAMP_FORMAT));
+            if (!fi.suffix().isEmpty())
+                new_name += "." + fi.suffix();
+            if (!QFile::exists(new_name) && QFile::rename(file_name,new_name))
+                segment = new_name;
+            rotatingEngineData->job_pool.start(new RotatingFileLoggerEngineJob(file_name,segment,rotatingEngineData->compress_segments,rotatingEngineData->max_segment_count));
+        }
+    }
+
+    if (!FileLoggerEngine::initialize())
+        return false;
+
+    rotatingEngineData->current_size = QFileInfo(file_name).size();
+    rotatingEngineData->current_age.start();
+    return true;
+}
+
+QString Qtilities::Logging::RotatingFileLoggerEngine::description() const {
+    return QObject::tr("Writes log messages to a file which is rotated when it becomes too large or too old.");
+}
+
+QString Qtilities::Logging::RotatingFileLoggerEngine::status() const {
+    if (abstractLoggerEngineData->is_initialized && abstractLoggerEngineData->is_enabled)
+        return QString(QObject::tr("%1 Rotated %2 times this session.")).arg(FileLoggerEngine::status()).arg(rotatingEngineData->rotation_count);
+    return FileLoggerEngine::status();
+}
+
+void Qtilities::Logging::RotatingFileLoggerEngine::clearLog() {
+    FileLoggerEngine::clearLog();
+    rotatingEngineData->current_size = 0;
+}
+
+void Qtilities::Logging::RotatingFileLoggerEngine::logMessage(const QString& message, Logger::MessageType message_type) {
+    if (!abstractLoggerEngineData->is_initialized)
+        return;
+
+    if ((rotatingEngineData->max_file_size > 0 && rotatingEngineData->current_size >= rotatingEngineData->max_file_size) ||
+        (rotatingEngineData->max_age > 0 && rotatingEngineData->current_age.elapsed() >= (qint64) rotatingEngineData->max_age * 1000))
+        rotate();
+
+    FileLoggerEngine::logMessage(message,message_type);
+    // The file is written in the local encoding, the length of the message is a close enough estimate:
+    rotatingEngineData->current_size += message.length() + 1;
+}
+
+bool Qtilities::Logging::RotatingFileLoggerEngine::rotate() {
+    if (!abstractLoggerEngineData->is_initialized || rotatingEngineData->is_rotating)
+        return false;
+
+    // Closes the file, in BufferedWriteMode this waits until all queued messages are written:
+    rotatingEngineData->is_rotating = true;
+    finalize();
+
+    const QString file_name = getFileName();
+    QFileInfo fi(file_name);
+    const QString timestamp = QDateTime::currentDateTime().toString(ROTATING_SEGMENT_TIMESTAMP_FORMAT);
+    const QString suffix = fi.suffix().isEmpty() ? QString() : "." + fi.suffix();
+    QString segment = fi.absoluteDir().absoluteFilePath(fi.completeBaseName() + "." + timestamp + suffix);
+    int duplicate = 0;
+    while (QFile::exists(segment) || QFile::exists(segment + ROTATING_SEGMENT_COMPRESSED_SUFFIX))
+        segment = fi.absoluteDir().absoluteFilePath(QString("%1.%2-%3%4").arg(fi.completeBaseName()).arg(timestamp).arg(++duplicate).arg(suffix));
+
+    if (!QFile::rename(file_name,segment)) {
+        qWarning() << tr("Failed to rotate file logger engine:") << file_name;
+        segment.clear();
+    }
+
+    const bool success = initialize();
+    rotatingEngineData->is_rotating = false;
+    if (!success)
+        return false;
+
+    ++rotatingEngineData->rotation_count;
+    rotatingEngineData->job_pool.start(new RotatingFileLoggerEngineJob(file_name,segment,rotatingEngineData->compress_segments,rotatingEngineData->max_segment_count));
+    return !segment.isEmpty();
+}
+
+QStringList Qtilities::Logging::RotatingFileLoggerEngine::segmentFileNames() const {
+    if (getFileName().isEmpty())
+        return QStringList();
+    return rotatingSegments(getFileName());
+}
+
+bool Qtilities::Logging::RotatingFileLoggerEngine::exportBinary(QDataStream& stream) const {
+    if (!FileLoggerEngine::exportBinary(stream))
+        return false;
+
+    stream << ROTATING_POLICY_VERSION;
+    stream << rotatingEngineData->max_file_size;
+    stream << (qint32) rotatingEngineData->max_age;
+    stream << (qint32) rotatingEngineData->max_segment_count;
+    stream << rotatingEngineData->compress_segments;
+    return stream.status() == QDataStream::Ok;
+}
+
+bool Qtilities::Logging::RotatingFileLoggerEngine::importBinary(QDataStream& stream) {
+    if (!FileLoggerEngine::importBinary(stream))
+        return false;
+
+    quint32 version;
+    qint64 max_file_size;
+    qint32 max_age;
+    qint32 max_segment_count;
+    bool compress_segments;
+    stream >> version;
+    if (version != ROTATING_POLICY_VERSION)
+        return false;
+    stream >> max_file_size;
+    stream >> max_age;
+    stream >> max_segment_count;
+    stream >> compress_segments;
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    setMaxFileSize(max_file_size);
+    setMaxAge(max_age);
+    setMaxSegmentCount(max_segment_count);
+    setCompressSegments(compress_segments);
+    return true;
+}
+
+void Qtilities::Logging::RotatingFileLoggerEngine::setMaxFileSize(qint64 max_size) {
+    rotatingEngineData->max_file_size = qMax((qint64) 0,max_size);
+}
+
+qint64 Qtilities::Logging::RotatingFileLoggerEngine::maxFileSize() const {
+    return rotatingEngineData->max_file_size;
+}
+
+void Qtilities::Logging::RotatingFileLoggerEngine::setMaxAge(int secs) {
+    rotatingEngineData->max_age = qMax(0,secs);
+}
+
+int Qtilities::Logging::RotatingFileLoggerEngine::maxAge() const {
+    return rotatingEngineData->max_age;
+}
+
+void Qtilities::Logging::RotatingFileLoggerEngine::setMaxSegmentCount(int count) {
+    rotatingEngineData->max_segment_count = qMax(0,count);
+}
+
+int Qtilities::Logging::RotatingFileLoggerEngine::maxSegmentCount() const {
+    return rotatingEngineData->max_segment_count;
+}
+
+void Qtilities::Logging::RotatingFileLoggerEngine::setCompressSegments(bool compress) {
+    rotatingEngineData->compress_segments = compress;
+}
+
+bool Qtilities::Logging::RotatingFileLoggerEngine::compressSegments() const {
+    return rotatingEngineData->compress_segments;
+}
+
+// ------------------------------------
+// BinaryFileLoggerEngine implementation
+// ------------------------------------
+namespace Qtilities {
+    namespace Logging {
+        LoggerFactoryItem<AbstractLoggerEngine, BinaryFileLoggerEngine> BinaryFileLoggerEngine::factory;
+    }
+}
+
+struct Qtilities::Logging::BinaryFileLoggerEngineData {
+    BinaryFileLoggerEngineData() : flush_size(64 * 1024),
+        template_limit(4096),
+        message_count(0),
+        bytes_written(0) {}
+
+    QString                 file_name;
+    QFile                   file;
+    QByteArray              pending;
+    int                     flush_size;
+    int                     template_limit;
+    QHash<QString,quint32>  template_ids;
+    QHash<QString,quint32>  engine_ids;
+    qint64                  message_count;
+    qint64                  bytes_written;
+};
+
+Qtilities::Logging::BinaryFileLoggerEngine::BinaryFileLoggerEngine() : AbstractLoggerEngine()
+{
+    d = new BinaryFileLoggerEngineData;
+    abstractLoggerEngineData->formatting_engine = &FormattingEngine_Binary::instance();
+    setName(QObject::tr("Binary File Logger Engine"));
+}
+
+Qtilities::Logging::BinaryFileLoggerEngine::~BinaryFileLoggerEngine()
+{
+    finalize();
+    delete d;
+}
+
+bool Qtilities::Logging::BinaryFileLoggerEngine::initialize() {
+    if (d->file_name.isEmpty()) {
+        LOG_ERROR(QString(tr("Failed to initialize binary file logger engine (%1): File name is empty...").arg(objectName())));
+        return false;
+    }
+
+    // Other formatting engines can't produce binary records:
+    abstractLoggerEngineData->formatting_engine = &FormattingEngine_Binary::instance();
+
+    QFileInfo fi(d->file_name);
+    QDir dir(fi.path());
+    if (!dir.exists())
+        dir.mkpath(fi.path());
+
+    d->file.setFileName(d->file_name);
+    if (!d->file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LOG_ERROR(QString(tr("Failed to initialize binary file logger engine (%1): Can't open the specified file (%2) for writing...")).arg(objectName()).arg(d->file_name));
+        return false;
+    }
+
+    d->template_ids.clear();
+    d->engine_ids.clear();
+    d->message_count = 0;
+    d->pending = FormattingEngine_Binary::instance().fileHeader();
+    d->bytes_written = 0;
+    flush();
+
+    abstractLoggerEngineData->is_initialized = true;
+    return true;
+}
+
+void Qtilities::Logging::BinaryFileLoggerEngine::finalize() {
+    if (!abstractLoggerEngineData->is_initialized)
+        return;
+
+    flush();
+    d->file.close();
+    abstractLoggerEngineData->is_initialized = false;
+}
+
+QString Qtilities::Logging::BinaryFileLoggerEngine::description() const {
+    return QObject::tr("Writes log messages as binary records to a file.");
+}
+
+QString Qtilities::Logging::BinaryFileLoggerEngine::status() const {
+    if (abstractLoggerEngineData->is_initialized) {
+        if (abstractLoggerEngineData->is_enabled)
+            return QString(QObject::tr("Logging in progress to binary output file: %1 (%2 messages, %3 templates, %4 KiB written)"))
+                    .arg(d->file_name).arg(d->message_count).arg(d->template_ids.count()).arg(d->bytes_written / 1024);
+        else
+            return QObject::tr("Ready but inactive.");
+    } else {
+        return QObject::tr("Not initialized.");
+    }
+}
+
+void Qtilities::Logging::BinaryFileLoggerEngine::clearLog() {
+    if (!abstractLoggerEngineData->is_initialized)
+        return;
+
+    // Definitions are part of the file, thus they are cleared with it:
+    d->file.resize(0);
+    d->template_ids.clear();
+    d->engine_ids.clear();
+    d->pending = FormattingEngine_Binary::instance().fileHeader();
+    d->bytes_written = 0;
+    flush();
+}
+
+void Qtilities::Logging::BinaryFileLoggerEngine::logMessage(const QString& message, Logger::MessageType message_type) {
+    appendMessage(QString(),message_type,message,QList<QVariant>());
+}
+
+void Qtilities::Logging::BinaryFileLoggerEngine::newMessages(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+    if (messages.isEmpty() || !acceptsMessage(engine_name,message_type,message_context))
+        return;
+
+    // The messages are encoded as they are, there is no need to format them first:
+    appendMessage(engine_name,message_type,messages.front().toString(),messages.mid(1));
+}
+
+void Qtilities::Logging::BinaryFileLoggerEngine::appendMessage(const QString& engine_name, Logger::MessageType message_type, const QString& message, const QList<QVariant>& arguments) {
+    if (!abstractLoggerEngineData->is_initialized)
+        return;
+
+    const FormattingEngine_Binary& binary_format = FormattingEngine_Binary::instance();
+
+    // System wide messages use engine id 0:
+    quint32 engine_id = 0;
+    if (!engine_name.isEmpty()) {
+        QHash<QString,quint32>::const_iterator itr = d->engine_ids.constFind(engine_name);
+        if (itr != d->engine_ids.constEnd()) {
+            engine_id = itr.value();
+        } else {
+            engine_id = d->engine_ids.count() + 1;
+            d->engine_ids.insert(engine_name,engine_id);
+            binary_format.appendDefinitionRecord(d->pending,FormattingEngine_Binary::EngineRecord,engine_id,engine_name);
+        }
+    }
+
+    QList<QVariant> record_arguments;
+    const QString message_template = binary_format.extractTemplate(message,&record_arguments);
+    record_arguments.append(arguments);
+
+    quint32 template_id = FormattingEngine_Binary::InlineTemplateId;
+    // Records hold at most 255 arguments:
+    if (record_arguments.count() <= 255) {
+        QHash<QString,quint32>::const_iterator itr = d->template_ids.constFind(message_template);
+        if (itr != d->template_ids.constEnd()) {
+            template_id = itr.value();
+        } else if (d->template_ids.count() < d->template_limit) {
+            template_id = d->template_ids.count();
+            d->template_ids.insert(message_template,template_id);
+            binary_format.appendDefinitionRecord(d->pending,FormattingEngine_Binary::TemplateRecord,template_id,message_template);
+        }
+    }
+    if (template_id == (quint32) FormattingEngine_Binary::InlineTemplateId) {
+        record_arguments = arguments;
+        record_arguments.prepend(QVariant(message));
+    }
+
+    binary_format.appendMessageRecord(d->pending,message_type,QDateTime::currentMSecsSinceEpoch(),engine_id,template_id,record_arguments);
+    ++d->message_count;
+
+    if (d->pending.size() >= d->flush_size || message_type == Logger::Error || message_type == Logger::Fatal)
+        flush();
+}
+
+void Qtilities::Logging::BinaryFileLoggerEngine::flush() {
+    if (d->pending.isEmpty() || !d->file.isOpen())
+        return;
+
+    const qint64 written = d->file.write(d->pending);
+    d->file.flush();
+    if (written > 0)
+        d->bytes_written += written;
+    d->pending.clear();
+}
+
+Qtilities::Logging::Interfaces::ILoggerExportable::ExportModeFlags Qtilities::Logging::BinaryFileLoggerEngine::supportedFormats() const {
+    ILoggerExportable::ExportModeFlags flags = 0;
+    flags |= ILoggerExportable::Binary;
+    return flags;
+}
+
+bool Qtilities::Logging::BinaryFileLoggerEngine::exportBinary(QDataStream& stream) const {
+    stream << d->file_name;
+    stream << (qint32) d->flush_size;
+    return true;
+}
+
+bool Qtilities::Logging::BinaryFileLoggerEngine::importBinary(QDataStream& stream) {
+    qint32 flush_size;
+    stream >> d->file_name;
+    stream >> flush_size;
+    d->flush_size = flush_size;
+    return stream.status() == QDataStream::Ok;
+}
+
+void Qtilities::Logging::BinaryFileLoggerEngine::setFileName(const QString& file_name) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->file_name = file_name;
+}
+
+QString Qtilities::Logging::BinaryFileLoggerEngine::getFileName() const {
+    return d->file_name;
+}
+
+void Qtilities::Logging::BinaryFileLoggerEngine::setFlushSize(int flush_size) {
+    d->flush_size = qMax(0,flush_size);
+}
+
+int Qtilities::Logging::BinaryFileLoggerEngine::flushSize() const {
+    return d->flush_size;
+}
+
+void Qtilities::Logging::BinaryFileLoggerEngine::setTemplateLimit(int template_limit) {
+    d->template_limit = qMax(0,template_limit);
+}
+
+int Qtilities::Logging::BinaryFileLoggerEngine::templateLimit() const {
+    return d->template_limit;
+}
+
 // ------------------------------------
 // QtMsgLoggerEngine implementation
 // ------------------------------------
@@ -47,11 +47,33 @@ namespace Qtilities {
         // ------------------------------------
         // File Logger Engine
         // ------------------------------------
+        /*!
+        \struct FileLoggerEngineData
+        \brief Structure used by the FileLoggerEngine to store its private data.
+          */
+        struct FileLoggerEngineData;
+
         /*!
         \class FileLoggerEngine
         \brief A logger engine which stores the logged messages in a file.
 
         A logger engine which stores the logged messages in a file.
+
+        By default every message is written directly to the file, thus the file is opened and closed for every message (see FileLoggerEngine::DirectWriteMode).
+        Under heavy logging loads this becomes expensive and the BufferedWriteMode can be used instead. In this mode the file stays open and
+        logMessage() only places the message in a lock-free ring buffer. A dedicated writer thread drains the buffer and writes the messages
+        to the file. When the buffered data is written is controlled by setFlushSize(), setFlushInterval() and setFlushOnError().
+
+\code
+FileLoggerEngine* file_engine = new FileLoggerEngine;
+file_engine->setFileName("trace.log");
+file_engine->setWriteMode(FileLoggerEngine::BufferedWriteMode);
+file_engine->setFlushInterval(500);
+Log->attachLoggerEngine(file_engine);
+\endcode
+
+        finalize() stops the writer thread after all queued messages were written to the file. The status() of the engine includes the
+        throughput and latency of the engine, where latency is the time between a message being logged and it being written to the file.
           */
         class LOGGING_SHARED_EXPORT FileLoggerEngine : public AbstractLoggerEngine, public ILoggerExportable
         {
@@ -60,6 +82,15 @@ namespace Qtilities {
             Q_PROPERTY(QString FileName READ getFileName)
 
         public:
+            //! The ways in which the FileLoggerEngine can write messages to its file.
+            /*!
+              <i>This enumeration was added in %Qtilities v1.5.</i>
+              */
+            enum WriteMode {
+                DirectWriteMode,    /*!< Every message is written directly to the file in logMessage(). The file is opened and closed for every message. This is the default. */
+                BufferedWriteMode   /*!< Messages are queued in logMessage() and written by a background writer thread while the file stays open. */
+            };
+
             FileLoggerEngine();
             ~FileLoggerEngine();
 
@@ -92,7 +123,64 @@ namespace Qtilities {
               */
             void setFileName(const QString& fileName);
             //! Gets the file name to which the logger is currently logging.
-            QString getFileName();
+            QString getFileName() const;
+
+            //! Sets the write mode of the engine.
+            /*!
+              Its not possible to change the write mode while the logger engine is in a initialized state.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setWriteMode(WriteMode write_mode);
+            //! Gets the write mode of the engine.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            WriteMode writeMode() const;
+            //! Sets the number of bytes collected by the writer thread before they are written to the file in BufferedWriteMode.
+            /*!
+              The default is 64 KiB. A flush size of 0 writes every message as soon as the writer thread receives it.
+
+              \note Changes take effect the next time the engine is initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFlushSize(int flush_size);
+            //! Gets the number of bytes collected by the writer thread before they are written to the file in BufferedWriteMode.
+            int flushSize() const;
+            //! Sets the maximum time in milliseconds that a message can stay in the buffer in BufferedWriteMode.
+            /*!
+              The default is 1000 milliseconds.
+
+              \note Changes take effect the next time the engine is initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFlushInterval(int msecs);
+            //! Gets the maximum time in milliseconds that a message can stay in the buffer in BufferedWriteMode.
+            int flushInterval() const;
+            //! Sets if Logger::Error and Logger::Fatal messages causes the buffer to be written to the file immediately in BufferedWriteMode.
+            /*!
+              Enabled by default, which makes sure errors are on disk in case the application crashes shortly after logging them.
+
+              \note Changes take effect the next time the engine is initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFlushOnError(bool flush_on_error);
+            //! Gets if Logger::Error and Logger::Fatal messages causes the buffer to be written to the file immediately in BufferedWriteMode.
+            bool flushOnError() const;
+            //! Sets the number of messages which can be queued in the ring buffer in BufferedWriteMode.
+            /*!
+              The capacity is rounded up to the next power of two. When the buffer is full, logMessage() waits for the writer thread to make space, messages are never dropped. The default is 8192 messages.
+
+              Its not possible to change the capacity while the logger engine is in a initialized state.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setBufferCapacity(int capacity);
+            //! Gets the number of messages which can be queued in the ring buffer in BufferedWriteMode.
+            int bufferCapacity() const;
 
             // Make this class a factory item
             static LoggerFactoryItem<AbstractLoggerEngine, FileLoggerEngine> factory;
@@ -102,6 +190,202 @@ namespace Qtilities {
 
         private:
             QString file_name;
+            FileLoggerEngineData* d;
+        };
+
+        // ------------------------------------
+        // Rotating File Logger Engine
+        // ------------------------------------
+        /*!
+        \struct RotatingFileLoggerEngineData
+        \brief Structure used by the RotatingFileLoggerEngine to store its private data.
+          */
+        struct RotatingFileLoggerEngineData;
+
+        /*!
+        \class RotatingFileLoggerEngine
+        \brief A file logger engine which rotates its log file when it becomes too large or too old.
+
+        The FileLoggerEngine writes to a single file which grows for as long as the session runs. The RotatingFileLoggerEngine bounds the
+        log file by closing the current file and starting a new one whenever the current file exceeds setMaxFileSize() bytes, or when it
+        was started more than setMaxAge() seconds ago. The closed file is renamed to a segment next to the log file, where a timestamp is
+        inserted before the file extension. For example \p session.log becomes \p session.20130412-101527-042.log.
+
+        Closed segments are compressed in the background when setCompressSegments() is enabled, in which case the segment is replaced
+        by a file with an additional \p .qz extension. The compressed file contains the output of qCompress() and can be read back using
+        qUncompress(). Only the newest setMaxSegmentCount() segments are kept, older segments are deleted.
+
+\code
+RotatingFileLoggerEngine* file_engine = qobject_cast<RotatingFileLoggerEngine*> (Log->newRotatingFileEngine("Session Log","session.log",10 * 1024 * 1024,5));
+file_engine->setMaxAge(24 * 60 * 60);
+\endcode
+
+        When the engine is initialized while the log file already contains messages from a previous session, that file is rotated first
+        instead of being overwritten.
+
+        The rotation policy is part of the binary session configuration of the engine, thus it is restored by Logger::loadSessionConfig().
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class LOGGING_SHARED_EXPORT RotatingFileLoggerEngine : public FileLoggerEngine
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Logging::Interfaces::ILoggerExportable)
+
+        public:
+            RotatingFileLoggerEngine();
+            ~RotatingFileLoggerEngine();
+
+            // --------------------------------
+            // AbstractLoggerEngine Implementation
+            // --------------------------------
+            bool initialize();
+            QString description() const;
+            QString status() const;
+            void clearLog();
+
+            // --------------------------------
+            // ILoggerExportable Implementation
+            // --------------------------------
+            bool exportBinary(QDataStream& stream) const;
+            bool importBinary(QDataStream& stream);
+            QString factoryTag() const { return qti_def_FACTORY_TAG_ROTATING_FILE_LOGGER_ENGINE; }
+
+            //! Sets the size in bytes at which the log file is rotated.
+            /*!
+              The size is tracked from the length of the logged messages, thus the file is rotated on the first message which
+              takes it past the maximum size. A size of 0 disables size based rotation. The default is 10 MiB.
+              */
+            void setMaxFileSize(qint64 max_size);
+            //! Gets the size in bytes at which the log file is rotated.
+            qint64 maxFileSize() const;
+            //! Sets the age in seconds at which the log file is rotated.
+            /*!
+              The age is checked when messages are logged. An age of 0 disables time based rotation, which is the default.
+              */
+            void setMaxAge(int secs);
+            //! Gets the age in seconds at which the log file is rotated.
+            int maxAge() const;
+            //! Sets the number of closed segments which are kept next to the log file.
+            /*!
+              A count of 0 keeps all segments. The default is 5.
+              */
+            void setMaxSegmentCount(int count);
+            //! Gets the number of closed segments which are kept next to the log file.
+            int maxSegmentCount() const;
+            //! Sets if closed segments are compressed in the background. Enabled by default.
+            void setCompressSegments(bool compress);
+            //! Gets if closed segments are compressed in the background.
+            bool compressSegments() const;
+
+            //! Closes the current log file as a segment and starts a new log file.
+            /*!
+              This is done automatically according to the rotation policy, but can also be triggered manually.
+
+              \returns True if the log file was rotated, false if the engine is not initialized or the new log file could not be created.
+              */
+            bool rotate();
+            //! Returns the file names of the closed segments which are currently on disk, ordered from oldest to newest.
+            QStringList segmentFileNames() const;
+
+            // Make this class a factory item
+            static LoggerFactoryItem<AbstractLoggerEngine, RotatingFileLoggerEngine> factory;
+
+        public slots:
+            void logMessage(const QString& message, Logger::MessageType message_type);
+
+        private:
+            RotatingFileLoggerEngineData* rotatingEngineData;
+        };
+
+        // ------------------------------------
+        // Binary File Logger Engine
+        // ------------------------------------
+        /*!
+        \struct BinaryFileLoggerEngineData
+        \brief Structure used by the BinaryFileLoggerEngine to store its private data.
+          */
+        struct BinaryFileLoggerEngineData;
+
+        /*!
+        \class BinaryFileLoggerEngine
+        \brief A logger engine which writes messages as binary records to an append-only file.
+
+        The text based formatting engines convert every message and its arguments to a string, which is expensive to produce and to parse again
+        afterwards. This engine does not format messages. Instead it encodes the raw message contents using FormattingEngine_Binary, where the first
+        part of each message is split into a template and its variable parts using FormattingEngine_Binary::extractTemplate(). The template is stored
+        once per file, and the variable parts and the remaining parts of the message are packed as typed arguments. At most templateLimit() templates
+        are interned per file, messages with new templates are stored inline once the limit is reached.
+
+        Records are collected in memory and written when setFlushSize() bytes are pending, when an error or fatal message is logged, and when the
+        engine is finalized. Binary log files are read using the BinaryLogReader class.
+
+\code
+BinaryFileLoggerEngine* binary_engine = new BinaryFileLoggerEngine;
+binary_engine->setFileName("session.qlog");
+Log->attachLoggerEngine(binary_engine);
+\endcode
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class LOGGING_SHARED_EXPORT BinaryFileLoggerEngine : public AbstractLoggerEngine, public ILoggerExportable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Logging::Interfaces::ILoggerExportable)
+            Q_PROPERTY(QString FileName READ getFileName)
+
+        public:
+            BinaryFileLoggerEngine();
+            ~BinaryFileLoggerEngine();
+
+            // --------------------------------
+            // AbstractLoggerEngine Implementation
+            // --------------------------------
+            bool initialize();
+            void finalize();
+            QString description() const;
+            QString status() const;
+            bool isFormattingEngineConstant() const { return true; }
+            void clearLog();
+
+            // --------------------------------
+            // ILoggerExportable Implementation
+            // --------------------------------
+            ExportModeFlags supportedFormats() const;
+            bool exportBinary(QDataStream& stream) const;
+            bool importBinary(QDataStream& stream);
+            QString factoryTag() const { return qti_def_FACTORY_TAG_BINARY_FILE_LOGGER_ENGINE; }
+            QString instanceName() const { return name(); }
+
+            //! Sets the file name to which this engine will write the log output.
+            /*!
+                Its not possible to change the file name while the logger engine is in a initialized state.
+              */
+            void setFileName(const QString& file_name);
+            //! Gets the file name to which the logger is currently logging.
+            QString getFileName() const;
+            //! Sets the number of bytes collected in memory before they are written to the file. The default is 64 KiB.
+            void setFlushSize(int flush_size);
+            //! Gets the number of bytes collected in memory before they are written to the file.
+            int flushSize() const;
+            //! Writes all pending records to the file.
+            void flush();
+            //! Sets the maximum number of message templates interned per file. The default is 4096.
+            void setTemplateLimit(int template_limit);
+            //! Gets the maximum number of message templates interned per file.
+            int templateLimit() const;
+
+            // Make this class a factory item
+            static LoggerFactoryItem<AbstractLoggerEngine, BinaryFileLoggerEngine> factory;
+
+        public slots:
+            void logMessage(const QString& message, Logger::MessageType message_type);
+            void newMessages(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages);
+
+        private:
+            void appendMessage(const QString& engine_name, Logger::MessageType message_type, const QString& message, const QList<QVariant>& arguments);
+
+            BinaryFileLoggerEngineData* d;
         };
 
         // ------------------------------------
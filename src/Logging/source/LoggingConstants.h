@@ -39,12 +39,20 @@ namespace Qtilities {
             const char * const qti_def_FORMATTING_ENGINE_XML        = "XML Format";
             const char * const qti_def_FORMATTING_ENGINE_HTML       = "HTML Format";
             const char * const qti_def_FORMATTING_ENGINE_QT_MSG     = "Qt Messaging System Format";
+            const char * const qti_def_FORMATTING_ENGINE_BINARY     = "Binary Format";
 
             // Default Factory Tags
             const char * const qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE = "qti.def.FactoryTag.File";
+            const char * const qti_def_FACTORY_TAG_ROTATING_FILE_LOGGER_ENGINE = "qti.def.FactoryTag.RotatingFile";
+            const char * const qti_def_FACTORY_TAG_BINARY_FILE_LOGGER_ENGINE = "qti.def.FactoryTag.BinaryFile";
 
             // File Extensions
             const char * const qti_def_SUFFIX_LOGGER_CONFIG         = ".logconfig";
+            const char * const qti_def_SUFFIX_BINARY_LOG            = ".qlog";
+
+            // Binary Log Format
+            //! The magic bytes at the start of every binary log file, see Qtilities::Logging::FormattingEngine_Binary.
+            const char * const qti_def_BINARY_LOG_MAGIC             = "QTILOG01";
 
             // Default file paths (all subdirectories of the executable file)
             const char * const qti_def_PATH_SESSION                 = "Session";
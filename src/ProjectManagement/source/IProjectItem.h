@@ -42,6 +42,15 @@ namespace Qtilities {
                 virtual bool newProjectItem() = 0;
                 //! Close the project item.
                 virtual bool closeProjectItem(ITask *task = 0) = 0;
+                //! Indicates if the project item can be exported from a thread other than the thread in which it lives.
+                /*!
+                  When parallel exports are enabled on a Project using Project::setParallelExportEnabled(), project items which return true
+                  here are exported concurrently into separate buffers. Items which access widgets or other objects which may only be used
+                  in the GUI thread during exports must return false, which is the default.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual bool concurrentExportSupported() const { return false; }
             };
         }
     }
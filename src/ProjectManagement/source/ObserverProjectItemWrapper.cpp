@@ -19,6 +19,8 @@
 
 #include <QApplication>
 #include <QDomNodeList>
+#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
 
 using namespace Qtilities::Core::Interfaces;
 using namespace Qtilities::Core;
@@ -80,6 +82,20 @@ bool Qtilities::ProjectManagement::ObserverProjectItemWrapper::closeProjectItem(
     return true;
 }
 
+bool Qtilities::ProjectManagement::ObserverProjectItemWrapper::concurrentExportSupported() const {
+    if (!d->observer)
+        return false;
+
+    // Relational exports set properties on the subjects, which are handled by the event filters of their observers:
+    if (d->export_flags & ObserverData::ExportRelationalData || d->export_flags & ObserverData::ExportVisitorIDs)
+        return false;
+
+    // Shared subjects could be exported by more than one project item at the same time:
+    QList<const Observer*> observers;
+    observers << d->observer;
+    return !ObserverData::subjectsShared(observers);
+}
+
 Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::ProjectManagement::ObserverProjectItemWrapper::supportedFormats() const {
     IExportable::ExportModeFlags flags = 0;
     flags |= IExportable::Binary;
@@ -177,6 +193,46 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     return IExportable::Incomplete;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::ObserverProjectItemWrapper::exportXmlStream(QXmlStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (d->observer) {
+        // Add a new node for this observer, the same as exportXml() does:
+        writer->writeStartElement("ObserverProjectItemWrapper");
+        IExportable::ExportResultFlags result = d->observer->exportXmlStreamExt(writer,d->export_flags);
+        writer->writeEndElement();
+        return result;
+    } else
+        return IExportable::Incomplete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::ObserverProjectItemWrapper::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    IExportable::ExportResultFlags result = IExportable::Incomplete;
+    bool imported = false;
+    if (d->observer) {
+        // Only the first observer node is imported, the same as importXml() does:
+        while (reader->readNextStartElement()) {
+            if (!imported && reader->name() == QLatin1String("ObserverProjectItemWrapper")) {
+                d->observer->setExportVersion(exportVersion());
+                result = d->observer->importXmlStream(reader,import_list);
+                if (result & IExportable::FailedResult)
+                    return result;
+                imported = true;
+            } else
+                reader->skipCurrentElement();
+        }
+    } else
+        reader->skipCurrentElement();
+
+    return result;
+}
+
 void Qtilities::ProjectManagement::ObserverProjectItemWrapper::setExportItemFlags(ObserverData::ExportItemFlags flags) {
     d->export_flags = flags;
 }
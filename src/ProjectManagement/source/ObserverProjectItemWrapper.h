@@ -61,6 +61,15 @@ OBJECT_MANAGER->registerObject(project_item,QtilitiesCategory("Core::Project Ite
             QString projectItemName() const;
             bool newProjectItem();
             bool closeProjectItem(ITask* task = 0);
+            //! The observer context is exported without accessing the GUI, thus it can be exported concurrently as long as it is not shared with other project items.
+            /*!
+              Returns false when the export flags contain ObserverData::ExportRelationalData or ObserverData::ExportVisitorIDs, or when the observer
+              context or any subject underneath it is attached to more than one observer.
+
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool concurrentExportSupported() const;
 
             // --------------------------------
             // IExportable Implementation
@@ -74,6 +83,8 @@ OBJECT_MANAGER->registerObject(project_item,QtilitiesCategory("Core::Project Ite
             virtual IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
             virtual IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
             virtual IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            virtual IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            virtual IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
             //! Sets the export item flags to be used for this project item.
             /*!
@@ -21,6 +21,12 @@
 
 #include <QFileInfo>
 #include <QDomElement>
+#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QBuffer>
+#include <QFile>
 #include <QApplication>
 #include <QCursor>
 #include <QMessageBox>
@@ -29,6 +35,7 @@
 
 #include <stdio.h>
 #include <time.h>
+#include <limits.h>
 
 using namespace Qtilities::ProjectManagement::Constants;
 using namespace Qtilities;
@@ -36,7 +43,21 @@ using namespace Qtilities::Core;
 
 struct Qtilities::ProjectManagement::ProjectPrivateData {
     ProjectPrivateData(): project_file(QString()),
-    project_name(QString(QObject::tr("New Project"))) {}
+    project_name(QString(QObject::tr("New Project"))),
+    parallel_export(false),
+    indexed_binary_format(false),
+    deferred_item_loading(false),
+    mapped_project_data(0),
+    project_data_version(Qtilities::Qtilities_Latest),
+    project_data_application_version(0),
+    delta_saving(false),
+    compaction_threshold(50),
+    file_index_valid(false),
+    file_index_header_size(0),
+    file_index_file_size(0),
+    file_generation(0) {
+        compaction_pool.setMaxThreadCount(1);
+    }
 
     QList<IProjectItem*>    project_items;
     QString                 project_file;
@@ -44,14 +65,131 @@ struct Qtilities::ProjectManagement::ProjectPrivateData {
     QMutex                  modification_mutex;
 
     FileLocker              file_locker;
+    bool                    parallel_export;
+    QThreadPool             export_pool;
+
+    bool                    indexed_binary_format;
+    bool                    deferred_item_loading;
+    //! The indexed binary project file from which deferred project items are loaded. Mapped into memory when possible.
+    QFile                   project_data_file;
+    uchar*                  mapped_project_data;
+    //! The contents of project_data_file, either wrapping the mapped memory or read from the file.
+    QByteArray              project_data;
+    Qtilities::ExportVersion project_data_version;
+    quint32                 project_data_application_version;
+    QVector<qint64>         project_item_offsets;
+    QVector<qint64>         project_item_sizes;
+    QVector<bool>           project_items_loaded;
+
+    bool                    delta_saving;
+    int                     compaction_threshold;
+    //! The index of the indexed binary project file at project_file, used to append delta saves to the file.
+    bool                    file_index_valid;
+    QVector<qint64>         file_index_offsets;
+    QVector<qint64>         file_index_sizes;
+    //! The size of the file format information and the primary index at the start of the file.
+    qint64                  file_index_header_size;
+    //! The size of the file when it was last written or read, used to detect changes made to the file by others.
+    qint64                  file_index_file_size;
+    //! Changes every time the project file is written, compactions of older generations are discarded.
+    int                     file_generation;
+    QThreadPool             compaction_pool;
+};
+
+/*!
+  \class Qtilities::ProjectManagement::ProjectCompactionTask
+  \brief Compacts an indexed binary project file in the background.
+
+  Only the latest segment of each project item is copied to the compacted file, thus the project items are not exported
+  again. The compacted file is moved over the project file by Project in its own thread when the task is done.
+  */
+class Qtilities::ProjectManagement::ProjectCompactionTask : public QRunnable {
+public:
+    ProjectCompactionTask(Project* project, const QString& source_file, const QString& target_file, qint64 header_size, const QVector<qint64>& offsets, const QVector<qint64>& sizes, int generation) :
+        project(project),
+        source_file(source_file),
+        target_file(target_file),
+        header_size(header_size),
+        offsets(offsets),
+        sizes(sizes),
+        generation(generation) {}
+
+    void run() {
+        QVector<qint64> compacted_offsets;
+        bool success = Project::writeCompactedProjectFile(source_file,target_file,header_size,offsets,sizes,&compacted_offsets);
+        QMetaObject::invokeMethod(project,"finishProjectCompaction",Qt::QueuedConnection,Q_ARG(QString,target_file),Q_ARG(bool,success),Q_ARG(int,generation),Q_ARG(QVector<qint64>,compacted_offsets));
+    }
+
+private:
+    Project*            project;
+    QString             source_file;
+    QString             target_file;
+    qint64              header_size;
+    QVector<qint64>     offsets;
+    QVector<qint64>     sizes;
+    int                 generation;
+};
+
+/*!
+  \class Qtilities::ProjectManagement::ProjectItemExportTask
+  \brief Exports a single project item to a buffer during parallel exports of Project.
+
+  Binary exports use a buffer with the version, byte order and floating point precision of the stream to which the project is
+  exported, thus the buffer can be written to that stream as raw data afterwards. XML exports are done into a separate document.
+  */
+class Qtilities::ProjectManagement::ProjectItemExportTask : public QRunnable {
+public:
+    ProjectItemExportTask(IProjectItem* item, int item_index, IExportable::ExportMode export_mode, const QDataStream* target_stream) :
+        item(item),
+        item_index(item_index),
+        export_mode(export_mode),
+        stream_version(target_stream ? target_stream->version() : QDataStream::Qt_4_7),
+        byte_order(target_stream ? target_stream->byteOrder() : QDataStream::BigEndian),
+        precision(target_stream ? target_stream->floatingPointPrecision() : QDataStream::DoublePrecision),
+        doc("ProjectItem"),
+        result(IExportable::Failed) {
+        setAutoDelete(false);
+    }
+
+    void run() {
+        if (export_mode == IExportable::Binary) {
+            QBuffer buffer(&export_data);
+            buffer.open(QIODevice::WriteOnly);
+            QDataStream stream(&buffer);
+            stream.setVersion(stream_version);
+            stream.setByteOrder(byte_order);
+            stream.setFloatingPointPrecision(precision);
+            result = item->exportBinary(stream);
+            buffer.close();
+        } else {
+            // The Name attribute is added by the project when the element is added to its document:
+            item_root = doc.createElement("ProjectItem_" + QString::number(item_index));
+            doc.appendChild(item_root);
+            result = item->exportXml(&doc,&item_root);
+        }
+    }
+
+    IProjectItem*                           item;
+    int                                     item_index;
+    IExportable::ExportMode                 export_mode;
+    int                                     stream_version;
+    QDataStream::ByteOrder                  byte_order;
+    QDataStream::FloatingPointPrecision     precision;
+    QByteArray                              export_data;
+    QDomDocument                            doc;
+    QDomElement                             item_root;
+    IExportable::ExportResultFlags          result;
 };
 
 Qtilities::ProjectManagement::Project::Project(QObject* parent) : QObject(parent), IProject() {
     d = new ProjectPrivateData;
     setObjectName("Project");
+    qRegisterMetaType<QVector<qint64> >("QVector<qint64>");
 }
 
 Qtilities::ProjectManagement::Project::~Project() {
+    // A running compaction refers to this project:
+    d->compaction_pool.waitForDone();
     closeProject();
     delete d;
 }
@@ -68,6 +206,12 @@ bool Qtilities::ProjectManagement::Project::newProject() {
 }
 
 quint32 MARKER_PROJECT_SECTION = 0xBABEFACE;
+// Marks the start and the end of the index at the beginning of indexed binary project files:
+quint32 MARKER_PROJECT_INDEX_SECTION = 0xBABEF11E;
+// Marks the index segments and the trailer appended to indexed binary project files by delta saves:
+quint32 MARKER_PROJECT_DELTA_SECTION = 0xBABEDE17;
+// The size of the trailer of delta saves: the offset of the latest index segment followed by the delta marker:
+const qint64 PROJECT_DELTA_TRAILER_SIZE = sizeof(qint64) + sizeof(quint32);
 
 bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name, ITask* task) {
     if (!PROJECT_MANAGER->projectSavingEnabled()) {
@@ -87,21 +231,57 @@ bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name
 
     LOG_TASK_INFO(tr("Starting to save current project to file: ") + file_name,task);
 
+    // Project items modified before they were loaded would either lose their data in the file or be merged with it:
+    QStringList modified_unloaded_items = modifiedUnloadedProjectItems();
+    if (!modified_unloaded_items.isEmpty()) {
+        LOG_TASK_ERROR_P(QString(tr("The following project item(s) were modified before they were loaded, the project will not be saved to file %1: %2")).arg(file_name).arg(modified_unloaded_items.join(", ")),task);
+        return false;
+    }
+
+    // Delta saves append the modified project items to the project file, thus items which were not loaded yet keep their data in the file:
+    if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::Binary)) && d->indexed_binary_format && d->delta_saving && deltaSaveSupported(file_name)) {
+        IExportable::setExportTask(task);
+        IExportable::ExportResultFlags success = saveProjectDelta();
+        IExportable::clearExportTask();
+        if (success != IExportable::Failed) {
+            setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+            if (success == IExportable::Complete)
+                LOG_TASK_INFO_P(tr("Successfully saved changes to the complete project to file: ") + d->project_file,task);
+            if (success == IExportable::Incomplete)
+                LOG_TASK_INFO_P(tr("Successfully saved changes to the incomplete project to file: ") + d->project_file,task);
+
+            if (compactionRequired())
+                startProjectCompaction();
+            return true;
+        }
+        LOG_TASK_WARNING(tr("Failed to save the changes to the project, the complete project will be saved instead."),task);
+    }
+
+    // Deferred project items must be loaded before the project file is replaced:
+    if (!loadDeferredProjectItems(task)) {
+        LOG_TASK_ERROR_P(tr("Failed to load all project items, the project will not be saved to file: ") + file_name,task);
+        return false;
+    }
+
     if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::XML))) {
         QTemporaryFile file;
         file.open();
 
-        // Create the QDomDocument:
-        QDomDocument doc("QtilitiesXMLProject");
-        QDomElement root = doc.createElement("QtilitiesXMLProject");
-        doc.appendChild(root);
+        // Write the project directly to the file, the complete document is never built in memory:
+        QXmlStreamWriter writer(&file);
+        writer.setAutoFormatting(true);
+        writer.setAutoFormattingIndent(2);
+        writer.writeStartDocument();
+        writer.writeComment("Created by " + QApplication::applicationName() + " v" + QApplication::applicationVersion() + " on " + QDateTime::currentDateTime().toString());
+        writer.writeDTD("<!DOCTYPE QtilitiesXMLProject>");
+        writer.writeStartElement("QtilitiesXMLProject");
 
         #ifdef QTILITIES_BENCHMARKING
         time_t start,end;
         time(&start);
         #endif
         IExportable::setExportTask(task);
-        IExportable::ExportResultFlags success = exportXml(&doc,&root);
+        IExportable::ExportResultFlags success = exportXmlStream(&writer);
         IExportable::clearExportTask();
         #ifdef QTILITIES_BENCHMARKING
         time(&end);
@@ -109,11 +289,12 @@ bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name
         LOG_TASK_INFO("Project XML export completed in " + QString::number(diff) + " seconds.",task);
         #endif
 
-        // Put the complete doc in a string and save it to the file:
-        QString docStr = doc.toString(2);
-        docStr.prepend("<!--Created by " + QApplication::applicationName() + " v" + QApplication::applicationVersion() + " on " + QDateTime::currentDateTime().toString() + "-->\n");
-        docStr.prepend("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
-        file.write(docStr.toUtf8());
+        writer.writeEndElement();
+        writer.writeEndDocument();
+        if (writer.hasError()) {
+            LOG_TASK_ERROR(tr("Failed to write the project to a temporary file: ") + file.errorString(),task);
+            success = IExportable::Failed;
+        }
         file.close();
 
         if (success != IExportable::Failed) {
@@ -128,6 +309,7 @@ bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name
                 }
             }
             file.copy(d->project_file);
+            setProjectFileIndex(false);
 
             // Only if successfull, check if the new file is different to the old file and handle locks accordingly:
             if (PROJECT_MANAGER->useProjectFileLocks()) {
@@ -176,7 +358,14 @@ bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name
         time(&start);
         #endif
         IExportable::setExportTask(task);
-        IExportable::ExportResultFlags success = exportBinary(stream);
+        QVector<qint64> item_offsets;
+        QVector<qint64> item_sizes;
+        qint64 header_size = 0;
+        IExportable::ExportResultFlags success;
+        if (d->indexed_binary_format)
+            success = exportBinaryIndexed(stream,&item_offsets,&item_sizes,&header_size);
+        else
+            success = exportBinary(stream);
         IExportable::clearExportTask();
         #ifdef QTILITIES_BENCHMARKING
         time(&end);
@@ -198,6 +387,7 @@ bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name
                 }
             }
             file.copy(d->project_file);
+            setProjectFileIndex(d->indexed_binary_format,item_offsets,item_sizes,header_size);
 
             // Only if successfull, check if the new file is different to the old file and handle locks accordingly:
             if (PROJECT_MANAGER->useProjectFileLocks()) {
@@ -253,22 +443,18 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
     d->project_file = file_name;
     d->project_name = QFileInfo(file_name).fileName();
     file.open(QIODevice::ReadOnly);
+    setProjectFileIndex(false);
 
     if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::XML))) {
-        // Load the file into doc:
-        QDomDocument doc("QtilitiesXMLProject");
-        QString docStr = file.readAll();
-        file.close();
-        QString error_string;
-        int error_line;
-        int error_column;
-        if (!doc.setContent(docStr,&error_string,&error_line,&error_column)) {
-            LOG_TASK_ERROR_P(QString(tr("The tree input file could not be parsed by QDomDocument. Error on line %1 column %2: %3")).arg(error_line).arg(error_column).arg(error_string),task);
+        // Read the file element by element, the complete document is never built in memory:
+        QXmlStreamReader reader(&file);
+        if (!reader.readNextStartElement()) {
+            LOG_TASK_ERROR_P(QString(tr("The project file could not be parsed. Error on line %1 column %2: %3")).arg(reader.lineNumber()).arg(reader.columnNumber()).arg(reader.errorString()),task);
+            file.close();
             return false;
         }
-        QDomElement root = doc.documentElement();
 
-        // Interpret the loaded doc:
+        // Interpret the file:
         QList<QPointer<QObject> > import_list;
 
         #ifdef QTILITIES_BENCHMARKING
@@ -276,7 +462,7 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
         time(&start);
         #endif
         setExportTask(task);
-        IExportable::ExportResultFlags success = importXml(&doc,&root,import_list);
+        IExportable::ExportResultFlags success = importXmlStream(&reader,import_list);
         clearExportTask();
         #ifdef QTILITIES_BENCHMARKING
         time(&end);
@@ -284,6 +470,12 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
         LOG_TASK_INFO("Project XML import completed in " + QString::number(diff) + " seconds.",task);
         #endif
 
+        if (reader.hasError()) {
+            LOG_TASK_ERROR_P(QString(tr("The project file could not be parsed. Error on line %1 column %2: %3")).arg(reader.lineNumber()).arg(reader.columnNumber()).arg(reader.errorString()),task);
+            success = IExportable::Failed;
+        }
+        file.close();
+
         if (success & IExportable::SuccessResult || success == IExportable::Complete) {
             // We change the project name to the selected file name
             QFileInfo fi(d->project_file);
@@ -343,8 +535,18 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
         time_t start,end;
         time(&start);
         #endif
+        // Indexed project files are read from memory, while files saved by previous versions are read sequentially:
+        quint32 marker;
+        stream >> marker;
         setExportTask(task);
-        IExportable::ExportResultFlags success = importBinary(stream,import_list);
+        IExportable::ExportResultFlags success;
+        if (marker == MARKER_PROJECT_INDEX_SECTION) {
+            file.close();
+            success = importBinaryIndexed(file_name,import_list);
+        } else {
+            file.seek(0);
+            success = importBinary(stream,import_list);
+        }
         clearExportTask();
         #ifdef QTILITIES_BENCHMARKING
         time(&end);
@@ -410,6 +612,8 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
 
 bool Qtilities::ProjectManagement::Project::closeProject(ITask *task) {
     LOG_TASK_INFO_P(tr("Closing project: ") + d->project_file,task);
+    releaseProjectData();
+    setProjectFileIndex(false);
     for (int i = 0; i < d->project_items.count(); ++i) {
         d->project_items.at(i)->closeProjectItem(task);
     }
@@ -483,9 +687,141 @@ Qtilities::ProjectManagement::IProjectItem* Qtilities::ProjectManagement::Projec
     if (index < 0 || index >= d->project_items.count())
         return 0;
 
+    // Items are loaded when they are accessed for the first time, see setDeferredItemLoading():
+    if (!isProjectItemLoaded(index))
+        loadProjectItem(index);
     return d->project_items.at(index);
 }
 
+void Qtilities::ProjectManagement::Project::setIndexedBinaryFormatEnabled(bool is_enabled) {
+    d->indexed_binary_format = is_enabled;
+}
+
+bool Qtilities::ProjectManagement::Project::indexedBinaryFormatEnabled() const {
+    return d->indexed_binary_format;
+}
+
+void Qtilities::ProjectManagement::Project::setDeferredItemLoading(bool is_enabled) {
+    d->deferred_item_loading = is_enabled;
+}
+
+bool Qtilities::ProjectManagement::Project::deferredItemLoading() const {
+    return d->deferred_item_loading;
+}
+
+bool Qtilities::ProjectManagement::Project::isProjectItemLoaded(int index) const {
+    if (index < 0 || index >= d->project_items_loaded.count())
+        return true;
+
+    return d->project_items_loaded.at(index);
+}
+
+bool Qtilities::ProjectManagement::Project::loadProjectItem(int index, ITask* task) {
+    if (index < 0 || index >= d->project_items.count())
+        return false;
+    if (isProjectItemLoaded(index))
+        return true;
+
+    // Importing the item would merge the data in the project file with the changes:
+    if (d->project_items.at(index)->isModified()) {
+        LOG_TASK_ERROR_P(QString(tr("Project item %1 (%2) was modified before it was loaded, it will not be loaded from the project file.")).arg(index).arg(d->project_items.at(index)->projectItemName()),task);
+        return false;
+    }
+
+    // Loading an item does not change the project:
+    bool was_modified = isModified();
+    QList<QPointer<QObject> > import_list;
+    setExportTask(task);
+    IExportable::ExportResultFlags result = importDeferredProjectItem(index,import_list);
+    clearExportTask();
+    if (!was_modified)
+        d->project_items.at(index)->setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+
+    if (!d->project_items_loaded.contains(false))
+        releaseProjectData();
+
+    if (result == IExportable::Failed) {
+        LOG_TASK_ERROR_P(QString(tr("Failed to load project item %1: %2.")).arg(index).arg(d->project_items.at(index)->projectItemName()),task);
+        return false;
+    }
+    return true;
+}
+
+QStringList Qtilities::ProjectManagement::Project::modifiedUnloadedProjectItems() const {
+    QStringList item_names;
+    for (int i = 0; i < d->project_items_loaded.count() && i < d->project_items.count(); ++i) {
+        if (!d->project_items_loaded.at(i) && d->project_items.at(i)->isModified())
+            item_names << d->project_items.at(i)->projectItemName();
+    }
+    return item_names;
+}
+
+bool Qtilities::ProjectManagement::Project::loadDeferredProjectItems(ITask* task) {
+    bool success = true;
+    for (int i = 0; i < d->project_items_loaded.count(); ++i) {
+        if (!loadProjectItem(i,task))
+            success = false;
+    }
+    releaseProjectData();
+    return success;
+}
+
+void Qtilities::ProjectManagement::Project::setDeltaSavingEnabled(bool is_enabled) {
+    d->delta_saving = is_enabled;
+}
+
+bool Qtilities::ProjectManagement::Project::deltaSavingEnabled() const {
+    return d->delta_saving;
+}
+
+void Qtilities::ProjectManagement::Project::setCompactionThreshold(int percentage) {
+    if (percentage >= 0 && percentage <= 100)
+        d->compaction_threshold = percentage;
+}
+
+int Qtilities::ProjectManagement::Project::compactionThreshold() const {
+    return d->compaction_threshold;
+}
+
+void Qtilities::ProjectManagement::Project::setParallelExportEnabled(bool is_enabled) {
+    d->parallel_export = is_enabled;
+}
+
+bool Qtilities::ProjectManagement::Project::parallelExportEnabled() const {
+    return d->parallel_export;
+}
+
+void Qtilities::ProjectManagement::Project::setParallelThreadCount(int thread_count) {
+    if (thread_count > 0)
+        d->export_pool.setMaxThreadCount(thread_count);
+}
+
+QVector<Qtilities::ProjectManagement::ProjectItemExportTask*> Qtilities::ProjectManagement::Project::startParallelExport(IExportable::ExportMode export_mode, const QDataStream* target_stream) const {
+    QVector<ProjectItemExportTask*> export_tasks(d->project_items.count(),0);
+    if (!d->parallel_export)
+        return export_tasks;
+
+    QList<int> concurrent_items;
+    for (int i = 0; i < d->project_items.count(); ++i) {
+        IProjectItem* item = d->project_items.at(i);
+        if (item->concurrentExportSupported() && (item->supportedFormats() & export_mode))
+            concurrent_items << i;
+    }
+    // Nothing is gained when less than two items can be exported concurrently:
+    if (concurrent_items.count() < 2)
+        return export_tasks;
+
+    for (int i = 0; i < concurrent_items.count(); ++i) {
+        int item_index = concurrent_items.at(i);
+        export_tasks[item_index] = new ProjectItemExportTask(d->project_items.at(item_index),item_index,export_mode,target_stream);
+        d->export_pool.start(export_tasks.at(item_index));
+    }
+    d->export_pool.waitForDone();
+    LOG_DEBUG(QString(tr("%1 project item(s) were exported concurrently using %2 thread(s).")).arg(concurrent_items.count()).arg(d->export_pool.maxThreadCount()));
+
+    return export_tasks;
+}
+
 bool Qtilities::ProjectManagement::Project::isModified() const {
     for (int i = 0; i < d->project_items.count(); ++i) {
         if (d->project_items.at(i)->isModified())
@@ -522,53 +858,80 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     // ---------------------------------------------------
     // Save file format information:
     // ---------------------------------------------------
-    stream << MARKER_PROJECT_SECTION;
-    stream << (quint32) exportVersion();
-    stream << CoreGui::QtilitiesApplication::qtilitiesVersionString();
-    stream << (quint32) applicationExportVersion();
-    stream << QApplication::applicationVersion();
-    stream << MARKER_PROJECT_SECTION;
-
-    stream << (quint32) d->project_items.count();
-    QStringList item_names;
-    for (int i = 0; i < d->project_items.count(); ++i) {
-        item_names << d->project_items.at(i)->projectItemName();
-    }
-    stream << item_names;
+    exportBinaryProjectFormat(stream);
 
     // ---------------------------------------------------
     // Do the actual export:
     // ---------------------------------------------------
     LOG_DEBUG(QString(tr("This project contains %1 project item(s).")).arg(d->project_items.count()));
     IExportable::ExportResultFlags success = IExportable::Complete;
+    QVector<ProjectItemExportTask*> export_tasks = startParallelExport(IExportable::Binary,&stream);
     for (int i = 0; i < d->project_items.count(); ++i) {
-        if (d->project_items.at(i)->supportedFormats() & IExportable::Binary) {
-            LOG_DEBUG(QString(tr("Saving item %1: %2.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
-            d->project_items.at(i)->setExportTask(exportTask());
-            IExportable::ExportResultFlags item_result = d->project_items.at(i)->exportBinary(stream);
-            d->project_items.at(i)->clearExportTask();
-
-            if (item_result == IExportable::Failed) {
-                success = item_result;
-                break;
-            }
-            if (item_result == IExportable::Incomplete && success == IExportable::Complete)
-                success = item_result;
-        } else {
-            success = IExportable::Incomplete;
-            LOG_WARNING(QString(tr("Could not save project item %1: %2. This project item does not support binary exporting.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
+        IExportable::ExportResultFlags item_result = exportProjectItemBinary(i,stream,export_tasks.at(i));
+        if (item_result == IExportable::Failed) {
+            success = item_result;
+            break;
         }
+        if (item_result == IExportable::Incomplete && success == IExportable::Complete)
+            success = item_result;
     }
+    qDeleteAll(export_tasks);
 
     stream << MARKER_PROJECT_SECTION;
     return success;
 }
 
 Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list) {
-
     // ---------------------------------------------------
     // Inspect file format:
     // ---------------------------------------------------
+    Qtilities::ExportVersion read_version;
+    quint32 application_read_version;
+    if (inspectBinaryProjectFormat(stream,&read_version,&application_read_version) != IExportable::Complete)
+        return IExportable::Failed;
+
+    // ---------------------------------------------------
+    // Do the actual import:
+    // ---------------------------------------------------
+    // Now stream each project part.
+    IExportable::ExportResultFlags success = IExportable::Complete;
+    for (int i = 0; i < d->project_items.count(); ++i) {
+        IExportable::ExportResultFlags item_result = importProjectItemBinary(i,stream,read_version,application_read_version,import_list);
+        if (item_result == IExportable::Failed) {
+            success = item_result;
+            break;
+        }
+        if (item_result == IExportable::Incomplete && success == IExportable::Complete)
+            success = item_result;
+    }
+
+    if (success) {
+        quint32 marker;
+        stream >> marker;
+        if (marker != MARKER_PROJECT_SECTION)
+            success = IExportable::Failed;
+    }
+
+    return success;
+}
+
+void Qtilities::ProjectManagement::Project::exportBinaryProjectFormat(QDataStream& stream) const {
+    stream << MARKER_PROJECT_SECTION;
+    stream << (quint32) exportVersion();
+    stream << CoreGui::QtilitiesApplication::qtilitiesVersionString();
+    stream << (quint32) applicationExportVersion();
+    stream << QApplication::applicationVersion();
+    stream << MARKER_PROJECT_SECTION;
+
+    stream << (quint32) d->project_items.count();
+    QStringList item_names;
+    for (int i = 0; i < d->project_items.count(); ++i) {
+        item_names << d->project_items.at(i)->projectItemName();
+    }
+    stream << item_names;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::inspectBinaryProjectFormat(QDataStream& stream, Qtilities::ExportVersion* read_version, quint32* application_read_version) const {
     quint32 marker;
     stream >> marker;
     if (marker != MARKER_PROJECT_SECTION) {
@@ -577,14 +940,14 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     }
 
     stream >> marker;
-    Qtilities::ExportVersion read_version = (Qtilities::ExportVersion) marker;
+    *read_version = (Qtilities::ExportVersion) marker;
     LOG_INFO(QString(tr("Inspecting project file format: Qtilities export format version: %1")).arg(marker));
     QString qtilities_version;
     stream >> qtilities_version;
     LOG_INFO(QString(tr("Inspecting project file format: Qtilities version used to save the file: %1")).arg(qtilities_version));
 
     stream >> marker;
-    quint32 application_read_version = marker;
+    *application_read_version = marker;
     LOG_INFO(QString(tr("Inspecting project file format: Application export format version: %1")).arg(marker));
     QString application_version;
     stream >> application_version;
@@ -600,16 +963,16 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     // Check if input format is supported:
     // ---------------------------------------------------
     bool is_supported_format = false;
-    if (!(read_version < Qtilities::Qtilities_1_0 || read_version > Qtilities::Qtilities_Latest))
+    if (!(*read_version < Qtilities::Qtilities_1_0 || *read_version > Qtilities::Qtilities_Latest))
         is_supported_format = true;
 
     if (!is_supported_format) {
-        LOG_ERROR(QString(tr("Unsupported project file found with export version: %1. The project file will not be parsed.")).arg(read_version));
+        LOG_ERROR(QString(tr("Unsupported project file found with export version: %1. The project file will not be parsed.")).arg(*read_version));
         return IExportable::Failed;
     }
 
     // ---------------------------------------------------
-    // Do the actual import:
+    // Check the project items:
     // ---------------------------------------------------
     quint32 project_item_count;
     stream >> project_item_count;
@@ -622,45 +985,501 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     }
     stream >> item_names_readback;
     LOG_DEBUG(QString(tr("This project contains %1 project item(s).")).arg(item_names_readback.count()));
-    if (item_names != item_names_readback) {
+    if (item_names != item_names_readback || (int) project_item_count != item_names.count()) {
         LOG_ERROR(QString(tr("Failed to load project. The number of project items does not match your current set of plugin's number of project items, or they are not loaded in the same order.")));
         return IExportable::Failed;
     }
 
-    // Now stream each project part.
-    int int_count = project_item_count;
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::exportProjectItemBinary(int index, QDataStream& stream, ProjectItemExportTask* export_task) const {
+    IProjectItem* item = d->project_items.at(index);
+    if (!(item->supportedFormats() & IExportable::Binary)) {
+        LOG_WARNING(QString(tr("Could not save project item %1: %2. This project item does not support binary exporting.")).arg(index).arg(item->projectItemName()));
+        return IExportable::Incomplete;
+    }
+
+    LOG_DEBUG(QString(tr("Saving item %1: %2.")).arg(index).arg(item->projectItemName()));
+    if (export_task) {
+        // The item was exported concurrently by startParallelExport():
+        stream.writeRawData(export_task->export_data.constData(),export_task->export_data.size());
+        return export_task->result;
+    }
+
+    item->setExportTask(exportTask());
+    IExportable::ExportResultFlags item_result = item->exportBinary(stream);
+    item->clearExportTask();
+    return item_result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::importProjectItemBinary(int index, QDataStream& stream, Qtilities::ExportVersion read_version, quint32 application_read_version, QList<QPointer<QObject> >& import_list) {
+    IProjectItem* item = d->project_items.at(index);
+    if (!(item->supportedFormats() & IExportable::Binary)) {
+        LOG_WARNING(QString(tr("Could not load project item %1: %2. This project item does not support binary importing.")).arg(index).arg(item->projectItemName()));
+        return IExportable::Incomplete;
+    }
+
+    LOG_DEBUG(QString(tr("Loading item %1: %2.")).arg(index).arg(item->projectItemName()));
+    item->setExportVersion(read_version);
+    item->setApplicationExportVersion(application_read_version);
+
+    item->setExportTask(exportTask());
+    IExportable::ExportResultFlags item_result = item->importBinary(stream,import_list);
+    item->clearExportTask();
+    return item_result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::exportBinaryIndexed(QDataStream& stream, QVector<qint64>* offsets, QVector<qint64>* sizes, qint64* header_size) const {
+    QIODevice* device = stream.device();
+    if (!device || device->isSequential()) {
+        LOG_ERROR(tr("Indexed binary projects can only be written to random access devices."));
+        return IExportable::Failed;
+    }
+
+    // ---------------------------------------------------
+    // Save file format information and the index:
+    // ---------------------------------------------------
+    stream << MARKER_PROJECT_INDEX_SECTION;
+    exportBinaryProjectFormat(stream);
+
+    // The index is written with place holders first and updated when the offsets of the project items are known:
+    int item_count = d->project_items.count();
+    QVector<qint64> item_offsets(item_count,0);
+    QVector<qint64> item_sizes(item_count,-1);
+    qint64 index_pos = device->pos();
+    for (int i = 0; i < item_count; ++i)
+        stream << item_offsets.at(i) << item_sizes.at(i);
+    stream << MARKER_PROJECT_INDEX_SECTION;
+    if (header_size)
+        *header_size = device->pos();
+
+    // ---------------------------------------------------
+    // Do the actual export:
+    // ---------------------------------------------------
+    LOG_DEBUG(QString(tr("This project contains %1 project item(s).")).arg(item_count));
     IExportable::ExportResultFlags success = IExportable::Complete;
-    for (int i = 0; i < int_count; ++i) {
+    QVector<ProjectItemExportTask*> export_tasks = startParallelExport(IExportable::Binary,&stream);
+    for (int i = 0; i < item_count; ++i) {
+        qint64 item_pos = device->pos();
+        IExportable::ExportResultFlags item_result = exportProjectItemBinary(i,stream,export_tasks.at(i));
         if (d->project_items.at(i)->supportedFormats() & IExportable::Binary) {
-            LOG_DEBUG(QString(tr("Loading item %1: %2.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
-            d->project_items.at(i)->setExportVersion(read_version);
-            d->project_items.at(i)->setApplicationExportVersion(application_read_version);
+            item_offsets[i] = item_pos;
+            item_sizes[i] = device->pos() - item_pos;
+        }
 
-            d->project_items.at(i)->setExportTask(exportTask());
-            IExportable::ExportResultFlags item_result = d->project_items.at(i)->importBinary(stream, import_list);
-            d->project_items.at(i)->clearExportTask();
+        if (item_result == IExportable::Failed) {
+            success = item_result;
+            break;
+        }
+        if (item_result == IExportable::Incomplete && success == IExportable::Complete)
+            success = item_result;
+    }
+    qDeleteAll(export_tasks);
 
-            if (item_result == IExportable::Failed) {
-                success = item_result;
-                break;
-            }
-            if (item_result == IExportable::Incomplete && success == IExportable::Complete)
-                success = item_result;
-        } else {
-            success = IExportable::Incomplete;
-            LOG_WARNING(QString(tr("Could not load project item %1: %2. This project item does not support binary importing.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
+    if (success == IExportable::Failed)
+        return success;
+
+    qint64 end_pos = device->pos();
+    if (!device->seek(index_pos)) {
+        LOG_ERROR(tr("Failed to write the index of the indexed binary project."));
+        return IExportable::Failed;
+    }
+    for (int i = 0; i < item_count; ++i)
+        stream << item_offsets.at(i) << item_sizes.at(i);
+    device->seek(end_pos);
+
+    if (stream.status() != QDataStream::Ok)
+        return IExportable::Failed;
+    if (offsets)
+        *offsets = item_offsets;
+    if (sizes)
+        *sizes = item_sizes;
+    return success;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::importBinaryIndexed(const QString& file_name, QList<QPointer<QObject> >& import_list) {
+    releaseProjectData();
+
+    // ---------------------------------------------------
+    // Map the project file into memory:
+    // ---------------------------------------------------
+    d->project_data_file.setFileName(file_name);
+    if (!d->project_data_file.open(QIODevice::ReadOnly)) {
+        LOG_ERROR(tr("Failed to open project file: ") + file_name);
+        return IExportable::Failed;
+    }
+    qint64 file_size = d->project_data_file.size();
+    if (file_size > INT_MAX) {
+        LOG_ERROR(tr("Project file is too large to be loaded: ") + file_name);
+        d->project_data_file.close();
+        return IExportable::Failed;
+    }
+
+    d->mapped_project_data = d->project_data_file.map(0,file_size);
+    if (d->mapped_project_data) {
+        d->project_data = QByteArray::fromRawData((const char*) d->mapped_project_data,(int) file_size);
+    } else {
+        LOG_DEBUG(tr("The project file could not be mapped into memory, it will be read instead: ") + d->project_data_file.errorString());
+        d->project_data = d->project_data_file.readAll();
+        d->project_data_file.close();
+    }
+
+    // ---------------------------------------------------
+    // Inspect file format and read the index:
+    // ---------------------------------------------------
+    QDataStream stream(d->project_data);
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2)
+        stream.setVersion(QDataStream::Qt_4_7);
+
+    quint32 marker;
+    stream >> marker;
+    if (marker != MARKER_PROJECT_INDEX_SECTION || inspectBinaryProjectFormat(stream,&d->project_data_version,&d->project_data_application_version) != IExportable::Complete) {
+        releaseProjectData();
+        return IExportable::Failed;
+    }
+
+    int item_count = d->project_items.count();
+    d->project_item_offsets.fill(0,item_count);
+    d->project_item_sizes.fill(-1,item_count);
+    for (int i = 0; i < item_count; ++i) {
+        stream >> d->project_item_offsets[i] >> d->project_item_sizes[i];
+        if (d->project_item_offsets.at(i) < 0 || d->project_item_offsets.at(i) + d->project_item_sizes.at(i) > file_size) {
+            LOG_ERROR(QString(tr("Failed to load project. The index entry of project item %1 is invalid.")).arg(i));
+            releaseProjectData();
+            return IExportable::Failed;
         }
     }
+    stream >> marker;
+    if (marker != MARKER_PROJECT_INDEX_SECTION || stream.status() != QDataStream::Ok) {
+        LOG_ERROR(QString(tr("Failed to load project. The project index is corrupt.")));
+        releaseProjectData();
+        return IExportable::Failed;
+    }
+    qint64 header_size = stream.device()->pos();
 
-    if (success) {
-        stream >> marker;
-        if (marker != MARKER_PROJECT_SECTION)
+    // Delta saves append an index segment which replaces the primary index:
+    readLastDeltaIndex(stream,header_size,file_size);
+    setProjectFileIndex(true,d->project_item_offsets,d->project_item_sizes,header_size,file_size);
+    d->project_items_loaded.fill(false,item_count);
+
+    if (d->deferred_item_loading) {
+        LOG_INFO(QString(tr("Loading of %1 project item(s) is deferred until they are accessed.")).arg(item_count));
+        return IExportable::Complete;
+    }
+
+    // ---------------------------------------------------
+    // Do the actual import:
+    // ---------------------------------------------------
+    IExportable::ExportResultFlags success = IExportable::Complete;
+    for (int i = 0; i < item_count; ++i) {
+        IExportable::ExportResultFlags item_result = importDeferredProjectItem(i,import_list);
+        if (item_result == IExportable::Failed) {
+            success = item_result;
+            break;
+        }
+        if (item_result == IExportable::Incomplete && success == IExportable::Complete)
+            success = item_result;
+    }
+
+    releaseProjectData();
+    return success;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::importDeferredProjectItem(int index, QList<QPointer<QObject> >& import_list) {
+    d->project_items_loaded[index] = true;
+
+    // Items which do not support binary exports have no data in the file:
+    if (d->project_item_sizes.at(index) < 0) {
+        LOG_WARNING(QString(tr("Could not load project item %1: %2. This project item was not saved in the project file.")).arg(index).arg(d->project_items.at(index)->projectItemName()));
+        return IExportable::Incomplete;
+    }
+
+    QByteArray item_data = QByteArray::fromRawData(d->project_data.constData() + d->project_item_offsets.at(index),(int) d->project_item_sizes.at(index));
+    QDataStream stream(item_data);
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2)
+        stream.setVersion(QDataStream::Qt_4_7);
+
+    return importProjectItemBinary(index,stream,d->project_data_version,d->project_data_application_version,import_list);
+}
+
+void Qtilities::ProjectManagement::Project::releaseProjectData() {
+    d->project_data.clear();
+    if (d->mapped_project_data) {
+        d->project_data_file.unmap(d->mapped_project_data);
+        d->mapped_project_data = 0;
+    }
+    if (d->project_data_file.isOpen())
+        d->project_data_file.close();
+    d->project_item_offsets.clear();
+    d->project_item_sizes.clear();
+    d->project_items_loaded.clear();
+}
+
+bool Qtilities::ProjectManagement::Project::readDeltaIndex(QDataStream& stream, qint64 index_pos, qint64 file_size) {
+    if (index_pos < 0 || index_pos >= file_size || !stream.device()->seek(index_pos))
+        return false;
+
+    quint32 marker;
+    quint32 item_count;
+    stream >> marker >> item_count;
+    if (marker != MARKER_PROJECT_DELTA_SECTION || (int) item_count != d->project_items.count())
+        return false;
+
+    QVector<qint64> offsets(item_count,0);
+    QVector<qint64> sizes(item_count,-1);
+    for (int i = 0; i < (int) item_count; ++i) {
+        stream >> offsets[i] >> sizes[i];
+        if (offsets.at(i) < 0 || offsets.at(i) + sizes.at(i) > index_pos)
+            return false;
+    }
+    stream >> marker;
+    if (marker != MARKER_PROJECT_DELTA_SECTION || stream.status() != QDataStream::Ok)
+        return false;
+
+    d->project_item_offsets = offsets;
+    d->project_item_sizes = sizes;
+    return true;
+}
+
+bool Qtilities::ProjectManagement::Project::readLastDeltaIndex(QDataStream& stream, qint64 header_size, qint64 file_size) {
+    // The trailer of each delta save ends with the delta marker, thus we search backwards for it and accept the
+    // first trailer which points to a valid index segment that ends exactly where the trailer starts:
+    QByteArray marker_bytes;
+    QDataStream marker_stream(&marker_bytes,QIODevice::WriteOnly);
+    marker_stream.setByteOrder(stream.byteOrder());
+    marker_stream << MARKER_PROJECT_DELTA_SECTION;
+
+    const qint64 segment_size = 3 * (qint64) sizeof(quint32) + d->project_items.count() * 2 * (qint64) sizeof(qint64);
+    int marker_pos = d->project_data.size() - marker_bytes.size();
+    while (marker_pos >= 0) {
+        marker_pos = d->project_data.lastIndexOf(marker_bytes,marker_pos);
+        qint64 trailer_pos = (qint64) marker_pos - (qint64) sizeof(qint64);
+        if (marker_pos < 0 || trailer_pos - segment_size < header_size)
+            break;
+
+        qint64 index_pos;
+        stream.device()->seek(trailer_pos);
+        stream >> index_pos;
+        if (stream.status() == QDataStream::Ok && index_pos + segment_size == trailer_pos && readDeltaIndex(stream,index_pos,file_size)) {
+            if (marker_pos + marker_bytes.size() != file_size)
+                LOG_WARNING(QString(tr("The last save of project file \"%1\" was not completed, the project is loaded as it was saved before.")).arg(d->project_data_file.fileName()));
+            return true;
+        }
+        stream.resetStatus();
+        --marker_pos;
+    }
+
+    return false;
+}
+
+void Qtilities::ProjectManagement::Project::setProjectFileIndex(bool is_valid, const QVector<qint64>& offsets, const QVector<qint64>& sizes, qint64 header_size, qint64 file_size) {
+    d->file_index_valid = is_valid;
+    d->file_index_offsets = offsets;
+    d->file_index_sizes = sizes;
+    d->file_index_header_size = header_size;
+    if (is_valid && file_size < 0)
+        file_size = QFileInfo(d->project_file).size();
+    d->file_index_file_size = file_size;
+    ++d->file_generation;
+}
+
+bool Qtilities::ProjectManagement::Project::deltaSaveSupported(const QString& file_name) const {
+    if (!d->file_index_valid || d->file_index_offsets.count() != d->project_items.count())
+        return false;
+
+    // Delta saves can only be appended to the file which was loaded or saved last, when it was not changed since:
+    QFileInfo fi(file_name);
+    if (fi.absoluteFilePath() != QFileInfo(d->project_file).absoluteFilePath())
+        return false;
+    return fi.exists() && fi.size() == d->file_index_file_size;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::saveProjectDelta() {
+    QFile file(d->project_file);
+    if (!file.open(QIODevice::ReadWrite)) {
+        LOG_ERROR(tr("Failed to open the project file to save changes: ") + file.errorString());
+        return IExportable::Failed;
+    }
+    qint64 old_size = file.size();
+    file.seek(old_size);
+
+    QDataStream stream(&file);
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2)
+        stream.setVersion(QDataStream::Qt_4_7);
+
+    // ---------------------------------------------------
+    // Append the modified project items:
+    // ---------------------------------------------------
+    QVector<qint64> item_offsets = d->file_index_offsets;
+    QVector<qint64> item_sizes = d->file_index_sizes;
+    IExportable::ExportResultFlags success = IExportable::Complete;
+    int modified_count = 0;
+    for (int i = 0; i < d->project_items.count(); ++i) {
+        if (!d->project_items.at(i)->isModified())
+            continue;
+
+        ++modified_count;
+        qint64 item_pos = file.pos();
+        IExportable::ExportResultFlags item_result = exportProjectItemBinary(i,stream,0);
+        if (d->project_items.at(i)->supportedFormats() & IExportable::Binary) {
+            item_offsets[i] = item_pos;
+            item_sizes[i] = file.pos() - item_pos;
+        }
+
+        if (item_result == IExportable::Failed) {
+            success = item_result;
+            break;
+        }
+        if (item_result == IExportable::Incomplete && success == IExportable::Complete)
+            success = item_result;
+    }
+
+    // ---------------------------------------------------
+    // Append the index segment and the trailer:
+    // ---------------------------------------------------
+    if (success != IExportable::Failed) {
+        qint64 index_pos = file.pos();
+        stream << MARKER_PROJECT_DELTA_SECTION;
+        stream << (quint32) d->project_items.count();
+        for (int i = 0; i < d->project_items.count(); ++i)
+            stream << item_offsets.at(i) << item_sizes.at(i);
+        stream << MARKER_PROJECT_DELTA_SECTION;
+        stream << index_pos << MARKER_PROJECT_DELTA_SECTION;
+        if (stream.status() != QDataStream::Ok || !file.flush())
             success = IExportable::Failed;
     }
 
+    if (success == IExportable::Failed) {
+        // Remove the partially written segments, the previous index remains the latest index in the file:
+        file.resize(old_size);
+        file.close();
+        return success;
+    }
+
+    LOG_DEBUG(QString(tr("Appended %1 modified project item(s) to the project file (%2 bytes).")).arg(modified_count).arg(file.size() - old_size));
+    qint64 header_size = d->file_index_header_size;
+    file.close();
+    setProjectFileIndex(true,item_offsets,item_sizes,header_size);
     return success;
 }
 
+bool Qtilities::ProjectManagement::Project::compactionRequired() const {
+    if (!d->file_index_valid || d->file_index_file_size <= 0)
+        return false;
+
+    qint64 live_size = d->file_index_header_size;
+    for (int i = 0; i < d->file_index_sizes.count(); ++i) {
+        if (d->file_index_sizes.at(i) > 0)
+            live_size += d->file_index_sizes.at(i);
+    }
+    qint64 obsolete_size = d->file_index_file_size - live_size;
+    return obsolete_size * 100 > d->file_index_file_size * d->compaction_threshold;
+}
+
+void Qtilities::ProjectManagement::Project::startProjectCompaction() {
+    // Only one compaction runs at a time, a later compaction picks up the changes made in the mean time:
+    if (d->compaction_pool.activeThreadCount() > 0)
+        return;
+
+    LOG_DEBUG(tr("Compacting project file in the background: ") + d->project_file);
+    ProjectCompactionTask* task = new ProjectCompactionTask(this,d->project_file,d->project_file + ".compact",d->file_index_header_size,
+                                                            d->file_index_offsets,d->file_index_sizes,d->file_generation);
+    d->compaction_pool.start(task);
+}
+
+bool Qtilities::ProjectManagement::Project::compactProjectFile() {
+    // Wait for background compactions, which are discarded when done since the file is compacted below:
+    d->compaction_pool.waitForDone();
+    QCoreApplication::sendPostedEvents(this,QEvent::MetaCall);
+
+    if (!d->file_index_valid || !deltaSaveSupported(d->project_file))
+        return false;
+
+    QString compacted_file = d->project_file + ".compact";
+    QVector<qint64> compacted_offsets;
+    bool success = writeCompactedProjectFile(d->project_file,compacted_file,d->file_index_header_size,d->file_index_offsets,d->file_index_sizes,&compacted_offsets);
+    return finishProjectCompaction(compacted_file,success,d->file_generation,compacted_offsets);
+}
+
+bool Qtilities::ProjectManagement::Project::writeCompactedProjectFile(const QString& source_file, const QString& target_file, qint64 header_size, const QVector<qint64>& offsets, const QVector<qint64>& sizes, QVector<qint64>* compacted_offsets) {
+    QFile source(source_file);
+    QFile target(target_file);
+    if (!source.open(QIODevice::ReadOnly) || !target.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    // The file format information and the primary index are copied, the index is updated after the items were copied:
+    if (target.write(source.read(header_size)) != header_size)
+        return false;
+
+    compacted_offsets->fill(0,offsets.count());
+    const qint64 chunk_size = 1024 * 1024;
+    for (int i = 0; i < offsets.count(); ++i) {
+        if (sizes.at(i) < 0)
+            continue;
+
+        (*compacted_offsets)[i] = target.pos();
+        if (!source.seek(offsets.at(i)))
+            return false;
+        qint64 remaining = sizes.at(i);
+        while (remaining > 0) {
+            QByteArray chunk = source.read(qMin(remaining,chunk_size));
+            if (chunk.isEmpty() || target.write(chunk) != chunk.size())
+                return false;
+            remaining -= chunk.size();
+        }
+    }
+
+    // The primary index ends with a marker just before the data of the first item:
+    qint64 index_pos = header_size - (qint64) sizeof(quint32) - offsets.count() * 2 * (qint64) sizeof(qint64);
+    if (!target.seek(index_pos))
+        return false;
+    QDataStream stream(&target);
+    stream.setVersion(QDataStream::Qt_4_7);
+    for (int i = 0; i < offsets.count(); ++i)
+        stream << compacted_offsets->at(i) << sizes.at(i);
+    target.close();
+
+    return stream.status() == QDataStream::Ok && target.error() == QFile::NoError;
+}
+
+bool Qtilities::ProjectManagement::Project::finishProjectCompaction(const QString& compacted_file, bool success, int generation, const QVector<qint64>& compacted_offsets) {
+    // The project file changed while it was being compacted:
+    if (generation != d->file_generation || !deltaSaveSupported(d->project_file))
+        success = false;
+
+    if (success) {
+        // The original file is moved aside and only removed once the compacted file took its place, thus a complete
+        // copy of the project exists on disk at all times:
+        QString backup_file = d->project_file + ".bak";
+        QFile::remove(backup_file);
+        if (!QFile::rename(d->project_file,backup_file)) {
+            LOG_WARNING(tr("Failed to replace the project file with its compacted version at path: ") + d->project_file);
+            success = false;
+        } else if (!QFile::rename(compacted_file,d->project_file)) {
+            if (!QFile::rename(backup_file,d->project_file)) {
+                // Neither file can be moved back, keep both so that no data is lost:
+                LOG_ERROR(QString(tr("Failed to replace the project file with its compacted version. The project is available in \"%1\" and \"%2\".")).arg(backup_file).arg(compacted_file));
+                setProjectFileIndex(false);
+                return false;
+            }
+            LOG_WARNING(tr("Failed to replace the project file with its compacted version at path: ") + d->project_file);
+            success = false;
+        } else {
+            QFile::remove(backup_file);
+        }
+    }
+
+    if (!success) {
+        QFile::remove(compacted_file);
+        return false;
+    }
+
+    setProjectFileIndex(true,compacted_offsets,d->file_index_sizes,d->file_index_header_size);
+    LOG_DEBUG(tr("Successfully compacted project file: ") + d->project_file);
+    return true;
+}
+
 Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::exportXml(QDomDocument* doc, QDomElement* object_node) const {
     // ---------------------------------------------------
     // Save file format information:
@@ -675,14 +1494,23 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     // Do the actual export:
     // ---------------------------------------------------
     IExportable::ExportResultFlags success = IExportable::Complete;
+    QVector<ProjectItemExportTask*> export_tasks = startParallelExport(IExportable::XML);
     for (int i = 0; i < d->project_items.count(); ++i) {
         QString name = d->project_items.at(i)->projectItemName();
-        QDomElement itemRoot = doc->createElement("ProjectItem_" + QString::number(i));
-        itemRoot.setAttribute("Name",name);
-        object_node->appendChild(itemRoot);
-        d->project_items.at(i)->setExportTask(exportTask());
-        IExportable::ExportResultFlags item_result = d->project_items.at(i)->exportXml(doc,&itemRoot);
-        d->project_items.at(i)->clearExportTask();
+        IExportable::ExportResultFlags item_result;
+        if (export_tasks.at(i)) {
+            QDomElement itemRoot = doc->importNode(export_tasks.at(i)->item_root,true).toElement();
+            itemRoot.setAttribute("Name",name);
+            object_node->appendChild(itemRoot);
+            item_result = export_tasks.at(i)->result;
+        } else {
+            QDomElement itemRoot = doc->createElement("ProjectItem_" + QString::number(i));
+            itemRoot.setAttribute("Name",name);
+            object_node->appendChild(itemRoot);
+            d->project_items.at(i)->setExportTask(exportTask());
+            item_result = d->project_items.at(i)->exportXml(doc,&itemRoot);
+            d->project_items.at(i)->clearExportTask();
+        }
         if (item_result == IExportable::Failed) {
             success = item_result;
             break;
@@ -690,50 +1518,17 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
         if (item_result == IExportable::Incomplete && success == IExportable::Complete)
             success = item_result;
     }
+    qDeleteAll(export_tasks);
 
     // TODO - Export dynamic properties here
     return success;
 }
 
 Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list) {
-    // ---------------------------------------------------
-    // Inspect file format:
-    // ---------------------------------------------------
     Qtilities::ExportVersion read_version;
-    if (object_node->hasAttribute("ExportVersion")) {
-        read_version = (Qtilities::ExportVersion) object_node->attribute("ExportVersion").toInt();
-        LOG_TASK_INFO(QString(tr("Inspecting project file format: Qtilities export format version: %1")).arg(read_version),exportTask());
-    } else {
-        LOG_TASK_ERROR(QString(tr("The export version of the input file could not be determined. This might indicate that the input file is in the wrong format. The project file will not be parsed.")),exportTask());
-        QApplication::restoreOverrideCursor();
-        return IExportable::Failed;
-    }
-    if (object_node->hasAttribute("QtilitiesVersion"))
-        LOG_TASK_INFO(QString(tr("Inspecting project file format: Qtilities version used to save the file: %1")).arg(object_node->attribute("QtilitiesVersion")),exportTask());
-    quint32 application_read_version = 0;
-    if (object_node->hasAttribute("ApplicationExportVersion")) {
-        application_read_version = object_node->attribute("ApplicationExportVersion").toInt();
-        LOG_TASK_INFO(QString(tr("Inspecting project file format: Application export format version: %1")).arg(application_read_version),exportTask());
-    } else {
-        LOG_TASK_ERROR(QString(tr("The application export version of the input file could not be determined. This might indicate that the input file is in the wrong format. The project file will not be parsed.")),exportTask());
-        QApplication::restoreOverrideCursor();
+    quint32 application_read_version;
+    if (inspectXmlProjectFormat(object_node,&read_version,&application_read_version) != IExportable::Complete)
         return IExportable::Failed;
-    }
-    if (object_node->hasAttribute("ApplicationVersion"))
-        LOG_TASK_INFO(QString(tr("Inspecting project file format: Application version used to save the file: %1")).arg(object_node->attribute("ApplicationVersion")),exportTask());
-
-    // ---------------------------------------------------
-    // Check if input format is supported:
-    // ---------------------------------------------------
-    bool is_supported_format = false;
-    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(read_version,exportTask());
-    if (version_check_result == IExportable::VersionSupported)
-        is_supported_format = true;
-
-    if (!is_supported_format) {
-        LOG_TASK_ERROR(QString(tr("Unsupported project file found with export version: %1. The project file will not be parsed.")).arg(read_version),exportTask());
-        return IExportable::Failed;
-    }
 
     bool found_project_item = false;
 
@@ -796,3 +1591,156 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
 
     return success;
 }
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::exportXmlStream(QXmlStreamWriter* writer) const {
+    // ---------------------------------------------------
+    // Save file format information:
+    // ---------------------------------------------------
+    writer->writeAttribute("ExportVersion",QString::number(exportVersion()));
+    writer->writeAttribute("QtilitiesVersion",CoreGui::QtilitiesApplication::qtilitiesVersionString());
+    writer->writeAttribute("ApplicationExportVersion",QString::number(applicationExportVersion()));
+    writer->writeAttribute("ApplicationVersion",QApplication::applicationVersion());
+    writer->writeAttribute("ApplicationName",QApplication::applicationName());
+
+    // ---------------------------------------------------
+    // Do the actual export:
+    // ---------------------------------------------------
+    IExportable::ExportResultFlags success = IExportable::Complete;
+    QVector<ProjectItemExportTask*> export_tasks = startParallelExport(IExportable::XML);
+    for (int i = 0; i < d->project_items.count(); ++i) {
+        writer->writeStartElement("ProjectItem_" + QString::number(i));
+        writer->writeAttribute("Name",d->project_items.at(i)->projectItemName());
+        IExportable::ExportResultFlags item_result;
+        if (export_tasks.at(i)) {
+            item_result = export_tasks.at(i)->result;
+            if (!(item_result & IExportable::FailedResult))
+                writeXmlElementContents(writer,export_tasks.at(i)->item_root);
+        } else {
+            d->project_items.at(i)->setExportTask(exportTask());
+            item_result = d->project_items.at(i)->exportXmlStream(writer);
+            d->project_items.at(i)->clearExportTask();
+        }
+        writer->writeEndElement();
+        if (item_result == IExportable::Failed) {
+            success = item_result;
+            break;
+        }
+        if (item_result == IExportable::Incomplete && success == IExportable::Complete)
+            success = item_result;
+    }
+    qDeleteAll(export_tasks);
+
+    return success;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    // Only the attributes of the project node are needed to inspect the file format:
+    QDomDocument doc("tmp");
+    QDomElement object_node = doc.createElement("QtilitiesXMLProject");
+    doc.appendChild(object_node);
+    readXmlElementAttributes(reader,&object_node);
+
+    Qtilities::ExportVersion read_version;
+    quint32 application_read_version;
+    if (inspectXmlProjectFormat(&object_node,&read_version,&application_read_version) != IExportable::Complete)
+        return IExportable::Failed;
+
+    bool found_project_item = false;
+
+    // ---------------------------------------------------
+    // Do the actual import:
+    // ---------------------------------------------------
+    IExportable::ExportResultFlags success = IExportable::Complete;
+    while (reader->readNextStartElement()) {
+        if (!reader->name().toString().startsWith("ProjectItem_")) {
+            reader->skipCurrentElement();
+            continue;
+        }
+
+        found_project_item = true;
+        if (!reader->attributes().hasAttribute("Name")) {
+            LOG_TASK_WARNING(tr("Nameless project item found in input file. This item will be skipped."),exportTask());
+            reader->skipCurrentElement();
+            continue;
+        }
+        QString item_name = reader->attributes().value("Name").toString();
+        LOG_TASK_TRACE("Found project item in import file with name: " + item_name,exportTask());
+
+        // Now get the project item with name item_name:
+        IProjectItem* item_iface = 0;
+        for (int i = 0; i < d->project_items.count(); ++i) {
+            if (d->project_items.at(i)->projectItemName() == item_name) {
+                item_iface = d->project_items.at(i);
+                break;
+            }
+        }
+
+        if (!item_iface) {
+            LOG_TASK_WARNING(QString(tr("Input file contains a project item \"%1\" which does not exist in your application. Import will be incomplete.")).arg(item_name),exportTask());
+            if (success != IExportable::Failed)
+                success = IExportable::Incomplete;
+            reader->skipCurrentElement();
+            continue;
+        }
+
+        item_iface->setExportVersion(read_version);
+        item_iface->setApplicationExportVersion(application_read_version);
+        item_iface->setExportTask(exportTask());
+        success = item_iface->importXmlStream(reader,import_list);
+        item_iface->clearExportTask();
+
+        if (success & IExportable::FailedResult) {
+            LOG_TASK_ERROR(tr("Project item \"") + item_name + tr("\" failed during import."),exportTask());
+            success = IExportable::Incomplete;
+            break;
+        }
+    }
+
+    if (!found_project_item)
+        LOG_TASK_WARNING(tr("No project items found in project file."),exportTask());
+
+    return success;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::inspectXmlProjectFormat(const QDomElement* object_node, Qtilities::ExportVersion* read_version, quint32* application_read_version) const {
+    *application_read_version = 0;
+
+    // ---------------------------------------------------
+    // Inspect file format:
+    // ---------------------------------------------------
+    if (object_node->hasAttribute("ExportVersion")) {
+        *read_version = (Qtilities::ExportVersion) object_node->attribute("ExportVersion").toInt();
+        LOG_TASK_INFO(QString(tr("Inspecting project file format: Qtilities export format version: %1")).arg(*read_version),exportTask());
+    } else {
+        LOG_TASK_ERROR(QString(tr("The export version of the input file could not be determined. This might indicate that the input file is in the wrong format. The project file will not be parsed.")),exportTask());
+        QApplication::restoreOverrideCursor();
+        return IExportable::Failed;
+    }
+    if (object_node->hasAttribute("QtilitiesVersion"))
+        LOG_TASK_INFO(QString(tr("Inspecting project file format: Qtilities version used to save the file: %1")).arg(object_node->attribute("QtilitiesVersion")),exportTask());
+    if (object_node->hasAttribute("ApplicationExportVersion")) {
+        *application_read_version = object_node->attribute("ApplicationExportVersion").toInt();
+        LOG_TASK_INFO(QString(tr("Inspecting project file format: Application export format version: %1")).arg(*application_read_version),exportTask());
+    } else {
+        LOG_TASK_ERROR(QString(tr("The application export version of the input file could not be determined. This might indicate that the input file is in the wrong format. The project file will not be parsed.")),exportTask());
+        QApplication::restoreOverrideCursor();
+        return IExportable::Failed;
+    }
+    if (object_node->hasAttribute("ApplicationVersion"))
+        LOG_TASK_INFO(QString(tr("Inspecting project file format: Application version used to save the file: %1")).arg(object_node->attribute("ApplicationVersion")),exportTask());
+
+    // ---------------------------------------------------
+    // Check if input format is supported:
+    // ---------------------------------------------------
+    bool is_supported_format = false;
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(*read_version,exportTask());
+    if (version_check_result == IExportable::VersionSupported)
+        is_supported_format = true;
+
+    if (!is_supported_format) {
+        LOG_TASK_ERROR(QString(tr("Unsupported project file found with export version: %1. The project file will not be parsed.")).arg(*read_version),exportTask());
+        return IExportable::Failed;
+    }
+
+    return IExportable::Complete;
+}
@@ -18,6 +18,7 @@
 #include <Logger>
 
 #include <QObject>
+#include <QVector>
 
 namespace Qtilities {
     namespace ProjectManagement {
@@ -28,6 +29,8 @@ namespace Qtilities {
           \brief The ProjectPrivateData class stores private data used by the Project class.
          */
         struct ProjectPrivateData;
+        class ProjectItemExportTask;
+        class ProjectCompactionTask;
 
         /*!
           \class Project
@@ -63,6 +66,168 @@ namespace Qtilities {
             int projectItemCount() const;
             IProjectItem* projectItem(int index);
 
+            // --------------------------------
+            // Project Implementation
+            // --------------------------------
+            //! Enables or disables saving binary projects as indexed project files.
+            /*!
+              Indexed project files start with the file format information and an index containing the offset and size of each
+              project item, followed by the data of the project items. They are needed for deferred loading of project items (see
+              setDeferredItemLoading()) and for delta saves (see setDeltaSavingEnabled()).
+
+              \note Indexed project files can't be read by versions of %Qtilities before v1.5. When disabled, binary projects are saved
+              in the format used by previous versions. Indexed project files are read regardless of this setting.
+
+              Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa indexedBinaryFormatEnabled()
+              */
+            void setIndexedBinaryFormatEnabled(bool is_enabled);
+            //! Indicates if binary projects are saved as indexed project files.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setIndexedBinaryFormatEnabled()
+              */
+            bool indexedBinaryFormatEnabled() const;
+            //! Enables or disables deferred loading of project items from binary project files.
+            /*!
+              When loading an indexed project file (see setIndexedBinaryFormatEnabled()), the project file is mapped into memory and
+              only the index is read. When deferred loading is enabled, project items are not imported during loadProject(), instead
+              they are loaded when they are accessed through projectItem() for the first time, or explicitly using loadProjectItem().
+              Thus large projects can be opened without deserializing all project items first.
+
+              Project items which were not loaded yet are still empty, thus applications which access project items through their
+              own references must call loadProjectItem() before using them. Project items which were not loaded yet are loaded before
+              the project is saved, unless they were modified in the meantime: loading them would merge the data in the project file
+              with the changes, thus saveProject() refuses to save the project instead. The project items of the project must not be
+              changed while some of them are not loaded yet.
+
+              Binary project files which do not contain an index are always loaded completely.
+
+              Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa deferredItemLoading(), loadProjectItem(), isProjectItemLoaded()
+              */
+            void setDeferredItemLoading(bool is_enabled);
+            //! Indicates if deferred loading of project items from binary project files is enabled.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setDeferredItemLoading()
+              */
+            bool deferredItemLoading() const;
+            //! Indicates if the project item at \p index was loaded.
+            /*!
+              Always returns true unless loading of the item was deferred during loadProject().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setDeferredItemLoading(), loadProjectItem()
+              */
+            bool isProjectItemLoaded(int index) const;
+            //! Loads the project item at \p index when its loading was deferred during loadProject().
+            /*!
+              The item is imported from the project file which is mapped into memory. Loading an item does not change the modification state of the project.
+
+              Items which were modified before they were loaded are not loaded, since that would merge the data in the project file with the changes.
+
+              \returns True when the item was loaded, or when it was already loaded. False otherwise.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setDeferredItemLoading(), isProjectItemLoaded()
+              */
+            bool loadProjectItem(int index, ITask* task = 0);
+            //! Enables or disables delta saves of binary projects.
+            /*!
+              When enabled together with setIndexedBinaryFormatEnabled() and the project is saved to the indexed binary project file it was loaded from or saved to last, only the
+              project items which are modified according to IModificationNotifier::isModified() are exported. They are appended to the
+              project file as new segments, followed by a new index which replaces the index of the previous save. Thus the cost of
+              saving a project depends on the size of the changes, not on the size of the project. Project items which were not loaded
+              yet (see setDeferredItemLoading()) keep their data in the file and are not loaded during delta saves.
+
+              When the file was changed since it was last loaded or saved, or when the delta save fails, the complete project is saved.
+
+              Segments replaced by later saves stay in the file until it is compacted. Compaction is started in the background
+              after a delta save when the part of the file used by replaced segments exceeds compactionThreshold(). It only copies the
+              latest segments of the project items to a new file which replaces the project file, project items are not exported again.
+
+              Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa deltaSavingEnabled(), setCompactionThreshold(), compactProjectFile()
+              */
+            void setDeltaSavingEnabled(bool is_enabled);
+            //! Indicates if delta saves of binary projects are enabled.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setDeltaSavingEnabled()
+              */
+            bool deltaSavingEnabled() const;
+            //! Sets the percentage of the project file which may be used by replaced segments before the file is compacted after delta saves.
+            /*!
+              Default is 50.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setDeltaSavingEnabled()
+              */
+            void setCompactionThreshold(int percentage);
+            //! Gets the percentage of the project file which may be used by replaced segments before the file is compacted after delta saves.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setCompactionThreshold()
+              */
+            int compactionThreshold() const;
+            //! Compacts the project file now, removing all segments which were replaced by delta saves.
+            /*!
+              \returns True when the project file was compacted. False when the project file is not an indexed binary project file,
+              when it was changed since it was last loaded or saved, or when compaction failed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setDeltaSavingEnabled()
+              */
+            bool compactProjectFile();
+            //! Enables or disables parallel exports of the project items in this project.
+            /*!
+              When enabled, exportBinary() and exportXml() export the project items for which IProjectItem::concurrentExportSupported() returns
+              true concurrently on a thread pool into separate buffers. The buffers are written in the order of the project items, thus the
+              export is identical to a serial export. Items which do not support concurrent exports are exported in the thread of the project
+              after the concurrent exports finished. No export task is set on project items which are exported concurrently.
+
+              Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa parallelExportEnabled(), setParallelThreadCount()
+              */
+            void setParallelExportEnabled(bool is_enabled);
+            //! Indicates if parallel exports of the project items in this project are enabled.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setParallelExportEnabled()
+              */
+            bool parallelExportEnabled() const;
+            //! Sets the maximum number of threads used during parallel exports.
+            /*!
+              By default QThread::idealThreadCount() is used.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setParallelExportEnabled()
+              */
+            void setParallelThreadCount(int thread_count);
+
             // --------------------------------
             // IModificationNotifier Implementation
             // --------------------------------
@@ -81,6 +246,8 @@ namespace Qtilities {
             IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
             IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
             IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
             // --------------------------------
             // IObjectBase Implementation
@@ -89,6 +256,64 @@ namespace Qtilities {
             const QObject* objectBase() const { return this; }
 
         private:
+            //! Reads and validates the file format information on the project node of XML project files.
+            IExportable::ExportResultFlags inspectXmlProjectFormat(const QDomElement* object_node, Qtilities::ExportVersion* read_version, quint32* application_read_version) const;
+            //! Exports the project items which support concurrent exports on the export pool when parallel exports are enabled.
+            /*!
+              Returns a list with an entry for each project item, entries are null for items which must be exported serially. The caller must delete the tasks.
+              */
+            QVector<ProjectItemExportTask*> startParallelExport(IExportable::ExportMode export_mode, const QDataStream* target_stream = 0) const;
+            //! Writes the file format information and the names of the project items of binary project files.
+            void exportBinaryProjectFormat(QDataStream& stream) const;
+            //! Reads and validates the file format information and the names of the project items of binary project files.
+            IExportable::ExportResultFlags inspectBinaryProjectFormat(QDataStream& stream, Qtilities::ExportVersion* read_version, quint32* application_read_version) const;
+            //! Exports the project item at \p index to \p stream, or writes the result of \p export_task when it was exported concurrently.
+            IExportable::ExportResultFlags exportProjectItemBinary(int index, QDataStream& stream, ProjectItemExportTask* export_task) const;
+            //! Imports the project item at \p index from \p stream.
+            IExportable::ExportResultFlags importProjectItemBinary(int index, QDataStream& stream, Qtilities::ExportVersion read_version, quint32 application_read_version, QList<QPointer<QObject> >& import_list);
+            //! Exports the project as an indexed binary project, \p stream must operate on a random access device.
+            /*!
+              The index of the project items and the size of the file format information and index are returned in \p offsets, \p sizes and \p header_size.
+              */
+            IExportable::ExportResultFlags exportBinaryIndexed(QDataStream& stream, QVector<qint64>* offsets = 0, QVector<qint64>* sizes = 0, qint64* header_size = 0) const;
+            //! Maps the indexed binary project file \p file_name into memory, reads its index and loads the project items unless loading is deferred.
+            IExportable::ExportResultFlags importBinaryIndexed(const QString& file_name, QList<QPointer<QObject> >& import_list);
+            //! Imports the project item at \p index from the mapped project file.
+            IExportable::ExportResultFlags importDeferredProjectItem(int index, QList<QPointer<QObject> >& import_list);
+            //! Returns the names of the project items which were modified while they were not loaded yet.
+            QStringList modifiedUnloadedProjectItems() const;
+            //! Loads all project items which were not loaded yet and releases the mapped project file.
+            bool loadDeferredProjectItems(ITask* task = 0);
+            //! Releases the mapped project file and its index.
+            void releaseProjectData();
+            //! Reads the index segment appended by a delta save at \p index_pos, it replaces the index read from the start of the file.
+            bool readDeltaIndex(QDataStream& stream, qint64 index_pos, qint64 file_size);
+            //! Finds the last complete delta save in the mapped project file and reads its index.
+            /*!
+              Delta saves which were not completely written, for example because the application stopped while appending them, are skipped.
+
+              \return True if a delta index was read, false when the index at the start of the file is the latest index.
+              */
+            bool readLastDeltaIndex(QDataStream& stream, qint64 header_size, qint64 file_size);
+            //! Sets the index of the project file which is used by delta saves. When \p file_size is negative the size of the project file is used.
+            void setProjectFileIndex(bool is_valid, const QVector<qint64>& offsets = QVector<qint64>(), const QVector<qint64>& sizes = QVector<qint64>(), qint64 header_size = 0, qint64 file_size = -1);
+            //! Indicates if changes to the project can be appended to \p file_name.
+            bool deltaSaveSupported(const QString& file_name) const;
+            //! Appends the modified project items and a new index to the project file.
+            IExportable::ExportResultFlags saveProjectDelta();
+            //! Indicates if the part of the project file used by replaced segments exceeds the compaction threshold.
+            bool compactionRequired() const;
+            //! Starts compaction of the project file in the background.
+            void startProjectCompaction();
+            //! Writes the latest segments of \p source_file to \p target_file. This function is thread safe.
+            static bool writeCompactedProjectFile(const QString& source_file, const QString& target_file, qint64 header_size, const QVector<qint64>& offsets, const QVector<qint64>& sizes, QVector<qint64>* compacted_offsets);
+        private slots:
+            //! Replaces the project file with \p compacted_file, unless the project file changed since the compaction of \p generation started.
+            bool finishProjectCompaction(const QString& compacted_file, bool success, int generation, const QVector<qint64>& compacted_offsets);
+
+        private:
+            friend class ProjectCompactionTask;
+
             ProjectPrivateData* d;
         };
     }
@@ -44,6 +44,10 @@ struct Qtilities::ProjectManagement::ProjectManagerPrivateData  {
         project_changed_during_load(false),
         exec_style(ProjectManager::ExecNormal),
         saving_enabled(true),
+        parallel_project_export(false),
+        indexed_project_files(false),
+        deferred_project_item_loading(false),
+        delta_project_saving(false),
         project_actions_menu_id(qti_action_FILE),
         project_actions_command_id(qti_action_FILE_SETTINGS),
         actionProjectNew(0),
@@ -74,6 +78,10 @@ struct Qtilities::ProjectManagement::ProjectManagerPrivateData  {
     ProjectManager::ExecStyle               exec_style;
     bool                                    saving_enabled;
     QString                                 saving_info_message;
+    bool                                    parallel_project_export;
+    bool                                    indexed_project_files;
+    bool                                    deferred_project_item_loading;
+    bool                                    delta_project_saving;
 
     FileLocker                              file_locker;
 
@@ -361,6 +369,7 @@ bool Qtilities::ProjectManagement::ProjectManager::openProject(const QString& fi
 
     connect(d->current_project,SIGNAL(modificationStateChanged(bool)),SLOT(setModificationState(bool)));
     d->current_project->setProjectItems(d->item_list);
+    d->current_project->setDeferredItemLoading(d->deferred_project_item_loading);
     if (!d->current_project->loadProject(file_name,false,task_ref)) {
         // Call close project on all project items in the project.
         // Remember that some of them might have been loaded successfully:
@@ -456,6 +465,9 @@ bool Qtilities::ProjectManagement::ProjectManager::saveProject(QString file_name
 
     emit projectSavingStarted(file_name);
 
+    d->current_project->setParallelExportEnabled(d->parallel_project_export);
+    d->current_project->setIndexedBinaryFormatEnabled(d->indexed_project_files);
+    d->current_project->setDeltaSavingEnabled(d->delta_project_saving);
     if (d->current_project->saveProject(file_name,task_ref)) {
         addRecentProject(d->current_project);
         QApplication::restoreOverrideCursor();
@@ -616,6 +628,38 @@ bool ProjectManagement::ProjectManager::useProjectFileLocks() const {
     return d->use_project_file_locks;
 }
 
+void Qtilities::ProjectManagement::ProjectManager::setParallelProjectExportEnabled(bool is_enabled) {
+    d->parallel_project_export = is_enabled;
+}
+
+bool Qtilities::ProjectManagement::ProjectManager::parallelProjectExportEnabled() const {
+    return d->parallel_project_export;
+}
+
+void Qtilities::ProjectManagement::ProjectManager::setIndexedProjectFilesEnabled(bool is_enabled) {
+    d->indexed_project_files = is_enabled;
+}
+
+bool Qtilities::ProjectManagement::ProjectManager::indexedProjectFilesEnabled() const {
+    return d->indexed_project_files;
+}
+
+void Qtilities::ProjectManagement::ProjectManager::setDeferredProjectItemLoading(bool is_enabled) {
+    d->deferred_project_item_loading = is_enabled;
+}
+
+bool Qtilities::ProjectManagement::ProjectManager::deferredProjectItemLoading() const {
+    return d->deferred_project_item_loading;
+}
+
+void Qtilities::ProjectManagement::ProjectManager::setDeltaProjectSavingEnabled(bool is_enabled) {
+    d->delta_project_saving = is_enabled;
+}
+
+bool Qtilities::ProjectManagement::ProjectManager::deltaProjectSavingEnabled() const {
+    return d->delta_project_saving;
+}
+
 void Qtilities::ProjectManagement::ProjectManager::setCreateNewProjectOnStartup(bool toggle) {
     d->auto_create_new_project = toggle;
     writeSettings();
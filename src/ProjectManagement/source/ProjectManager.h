@@ -316,6 +316,81 @@ namespace Qtilities {
              *\sa setUseProjectFileLocks()
              */
             bool useProjectFileLocks() const;
+            //! Sets if the project items of projects are exported concurrently when projects are saved.
+            /*!
+              See Project::setParallelExportEnabled() for more details. This setting is not saved using QSettings.
+
+              Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa parallelProjectExportEnabled()
+              */
+            void setParallelProjectExportEnabled(bool is_enabled);
+            //! Gets if the project items of projects are exported concurrently when projects are saved.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setParallelProjectExportEnabled()
+              */
+            bool parallelProjectExportEnabled() const;
+            //! Sets if binary projects are saved as indexed project files.
+            /*!
+              See Project::setIndexedBinaryFormatEnabled() for more details. Indexed project files can't be read by versions of %Qtilities
+              before v1.5. This setting is not saved using QSettings.
+
+              Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa indexedProjectFilesEnabled()
+              */
+            void setIndexedProjectFilesEnabled(bool is_enabled);
+            //! Gets if binary projects are saved as indexed project files.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setIndexedProjectFilesEnabled()
+              */
+            bool indexedProjectFilesEnabled() const;
+            //! Sets if loading of the project items of binary projects is deferred until they are accessed.
+            /*!
+              See Project::setDeferredItemLoading() for more details. When enabled, project items must be loaded using Project::loadProjectItem()
+              before they are accessed through references other than Project::projectItem(). This setting is not saved using QSettings.
+
+              Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa deferredProjectItemLoading()
+              */
+            void setDeferredProjectItemLoading(bool is_enabled);
+            //! Gets if loading of the project items of binary projects is deferred until they are accessed.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setDeferredProjectItemLoading()
+              */
+            bool deferredProjectItemLoading() const;
+            //! Sets if only the modified project items of binary projects are saved when a project is saved to the file it was loaded from.
+            /*!
+              See Project::setDeltaSavingEnabled() for more details. Delta saves are only possible when setIndexedProjectFilesEnabled() is enabled.
+              This setting is not saved using QSettings.
+
+              Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa deltaProjectSavingEnabled()
+              */
+            void setDeltaProjectSavingEnabled(bool is_enabled);
+            //! Gets if only the modified project items of binary projects are saved when a project is saved to the file it was loaded from.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa setDeltaProjectSavingEnabled()
+              */
+            bool deltaProjectSavingEnabled() const;
             //! Sets the configuration option to create a new project when the no last open project is available.
             /*!
               This configuration setting has no effect if the openLastProjectOnStartup() is false.
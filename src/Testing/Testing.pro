@@ -58,7 +58,11 @@ contains(DEFINES, QTILITIES_TESTING) {
             source/TestTreeFileItem.h \
             source/TestAbstractTreeItem.h \
             source/TestObjectManager.h \
-            source/TestTask.h
+            source/TestTask.h \
+            source/TestLogger.h \
+            source/TestFileUtils.h \
+            source/TestObserverTreeModel.h \
+            source/TestQtilitiesProcess.h
 
     SOURCES += source/TestObserver.cpp \
             source/TestObserverRelationalTable.cpp \
@@ -73,7 +77,11 @@ contains(DEFINES, QTILITIES_TESTING) {
             source/TestTreeFileItem.cpp \
             source/TestAbstractTreeItem.cpp \
             source/TestObjectManager.cpp \
-            source/TestTask.cpp
+            source/TestTask.cpp \
+            source/TestLogger.cpp \
+            source/TestFileUtils.cpp \
+            source/TestObserverTreeModel.cpp \
+            source/TestQtilitiesProcess.cpp
 }
 
 # --------------------------
@@ -15,6 +15,52 @@
 using namespace QtilitiesCoreGui;
 
 #include <QDomDocument>
+#include <QElapsedTimer>
+
+namespace {
+    // Logger engine which only counts its messages, thus the benchmark measures the logger and formatting overhead only:
+    class CountingLoggerEngine : public AbstractLoggerEngine {
+    public:
+        CountingLoggerEngine() : AbstractLoggerEngine(), message_count(0) {}
+
+        bool initialize() { abstractLoggerEngineData->is_initialized = true; return true; }
+        void finalize() {}
+        QString description() const { return "Counts logged messages"; }
+        QString status() const { return QString::number(message_count); }
+        bool isFormattingEngineConstant() const { return true; }
+        void logMessage(const QString& message, Logger::MessageType message_type) {
+            Q_UNUSED(message)
+            Q_UNUSED(message_type)
+            ++message_count;
+        }
+
+        int message_count;
+    };
+
+    // Adds branch_count nodes with item_count items each under node, recursively until depth is reached:
+    void buildBenchmarkTree(TreeNode* node, int depth, int branch_count, int item_count) {
+        if (depth == 0)
+            return;
+
+        node->startProcessingCycle();
+        for (int i = 0; i < branch_count; ++i) {
+            TreeNode* child_node = node->addNode(QString("Node_%1_%2").arg(depth).arg(i));
+            for (int r = 0; r < item_count; ++r)
+                child_node->addItem(QString("Item_%1_%2_%3").arg(depth).arg(i).arg(r));
+            buildBenchmarkTree(child_node,depth - 1,branch_count,item_count);
+        }
+        node->endProcessingCycle(false);
+    }
+
+    // Counts all rows underneath parent in model:
+    int countBenchmarkRows(const QAbstractItemModel& model, const QModelIndex& parent = QModelIndex()) {
+        int row_count = model.rowCount(parent);
+        int total = row_count;
+        for (int i = 0; i < row_count; ++i)
+            total += countBenchmarkRows(model,model.index(i,0,parent));
+        return total;
+    }
+}
 
 int Qtilities::Testing::BenchmarkTests::execTest(int argc, char ** argv) {
     return QTest::qExec(this,argc,argv);
@@ -62,6 +108,28 @@ void Qtilities::Testing::BenchmarkTests::benchmarkObserverExport_1_0_1_0() {
     file.write(docStr.toUtf8());
     file.close();
 
+    // ---------------------------------------------------
+    // Compare serial and parallel binary exports:
+    // ---------------------------------------------------
+    // The parallel export must produce exactly the same stream as the serial export:
+    QByteArray serial_export;
+    QDataStream serial_stream(&serial_export,QIODevice::WriteOnly);
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(obj_source->exportBinaryExt(serial_stream,ObserverData::ExportData) == IExportable::Complete);
+    qint64 serial_time = timer.nsecsElapsed();
+
+    QByteArray parallel_export;
+    QDataStream parallel_stream(&parallel_export,QIODevice::WriteOnly);
+    timer.restart();
+    QVERIFY(obj_source->exportBinaryExt(parallel_stream,ObserverData::ExportData | ObserverData::ExportParallel) == IExportable::Complete);
+    qint64 parallel_time = timer.nsecsElapsed();
+
+    QVERIFY(serial_export == parallel_export);
+    qDebug() << QString("Binary export of %1 subtrees: serial %2 ms, parallel %3 ms using %4 thread(s), speedup %5x")
+                .arg(TreeDepth).arg(serial_time / 1000000.0).arg(parallel_time / 1000000.0).arg(QThread::idealThreadCount())
+                .arg(parallel_time > 0 ? (double) serial_time / parallel_time : 0.0);
+
     // Don't delete it here since deletion will make the test slower. Thus we don't care about the memory leaks.
     // delete obj_source;
 }
@@ -89,3 +157,241 @@ void Qtilities::Testing::BenchmarkTests::benchmarkObserverImport_1_0_1_0() {
     file.close();
     delete obj_import_xml;
 }
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverSubjectLookup_data() {
+    QTest::addColumn<int>("SubjectCount");
+    QTest::newRow("1k subjects") << 1000;
+    QTest::newRow("10k subjects") << 10000;
+    QTest::newRow("100k subjects") << 100000;
+    QTest::newRow("1M subjects") << 1000000;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverSubjectLookup() {
+    QFETCH(int, SubjectCount);
+
+    Observer* obs = new Observer("Lookup Observer");
+    QList<QObject*> subjects;
+    QList<int> subject_ids;
+    obs->startProcessingCycle();
+    for (int i = 0; i < SubjectCount; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName("Subject_" + QString::number(i));
+        obs->attachSubject(obj,Observer::ManualOwnership);
+        subjects << obj;
+    }
+    obs->endProcessingCycle(false);
+    subject_ids = obs->subjectIDs();
+    QVERIFY(subject_ids.count() == SubjectCount);
+
+    // Do the same number of lookups for every observer size. The lookup time should stay constant:
+    const int lookup_count = 1000;
+    const int stride = qMax(1,SubjectCount / lookup_count);
+    QBENCHMARK {
+        for (int i = 0; i < lookup_count; ++i) {
+            int index = (i * stride) % SubjectCount;
+            QVERIFY(obs->subjectReference(subject_ids.at(index)) == subjects.at(index));
+            QVERIFY(obs->subjectReference("Subject_" + QString::number(index)) == subjects.at(index));
+            QVERIFY(obs->subjectReference("SUBJECT_" + QString::number(index),Qt::CaseInsensitive) == subjects.at(index));
+            QVERIFY(obs->contains(subjects.at(index)));
+        }
+    }
+
+    // Don't delete it here since deletion will make the test slower. Thus we don't care about the memory leaks.
+    // delete obs;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkLoggerThroughput_data() {
+    QTest::addColumn<int>("EngineCount");
+    QTest::newRow("0 engines") << 0;
+    QTest::newRow("1 engine") << 1;
+    QTest::newRow("5 engines") << 5;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkLoggerThroughput() {
+    QFETCH(int, EngineCount);
+
+    AbstractFormattingEngine* formatting_engine = Log->formattingEngineReference(qti_def_FORMATTING_ENGINE_DEFAULT);
+    QVERIFY(formatting_engine != 0);
+
+    // Detach the engines of the test application so that only our engines are measured:
+    QList<AbstractLoggerEngine*> application_engines;
+    for (int i = 0; i < Log->attachedLoggerEngineCount(); ++i)
+        application_engines << Log->loggerEngineReferenceAt(i);
+    foreach (AbstractLoggerEngine* engine, application_engines)
+        Log->detachLoggerEngine(engine,false);
+
+    Logger::MessageType previous_log_level = Log->globalLogLevel();
+    Log->setGlobalLogLevel(Logger::Info);
+
+    // All engines share the same formatting engine:
+    QList<CountingLoggerEngine*> engines;
+    for (int i = 0; i < EngineCount; ++i) {
+        CountingLoggerEngine* engine = new CountingLoggerEngine;
+        engine->setName(QString("Benchmark Engine %1").arg(i));
+        engine->installFormattingEngine(formatting_engine);
+        QVERIFY(Log->attachLoggerEngine(engine,true));
+        engines << engine;
+    }
+
+    // The rate in messages per second is message_count divided by the time reported for one iteration:
+    const int message_count = 10000;
+    QBENCHMARK {
+        for (int i = 0; i < message_count; ++i)
+            LOG_INFO("Benchmark message");
+        // Filtered messages must be cheap too:
+        for (int i = 0; i < message_count; ++i)
+            LOG_TRACE("Filtered benchmark message " + QString::number(i));
+    }
+
+    foreach (CountingLoggerEngine* engine, engines) {
+        QVERIFY(engine->message_count >= message_count);
+        QVERIFY(engine->message_count % message_count == 0);
+        Log->detachLoggerEngine(engine,true);
+    }
+
+    Log->setGlobalLogLevel(previous_log_level);
+    foreach (AbstractLoggerEngine* engine, application_engines)
+        Log->attachLoggerEngine(engine,false);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkTreeBuilding_data() {
+    QTest::addColumn<bool>("WideTree");
+    QTest::addColumn<int>("ThreadCount");
+
+    QList<int> thread_counts;
+    thread_counts << 1 << 2 << 4;
+    if (!thread_counts.contains(QThread::idealThreadCount()))
+        thread_counts << QThread::idealThreadCount();
+
+    foreach (int thread_count, thread_counts) {
+        QTest::newRow(qPrintable(QString("wide tree, %1 thread(s)").arg(thread_count))) << true << thread_count;
+        QTest::newRow(qPrintable(QString("deep tree, %1 thread(s)").arg(thread_count))) << false << thread_count;
+    }
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkTreeBuilding() {
+    QFETCH(bool, WideTree);
+    QFETCH(int, ThreadCount);
+
+    // The wide tree has 200 nodes with 200 items each, the deep tree 6 levels of 4 nodes with 10 items each:
+    TreeNode* root_node = new TreeNode("Root Node");
+    if (WideTree)
+        buildBenchmarkTree(root_node,1,200,200);
+    else
+        buildBenchmarkTree(root_node,6,4,10);
+
+    // Build the tree serially first to verify the parallel builds against:
+    ObserverTreeModel serial_model;
+    serial_model.setObserverContext(root_node);
+    int expected_row_count = countBenchmarkRows(serial_model);
+    QVERIFY(expected_row_count > 0);
+
+    // A single thread is measured using the serial build:
+    ObserverTreeModel model;
+    model.toggleParallelTreeBuilding(ThreadCount > 1);
+    model.setTreeBuildingThreadCount(ThreadCount);
+    model.setObserverContext(root_node);
+
+    QBENCHMARK {
+        model.refresh();
+    }
+
+    QCOMPARE(countBenchmarkRows(model),expected_row_count);
+    delete root_node;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkProcessBufferSplitting_data() {
+    QTest::addColumn<int>("ChunkSize");
+    QTest::addColumn<bool>("LineBreakStrings");
+    QTest::newRow("4 KB chunks, new lines only") << 4096 << false;
+    QTest::newRow("4 KB chunks, line break strings") << 4096 << true;
+    QTest::newRow("64 KB chunks, line break strings") << 65536 << true;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkProcessBufferSplitting() {
+    QFETCH(int, ChunkSize);
+    QFETCH(bool, LineBreakStrings);
+
+    // Build a synthetic stream of about 30 MB in which every third message is an error spanning two lines:
+    const int line_count = 500000;
+    QByteArray stream;
+    stream.reserve(line_count * 70);
+    int expected_messages = 0;
+    for (int i = 0; i < line_count; ++i) {
+        if (i % 3 == 0) {
+            stream.append("ERROR: Synthetic error message number " + QByteArray::number(i) + "\n   continued on the next line\n");
+            expected_messages += 2;
+        } else {
+            stream.append("INFO: Synthetic information message number " + QByteArray::number(i) + "\n");
+            ++expected_messages;
+        }
+    }
+    // The new line character always separates messages, thus each message start following a new line adds an empty message:
+    if (LineBreakStrings)
+        expected_messages += line_count;
+
+    QStringList line_break_strings;
+    if (LineBreakStrings)
+        line_break_strings << "ERROR:" << "INFO:";
+
+    int message_count = 0;
+    qint64 message_bytes = 0;
+    QBENCHMARK {
+        ProcessBufferSplitter splitter;
+        if (LineBreakStrings)
+            splitter.setLineBreakStrings(line_break_strings);
+
+        message_count = 0;
+        message_bytes = 0;
+        for (int position = 0; position < stream.size(); position += ChunkSize) {
+            splitter.append(stream.constData() + position,qMin(ChunkSize,stream.size() - position));
+            message_count += splitter.messageCount();
+            for (int i = 0; i < splitter.messageCount(); ++i)
+                message_bytes += splitter.messageLength(i);
+            splitter.clearMessages();
+        }
+        splitter.flush();
+        message_count += splitter.messageCount();
+    }
+
+    QVERIFY(message_bytes > 0);
+    QVERIFY(message_bytes <= stream.size());
+    QCOMPARE(message_count,expected_messages);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkFindFilesUnderDir_data() {
+    QTest::addColumn<int>("ThreadCount");
+    QTest::newRow("Serial") << 0;
+    QTest::newRow("Parallel, 1 thread") << 1;
+    QTest::newRow("Parallel, 4 threads") << 4;
+    QTest::newRow("Parallel, ideal thread count") << -1;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkFindFilesUnderDir() {
+    QFETCH(int, ThreadCount);
+
+    // Generate 8 top level directories, each with 8 sub directories containing 50 files, thus 3200 files in 72 directories:
+    QString root = QtilitiesApplication::applicationSessionPath() + "/benchmarkFindFilesUnderDir";
+    if (!QDir(root).exists()) {
+        for (int i = 0; i < 8; ++i) {
+            for (int j = 0; j < 8; ++j) {
+                QString path = root + QString("/top_%1/sub_%2").arg(i).arg(j);
+                QDir().mkpath(path);
+                for (int k = 0; k < 50; ++k)
+                    FileUtils::writeTextFile(path + QString("/file_%1.txt").arg(k),"Benchmark");
+            }
+        }
+    }
+
+    FileUtils file_utils(false);
+    int found_count = 0;
+    QBENCHMARK {
+        if (ThreadCount == 0)
+            found_count = file_utils.findFilesUnderDir(root).count();
+        else
+            found_count = file_utils.findFilesUnderDirParallel(root,QString(),QString(),QDir::Files | QDir::NoDotAndDotDot,QDir::NoSort,ThreadCount).count();
+    }
+
+    // findFilesUnderDir() also returns the 64 nested directories:
+    QCOMPARE(found_count,ThreadCount == 0 ? 3264 : 3200);
+}
@@ -42,10 +42,25 @@ namespace Qtilities {
              QString testName() const { return tr("Some expriments with benchmarking"); }
         private slots:
             void benchmarkObserverExport_1_0_1_0_data();
-            //! Do a benchmark on a big observer export
+            //! Do a benchmark on a big observer export, and compare serial and parallel binary exports of the same tree.
             void benchmarkObserverExport_1_0_1_0();
             //! Do a benchmark on a big observer export
             void benchmarkObserverImport_1_0_1_0();
+            void benchmarkObserverSubjectLookup_data();
+            //! Do a benchmark on subject lookups (by ID, by name and using contains()) for observers with an increasing number of subjects.
+            void benchmarkObserverSubjectLookup();
+            void benchmarkLoggerThroughput_data();
+            //! Do a benchmark on the number of messages per second which can be logged with zero, one and five logger engines attached.
+            void benchmarkLoggerThroughput();
+            void benchmarkTreeBuilding_data();
+            //! Do a benchmark on building ObserverTreeModel trees for wide and deep trees, serially and in parallel using an increasing number of threads.
+            void benchmarkTreeBuilding();
+            void benchmarkProcessBufferSplitting_data();
+            //! Do a benchmark on splitting a large synthetic process output stream into messages using a ProcessBufferSplitter.
+            void benchmarkProcessBufferSplitting();
+            void benchmarkFindFilesUnderDir_data();
+            //! Do a benchmark on finding the files in a generated directory hierarchy using FileUtils::findFilesUnderDir() and FileUtils::findFilesUnderDirParallel().
+            void benchmarkFindFilesUnderDir();
         };
     }
 }
@@ -19,6 +19,8 @@ using namespace QtilitiesExtensionSystem;
 
 #include <QDomDocument>
 #include <QDomElement>
+#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
 
 int Qtilities::Testing::TestExporting::execTest(int argc, char ** argv) {
     return QTest::qExec(this,argc,argv);
@@ -929,6 +931,167 @@ void Qtilities::Testing::TestExporting::testObserver_w1_0_r1_0() {
         LOG_INFO("TestExporting::testObserver_w1_0_r1_0() Extended Binary end:");
     }
     // ---------------------------------------------------
+    // Test ExportStreamed binary:
+    // ---------------------------------------------------
+    {
+        LOG_INFO("TestExporting::testObserver_w1_0_r1_0() Streamed Binary start:");
+        TreeNode* obj_source = new TreeNode("Root Node");
+        // Give it the same name since we don't construct it using a factory:
+        TreeNode* obj_import_binary = new TreeNode("Root Node");
+
+        // Add all known filters:
+        obj_source->enableActivityControl(ObserverHints::CheckboxActivityDisplay);
+        obj_source->enableNamingControl(ObserverHints::ReadOnlyNames,NamingPolicyFilter::ProhibitDuplicateNames);
+        obj_source->setChildType("Example child type");
+
+        // Build a tree with an item with multiple parents:
+        obj_source->addItem("Item 1");
+        obj_source->addItem("Item 2");
+        TreeItem* shared_item = obj_source->addItem("Shared Item");
+        TreeNode* child_nodeA = obj_source->addNode("TestNodeA");
+        child_nodeA->addItem("TestChild1");
+        child_nodeA->addItem("TestChild2");
+        child_nodeA->addItem("TestChild3");
+        TreeNode* child_nodeB = obj_source->addNode("TestNodeB");
+        child_nodeB->addItem("TestChild1");
+        child_nodeB->addItem("TestChild2");
+        child_nodeB->addItem("TestChild3");
+        child_nodeB->addItem(shared_item);
+
+        QFile file("testObserverStreamed_w1_0_r1_0.binary");
+        file.open(QIODevice::WriteOnly);
+        QDataStream stream_out(&file);
+        stream_out.setVersion(QDataStream::Qt_4_7);
+        obj_source->setExportVersion(write_version);
+        IExportable::ExportResultFlags result_flags = obj_source->exportBinaryExt(stream_out,ObserverData::ExportData | ObserverData::ExportStreamed);
+        QVERIFY(result_flags == IExportable::Complete);
+        file.close();
+
+        // Older importers only accept the normal observer marker at the start, thus they must reject streamed exports:
+        file.open(QIODevice::ReadOnly);
+        QDataStream stream_marker(&file);
+        stream_marker.setVersion(QDataStream::Qt_4_7);
+        quint32 start_marker;
+        stream_marker >> start_marker;
+        QVERIFY(start_marker != 0xDEADBEEF);
+        file.close();
+
+        file.open(QIODevice::ReadOnly);
+        QList<QPointer<QObject> > import_list;
+        QDataStream stream_in(&file);
+        stream_in.setVersion(QDataStream::Qt_4_7);
+        obj_import_binary->setExportVersion(read_version);
+        QVERIFY(obj_import_binary->importBinary(stream_in,import_list) == IExportable::Complete);
+        file.close();
+
+        // The tree must be the same and the shared item must only be constructed once:
+        QCOMPARE(obj_import_binary->treeCount(),obj_source->treeCount());
+        QCOMPARE(obj_import_binary->subjectNames(),obj_source->subjectNames());
+        Observer* import_nodeB = qobject_cast<Observer*> (obj_import_binary->subjectReference("TestNodeB"));
+        QVERIFY(import_nodeB);
+        QCOMPARE(import_nodeB->subjectCount(),4);
+        QVERIFY(import_nodeB->subjectAt(3) == obj_import_binary->subjectReference("Shared Item"));
+        QCOMPARE(Observer::parentCount(import_nodeB->subjectAt(3)),2);
+
+        delete obj_source;
+        delete obj_import_binary;
+        LOG_INFO("TestExporting::testObserver_w1_0_r1_0() Streamed Binary end:");
+    }
+    // ---------------------------------------------------
+    // Test XML stream exports and imports against the QDomDocument path:
+    // ---------------------------------------------------
+    {
+        LOG_INFO("TestExporting::testObserver_w1_0_r1_0() XML Stream start:");
+        TreeNode* obj_source = new TreeNode("Root Node");
+        // Give it the same name since we don't construct it using a factory:
+        TreeNode* obj_import_xml = new TreeNode("Root Node");
+        TreeNode* obj_import_stream = new TreeNode("Root Node");
+
+        // Add all known filters:
+        obj_source->enableActivityControl(ObserverHints::CheckboxActivityDisplay);
+        obj_source->enableNamingControl(ObserverHints::ReadOnlyNames,NamingPolicyFilter::ProhibitDuplicateNames);
+        obj_source->setChildType("Example child type");
+
+        obj_source->addItem("Item 1",QtilitiesCategory("Category A"));
+        obj_source->addItem("Item 2");
+        TreeNode* child_nodeA = obj_source->addNode("TestNodeA",QtilitiesCategory("Category B"));
+        child_nodeA->addItem("TestChild1");
+        child_nodeA->addItem("TestChild2");
+        TreeNode* child_nodeB = child_nodeA->addNode("TestNodeB");
+        child_nodeB->addItem("TestChild3");
+        // An observer without subjects does not get a Children element:
+        obj_source->addNode("TestNodeC");
+
+        // 1. Stream export, QDomDocument import:
+        QFile file("testObserverStream_w1_0_r1_0.xml");
+        file.open(QIODevice::WriteOnly);
+        QXmlStreamWriter writer(&file);
+        writer.setAutoFormatting(true);
+        writer.writeStartDocument();
+        writer.writeStartElement("QtilitiesTesting");
+        writer.writeStartElement("object_node");
+        obj_source->setExportVersion(write_version);
+        QVERIFY(obj_source->exportXmlStream(&writer) == IExportable::Complete);
+        writer.writeEndElement();
+        writer.writeEndElement();
+        writer.writeEndDocument();
+        QVERIFY(!writer.hasError());
+        file.close();
+
+        file.open(QIODevice::ReadOnly);
+        QDomDocument doc("QtilitiesTesting");
+        QVERIFY(doc.setContent(&file));
+        file.close();
+        QDomElement rootItem = doc.documentElement().firstChildElement("object_node");
+        QVERIFY(!rootItem.isNull());
+        QList<QPointer<QObject> > import_list_xml;
+        obj_import_xml->setExportVersion(read_version);
+        QVERIFY(obj_import_xml->importXml(&doc,&rootItem,import_list_xml) == IExportable::Complete);
+
+        // 2. QDomDocument export, stream import:
+        QDomDocument doc_dom("QtilitiesTesting");
+        QDomElement root_dom = doc_dom.createElement("QtilitiesTesting");
+        doc_dom.appendChild(root_dom);
+        QDomElement rootItem_dom = doc_dom.createElement("object_node");
+        root_dom.appendChild(rootItem_dom);
+        QVERIFY(obj_source->exportXml(&doc_dom,&rootItem_dom) == IExportable::Complete);
+
+        QXmlStreamReader reader(doc_dom.toString(2));
+        QVERIFY(reader.readNextStartElement());
+        QVERIFY(reader.readNextStartElement());
+        QCOMPARE(reader.name().toString(),QString("object_node"));
+        QList<QPointer<QObject> > import_list_stream;
+        obj_import_stream->setExportVersion(read_version);
+        QVERIFY(obj_import_stream->importXmlStream(&reader,import_list_stream) == IExportable::Complete);
+        QVERIFY(!reader.hasError());
+        // The reader must be left on the end element of the object node:
+        QVERIFY(reader.isEndElement());
+        QCOMPARE(reader.name().toString(),QString("object_node"));
+
+        // Both imported trees must be the same as the source tree:
+        QList<TreeNode*> imported_trees;
+        imported_trees << obj_import_xml << obj_import_stream;
+        for (int i = 0; i < imported_trees.count(); ++i) {
+            TreeNode* imported = imported_trees.at(i);
+            QCOMPARE(imported->treeCount(),obj_source->treeCount());
+            QCOMPARE(imported->subjectNames(),obj_source->subjectNames());
+            QVERIFY(imported->hasCategory(QtilitiesCategory("Category A")));
+            QVERIFY(imported->hasCategory(QtilitiesCategory("Category B")));
+            Observer* import_nodeA = qobject_cast<Observer*> (imported->subjectReference("TestNodeA"));
+            QVERIFY(import_nodeA);
+            QCOMPARE(import_nodeA->subjectNames(),child_nodeA->subjectNames());
+            Observer* import_nodeB = qobject_cast<Observer*> (import_nodeA->subjectReference("TestNodeB"));
+            QVERIFY(import_nodeB);
+            QCOMPARE(import_nodeB->subjectNames(),child_nodeB->subjectNames());
+            QCOMPARE(imported->subjectFilters().count(),obj_source->subjectFilters().count());
+        }
+
+        delete obj_source;
+        delete obj_import_xml;
+        delete obj_import_stream;
+        LOG_INFO("TestExporting::testObserver_w1_0_r1_0() XML Stream end:");
+    }
+    // ---------------------------------------------------
     // Test ExportRelationalData xml:
     // ---------------------------------------------------
     {
@@ -1026,9 +1189,91 @@ void Qtilities::Testing::TestExporting::testProject_w1_0_r1_0() {
     QVERIFY(FileUtils::compareFiles(file_original_binary,file_readback_binary));
     QVERIFY(FileUtils::compareFiles(file_original_xml,file_readback_xml));
 
+    // Binary projects are only saved as indexed project files when enabled, older versions can't read them:
+    QString file_indexed = QString("%1/%2_indexed.prj").arg(QtilitiesApplication::applicationSessionPath()).arg("testProject_w1_0_r1_0");
+    obj_source->setIndexedBinaryFormatEnabled(true);
+    QVERIFY(obj_source->saveProject(file_indexed));
+    QVERIFY(!FileUtils::compareFiles(file_original_binary,file_indexed));
+
+    // Deferred loading of project items from indexed binary projects:
+    CodeEditorWidget code_editor_widget_deferred;
+    code_editor_widget_deferred.setObjectName("Code Editor");
+    CodeEditorProjectItemWrapper* wrapper_deferred = new CodeEditorProjectItemWrapper(&code_editor_widget_deferred);
+    Project* obj_import_deferred = new Project;
+    obj_import_deferred->addProjectItem(wrapper_deferred);
+    obj_import_deferred->setIndexedBinaryFormatEnabled(true);
+    obj_import_deferred->setDeferredItemLoading(true);
+    QVERIFY(obj_import_deferred->loadProject(file_indexed));
+    QVERIFY(!obj_import_deferred->isProjectItemLoaded(0));
+    QVERIFY(code_editor_widget_deferred.codeEditor()->toPlainText().isEmpty());
+    QVERIFY(obj_import_deferred->loadProjectItem(0));
+    QVERIFY(obj_import_deferred->isProjectItemLoaded(0));
+    QCOMPARE(code_editor_widget_deferred.codeEditor()->toPlainText(),QString("Testing Plain Text... Hooray!"));
+
+    // Accessing a project item loads it:
+    QVERIFY(obj_import_deferred->loadProject(file_indexed));
+    QVERIFY(!obj_import_deferred->isProjectItemLoaded(0));
+    QVERIFY(obj_import_deferred->projectItem(0) == wrapper_deferred);
+    QVERIFY(obj_import_deferred->isProjectItemLoaded(0));
+    QCOMPARE(code_editor_widget_deferred.codeEditor()->toPlainText(),QString("Testing Plain Text... Hooray!"));
+
+    // Items which were not loaded yet must be loaded when saving:
+    QVERIFY(obj_import_deferred->loadProject(file_indexed));
+    QVERIFY(!obj_import_deferred->isProjectItemLoaded(0));
+    QString file_readback_deferred = QString("%1/%2_readback_deferred.prj").arg(QtilitiesApplication::applicationSessionPath()).arg("testProject_w1_0_r1_0");
+    QVERIFY(obj_import_deferred->saveProject(file_readback_deferred));
+    QVERIFY(FileUtils::compareFiles(file_indexed,file_readback_deferred));
+
+    // Items which were modified before they were loaded are not merged with the project file, the project is not saved instead:
+    QVERIFY(obj_import_deferred->loadProject(file_indexed));
+    QVERIFY(!obj_import_deferred->isProjectItemLoaded(0));
+    code_editor_widget_deferred.codeEditor()->setPlainText("Testing Unloaded Changes...");
+    wrapper_deferred->setModificationState(true);
+    QVERIFY(!obj_import_deferred->saveProject(file_readback_deferred));
+    QVERIFY(FileUtils::compareFiles(file_indexed,file_readback_deferred));
+
+    // Delta saves only append the modified project items to the project file:
+    QString file_delta = QString("%1/%2_delta.prj").arg(QtilitiesApplication::applicationSessionPath()).arg("testProject_w1_0_r1_0");
+    obj_source->setDeltaSavingEnabled(true);
+    obj_source->setCompactionThreshold(100);
+    QVERIFY(obj_source->saveProject(file_delta));
+    qint64 full_size = QFileInfo(file_delta).size();
+    code_editor_widget_source.codeEditor()->setPlainText("Testing Delta Saves... Hooray!");
+    wrapper_source->setModificationState(true);
+    QVERIFY(obj_source->saveProject(file_delta));
+    QVERIFY(QFileInfo(file_delta).size() > full_size);
+
+    CodeEditorWidget code_editor_widget_delta;
+    code_editor_widget_delta.setObjectName("Code Editor");
+    CodeEditorProjectItemWrapper* wrapper_delta = new CodeEditorProjectItemWrapper(&code_editor_widget_delta);
+    Project* obj_import_delta = new Project;
+    obj_import_delta->addProjectItem(wrapper_delta);
+    QVERIFY(obj_import_delta->loadProject(file_delta));
+    QCOMPARE(code_editor_widget_delta.codeEditor()->toPlainText(),QString("Testing Delta Saves... Hooray!"));
+
+    // Compaction removes the replaced segment and the delta index, the new text is one UTF-16 character longer:
+    QVERIFY(obj_source->compactProjectFile());
+    QCOMPARE(QFileInfo(file_delta).size(),full_size + 2);
+    QVERIFY(obj_import_delta->loadProject(file_delta));
+    QCOMPARE(code_editor_widget_delta.codeEditor()->toPlainText(),QString("Testing Delta Saves... Hooray!"));
+
+    // A delta save which was not completely written must be ignored, leaving the project as it was after the previous delta save:
+    code_editor_widget_source.codeEditor()->setPlainText("Testing Torn Saves... First!");
+    wrapper_source->setModificationState(true);
+    QVERIFY(obj_source->saveProject(file_delta));
+    code_editor_widget_source.codeEditor()->setPlainText("Testing Torn Saves... Second!");
+    wrapper_source->setModificationState(true);
+    QVERIFY(obj_source->saveProject(file_delta));
+    QFile torn_file(file_delta);
+    QVERIFY(torn_file.resize(QFileInfo(file_delta).size() - 4));
+    QVERIFY(obj_import_delta->loadProject(file_delta));
+    QCOMPARE(code_editor_widget_delta.codeEditor()->toPlainText(),QString("Testing Torn Saves... First!"));
+
     delete obj_source;
     delete obj_import_binary;
     delete obj_import_xml;
+    delete obj_import_deferred;
+    delete obj_import_delta;
 }
 
 void Qtilities::Testing::TestExporting::testObserverProjectItemWrapper_w1_0_r1_0() {
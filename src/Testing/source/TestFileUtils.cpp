@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestFileUtils.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+Q_DECLARE_METATYPE(QFileInfoList)
+
+namespace {
+    // Creates a directory hierarchy of the given depth under path, with a .txt, .log and .bak file in every directory:
+    void createTestTree(const QString& path, int branch_count, int depth) {
+        QDir().mkpath(path);
+        QStringList file_names;
+        file_names << "notes.txt" << "output.log" << "backup.bak";
+        foreach (const QString& file_name, file_names)
+            FileUtils::writeTextFile(path + "/" + file_name,file_name);
+
+        if (depth == 0)
+            return;
+        for (int i = 0; i < branch_count; ++i)
+            createTestTree(path + QString("/dir_%1").arg(i),branch_count,depth - 1);
+    }
+
+    // Entries are compared by path since the order in which findFilesUnderDirParallel() finds them is not defined:
+    QStringList sortedPaths(const QFileInfoList& infos, bool include_dirs = true) {
+        QStringList paths;
+        foreach (const QFileInfo& info, infos) {
+            if (include_dirs || !info.isDir())
+                paths << info.absoluteFilePath();
+        }
+        paths.sort();
+        return paths;
+    }
+
+    QString testTreePath() {
+        return QtilitiesApplication::applicationSessionPath() + "/testFindFilesUnderDir";
+    }
+}
+
+int Qtilities::Testing::TestFileUtils::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestFileUtils::testFindFilesUnderDirParallel_data() {
+    QTest::addColumn<QString>("FileFilters");
+    QTest::addColumn<QString>("IgnoreList");
+    QTest::addColumn<int>("Filters");
+    QTest::addColumn<int>("ThreadCount");
+
+    QTest::newRow("Files and directories, 1 thread") << QString() << QString() << (int) (QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot) << 1;
+    QTest::newRow("Files and directories, 4 threads") << QString() << QString() << (int) (QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot) << 4;
+    QTest::newRow("Files only") << QString() << QString() << (int) (QDir::Files | QDir::NoDotAndDotDot) << 4;
+    QTest::newRow("File filters") << QString("*.txt *.log") << QString() << (int) (QDir::Files | QDir::NoDotAndDotDot) << 4;
+    QTest::newRow("Ignore list") << QString() << QString("*.bak */dir_1") << (int) (QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot) << 4;
+}
+
+void Qtilities::Testing::TestFileUtils::testFindFilesUnderDirParallel() {
+    QFETCH(QString, FileFilters);
+    QFETCH(QString, IgnoreList);
+    QFETCH(int, Filters);
+    QFETCH(int, ThreadCount);
+
+    QString root = testTreePath();
+    FileUtils::removeDir(root);
+    createTestTree(root,3,3);
+
+    FileUtils file_utils(false);
+    QDir::Filters filters = (QDir::Filters) Filters;
+    QFileInfoList serial = file_utils.findFilesUnderDir(root,FileFilters,IgnoreList,filters);
+    QFileInfoList parallel = file_utils.findFilesUnderDirParallel(root,FileFilters,IgnoreList,filters,QDir::NoSort,ThreadCount);
+    QVERIFY(!parallel.isEmpty());
+    QVERIFY(sortedPaths(file_utils.lastFilesUnderDir()) == sortedPaths(parallel));
+
+    // findFilesUnderDir() returns nested directories even when only files are requested, see findFilesUnderDirParallel():
+    if (filters & QDir::AllDirs) {
+        QVERIFY(sortedPaths(serial) == sortedPaths(parallel));
+    } else {
+        QVERIFY(sortedPaths(serial,false) == sortedPaths(parallel));
+        // No directories at all:
+        QVERIFY(sortedPaths(parallel,false) == sortedPaths(parallel));
+    }
+
+    FileUtils::removeDir(root);
+}
+
+void Qtilities::Testing::TestFileUtils::testFindFilesUnderDirParallelStreaming() {
+    QString root = testTreePath();
+    FileUtils::removeDir(root);
+    createTestTree(root,4,2);
+
+    FileUtils file_utils(false);
+    qRegisterMetaType<QFileInfoList>("QFileInfoList");
+    QSignalSpy spy(&file_utils,SIGNAL(filesFound(QFileInfoList)));
+    QFileInfoList returned = file_utils.findFilesUnderDirParallel(root,QString(),QString(),QDir::Files | QDir::NoDotAndDotDot,QDir::NoSort,4,false);
+    QVERIFY(returned.isEmpty());
+    QVERIFY(file_utils.lastFilesUnderDir().isEmpty());
+
+    QFileInfoList streamed;
+    for (int i = 0; i < spy.count(); ++i)
+        streamed.append(qvariant_cast<QFileInfoList>(spy.at(i).at(0)));
+    // 1 + 4 + 16 directories with 3 files each:
+    QVERIFY(streamed.count() == 63);
+    QVERIFY(sortedPaths(streamed) == sortedPaths(file_utils.findFilesUnderDir(root)));
+
+    FileUtils::removeDir(root);
+}
@@ -0,0 +1,53 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_FILE_UTILS_H
+#define TEST_FILE_UTILS_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::FileUtils.
+        class TESTING_SHARED_EXPORT TestFileUtils: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("File Utils"); }
+
+        private slots:
+            void testFindFilesUnderDirParallel_data();
+            //! Tests that Qtilities::Core::FileUtils::findFilesUnderDirParallel() finds the same entries as Qtilities::Core::FileUtils::findFilesUnderDir().
+            void testFindFilesUnderDirParallel();
+            //! Tests that Qtilities::Core::FileUtils::findFilesUnderDirParallel() streams all entries through filesFound() when results are not collected.
+            void testFindFilesUnderDirParallelStreaming();
+        };
+    }
+}
+
+#endif // TEST_FILE_UTILS_H
@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestLogger.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QRunnable>
+#include <QThreadPool>
+
+namespace {
+    const int buffered_producer_count = 4;
+    const int buffered_messages_per_producer = 500;
+
+    // Logs a numbered sequence of messages to a file logger engine from a pool thread:
+    class BufferedLoggerProducer : public QRunnable {
+    public:
+        BufferedLoggerProducer(FileLoggerEngine* engine, int producer) : engine(engine), producer(producer) {}
+
+        void run() {
+            for (int i = 0; i < buffered_messages_per_producer; ++i)
+                engine->logMessage(QString("Producer %1 message %2").arg(producer).arg(i),Logger::Info);
+        }
+
+    private:
+        FileLoggerEngine* engine;
+        int producer;
+    };
+
+    QStringList readLogLines(const QString& file_name) {
+        QFile file(file_name);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            return QStringList();
+        return QString::fromLocal8Bit(file.readAll()).split("\n");
+    }
+}
+
+int Qtilities::Testing::TestLogger::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestLogger::testGlobalLogLevel() {
+    Logger::MessageType previous_log_level = Log->globalLogLevel();
+
+    Log->setGlobalLogLevel(Logger::Warning);
+    QVERIFY(Log->isMessageTypeLogged(Logger::Info));
+    QVERIFY(Log->isMessageTypeLogged(Logger::Warning));
+    QVERIFY(!Log->isMessageTypeLogged(Logger::Error));
+    QVERIFY(!Log->isMessageTypeLogged(Logger::None));
+
+    // AllLogLevels is not a single message type, all message types must pass it:
+    Log->setGlobalLogLevel(Logger::AllLogLevels);
+    QVERIFY(Log->isMessageTypeLogged(Logger::Info));
+    QVERIFY(Log->isMessageTypeLogged(Logger::Warning));
+    QVERIFY(Log->isMessageTypeLogged(Logger::Error));
+    QVERIFY(Log->isMessageTypeLogged(Logger::Fatal));
+    QVERIFY(!Log->isMessageTypeLogged(Logger::None));
+    #ifndef QT_NO_DEBUG
+    QVERIFY(Log->isMessageTypeLogged(Logger::Debug));
+    QVERIFY(Log->isMessageTypeLogged(Logger::Trace));
+    #endif
+
+    Log->setGlobalLogLevel(previous_log_level);
+}
+
+void Qtilities::Testing::TestLogger::testBinaryLogRoundTrip() {
+    QString file_name = QtilitiesApplication::applicationSessionPath() + "/testBinaryLogRoundTrip" + qti_def_SUFFIX_BINARY_LOG;
+    QStringList messages;
+    for (int i = 0; i < 20; ++i)
+        messages << QString("Processed item %1 of 20 in \"%2\".").arg(i).arg(QString("Folder %1").arg(i % 3));
+    messages << "Version v1.5 uses utf8 and 0x1F." << "Literal {braces} and {} stay." << "Leading zeros 007 and -12." << "Unterminated \"quote 5";
+
+    BinaryFileLoggerEngine* engine = new BinaryFileLoggerEngine;
+    engine->setFileName(file_name);
+    QVERIFY(engine->initialize());
+    for (int i = 0; i < messages.count(); ++i)
+        engine->logMessage(messages.at(i),Logger::Info);
+    QList<QVariant> message_contents;
+    message_contents << QString("Copied %1 files").arg(3) << 42 << true;
+    engine->newMessages(QString(),Logger::Warning,Logger::SystemWideMessages,message_contents);
+    engine->finalize();
+
+    BinaryLogReader reader;
+    QVERIFY(reader.open(file_name));
+    BinaryLogRecord record;
+    for (int i = 0; i < messages.count(); ++i) {
+        QVERIFY(reader.readNext(&record));
+        QCOMPARE(reader.message(record),messages.at(i));
+        // Messages which only differ in their numbers and quoted text share a template:
+        if (i < 20)
+            QCOMPARE(record.template_id,(quint32) 0);
+    }
+    QVERIFY(reader.readNext(&record));
+    QCOMPARE(record.message_type,Logger::Warning);
+    QCOMPARE(reader.message(record),QString("Copied 3 files 42 true"));
+    QVERIFY(!reader.readNext(&record));
+    QCOMPARE(reader.messageTemplate(0),QString("Processed item {} of {} in \"{}\"."));
+
+    delete engine;
+    QFile::remove(file_name);
+}
+
+void Qtilities::Testing::TestLogger::testBinaryLogTemplateLimit() {
+    QString file_name = QtilitiesApplication::applicationSessionPath() + "/testBinaryLogTemplateLimit" + qti_def_SUFFIX_BINARY_LOG;
+    BinaryFileLoggerEngine* engine = new BinaryFileLoggerEngine;
+    engine->setFileName(file_name);
+    engine->setTemplateLimit(2);
+    QVERIFY(engine->initialize());
+    engine->logMessage("First message",Logger::Info);
+    engine->logMessage("Second message",Logger::Info);
+    engine->logMessage("Third message",Logger::Info);
+    engine->logMessage("First message",Logger::Info);
+    engine->finalize();
+
+    BinaryLogReader reader;
+    QVERIFY(reader.open(file_name));
+    BinaryLogRecord record;
+    QVERIFY(reader.readNext(&record));
+    QCOMPARE(record.template_id,(quint32) 0);
+    QVERIFY(reader.readNext(&record));
+    QCOMPARE(record.template_id,(quint32) 1);
+    // The limit was reached, thus the third message is stored inline:
+    QVERIFY(reader.readNext(&record));
+    QCOMPARE(record.template_id,(quint32) FormattingEngine_Binary::InlineTemplateId);
+    QCOMPARE(reader.message(record),QString("Third message"));
+    // Interned templates are still used:
+    QVERIFY(reader.readNext(&record));
+    QCOMPARE(record.template_id,(quint32) 0);
+    QCOMPARE(reader.message(record),QString("First message"));
+    QVERIFY(!reader.readNext(&record));
+
+    delete engine;
+    QFile::remove(file_name);
+}
+
+void Qtilities::Testing::TestLogger::testBufferedFileLogger() {
+    QString file_name = QtilitiesApplication::applicationSessionPath() + "/testBufferedFileLogger.log";
+    FileLoggerEngine* engine = new FileLoggerEngine;
+    engine->setFileName(file_name);
+    engine->installFormattingEngine(Log->formattingEngineReference(qti_def_FORMATTING_ENGINE_DEFAULT));
+    engine->setWriteMode(FileLoggerEngine::BufferedWriteMode);
+    // A small ring buffer makes the producers wait for the writer, and nothing is flushed before finalize():
+    engine->setBufferCapacity(4);
+    engine->setFlushSize(1024 * 1024);
+    engine->setFlushInterval(60 * 60 * 1000);
+    engine->setFlushOnError(false);
+    QVERIFY(engine->initialize());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(buffered_producer_count);
+    for (int i = 0; i < buffered_producer_count; ++i)
+        pool.start(new BufferedLoggerProducer(engine,i));
+    pool.waitForDone();
+    engine->finalize();
+    QVERIFY(!engine->isInitialized());
+
+    // Every message must be written exactly once, in the order in which each producer logged it:
+    QVector<int> next_message(buffered_producer_count,0);
+    QRegExp message_exp("Producer (\\d+) message (\\d+)");
+    int finalize_count = 0;
+    foreach (const QString& line, readLogLines(file_name)) {
+        if (line.startsWith("End of session log."))
+            ++finalize_count;
+        if (!message_exp.exactMatch(line))
+            continue;
+        const int producer = message_exp.cap(1).toInt();
+        QCOMPARE(finalize_count,0);
+        QCOMPARE(message_exp.cap(2).toInt(),next_message.at(producer));
+        ++next_message[producer];
+    }
+    for (int i = 0; i < buffered_producer_count; ++i)
+        QCOMPARE(next_message.at(i),buffered_messages_per_producer);
+    QCOMPARE(finalize_count,1);
+
+    delete engine;
+    QFile::remove(file_name);
+}
+
+void Qtilities::Testing::TestLogger::testFileLoggerFinalize() {
+    QList<FileLoggerEngine::WriteMode> write_modes;
+    write_modes << FileLoggerEngine::DirectWriteMode << FileLoggerEngine::BufferedWriteMode;
+    foreach (FileLoggerEngine::WriteMode write_mode, write_modes) {
+        QString file_name = QtilitiesApplication::applicationSessionPath() + QString("/testFileLoggerFinalize%1.log").arg((int) write_mode);
+        FileLoggerEngine* engine = new FileLoggerEngine;
+        engine->setFileName(file_name);
+        engine->installFormattingEngine(Log->formattingEngineReference(qti_def_FORMATTING_ENGINE_DEFAULT));
+        engine->setWriteMode(write_mode);
+        QVERIFY(engine->initialize());
+        engine->logMessage("Before finalize",Logger::Info);
+        engine->finalize();
+        QVERIFY(!engine->isInitialized());
+
+        // Messages logged after finalize() and the destructor must not write anything:
+        engine->logMessage("After finalize",Logger::Info);
+        engine->finalize();
+        delete engine;
+
+        QStringList lines = readLogLines(file_name);
+        QVERIFY(lines.contains("Before finalize"));
+        QVERIFY(!lines.contains("After finalize"));
+        int finalize_count = 0;
+        foreach (const QString& line, lines) {
+            if (line.startsWith("End of session log."))
+                ++finalize_count;
+        }
+        QCOMPARE(finalize_count,1);
+        QFile::remove(file_name);
+    }
+}
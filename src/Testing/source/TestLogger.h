@@ -0,0 +1,58 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_LOGGER_H
+#define TEST_LOGGER_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Logging::Logger and its logger engines.
+        class TESTING_SHARED_EXPORT TestLogger: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("Logger"); }
+
+        private slots:
+            //! Tests the message types which pass the global log level, including AllLogLevels.
+            void testGlobalLogLevel();
+            //! Tests that messages written by Qtilities::Logging::BinaryFileLoggerEngine are read back exactly by Qtilities::Logging::BinaryLogReader.
+            void testBinaryLogRoundTrip();
+            //! Tests that the number of templates interned by Qtilities::Logging::BinaryFileLoggerEngine is bounded.
+            void testBinaryLogTemplateLimit();
+            //! Tests that all messages queued by concurrent producers in Qtilities::Logging::FileLoggerEngine::BufferedWriteMode are flushed by finalize().
+            void testBufferedFileLogger();
+            //! Tests that nothing is written to a file logger engine after it was finalized.
+            void testFileLoggerFinalize();
+        };
+    }
+}
+
+#endif // TEST_LOGGER_H
@@ -157,3 +157,72 @@ void Qtilities::Testing::TestNamingPolicyFilter::testProcessingCycleValidationCh
     node.endProcessingCycle();
 }
 
+void Qtilities::Testing::TestNamingPolicyFilter::testNameIndex() {
+    TreeNode node;
+    node.enableNamingControl(ObserverHints::ReadOnlyNames,NamingPolicyFilter::ProhibitDuplicateNames,NamingPolicyFilter::Reject);
+    NamingPolicyFilter* filter = node.namingPolicyFilter();
+    QVERIFY(filter != 0);
+
+    TreeItem* itemA = node.addItem("A");
+    TreeItem* itemB = node.addItem("B");
+    QVERIFY(node.subjectCount() == 2);
+
+    // ProhibitDuplicateNames is case insensitive:
+    QVERIFY(node.addItem("a") == 0);
+    QVERIFY(filter->getConflictingObject("B") == itemB);
+
+    // Renamed subjects are found under their new names:
+    filter->setName(itemB,"C");
+    QVERIFY(filter->getConflictingObject("B") == 0);
+    QVERIFY(filter->getConflictingObject("C") == itemB);
+    QVERIFY(node.addItem("B") != 0);
+    QVERIFY(node.addItem("c") == 0);
+
+    // Deleted subjects release their names:
+    delete itemA;
+    QVERIFY(node.addItem("A") != 0);
+
+    // Objects are also checked against objects before them in the same batch:
+    QObject* obj1 = new QObject;
+    obj1->setObjectName("D");
+    QObject* obj2 = new QObject;
+    obj2->setObjectName("d");
+    QList<QObject*> batch;
+    batch << obj1 << obj2;
+    QList<QPointer<QObject> > attached = node.attachSubjects(batch);
+    QCOMPARE(attached.count(),1);
+    QVERIFY(attached.front() == obj1);
+
+    delete obj1;
+    delete obj2;
+}
+
+void Qtilities::Testing::TestNamingPolicyFilter::testNameIndexUnnotifiedRenames() {
+    TreeNode node;
+    node.enableNamingControl(ObserverHints::ReadOnlyNames,NamingPolicyFilter::ProhibitDuplicateNames,NamingPolicyFilter::Reject);
+    NamingPolicyFilter* filter = node.namingPolicyFilter();
+    QVERIFY(filter != 0);
+
+    TreeItem* itemA = node.addItem("A");
+    QVERIFY(filter->getConflictingObject("A") == itemA);
+
+    // Renames while subject event filtering is disabled are not passed to the filter:
+    node.toggleSubjectEventFiltering(false);
+    node.setMultiContextPropertyValue(itemA,qti_prop_NAME,QString("B"));
+    node.toggleSubjectEventFiltering(true);
+    QVERIFY(filter->getConflictingObject("A") == 0);
+    QVERIFY(filter->getConflictingObject("B") == itemA);
+    QVERIFY(node.addItem("b") == 0);
+    QVERIFY(node.addItem("A") != 0);
+
+    // Subjects attached while subject event filtering is disabled are never monitored:
+    node.toggleSubjectEventFiltering(false);
+    TreeItem* itemC = node.addItem("C");
+    node.toggleSubjectEventFiltering(true);
+    QVERIFY(itemC != 0);
+    QVERIFY(filter->getConflictingObject("C") == itemC);
+    node.setMultiContextPropertyValue(itemC,qti_prop_NAME,QString("D"));
+    QVERIFY(filter->getConflictingObject("D") == itemC);
+    QVERIFY(node.addItem("d") == 0);
+    QVERIFY(node.subjectCount() == 3);
+}
@@ -54,6 +54,10 @@ namespace Qtilities {
             void testRejectValidityResolutionPolicy();
             //! Tests NamingPolicyFilter::processingCycleValidationChecks().
             void testProcessingCycleValidationChecks();
+            //! Tests that the name index of NamingPolicyFilter follows renames, detachments and batches.
+            void testNameIndex();
+            //! Tests that the name index of NamingPolicyFilter finds subjects renamed without the filter being notified, for example while subject event filtering is disabled.
+            void testNameIndexUnnotifiedRenames();
         };
     }
 }
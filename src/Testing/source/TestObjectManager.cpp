@@ -190,3 +190,87 @@ void Qtilities::Testing::TestObjectManager::testCompareDynamicPropertiesDiff() {
 void Qtilities::Testing::TestObjectManager::testMoveSubjects() {
 
 }
+
+void Qtilities::Testing::TestObjectManager::testPropertyStore() {
+    ObjectManager::setPropertyStoreEnabled(true);
+    QVERIFY(ObjectManager::propertyStoreEnabled());
+
+    QObject* obj = new QObject;
+    SharedProperty test_shared_property("Shared Property",QVariant(5));
+    ObjectManager::setSharedProperty(obj,test_shared_property);
+    MultiContextProperty test_multi_context_property("Multi Context Property");
+    test_multi_context_property.setValue(QVariant(1),1);
+    test_multi_context_property.setValue(QVariant(2),2);
+    ObjectManager::setMultiContextProperty(obj,test_multi_context_property);
+
+    // Values must be served for the correct contexts:
+    bool ok = false;
+    QCOMPARE(ObjectManager::getPropertyContextValue(obj,"Shared Property",10,&ok).toInt(),5);
+    QVERIFY(ok);
+    QCOMPARE(ObjectManager::getPropertyContextValue(obj,"Multi Context Property",1,&ok).toInt(),1);
+    QVERIFY(ok);
+    QCOMPARE(ObjectManager::getPropertyContextValue(obj,"Multi Context Property",2).toInt(),2);
+    QVERIFY(!ObjectManager::getPropertyContextValue(obj,"Multi Context Property",3).isValid());
+    QVERIFY(!ObjectManager::getPropertyContextValue(obj,"Missing Property",1,&ok).isValid());
+    QVERIFY(!ok);
+
+    // Values set through the store must be visible through QObject::property():
+    QVERIFY(ObjectManager::setPropertyContextValue(obj,"Multi Context Property",QVariant(30),3));
+    QVERIFY(ObjectManager::setPropertyContextValue(obj,"Shared Property",QVariant(50),1));
+    MultiContextProperty check_multi_context_property = ObjectManager::getMultiContextProperty(obj,"Multi Context Property");
+    QCOMPARE(check_multi_context_property.contextMap().count(),3);
+    QCOMPARE(check_multi_context_property.value(3).toInt(),30);
+    QCOMPARE(check_multi_context_property.lastChangedContext(),3);
+    QCOMPARE(ObjectManager::getSharedProperty(obj,"Shared Property").value().toInt(),50);
+    QVERIFY(!ObjectManager::setPropertyContextValue(obj,"Missing Property",QVariant(1),1));
+
+    // Changes made directly on the dynamic property must be picked up by the store:
+    check_multi_context_property.setValue(QVariant(100),1);
+    ObjectManager::setMultiContextProperty(obj,check_multi_context_property);
+    QCOMPARE(ObjectManager::getPropertyContextValue(obj,"Multi Context Property",1).toInt(),100);
+    ObjectManager::removeDynamicProperties(obj);
+    QVERIFY(!ObjectManager::getPropertyContextValue(obj,"Multi Context Property",1).isValid());
+    QVERIFY(!ObjectManager::getPropertyContextValue(obj,"Shared Property",1).isValid());
+
+    delete obj;
+    ObjectManager::setPropertyStoreEnabled(false);
+    QVERIFY(!ObjectManager::propertyStoreEnabled());
+}
+
+void Qtilities::Testing::TestObjectManager::testPropertyAtoms() {
+    // Every atom must be found from its own name, which also verifies the lengths in the atom table:
+    for (int i = QtilitiesPropertyAtoms::NoAtom + 1; i < QtilitiesPropertyAtoms::AtomCount; ++i) {
+        QtilitiesPropertyAtoms::Atom atom = (QtilitiesPropertyAtoms::Atom) i;
+        const char* name = QtilitiesPropertyAtoms::name(atom);
+        QVERIFY(name != 0);
+        QCOMPARE((int) QtilitiesPropertyAtoms::atom(name),i);
+        QCOMPARE((int) QtilitiesPropertyAtoms::atom(QByteArray(name)),i);
+    }
+
+    QCOMPARE(QtilitiesPropertyAtoms::atom(qti_prop_NAME),QtilitiesPropertyAtoms::NameAtom);
+    QCOMPARE(QtilitiesPropertyAtoms::atom("Normal Property"),QtilitiesPropertyAtoms::NoAtom);
+    QCOMPARE(QtilitiesPropertyAtoms::atom("qti.core.Unknown"),QtilitiesPropertyAtoms::NoAtom);
+    QCOMPARE(QtilitiesPropertyAtoms::atom("qti."),QtilitiesPropertyAtoms::NoAtom);
+    QCOMPARE(QtilitiesPropertyAtoms::atom((const char*) 0),QtilitiesPropertyAtoms::NoAtom);
+
+    // The capabilities must match the documented permissions of the properties:
+    QVERIFY(!QtilitiesProperty::propertyIsExportable(qti_prop_OBSERVER_MAP));
+    QVERIFY(QtilitiesProperty::propertyIsReserved(qti_prop_OBSERVER_MAP));
+    QVERIFY(!QtilitiesProperty::propertyIsRemovable(qti_prop_OBSERVER_MAP));
+    QVERIFY(QtilitiesProperty::propertyIsExportable(qti_prop_CATEGORY_MAP));
+    QVERIFY(QtilitiesProperty::propertyIsRemovable(qti_prop_CATEGORY_MAP));
+    QVERIFY(QtilitiesProperty::propertySupportsChangeNotifications(qti_prop_CATEGORY_MAP));
+    QVERIFY(QtilitiesProperty::propertyIsExportable(qti_prop_VISITOR_ID));
+    QVERIFY(QtilitiesProperty::propertyIsReserved(qti_prop_VISITOR_ID));
+    QVERIFY(QtilitiesProperty::propertyIsExportable("Normal Property"));
+    QVERIFY(QtilitiesProperty::propertyIsRemovable("Normal Property"));
+    QVERIFY(!QtilitiesProperty::propertyIsReserved("Normal Property"));
+    QVERIFY(!QtilitiesProperty::propertySupportsChangeNotifications("Normal Property"));
+
+    // The observer related capabilities must match Observer::reservedProperties() and Observer::monitoredProperties():
+    Observer obs;
+    foreach (const QString& property_name, obs.reservedProperties())
+        QVERIFY(QtilitiesPropertyAtoms::capabilities(property_name.toUtf8().constData()) & QtilitiesPropertyAtoms::ObserverReserved);
+    foreach (const QString& property_name, obs.monitoredProperties())
+        QVERIFY(QtilitiesPropertyAtoms::capabilities(property_name.toUtf8().constData()) & QtilitiesPropertyAtoms::ObserverMonitored);
+}
@@ -49,6 +49,10 @@ namespace Qtilities {
             void testCompareDynamicPropertiesDiff();
             //! Tests moving of subjects between observers using ObjectManager::moveSubjects().
             void testMoveSubjects();
+            //! Tests the property store enabled using ObjectManager::setPropertyStoreEnabled().
+            void testPropertyStore();
+            //! Tests the classification of property names using QtilitiesPropertyAtoms.
+            void testPropertyAtoms();
         };
     }
 }
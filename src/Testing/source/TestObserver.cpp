@@ -60,6 +60,157 @@ void Qtilities::Testing::TestObserver::testSubjectLimit() {
     QVERIFY(node.addItem("Item 3") != 0);
 }
 
+void Qtilities::Testing::TestObserver::testAttachDetachSubjectsBatch() {
+    Observer observer("Batch Observer");
+    observer.setSubjectLimit(4);
+
+    QList<QObject*> objects;
+    for (int i = 0; i < 5; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName(QString("Object %1").arg(i));
+        objects << obj;
+    }
+
+    // Duplicates are only attached once and the subject limit includes objects attached earlier in the batch:
+    QList<QObject*> batch;
+    batch << objects.at(0) << objects.at(1) << objects.at(0) << objects.at(2) << objects.at(3) << objects.at(4);
+    QList<Observer::EvaluationResult> results = observer.canAttach(batch);
+    QCOMPARE(results.count(),6);
+    QVERIFY(results.at(2) == Observer::Rejected);
+    QVERIFY(results.at(5) == Observer::Rejected);
+
+    QList<QPointer<QObject> > attached = observer.attachSubjects(batch);
+    QCOMPARE(attached.count(),4);
+    QCOMPARE(observer.subjectCount(),4);
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(observer.subjectAt(i) == objects.at(i));
+
+    // Detaching removes the objects in a single pass and keeps the order of the remaining subjects:
+    QList<QObject*> detach_batch;
+    detach_batch << objects.at(2) << objects.at(0) << objects.at(4);
+    QList<QPointer<QObject> > detached = observer.detachSubjects(detach_batch);
+    QCOMPARE(detached.count(),2);
+    QCOMPARE(observer.subjectCount(),2);
+    QVERIFY(observer.subjectAt(0) == objects.at(1));
+    QVERIFY(observer.subjectAt(1) == objects.at(3));
+    QVERIFY(observer.subjectReference(objects.at(0)->objectName()) == 0);
+    QVERIFY(observer.contains(objects.at(3)));
+
+    qDeleteAll(objects);
+    QCOMPARE(observer.subjectCount(),0);
+}
+
+void Qtilities::Testing::TestObserver::testCategoryIndex() {
+    TreeNode node("Category Index Node");
+    const QtilitiesCategory category_ab("A::B","::");
+    const QtilitiesCategory category_c("C");
+    const QtilitiesCategory category_d("D");
+
+    TreeItem* item1 = node.addItem("Item 1",category_ab);
+    node.addItem("Item 2");
+    TreeItem* item3 = node.addItem("Item 3",category_ab);
+    TreeItem* item4 = node.addItem("Item 4",category_c);
+
+    QCOMPARE(node.subjectCategories().count(),3);
+    QVERIFY(node.hasCategory(category_ab));
+    QVERIFY(!node.hasCategory(QtilitiesCategory()));
+    QList<QObject*> subjects = node.subjectReferencesByCategory(category_ab);
+    QCOMPARE(subjects.count(),2);
+    QVERIFY(subjects.at(0) == item1);
+    QVERIFY(subjects.at(1) == item3);
+    QCOMPARE(node.subjectNamesByCategory(QtilitiesCategory()),QStringList() << "Item 2");
+
+    // Attachments after the index was built:
+    TreeItem* item5 = node.addItem("Item 5",category_c);
+    QCOMPARE(node.subjectReferencesByCategory(category_c).count(),2);
+
+    // Category changes keep the subjects in the order in which they were attached:
+    node.setMultiContextPropertyValue(item1,qti_prop_CATEGORY_MAP,qVariantFromValue(category_c));
+    QCOMPARE(node.subjectReferencesByCategory(category_ab).count(),1);
+    subjects = node.subjectReferencesByCategory(category_c);
+    QCOMPARE(subjects.count(),3);
+    QVERIFY(subjects.at(0) == item1);
+    QVERIFY(subjects.at(1) == item4);
+    QVERIFY(subjects.at(2) == item5);
+    QCOMPARE(node.subjectReferenceCategoryMap().value(item1),QString("C"));
+
+    QCOMPARE(node.renameCategory(category_c,category_d).count(),3);
+    QVERIFY(!node.hasCategory(category_c));
+    QCOMPARE(node.subjectReferencesByCategory(category_d).count(),3);
+
+    // Detachments and deletions:
+    node.detachSubject(item4);
+    QCOMPARE(node.subjectReferencesByCategory(category_d).count(),2);
+    delete item5;
+    QCOMPARE(node.subjectReferencesByCategory(category_d).count(),1);
+    QCOMPARE(node.subjectCategories().count(),3);
+
+    // Subjects attached while subject event filtering is disabled are not monitored, their category changes must still be found:
+    node.toggleSubjectEventFiltering(false);
+    TreeItem* item6 = node.addItem("Item 6",category_ab);
+    node.toggleSubjectEventFiltering(true);
+    QCOMPARE(node.subjectReferencesByCategory(category_ab).count(),2);
+    node.setMultiContextPropertyValue(item6,qti_prop_CATEGORY_MAP,qVariantFromValue(category_d));
+    QCOMPARE(node.subjectReferencesByCategory(category_ab).count(),1);
+    QCOMPARE(node.subjectReferencesByCategory(category_d).count(),2);
+    QCOMPARE(node.subjectReferenceCategoryMap().value(item6),QString("D"));
+}
+
+void Qtilities::Testing::TestObserver::testSubjectReferenceAfterRename() {
+    Observer observer("Rename Lookup Observer");
+    QObject* monitored = new QObject;
+    monitored->setObjectName("Monitored Before");
+    QVERIFY(observer.attachSubject(monitored));
+    monitored->setObjectName("Monitored After");
+    QVERIFY(observer.subjectReference("Monitored Before") == 0);
+    QVERIFY(observer.subjectReference("Monitored After") == monitored);
+
+    // Subjects attached while subject event filtering is disabled are not monitored, their names can change without the observer being notified:
+    observer.toggleSubjectEventFiltering(false);
+    QObject* unmonitored = new QObject;
+    unmonitored->setObjectName("Unmonitored Before");
+    QVERIFY(observer.attachSubject(unmonitored));
+    observer.toggleSubjectEventFiltering(true);
+    unmonitored->blockSignals(true);
+    unmonitored->setObjectName("Unmonitored After");
+    unmonitored->blockSignals(false);
+    QVERIFY(observer.subjectReference("Unmonitored After") == unmonitored);
+    QVERIFY(observer.subjectReference("Unmonitored Before") == 0);
+    QVERIFY(observer.containsSubjectWithName("unmonitored after",Qt::CaseInsensitive));
+
+    observer.detachAll();
+    delete monitored;
+    delete unmonitored;
+}
+
+void Qtilities::Testing::TestObserver::testSubjectReferenceDuplicateNames() {
+    Observer observer("Duplicate Names Observer");
+    QObject* first = new QObject;
+    first->setObjectName("Same Name");
+    QObject* renamed = new QObject;
+    renamed->setObjectName("Other Name");
+    QObject* second = new QObject;
+    second->setObjectName("Same Name");
+    QVERIFY(observer.attachSubject(first));
+    QVERIFY(observer.attachSubject(renamed));
+    QVERIFY(observer.attachSubject(second));
+    QVERIFY(observer.subjectReference("Same Name") == first);
+    QVERIFY(observer.subjectReference(observer.subjectID("Other Name")) == renamed);
+
+    // A renamed subject gets the name after the subjects which already had it, even though it appears before them in the observer:
+    renamed->setObjectName("Same Name");
+    QVERIFY(observer.subjectReference("Same Name") == first);
+    QVERIFY(observer.detachSubject(first));
+    QVERIFY(observer.subjectReference("Same Name") == second);
+    QVERIFY(observer.detachSubject(second));
+    QVERIFY(observer.subjectReference("Same Name") == renamed);
+
+    observer.detachAll();
+    delete first;
+    delete renamed;
+    delete second;
+}
+
 void Qtilities::Testing::TestObserver::testOwnershipManual() {
     LOG_INFO("TestObserver::testOwnershipManual() start:");
 
@@ -223,6 +374,44 @@ void Qtilities::Testing::TestObserver::testTreeCount() {
     QVERIFY(rootNode->treeCount() == 7);
 }
 
+void Qtilities::Testing::TestObserver::testTreeCountCached() {
+    TreeNode* rootNode = new TreeNode("Root");
+    TreeNode* parentNode1 = rootNode->addNode("Parent 1");
+    TreeNode* parentNode2 = rootNode->addNode("Parent 2");
+    parentNode1->addItem("Child 1");
+    TreeItem* child2 = parentNode1->addItem("Child 2");
+    parentNode2->addItem("Child 3");
+
+    QVERIFY(rootNode->treeCount() == 5);
+    QVERIFY(rootNode->treeCount("Qtilities::CoreGui::TreeNode") == 2);
+    QVERIFY(parentNode1->treeCount() == 2);
+
+    // Changes deep in the tree must be visible on all observers above it:
+    TreeItem* child4 = parentNode2->addItem("Child 4");
+    QVERIFY(rootNode->treeCount() == 6);
+    QVERIFY(parentNode2->treeCount() == 2);
+    parentNode1->attachSubject(child4);
+    QVERIFY(rootNode->treeCount() == 7);
+    QVERIFY(parentNode1->treeCount() == 3);
+
+    // Nested nodes change the counts for the base class name as well:
+    TreeNode* parentNode3 = parentNode2->addNode("Parent 3");
+    QVERIFY(rootNode->treeCount("Qtilities::CoreGui::TreeNode") == 3);
+    parentNode3->addItem("Child 5");
+    QVERIFY(rootNode->treeCount() == 9);
+
+    QVERIFY(parentNode1->detachSubject(child4));
+    QVERIFY(rootNode->treeCount() == 8);
+    QVERIFY(parentNode1->treeCount() == 2);
+
+    // Deleted subjects are removed from the counts:
+    delete child2;
+    QVERIFY(rootNode->treeCount() == 7);
+    QVERIFY(parentNode1->treeCount() == 1);
+
+    delete rootNode;
+}
+
 void Qtilities::Testing::TestObserver::testTreeAt() {
     // Example tree using tree node classes to simplify test:
     TreeNode* rootNode = new TreeNode("Root");
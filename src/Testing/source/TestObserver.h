@@ -56,6 +56,14 @@ namespace Qtilities {
             void testAttachWithObserverLimit();
             //! Tests the subject limit functionality Observer.
             void testSubjectLimit();
+            //! A test which tests attachSubjects() and detachSubjects() on batches of objects.
+            void testAttachDetachSubjectsBatch();
+            //! Tests that the category functions on Observer follows attachments, detachments and category changes, also on subjects which are not monitored by the event filter of the observer.
+            void testCategoryIndex();
+            //! Tests that subjects are found by their new names after they were renamed, also when the observer was not notified of the rename.
+            void testSubjectReferenceAfterRename();
+            //! Tests which subject is found by name when more than one subject has the same name.
+            void testSubjectReferenceDuplicateNames();
 
             // -----------------------------
             // Ownership related tests
@@ -76,6 +84,8 @@ namespace Qtilities {
             // -----------------------------
             //! A test which tests treeCount() function.
             void testTreeCount();
+            //! A test which checks that the cached counts of treeCount() follow changes to the tree.
+            void testTreeCountCached();
             //! A test which tests treeAt() function.
             void testTreeAt();
             //! A test which tests treeAt() function.
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestObserverTreeModel.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+int Qtilities::Testing::TestObserverTreeModel::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestObserverTreeModel::testFindObjectOnDemand() {
+    TreeNode root("Root");
+    TreeNode* branch = root.addNode("Branch");
+    TreeNode* sub_branch = branch->addNode("Sub Branch");
+    for (int i = 0; i < 10; ++i)
+        sub_branch->addItem(QString("Item %1").arg(i));
+    TreeItem* deep_item = sub_branch->addItem("Deep Item");
+
+    ObserverTreeModel model;
+    model.toggleOnDemandPopulation(true);
+    model.setFetchBatchSize(4);
+    model.setObserverContext(&root);
+
+    // Only the children of the observer context exist, thus the branch was never expanded:
+    QModelIndex branch_index = model.findObject(branch);
+    QVERIFY(branch_index.isValid());
+    QVERIFY(model.canFetchMore(branch_index));
+    QVERIFY(model.rowCount(branch_index) == 0);
+
+    // Selecting the deep item must populate the path to it, fetching batches until the item was created:
+    QModelIndex deep_index = model.findObject(deep_item);
+    QVERIFY(deep_index.isValid());
+    QVERIFY(model.getItem(deep_index)->getObject() == deep_item);
+    QVERIFY(model.rowCount(branch_index) == 1);
+    QModelIndex sub_branch_index = model.findObject(sub_branch);
+    QVERIFY(model.parent(deep_index) == sub_branch_index);
+    QVERIFY(model.rowCount(sub_branch_index) >= 11);
+
+    // Objects which are not in the tree are still not found:
+    TreeItem outside_item("Outside Item");
+    QVERIFY(!model.findObject(&outside_item).isValid());
+}
@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestQtilitiesProcess.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+namespace {
+    // Returns the complete messages in splitter and removes them from it:
+    QStringList takeMessages(ProcessBufferSplitter& splitter) {
+        QStringList messages;
+        for (int i = 0; i < splitter.messageCount(); ++i)
+            messages << splitter.message(i);
+        splitter.clearMessages();
+        return messages;
+    }
+}
+
+int Qtilities::Testing::TestQtilitiesProcess::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestQtilitiesProcess::testProcessBufferSplitter() {
+    ProcessBufferSplitter splitter;
+
+    // A message split across chunks is only complete once its separator arrived:
+    splitter.append(QByteArray("first mes"));
+    QVERIFY(splitter.messageCount() == 0);
+    QVERIFY(splitter.remainder() == "first mes");
+    splitter.append(QByteArray("sage\nsecond message\nthi"));
+    QVERIFY(takeMessages(splitter) == (QStringList() << "first message" << "second message"));
+    QVERIFY(splitter.remainder() == "thi");
+
+    // CRLF line endings split on the new line, the carriage return stays part of the message:
+    splitter.append(QByteArray("rd message\r"));
+    QVERIFY(splitter.messageCount() == 0);
+    splitter.append(QByteArray("\nfourth message\r\n\r\n"));
+    QVERIFY(takeMessages(splitter) == (QStringList() << "third message\r" << "fourth message\r" << "\r"));
+
+    // A trailing partial line is only returned when the stream is flushed:
+    splitter.append(QByteArray("fifth message\npartial line"));
+    QVERIFY(takeMessages(splitter) == (QStringList() << "fifth message"));
+    QVERIFY(splitter.remainder() == "partial line");
+    splitter.flush();
+    QVERIFY(takeMessages(splitter) == (QStringList() << "partial line"));
+    QVERIFY(splitter.remainder().isEmpty());
+
+    // Flushing an empty remainder adds nothing:
+    splitter.flush();
+    QVERIFY(splitter.messageCount() == 0);
+
+    // Multi byte UTF-8 characters split across chunks:
+    QByteArray utf8 = QString::fromUtf8("caf\xc3\xa9 message\n").toUtf8();
+    splitter.append(utf8.left(4));
+    splitter.append(utf8.mid(4));
+    QVERIFY(takeMessages(splitter) == (QStringList() << QString::fromUtf8("caf\xc3\xa9 message")));
+}
+
+void Qtilities::Testing::TestQtilitiesProcess::testProcessBufferSplitterMessageStarts() {
+    ProcessBufferSplitter splitter;
+    splitter.setLineBreakStrings(QStringList() << "ERROR:" << "WARNING:");
+
+    // Message starts are kept at the start of their message, also when they are split across chunks:
+    splitter.append(QByteArray("compiling ERR"));
+    QVERIFY(splitter.messageCount() == 0);
+    QVERIFY(splitter.remainder() == "compiling ERR");
+    splitter.append(QByteArray("OR: failed WARNING: slow\n"));
+    QVERIFY(takeMessages(splitter) == (QStringList() << "compiling " << "ERROR: failed " << "WARNING: slow"));
+
+    // A message start following a new line completes the empty message between them:
+    splitter.append(QByteArray("done\nERROR: again\r\n"));
+    QVERIFY(takeMessages(splitter) == (QStringList() << "done" << "" << "ERROR: again\r"));
+
+    // Custom separators are matched longest first:
+    ProcessBufferSplitter custom_splitter;
+    custom_splitter.clearDelimiters();
+    custom_splitter.addSeparator("\r\n");
+    custom_splitter.addSeparator("\r");
+    custom_splitter.append(QByteArray("one\r\ntwo\r"));
+    QVERIFY(takeMessages(custom_splitter) == (QStringList() << "one"));
+    custom_splitter.append(QByteArray("three\r\n"));
+    QVERIFY(takeMessages(custom_splitter) == (QStringList() << "two" << "three"));
+}
+
+void Qtilities::Testing::TestQtilitiesProcess::testProcessBufferMessages() {
+#ifndef Q_OS_WIN
+    qRegisterMetaType<Logger::MessageType>("Logger::MessageType");
+
+    QtilitiesProcess process("Buffer Messages");
+    QSignalSpy spy(&process,SIGNAL(newMessageLogged(QString,Logger::MessageType)));
+
+    // The pauses make the output arrive in separate chunks, splitting the first message and ending with a partial line:
+    QString script = "printf 'first mes'; sleep 1; printf 'sage\\r\\nsecond   message\\r\\n'; sleep 1; printf 'partial line'";
+    QVERIFY(process.startProcess("sh",QStringList() << "-c" << script));
+    QVERIFY(process.process()->waitForFinished(10000));
+    QVERIFY(process.state() == ITask::TaskCompleted);
+
+    QStringList messages;
+    for (int i = 0; i < spy.count(); ++i)
+        messages << spy.at(i).at(0).toString();
+
+    // Messages are simplified, which removes the carriage returns:
+    int first = messages.indexOf("first message");
+    QVERIFY(first != -1);
+    QVERIFY(messages.mid(first,3) == (QStringList() << "first message" << "second message" << "partial line"));
+    QVERIFY(!messages.contains("first mes"));
+    QVERIFY(messages.count("partial line") == 1);
+#endif
+}
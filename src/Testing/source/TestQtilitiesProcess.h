@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_QTILITIES_PROCESS_H
+#define TEST_QTILITIES_PROCESS_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::QtilitiesProcess and Qtilities::Core::ProcessBufferSplitter.
+        class TESTING_SHARED_EXPORT TestQtilitiesProcess: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("Qtilities Process"); }
+
+        private slots:
+            //! Tests the exact messages produced by Qtilities::Core::ProcessBufferSplitter for data split across chunks, CRLF line endings and trailing partial lines.
+            void testProcessBufferSplitter();
+            //! Tests the exact messages produced by Qtilities::Core::ProcessBufferSplitter when message starts are used.
+            void testProcessBufferSplitterMessageStarts();
+            //! Tests the exact messages logged by Qtilities::Core::QtilitiesProcess for output which arrives in multiple chunks.
+            void testProcessBufferMessages();
+        };
+    }
+}
+
+#endif // TEST_QTILITIES_PROCESS_H
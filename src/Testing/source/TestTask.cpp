@@ -14,6 +14,60 @@
 #include <QtilitiesCore>
 using namespace QtilitiesCore;
 
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSemaphore>
+#include <QSignalSpy>
+
+namespace Qtilities {
+    namespace Testing {
+        class TestCountingWorkItem : public TaskWorkItem {
+        public:
+            TestCountingWorkItem(int count, QAtomicInt* total, ITask::TaskResult result = ITask::TaskSuccessful) : TaskWorkItem(count),
+                d_count(count),
+                d_total(total),
+                d_result(result) {}
+
+            ITask::TaskResult run() {
+                for (int i = 0; i < d_count; ++i) {
+                    if (!checkPoint())
+                        return ITask::TaskFailed;
+                    d_total->ref();
+                    addCompletedSubTasks(1);
+                }
+                return d_result;
+            }
+
+        private:
+            int                 d_count;
+            QAtomicInt*         d_total;
+            ITask::TaskResult   d_result;
+        };
+
+        class TestGateWorkItem : public TaskWorkItem {
+        public:
+            TestGateWorkItem(QSemaphore* gate) : d_gate(gate) {}
+
+            ITask::TaskResult run() {
+                d_gate->acquire();
+                return ITask::TaskSuccessful;
+            }
+
+        private:
+            QSemaphore* d_gate;
+        };
+
+        //! Adds a process to \p pool which does nothing for the given number of seconds.
+        int addSleepProcess(QtilitiesProcessPool& pool, int seconds) {
+        #ifdef Q_OS_WIN
+            return pool.addProcess("ping",QStringList() << "-n" << QString::number(seconds + 1) << "127.0.0.1");
+        #else
+            return pool.addProcess("sleep",QStringList() << QString::number(seconds));
+        #endif
+        }
+    }
+}
+
 int Qtilities::Testing::TestTask::execTest(int argc, char ** argv) {
     return QTest::qExec(this,argc,argv);
 }
@@ -40,3 +94,189 @@ void Qtilities::Testing::TestTask::testBusyState() {
     QVERIFY(task.state() == ITask::TaskCompleted);
     QVERIFY(task.result() == ITask::TaskFailed);
 }
+
+void Qtilities::Testing::TestTask::testTaskExecutor() {
+    TaskExecutor executor;
+    QAtomicInt total(0);
+
+    Task first_task("First Work Item");
+    Task second_task("Second Work Item");
+    int first_id = executor.submit(new TestCountingWorkItem(10,&total),&first_task);
+    int second_id = executor.submit(new TestCountingWorkItem(5,&total),&second_task,TaskExecutor::HighPriority,QList<int>() << first_id);
+    QVERIFY(first_id != -1);
+    QVERIFY(second_id != -1);
+    QVERIFY(executor.waitForDone(10000));
+
+    QVERIFY(total.fetchAndAddRelaxed(0) == 15);
+    QVERIFY(executor.workItemState(first_id) == TaskExecutor::WorkItemFinished);
+    QVERIFY(executor.workItemState(second_id) == TaskExecutor::WorkItemFinished);
+    QVERIFY(first_task.state() == ITask::TaskCompleted);
+    QVERIFY(first_task.result() == ITask::TaskSuccessful);
+    QVERIFY(first_task.currentProgress() == 10);
+    QVERIFY(second_task.result() == ITask::TaskSuccessful);
+
+    // Work items depending on a failed work item must be cancelled:
+    Task failing_task("Failing Work Item");
+    Task dependent_task("Dependent Work Item");
+    int failing_id = executor.submit(new TestCountingWorkItem(1,&total,ITask::TaskFailed),&failing_task);
+    int dependent_id = executor.submit(new TestCountingWorkItem(1,&total),&dependent_task,TaskExecutor::NormalPriority,QList<int>() << failing_id);
+    QVERIFY(executor.waitForDone(10000));
+
+    QVERIFY(total.fetchAndAddRelaxed(0) == 16);
+    QVERIFY(executor.workItemResult(failing_id) == ITask::TaskFailed);
+    QVERIFY(executor.workItemState(dependent_id) == TaskExecutor::WorkItemCancelled);
+    QVERIFY(dependent_task.state() == ITask::TaskCompleted);
+    QVERIFY(dependent_task.result() == ITask::TaskFailed);
+
+    // Pausing and cancelling a work item which is still waiting for its dependencies:
+    QSemaphore gate;
+    Task gate_task("Gate Work Item");
+    Task paused_task("Paused Work Item");
+    int gate_id = executor.submit(new TestGateWorkItem(&gate),&gate_task);
+    int paused_id = executor.submit(new TestCountingWorkItem(1,&total),&paused_task,TaskExecutor::NormalPriority,QList<int>() << gate_id);
+    QVERIFY(executor.workItemState(paused_id) == TaskExecutor::WorkItemWaiting);
+    executor.pause(paused_id);
+    executor.cancel(paused_id);
+    QVERIFY(executor.workItemState(paused_id) == TaskExecutor::WorkItemCancelled);
+    gate.release();
+    QVERIFY(executor.waitForDone(10000));
+
+    QVERIFY(total.fetchAndAddRelaxed(0) == 16);
+    QVERIFY(executor.workItemResult(gate_id) == ITask::TaskSuccessful);
+    QVERIFY(paused_task.result() == ITask::TaskFailed);
+
+    // Finished work items are removed, only the outcome of recent work items is remembered:
+    int last_id = -1;
+    for (int i = 0; i < 2000; ++i)
+        last_id = executor.submit(new TestCountingWorkItem(1,&total),0,TaskExecutor::NormalPriority,QList<int>() << last_id);
+    QVERIFY(executor.waitForDone(30000));
+    QVERIFY(total.fetchAndAddRelaxed(0) == 2016);
+    QVERIFY(executor.activeWorkItemCount() == 0);
+    QVERIFY(executor.workItemState(last_id) == TaskExecutor::WorkItemFinished);
+    QVERIFY(executor.workItemState(first_id) == TaskExecutor::WorkItemUnknown);
+
+    // Dependencies which finished earlier are resolved from the remembered outcome:
+    int late_id = executor.submit(new TestCountingWorkItem(1,&total),0,TaskExecutor::NormalPriority,QList<int>() << last_id);
+    QVERIFY(executor.waitForDone(10000));
+    QVERIFY(executor.workItemState(late_id) == TaskExecutor::WorkItemFinished);
+    QVERIFY(total.fetchAndAddRelaxed(0) == 2017);
+}
+
+void Qtilities::Testing::TestTask::testTaskExecutorPausedQueuedItems() {
+    TaskExecutor executor;
+    executor.setMaxThreadCount(1);
+    QAtomicInt total(0);
+
+    // The gate occupies the only thread while the paused item is queued behind it:
+    QSemaphore gate;
+    int gate_id = executor.submit(new TestGateWorkItem(&gate));
+    int paused_id = executor.submit(new TestCountingWorkItem(1,&total));
+    executor.pause(paused_id);
+    int other_id = executor.submit(new TestCountingWorkItem(10,&total));
+    gate.release();
+
+    // The paused item must give its thread back, allowing the other item to run:
+    QElapsedTimer timer;
+    timer.start();
+    while (executor.workItemState(other_id) != TaskExecutor::WorkItemFinished && timer.elapsed() < 10000)
+        QCoreApplication::sendPostedEvents(&executor,QEvent::MetaCall);
+    QVERIFY(executor.workItemState(gate_id) == TaskExecutor::WorkItemFinished);
+    QVERIFY(executor.workItemState(other_id) == TaskExecutor::WorkItemFinished);
+    QVERIFY(executor.workItemState(paused_id) == TaskExecutor::WorkItemQueued);
+    QVERIFY(total.fetchAndAddRelaxed(0) == 10);
+
+    executor.resume(paused_id);
+    QVERIFY(executor.waitForDone(10000));
+    QVERIFY(executor.workItemState(paused_id) == TaskExecutor::WorkItemFinished);
+    QVERIFY(total.fetchAndAddRelaxed(0) == 11);
+
+    // Cancelling a paused item which gave its thread back finishes it directly:
+    gate_id = executor.submit(new TestGateWorkItem(&gate));
+    paused_id = executor.submit(new TestCountingWorkItem(1,&total));
+    executor.pause(paused_id);
+    gate.release();
+    QVERIFY(!executor.waitForDone(500));
+    executor.cancel(paused_id);
+    QVERIFY(executor.waitForDone(10000));
+    QVERIFY(executor.workItemState(paused_id) == TaskExecutor::WorkItemCancelled);
+    QVERIFY(total.fetchAndAddRelaxed(0) == 11);
+}
+
+void Qtilities::Testing::TestTask::testProcessPool() {
+    QtilitiesProcessPool pool("Process Pool",false);
+    pool.setMaxConcurrentProcesses(2);
+    QSignalSpy started_spy(&pool,SIGNAL(processAboutToStart(int,QtilitiesProcess*)));
+    QSignalSpy finished_spy(&pool,SIGNAL(allProcessesFinished()));
+
+    for (int i = 0; i < 5; ++i)
+        addSleepProcess(pool,1);
+    QVERIFY(pool.startProcesses());
+    QVERIFY(pool.runningProcessCount() == 2);
+    QVERIFY(pool.queuedProcessCount() == 3);
+    QVERIFY(started_spy.count() == 2);
+
+    // Processes added while the pool is busy are part of its progress:
+    addSleepProcess(pool,1);
+    QVERIFY(pool.numberOfSubTasks() == 6);
+
+    QElapsedTimer timer;
+    timer.start();
+    while (pool.state() == ITask::TaskBusy && timer.elapsed() < 30000) {
+        QVERIFY(pool.runningProcessCount() <= 2);
+        QCoreApplication::processEvents(QEventLoop::AllEvents,50);
+    }
+    QVERIFY(pool.state() == ITask::TaskCompleted);
+    QVERIFY(pool.result() == ITask::TaskSuccessful);
+    QVERIFY(pool.finishedProcessCount() == 6);
+    QVERIFY(pool.currentProgress() == pool.numberOfSubTasks());
+    QVERIFY(finished_spy.count() == 1);
+
+    // Processes are started in the order in which they were added:
+    QVERIFY(started_spy.count() == 6);
+    for (int i = 0; i < started_spy.count(); ++i) {
+        QVERIFY(started_spy.at(i).at(0).toInt() == i);
+        QVERIFY(pool.processResult(i) == ITask::TaskSuccessful);
+    }
+
+    // Stopping the pool must not wait for the processes and must drop the queue:
+    QVERIFY(pool.clearProcesses());
+    finished_spy.clear();
+    for (int i = 0; i < 4; ++i)
+        addSleepProcess(pool,30);
+    QVERIFY(pool.startProcesses());
+    timer.restart();
+    pool.stopProcesses();
+    QVERIFY(timer.elapsed() < 1000);
+    QVERIFY(pool.queuedProcessCount() == 0);
+    QVERIFY(pool.waitForFinished(10000));
+    QVERIFY(pool.state() == ITask::TaskCompleted);
+    QVERIFY(pool.result() == ITask::TaskFailed);
+    QVERIFY(pool.runningProcessCount() == 0);
+    QVERIFY(pool.finishedProcessCount() == 2);
+    QVERIFY(pool.process(2) == 0);
+    QVERIFY(finished_spy.count() == 1);
+}
+
+void Qtilities::Testing::TestTask::testProgressUpdateRate() {
+    Task task("Throttled Task");
+    task.setProgressUpdateRate(30);
+    QVERIFY(task.progressUpdateRate() == 30);
+
+    QSignalSpy spy(&task,SIGNAL(subTaskCompleted(int,QString,Logger::MessageType)));
+    task.startTask(10000);
+    for (int i = 0; i < 10000; ++i)
+        task.addCompletedSubTasks(1,"Sub task completed");
+    QVERIFY(task.currentProgress() == 10000);
+    QVERIFY(spy.count() < 10000);
+
+    task.logWarning("Warning message");
+    QVERIFY(task.busyState() == ITask::TaskBusyWithWarnings);
+
+    // Completing the task must broadcast all outstanding progress:
+    task.completeTask();
+    int broadcast_progress = 0;
+    for (int i = 0; i < spy.count(); ++i)
+        broadcast_progress += spy.at(i).at(0).toInt();
+    QVERIFY(broadcast_progress == 10000);
+    QVERIFY(task.result() == ITask::TaskSuccessfulWithWarnings);
+}
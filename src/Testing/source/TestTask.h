@@ -43,6 +43,14 @@ namespace Qtilities {
         private slots:
             //! Tests related to the busy state of the task.
             void testBusyState();
+            //! Tests running work items with dependencies on a Qtilities::Core::TaskExecutor.
+            void testTaskExecutor();
+            //! Tests that paused work items which did not start yet do not occupy threads of a Qtilities::Core::TaskExecutor.
+            void testTaskExecutorPausedQueuedItems();
+            //! Tests running a queue of processes on a Qtilities::Core::QtilitiesProcessPool.
+            void testProcessPool();
+            //! Tests throttled progress updates of Qtilities::Core::Task.
+            void testProgressUpdateRate();
         };
     }
 }
@@ -371,3 +371,74 @@ void Testing::TestTreeIterator::testIterationForwardMultipleParentsC() {
 //    }
 }
 
+
+void Qtilities::Testing::TestTreeIterator::testSetCurrentMultipleParents() {
+    TreeNode* rootTop = new TreeNode("Root Node");
+    TreeNode* rootNodeA = new TreeNode("A1");
+    rootNodeA->addItem("A2");
+    TreeItem* shared_item = rootNodeA->addItem("A3");
+    QObject* lastA = rootNodeA->addItem("A4");
+    TreeNode* rootNodeB = new TreeNode("B1");
+    QObject* firstB = rootNodeB->addItem("B2");
+    rootNodeB->attachSubject(shared_item);
+    QObject* lastB = rootNodeB->addItem("B3");
+    rootTop->attachSubject(rootNodeA);
+    rootTop->attachSubject(rootNodeB);
+
+    TreeIterator itr(rootTop);
+    itr.setCurrent(shared_item,rootNodeB);
+    QVERIFY(itr.current() == shared_item);
+    QVERIFY(itr.next() == lastB);
+    itr.setCurrent(shared_item,rootNodeA);
+    QVERIFY(itr.next() == lastA);
+
+    // Without a parent, the first occurrence following the current position is used:
+    itr.setCurrent(firstB);
+    itr.setCurrent(shared_item);
+    QVERIFY(itr.next() == lastB);
+    itr.setCurrent(lastB);
+    itr.setCurrent(shared_item);
+    QVERIFY(itr.next() == lastB);
+    itr.first();
+    itr.setCurrent(shared_item);
+    QVERIFY(itr.next() == lastA);
+
+    // Objects which are not in the tree move the iterator to the top node:
+    itr.setCurrent(rootTop);
+    QVERIFY(itr.current() == rootTop);
+    QVERIFY(itr.previous() == 0);
+
+    delete rootTop;
+}
+
+void Qtilities::Testing::TestTreeIterator::testTreeSnapshotInvalidation() {
+    TreeNode* rootTop = new TreeNode("Root Node");
+    TreeNode* nodeA = rootTop->addNode("A");
+    TreeNode* nodeB = nodeA->addNode("B");
+    nodeB->addItem("B1");
+    QCOMPARE(rootTop->treeSnapshot().objects.count(),3);
+    QCOMPARE(nodeA->treeSnapshot().objects.count(),2);
+
+    // Attaching to a node deep down the tree must refresh the snapshots of all nodes above it:
+    TreeItem* item = nodeB->addItem("B2");
+    QVERIFY(rootTop->treeContains(item));
+    QVERIFY(rootTop->treeAt(3) == item);
+    QVERIFY(nodeA->treeContains(item));
+    TreeIterator itr(rootTop);
+    QVERIFY(itr.last() == item);
+
+    // Changes to unrelated observers do not affect the tree:
+    QObject* unrelated = new QObject;
+    unrelated->setObjectName("Unrelated");
+    OBJECT_MANAGER->registerObject(unrelated);
+    QCOMPARE(rootTop->treeSnapshot().objects.count(),4);
+    OBJECT_MANAGER->removeObject(unrelated);
+    delete unrelated;
+
+    nodeB->detachSubject(item);
+    QVERIFY(!rootTop->treeContains(item));
+    QCOMPARE(rootTop->treeSnapshot().objects.count(),3);
+    QCOMPARE(nodeA->treeSnapshot().objects.count(),2);
+
+    delete rootTop;
+}
@@ -60,6 +60,10 @@ namespace Qtilities {
             void testIterationBackwardComplexA();
             //! Tests forward interation through a tree with items that appear in more than once tree.
             void testIterationForwardMultipleParentsC();
+            //! Tests that setCurrent() selects the correct occurrence of items that appear in more than one tree.
+            void testSetCurrentMultipleParents();
+            //! Tests that the tree snapshot of an observer is refreshed when an observer underneath it changes.
+            void testTreeSnapshotInvalidation();
         };
     }
 }
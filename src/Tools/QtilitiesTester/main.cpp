@@ -104,8 +104,20 @@ int main(int argc, char *argv[])
     TestTask* testTask = new TestTask;
     testFrontend.addTest(testTask,QtilitiesCategory("Qtilities::Core","::"));
 
+    TestLogger* testLogger = new TestLogger;
+    testFrontend.addTest(testLogger,QtilitiesCategory("Qtilities::Logging","::"));
+
     TestFileSetInfo* testFileSetInfo = new TestFileSetInfo;
     testFrontend.addTest(testFileSetInfo,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestFileUtils* testFileUtils = new TestFileUtils;
+    testFrontend.addTest(testFileUtils,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestObserverTreeModel* testObserverTreeModel = new TestObserverTreeModel;
+    testFrontend.addTest(testObserverTreeModel,QtilitiesCategory("Qtilities::CoreGui","::"));
+
+    TestQtilitiesProcess* testQtilitiesProcess = new TestQtilitiesProcess;
+    testFrontend.addTest(testQtilitiesProcess,QtilitiesCategory("Qtilities::Core","::"));
     #endif
 
     // ---------------------------------------------